@@ -356,12 +356,13 @@ def _pso_gen_racing_ctor(
         neighb_type=2,
         neighb_param=4,
         nr_eval_per_x=5,
-        max_fevals=10000000):
+        max_fevals=10000000,
+        threads=1):
     """
     Constructs a Particle Swarm Optimization (generational). The position update is applied
     only at the end of an entire loop over the population (swarm). Use this version for stochastic problems.
 
-    USAGE: algorithm.pso_gen(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4, nr_eval_per_x = 5, max_fevals = 10000000)
+    USAGE: algorithm.pso_gen(gen=1, omega = 0.7298, eta1 = 2.05, eta2 = 2.05, vcoeff = 0.5, variant = 5, neighb_type = 2, neighb_param = 4, nr_eval_per_x = 5, max_fevals = 10000000, threads = 1)
 
     * gen: number of generations
     * omega: constriction factor (or particle inertia weight) in [0,1]
@@ -391,6 +392,9 @@ def _pso_gen_racing_ctor(
             The minimum outdegree is 1 (the particle always connects back to itself).
 * nr_eval_per_x: Specify the expected budget to be allocated during racing
     * max_fevals: When specified other than -1, this serve as another termination condition -- maximium number of objective function evaluations
+    * threads: number of threads re-evaluating the individuals during racing (0 for the number of hardware threads).
+            Only problems implemented in C++ can be evaluated with more than one thread.
+            The speedup achieved in the last evolution is available as the racing_speedup attribute
     """
     # We set the defaults or the kwargs
     arg_list = []
@@ -403,8 +407,10 @@ def _pso_gen_racing_ctor(
     arg_list.append(neighb_type)
     arg_list.append(neighb_param)
     arg_list.append(nr_eval_per_x)
-    if max_fevals > 0:
-        arg_list.append(max_fevals)
+    if max_fevals <= 0:
+        max_fevals = 2 ** 32 - 1
+    arg_list.append(max_fevals)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 pso_gen_racing._orig_init = pso_gen_racing.__init__
 pso_gen_racing.__init__ = _pso_gen_racing_ctor
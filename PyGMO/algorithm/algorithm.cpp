@@ -321,7 +321,9 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	// Particle Swarm Optimization (generational with racing mechanism)
 	algorithm_wrapper<algorithm::pso_generational_racing>("pso_gen_racing", "Particle Swarm Optimization (generational with racing)")
-		.def(init<optional<int,double, double, double, double, int, int, int, unsigned int, unsigned int> >());
+		.def(init<optional<int,double, double, double, double, int, int, int, unsigned int, unsigned int, unsigned int> >())
+		.add_property("threads", &algorithm::pso_generational_racing::get_threads)
+		.add_property("racing_speedup", &algorithm::pso_generational_racing::get_racing_speedup);
 	
 	// Simple Genetic Algorithm.
 	algorithm_wrapper<algorithm::sga>("sga", "A simple genetic algorithm (generational)")
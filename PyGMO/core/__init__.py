@@ -15,6 +15,7 @@ __all__ = [
     'island',
     'local_island',
     'migration_direction',
+    'migr_history_mode',
     'population',
     'py_island']
 
@@ -551,11 +552,11 @@ population.plot_pareto_fronts = _pop_plot_pareto_fronts
 
 
 def _pop_race(self, n_winners, min_trials=0, max_feval=500,
-              delta=0.05, racers_idx=[], race_best=True, screen_output=False):
+              delta=0.05, racers_idx=[], race_best=True, screen_output=False, threads=1):
     """
     Races individuals in a population
 
-    USAGE: pop.race(n_winners, min_trials = 0, max_feval = 500, delta = 0.05, racers_idx = [], race_best=True, screen_output=False)
+    USAGE: pop.race(n_winners, min_trials = 0, max_feval = 500, delta = 0.05, racers_idx = [], race_best=True, screen_output=False, threads=1)
 
     * n_winners: number of winners in the race
     * min_trials: minimum amount of evaluations before an individual can stop racing
@@ -564,6 +565,8 @@ def _pop_race(self, n_winners, min_trials=0, max_feval=500,
     * racers_idx: indices of the individuals in pop to be raced
     * race_best: when True winners are the best, otherwise winners are the worst
     * screen_output: produces some screen output at each iteration of the race
+    * threads: number of threads re-evaluating the racers (0 for the number of hardware threads).
+            Only problems implemented in C++ can be evaluated with more than one thread
     """
     arg_list = []
     arg_list.append(n_winners)
@@ -573,6 +576,7 @@ def _pop_race(self, n_winners, min_trials=0, max_feval=500,
     arg_list.append(racers_idx)
     arg_list.append(race_best)
     arg_list.append(screen_output)
+    arg_list.append(threads)
     return self._orig_race(*arg_list)
 
 population._orig_race = population.race
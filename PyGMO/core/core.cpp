@@ -77,8 +77,9 @@ static inline boost::python::tuple race_return_tuple(const population &pop, cons
 									double delta = 0.05,
 									const std::vector<population::size_type> &active_set = std::vector<population::size_type>(),
 									const bool race_best = true,
-									const bool screen_output = false) {
-	std::pair<std::vector<pagmo::population::size_type>, unsigned int> res = pop.race(n_final,min_trials, max_count, delta, active_set, race_best ,screen_output);
+									const bool screen_output = false,
+									const unsigned int n_threads = 1) {
+	std::pair<std::vector<pagmo::population::size_type>, unsigned int> res = pop.race(n_final,min_trials, max_count, delta, active_set, race_best ,screen_output, n_threads);
 	return boost::python::make_tuple(res.first,res.second);
 }
 
@@ -130,6 +131,11 @@ inline static void population_set_x(population &pop, int n, const decision_vecto
 	pop.set_x(boost::numeric_cast<population::size_type>(n),x);
 }
 
+inline static void population_set_xfc(population &pop, int n, const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	pop.set_x(boost::numeric_cast<population::size_type>(n),x,f,c);
+}
+
 inline static void population_set_v(population &pop, int n, const decision_vector &v)
 {
 	pop.set_v(boost::numeric_cast<population::size_type>(n),v);
@@ -278,7 +284,14 @@ BOOST_PYTHON_MODULE(_core)
 
 	typedef population::size_type (population::*get_best_1_idx)() const;
 	typedef std::vector<population::size_type> (population::*get_best_N_idx)(const population::size_type& N) const;
+	typedef void (population::*push_back_x)(const decision_vector &);
+	typedef void (population::*push_back_xfc)(const decision_vector &, const fitness_vector &, const constraint_vector &);
+	typedef bool (population::*replace_worst_x)(const decision_vector &);
+	typedef bool (population::*replace_worst_xfc)(const decision_vector &, const fitness_vector &, const constraint_vector &);
 
+	enum_<population::pareto_engine::type>("_pareto_engine_type")
+		.value("INCREMENTAL", population::pareto_engine::INCREMENTAL)
+		.value("LAZY_SORT", population::pareto_engine::LAZY_SORT);
 
 	class_<population>("population", "Population class.", init<const problem::base &,optional<int, boost::uint32_t> >())
 		.def(init<const population &>())
@@ -294,15 +307,22 @@ BOOST_PYTHON_MODULE(_core)
 		.def("compute_nadir",&population::compute_nadir, "Get the nadir objective vector")
 		.def("compute_ideal",&population::compute_ideal, "Get the ideal objective vector")
 		.def("compute_pareto_fronts",&population::compute_pareto_fronts, "Computes all Pareto fronts")
+		.add_property("pareto_engine",&population::get_pareto_engine,&population::set_pareto_engine, "Pareto bookkeeping engine (INCREMENTAL or LAZY_SORT)")
+		.add_property("evaluation_check",&population::get_evaluation_check,&population::set_evaluation_check, "Re-evaluate the individuals inserted with their fitness and constraints")
 //		.def("get_crowding_d",&population::get_crowding_d, "returns crowding distance")
 //		.def("update_pareto_information",&population::update_pareto_information, "updates crowding distance and front informations")
 		.def("get_best_idx",get_best_1_idx(&population::get_best_idx),"Get index of best individual.")
 		.def("get_best_idx",get_best_N_idx(&population::get_best_idx),"Get index of best N individual.")
 		.def("get_worst_idx",&population::get_worst_idx,"Get index of worst individual.")
 		.def("set_x", &population_set_x,"Set decision vector of individual at position n.")
+		.def("set_x", &population_set_xfc,"Set decision vector of individual at position n, with its fitness and constraints already evaluated.")
 		.def("set_v", &population_set_v,"Set velocity of individual at position n.")
-		.def("push_back", &population::push_back,"Append individual with given decision vector at the end of the population.")
+		.def("push_back", push_back_x(&population::push_back),"Append individual with given decision vector at the end of the population.")
+		.def("push_back", push_back_xfc(&population::push_back),"Append individual with given decision vector, fitness and constraints at the end of the population.")
 		.def("erase", &population::erase, "Erase individual at position")
+		.def("erase_unordered", &population::erase_unordered, "Erase individual at position, moving the last individual in its place")
+		.def("replace_worst", replace_worst_x(&population::replace_worst),"Replace the worst individual with the given decision vector, if not worse. Returns True on replacement.")
+		.def("replace_worst", replace_worst_xfc(&population::replace_worst),"Replace the worst individual with the given decision vector, fitness and constraints, if not worse. Returns True on replacement.")
 		.def("mean_velocity", &population::mean_velocity, "Calculates the mean velocity across particles")
 		.def("race", &race_return_tuple, "Race the individuals")
 		.def("repair", &population_repair, "Repair the individual at the given index")
@@ -395,10 +415,15 @@ BOOST_PYTHON_MODULE(_core)
 		.def("join", &archipelago::join,"Wait for evolution to complete.")
 		.def("interrupt", &archipelago::interrupt,"Interrupt evolution.")
 		.def("busy", &archipelago::busy,"Check if archipelago is evolving.")
+		.add_property("threads", &archipelago::get_threads, &archipelago::set_threads, "Number of worker threads evolving the islands (0 for one thread per island).")
 		.def("push_back", &archipelago::push_back,"Append island.")
 		.def("set_algorithm", &archipelago_set_algorithm,"Set algorithm on island.")
 		.def("dump_migr_history", &archipelago::dump_migr_history)
 		.def("clear_migr_history", &archipelago::clear_migr_history)
+		.def("set_migr_history", &archipelago::set_migr_history,"Set the migration history mode *mode*, with capacity *capacity* for migr_history_mode.history_ring.",
+			(boost::python::arg("mode"),boost::python::arg("capacity") = 0))
+		.add_property("migr_history_mode", &archipelago::get_migr_history_mode, "Migration history mode.")
+		.add_property("migr_history_capacity", &archipelago::get_migr_history_capacity, "Capacity of the migration history in migr_history_mode.history_ring mode.")
 		.def("cpp_loads", &py_cpp_loads<archipelago>,
 			"Load C++ serialized representation from string *str*.\n\n"
 			":Parameters:\n"
@@ -420,4 +445,10 @@ BOOST_PYTHON_MODULE(_core)
 	enum_<archipelago::migration_direction>("migration_direction")
 		.value("source",archipelago::source)
 		.value("destination",archipelago::destination);
+
+	enum_<archipelago::migr_history_mode>("migr_history_mode")
+		.value("history_off",archipelago::history_off)
+		.value("history_full",archipelago::history_full)
+		.value("history_ring",archipelago::history_ring)
+		.value("history_aggregate",archipelago::history_aggregate);
 }
@@ -89,11 +89,11 @@ BOOST_PYTHON_MODULE(_migration) {
 
 	// Hypervolume greedy selection policy
 	migration_s_policy_wrapper<migration::hv_greedy_s_policy>("hv_greedy_s_policy","Hypervolume Greedy migration selection policy.")
-		.def(init<optional<const double &, migration::rate_type, const double> >());
+		.def(init<optional<const double &, migration::rate_type, const double, const util::hv_algorithm::base_ptr> >());
 
 	// Hypervolume best selection policy
 	migration_s_policy_wrapper<migration::hv_best_s_policy>("hv_best_s_policy","Hypervolume Best migration selection policy.")
-		.def(init<optional<const double &, migration::rate_type, const double> >());
+		.def(init<optional<const double &, migration::rate_type, const double, const util::hv_algorithm::base_ptr> >());
 
 	// Expose migration replacement policies.	
 
@@ -114,11 +114,11 @@ BOOST_PYTHON_MODULE(_migration) {
 
 	// Hypervolume greedy replacement policy.
 	migration_r_policy_wrapper<migration::hv_greedy_r_policy>("hv_greedy_r_policy","Hypervolume greedy migration replacement policy.")
-		.def(init<optional<const double &, migration::rate_type, const double> >());
+		.def(init<optional<const double &, migration::rate_type, const double, const util::hv_algorithm::base_ptr> >());
 
 	// Hypervolume fair replacement policy.
 	migration_r_policy_wrapper<migration::hv_fair_r_policy>("hv_fair_r_policy","Hypervolume fair migration replacement policy.")
-		.def(init<optional<const double &, migration::rate_type, const double> >());
+		.def(init<optional<const double &, migration::rate_type, const double, const util::hv_algorithm::base_ptr> >());
 
 	// Register to_python conversion from smart pointer.
 	register_ptr_to_python<migration::base_s_policy_ptr>();
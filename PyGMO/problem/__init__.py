@@ -716,12 +716,13 @@ def _noisy_ctor(
         param_first=0.0,
         param_second=1.0,
         noise_type=noisy.noise_distribution.NORMAL,
-        seed=0):
+        seed=0,
+        threads=1):
     """
     Inject noise to a problem.
     The new objective function will become stochastic, influence by a normally distributed noise.
 
-    USAGE: problem.noisy(problem=PyGMO.ackley(1), trials = 1, param_first=0.0, param_second=1.0, noise_type = problem.noisy.noise_distribution.NORMAL, seed=0)
+    USAGE: problem.noisy(problem=PyGMO.ackley(1), trials = 1, param_first=0.0, param_second=1.0, noise_type = problem.noisy.noise_distribution.NORMAL, seed=0, threads=1)
 
     * problem: PyGMO problem on which one wants to add noises
     * trials: number of trials to average around
@@ -729,6 +730,7 @@ def _noisy_ctor(
     * param_second: Standard deviation of the Gaussian noise / Upper bound of the uniform noise
     * noise_type: Whether to inject a normally distributed noise or uniformly distributed noise
     * seed: Seed for the underlying RNG
+    * threads: number of threads evaluating the trials (0 for all the hardware threads, must be 1 for problems written in Python)
     """
 
     # We construct the arg list for the original constructor exposed by
@@ -742,22 +744,24 @@ def _noisy_ctor(
     arg_list.append(param_second)
     arg_list.append(noise_type)
     arg_list.append(seed)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 noisy._orig_init = noisy.__init__
 noisy.__init__ = _noisy_ctor
 
 
-def _robust_ctor(self, problem=None, trials=1, rho=0.1, seed=0):
+def _robust_ctor(self, problem=None, trials=1, rho=0.1, seed=0, threads=1):
     """
     Inject noise to a problem in the decision space.
     The solution to the resulting problem is robust the the noise in the rho area.
 
-    USAGE: problem.robust(problem=PyGMO.ackley(10), trials=1, rho=0.1, seed=0)
+    USAGE: problem.robust(problem=PyGMO.ackley(10), trials=1, rho=0.1, seed=0, threads=1)
 
     * problem: PyGMO problem to be transformed to its robust version
     * trials: number of trials to average around
     * rho: Parameter controlling the magnitude of noise
     * seed: Seed for the underlying RNG
+    * threads: number of threads evaluating the trials (0 for all the hardware threads, must be 1 for problems written in Python)
     """
     arg_list = []
     if problem is None:
@@ -766,6 +770,7 @@ def _robust_ctor(self, problem=None, trials=1, rho=0.1, seed=0):
     arg_list.append(trials)
     arg_list.append(rho)
     arg_list.append(seed)
+    arg_list.append(threads)
     self._orig_init(*arg_list)
 robust._orig_init = robust.__init__
 robust.__init__ = _robust_ctor
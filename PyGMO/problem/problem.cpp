@@ -248,6 +248,13 @@ BOOST_PYTHON_MODULE(_problem) {
 		.add_property("best_c",make_function(&problem::base::get_best_c,return_value_policy<copy_const_reference>()),"Best known constraints vector(s).")
 		.add_property("fevals",&problem::base::get_fevals,"Number of function evaluations.")
 		.add_property("cevals",&problem::base::get_cevals,"Number of constraints evaluations.")
+		// Caching.
+		.add_property("cache_capacity",&problem::base::get_cache_capacity,&problem::base::set_cache_capacity,"Capacity of the fitness and constraint caches.")
+		.add_property("cache_quantum",&problem::base::get_cache_quantum,&problem::base::set_cache_quantum,"Quantization step used to look up decision vectors in the caches (0 for bitwise comparison).")
+		.add_property("cache_hits",&problem::base::get_cache_hits,"Number of evaluations served by the caches.")
+		.add_property("cache_misses",&problem::base::get_cache_misses,"Number of evaluations not served by the caches.")
+		// Batch evaluation.
+		.add_property("batch_threads",&problem::base::get_batch_threads,&problem::python_base::py_set_batch_threads,"Number of threads used to evaluate batches of decision vectors (0 for the hardware concurrency). Must be 1 for problems implemented in Python.")
 		.def_pickle(python_class_pickle_suite<problem::python_base>());
 
 	// Expose base stochastic problem class, including the virtual methods. Here we explicitly
@@ -409,7 +416,7 @@ BOOST_PYTHON_MODULE(_problem) {
 	// Travelling salesman problem (TSP)
 	tsp_problem_wrapper<problem::tsp>("tsp","Travelling salesman problem (TSP and ATSP)")
 		.def(init<const std::vector<std::vector<double> > &, const problem::base_tsp::encoding_type &>())
-		.add_property("weights", make_function(&problem::tsp::get_weights, return_value_policy<copy_const_reference>()));
+		.add_property("weights", &problem::tsp::get_weights);
 
 	// Travelling salesman problem, vehicle routing problem with limited capacity variant (TSP-VRPLC)
 	tsp_problem_wrapper<problem::tsp_vrplc>("tsp_vrplc","Vehicle routing problem with limited capacity (TSP-VRPLC)")
@@ -524,14 +531,16 @@ BOOST_PYTHON_MODULE(_problem) {
 		.value("UNIFORM", problem::noisy::UNIFORM);
 
 	stochastic_problem_wrapper<problem::noisy>("noisy", "Noisy problem")
-		.def(init<const problem::base &, unsigned int, const double, const double, problem::noisy::noise_type, unsigned int>())
+		.def(init<const problem::base &, unsigned int, const double, const double, problem::noisy::noise_type, unsigned int, unsigned int>())
 		.add_property("noise_param_first", &problem::noisy::get_param_first)
-		.add_property("noise_param_second", &problem::noisy::get_param_second);
+		.add_property("noise_param_second", &problem::noisy::get_param_second)
+		.add_property("threads", &problem::noisy::get_threads);
 
 	// Robust meta-problem
 	stochastic_problem_wrapper<problem::robust>("robust", "Robust problem")
-		.def(init<const problem::base &,unsigned int, const double, unsigned int>())
-		.add_property("rho", &problem::robust::get_rho);
+		.def(init<const problem::base &,unsigned int, const double, unsigned int, unsigned int>())
+		.add_property("rho", &problem::robust::get_rho)
+		.add_property("threads", &problem::robust::get_threads);
 
 
 #ifdef PAGMO_ENABLE_KEP_TOOLBOX
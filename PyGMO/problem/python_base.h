@@ -25,9 +25,18 @@
 #ifndef PAGMO_PROBLEM_PYTHON_BASE_H
 #define PAGMO_PROBLEM_PYTHON_BASE_H
 
+#include <Python.h>
+#include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/python/class.hpp>
+#include <boost/python/extract.hpp>
+#include <boost/python/handle.hpp>
+#include <boost/python/import.hpp>
+#include <boost/python/object.hpp>
+#include <boost/python/tuple.hpp>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "../../src/config.h"
 #include "../../src/exceptions.h"
@@ -152,12 +161,66 @@ class __PAGMO_VISIBLE python_base: public base, public boost::python::wrapper<ba
             pagmo_assert(f);
             return f(f0, c0, f1, c1);
         }
+		// The Python methods cannot be run concurrently on copies of the problem, hence batches are always evaluated in the calling thread.
+		void py_set_batch_threads(unsigned int n)
+		{
+			if (n != 1) {
+				pagmo_throw(value_error,"problems implemented in Python can only be evaluated by one batch thread");
+			}
+			set_batch_threads(n);
+		}
 
 	protected:
 		void objfun_impl(fitness_vector &f, const decision_vector &x) const
 		{
 			f = py_objfun(x);
 		}
+		// If the optional _batch_objfun_impl() method is implemented in Python, the whole batch is evaluated with a single call:
+		// the decision vectors are packed row by row in a buffer and handed over as a read-only 2-D numpy array viewing the buffer
+		// (valid only during the call), and the fitness vectors are read back from the 2-D array returned. Otherwise,
+		// _objfun_impl() is called on each decision vector.
+		void batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+		{
+			boost::python::override batch = this->get_override("_batch_objfun_impl");
+			if (!batch) {
+				base::batch_objfun_impl(f,x);
+				return;
+			}
+			f.resize(x.size());
+			if (x.empty()) {
+				return;
+			}
+			const size_type n = get_dimension();
+			const f_size_type nf = get_f_dimension();
+			std::vector<double> buffer(x.size() * n);
+			for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+				std::copy(x[i].begin(),x[i].end(),buffer.begin() + i * n);
+			}
+			boost::python::object numpy = boost::python::import("numpy");
+			const Py_ssize_t n_bytes = boost::numeric_cast<Py_ssize_t>(buffer.size() * sizeof(double));
+		#if PY_MAJOR_VERSION >= 3
+			boost::python::object view(boost::python::handle<>(PyMemoryView_FromMemory(reinterpret_cast<char *>(&buffer[0]),n_bytes,PyBUF_READ)));
+		#else
+			boost::python::object view(boost::python::handle<>(PyBuffer_FromMemory(&buffer[0],n_bytes)));
+		#endif
+			boost::python::object X = numpy.attr("frombuffer")(view,"float64").attr("reshape")(x.size(),n);
+			boost::python::object F = numpy.attr("ascontiguousarray")(batch(X),"float64");
+			if (boost::python::extract<int>(F.attr("ndim"))() != 2 ||
+				boost::python::extract<std::size_t>(F.attr("shape")[0])() != x.size() ||
+				boost::python::extract<std::size_t>(F.attr("shape")[1])() != nf)
+			{
+				pagmo_throw(value_error,"_batch_objfun_impl() must return a 2-D array with one row of fitnesses per decision vector");
+			}
+			Py_buffer fitnesses;
+			if (PyObject_GetBuffer(F.ptr(),&fitnesses,PyBUF_C_CONTIGUOUS) != 0) {
+				boost::python::throw_error_already_set();
+			}
+			const double *data = static_cast<const double *>(fitnesses.buf);
+			for (std::vector<fitness_vector>::size_type i = 0; i < x.size(); ++i) {
+				f[i].assign(data + i * nf,data + (i + 1) * nf);
+			}
+			PyBuffer_Release(&fitnesses);
+		}
 		bool equality_operator_extra(const base &p) const
 		{
 			// NOTE: here the dynamic cast is safe because in base equality we already checked the C++ type.
@@ -116,9 +116,11 @@ def run_full_test_suite():
     """Run the complete test suite for PyGMO."""
     from PyGMO import test
     from PyGMO.test._hypervolume_tests import get_hv_suite
+    from PyGMO.test._batch_objfun_tests import get_batch_objfun_suite
     suite = _ut.TestLoader().loadTestsFromModule(test)
-    # Add hypervolume suite explicitly
+    # Add hypervolume and batch evaluation suites explicitly
     suite.addTests(get_hv_suite())
+    suite.addTests(get_batch_objfun_suite())
 
     _ut.TextTestRunner(verbosity=2).run(suite)
 
@@ -127,3 +129,9 @@ def run_hv_test_suite():
     """Run the hypervolume test suite."""
     from PyGMO.test._hypervolume_tests import get_hv_suite
     _ut.TextTestRunner(verbosity=2).run(get_hv_suite())
+
+
+def run_batch_objfun_test_suite():
+    """Run the test suite for the batch evaluation of problems implemented in Python."""
+    from PyGMO.test._batch_objfun_tests import get_batch_objfun_suite
+    _ut.TextTestRunner(verbosity=2).run(get_batch_objfun_suite())
@@ -0,0 +1,106 @@
+from PyGMO import population, problem, algorithm
+import unittest
+
+
+class _sphere(problem.base):
+
+    """Sphere function evaluated one decision vector at a time."""
+
+    def __init__(self, dim=5):
+        super(_sphere, self).__init__(dim)
+        self.set_bounds(-5.12, 5.12)
+        self.n_single = 0
+
+    def _objfun_impl(self, x):
+        self.n_single += 1
+        return (sum([xi * xi for xi in x]), )
+
+
+class _batch_sphere(_sphere):
+
+    """Sphere function evaluating whole batches of decision vectors as numpy arrays."""
+
+    def __init__(self, dim=5):
+        super(_batch_sphere, self).__init__(dim)
+        self.batches = []
+
+    def _batch_objfun_impl(self, X):
+        self.batches.append(X.copy())
+        return (X * X).sum(axis=1).reshape(X.shape[0], 1)
+
+
+class _bad_batch_sphere(_sphere):
+
+    """Returns the fitnesses as a 1-D array instead of one row per decision vector."""
+
+    def _batch_objfun_impl(self, X):
+        return (X * X).sum(axis=1)
+
+
+class _transposed_batch_sphere(_sphere):
+
+    """Returns one column per decision vector instead of one row."""
+
+    def _batch_objfun_impl(self, X):
+        return (X * X).sum(axis=1).reshape(1, X.shape[0])
+
+
+class _writing_batch_sphere(_batch_sphere):
+
+    """Tries to modify the decision vectors handed over."""
+
+    def _batch_objfun_impl(self, X):
+        X[0, 0] = 0.
+        return super(_writing_batch_sphere, self)._batch_objfun_impl(X)
+
+
+class BatchObjfunTest(unittest.TestCase):
+
+    def check_fitnesses(self, pop):
+        # The fitnesses read back from the batches are those of the decision vectors handed over.
+        for ind in pop:
+            self.assertAlmostEqual(
+                ind.cur_f[0], sum([xi * xi for xi in ind.cur_x]))
+
+    def test_round_trip(self):
+        prob = _batch_sphere(5)
+        pop = population(prob, 20)
+        # The population keeps its own copy of the problem.
+        n_batches = len(pop.problem.batches)
+        pop = algorithm.de(5).evolve(pop)
+        batches = pop.problem.batches[n_batches:]
+        self.assertTrue(len(batches) > 0)
+        for X in batches:
+            self.assertEqual(X.ndim, 2)
+            self.assertEqual(X.shape[1], 5)
+            self.assertEqual(str(X.dtype), 'float64')
+        self.check_fitnesses(pop)
+
+    def test_read_only(self):
+        # The decision vectors are a read-only view of the C++ buffer.
+        pop = population(_writing_batch_sphere(3), 10)
+        self.assertRaises(ValueError, algorithm.de(1).evolve, pop)
+
+    def test_shape_check(self):
+        for prob in [_bad_batch_sphere(5), _transposed_batch_sphere(5)]:
+            pop = population(prob, 10)
+            self.assertRaises(ValueError, algorithm.de(1).evolve, pop)
+
+    def test_fallback(self):
+        pop = population(_sphere(5), 20)
+        n_single = pop.problem.n_single
+        pop = algorithm.de(5).evolve(pop)
+        self.assertTrue(pop.problem.n_single > n_single)
+        self.check_fitnesses(pop)
+
+    def test_batch_threads(self):
+        prob = _batch_sphere(5)
+        self.assertEqual(prob.batch_threads, 1)
+        prob.batch_threads = 1
+        self.assertRaises(ValueError, setattr, prob, 'batch_threads', 2)
+
+
+def get_batch_objfun_suite():
+    suite = unittest.TestSuite()
+    suite.addTests(unittest.makeSuite(BatchObjfunTest))
+    return suite
@@ -17,6 +17,7 @@ hv_algorithm.__doc__ = """Module containing available algorithms for the hypervo
                 hv_algorithm.bf_fpras()
                 hv_algorithm.hoy()
                 hv_algorithm.fpl()
+                hv_algorithm.adaptive()
 """
 
 
@@ -59,7 +60,7 @@ class _HypervolumeValidation:
         "Hypervolume takes either exactly one unnamed argument or one keyword argument 'data_src' in the constructor")
 
     # types of hypervolume algorithms
-    types_hv_algo = (hv_algorithm.hv2d, hv_algorithm.hv3d, hv_algorithm.hv4d, hv_algorithm.wfg, hv_algorithm.bf_approx, hv_algorithm.bf_fpras, hv_algorithm.hoy, hv_algorithm.fpl)
+    types_hv_algo = (hv_algorithm.hv2d, hv_algorithm.hv3d, hv_algorithm.hv4d, hv_algorithm.wfg, hv_algorithm.bf_approx, hv_algorithm.bf_fpras, hv_algorithm.hoy, hv_algorithm.fpl, hv_algorithm.adaptive)
 
     # allowed types for the refernce point
     types_rp = (list, tuple,)
@@ -447,7 +448,7 @@ hv_algorithm.hoy._original_init = hv_algorithm.hoy.__init__
 hv_algorithm.hoy.__init__ = _hoy_ctor
 
 
-def _wfg_ctor(self, stop_dimension=2):
+def _wfg_ctor(self, stop_dimension=2, threads=1):
     """
     Hypervolume algorithm: WFG.
     Applicable to hypervolume computation problems of dimension in [2, ..]
@@ -455,6 +456,9 @@ def _wfg_ctor(self, stop_dimension=2):
     REF: "A Fast Way of Calculating Exact Hypervolumes", Lyndon While, Lucas Bradstreet, Luigi Barone.
     IEEE TRANSACXTIONS ON EVOLUTIONARY COMPUTATION, VOL. 16, NO. 1, FEBRURARY 2012
 
+    * stop_dimension: dimension at which the slicing stops and another algorithm takes over
+    * threads: number of tasks the top level of the computation is split into (1 = sequential, 0 = one per hardware thread)
+
     USAGE:
             hv = hypervolume(...) # see 'hypervolume?' for usage
             refpoint = [1.0]*7
@@ -464,6 +468,7 @@ def _wfg_ctor(self, stop_dimension=2):
     """
     args = []
     args.append(stop_dimension)
+    args.append(threads)
     return self._original_init(*args)
 hv_algorithm.wfg._original_init = hv_algorithm.wfg.__init__
 hv_algorithm.wfg.__init__ = _wfg_ctor
@@ -541,6 +546,36 @@ hv_algorithm.bf_fpras._original_init = hv_algorithm.bf_fpras.__init__
 hv_algorithm.bf_fpras.__init__ = _bf_fpras_ctor
 
 
+def _adaptive_ctor(self, eps=1e-2, delta=1e-2, max_time=0.0):
+    """
+    Hypervolume algorithm: exact or approximated, depending on a budget.
+
+    The exact algorithms are used when their predicted cost fits the budget, Monte Carlo approximations otherwise
+    (Karp-Luby estimator for the hypervolume, sampling of the bounding boxes for the exclusive contributions, bf_approx for the extreme contributors).
+    Called directly, its compute, exclusive and contributions methods also report how the result was obtained,
+    and the half-widths of its confidence intervals.
+
+    USAGE:
+            * eps - accuracy of the approximation (relative to the hypervolume, or to the bounding box of each exclusive contribution)
+            * delta - probability of the approximation exceeding the accuracy
+            * max_time - time limit in seconds for each call, 0 to use the accuracy budget (eps, delta) instead
+
+            hv = hypervolume(...) # see 'hypervolume?' for usage
+            refpoint = [1.0]*10
+            algo = hv_algorithm.adaptive(max_time=0.5)
+            hv.compute(r=refpoint, algorithm=algo)
+            value, exact, errors = algo.compute(hv.get_points(), refpoint)
+    """
+
+    args = []
+    args.append(eps)
+    args.append(delta)
+    args.append(max_time)
+    return self._original_init(*args)
+hv_algorithm.adaptive._original_init = hv_algorithm.adaptive.__init__
+hv_algorithm.adaptive.__init__ = _adaptive_ctor
+
+
 def _race_pop_ctor(self, pop=None, seed=0):
     """
     Constructs a racing object responsible for racing individuals in a population
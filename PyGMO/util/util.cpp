@@ -107,6 +107,34 @@ static inline class_<HVAlgorithm,bases<util::hv_algorithm::base> > algorithm_wra
 	return retval;
 }
 
+// Adaptive computations, returning the result along with whether it is exact and its errors
+static inline boost::python::tuple adaptive_compute_return_tuple(const util::hv_algorithm::adaptive &algo, std::vector<fitness_vector> points, const fitness_vector &r_point)
+{
+	util::hv_algorithm::adaptive::report rep;
+	algo.verify_before_compute(points, r_point);
+	const double value = algo.compute(points, r_point, rep);
+	return boost::python::make_tuple(value, rep.exact, rep.errors);
+}
+
+static inline boost::python::tuple adaptive_exclusive_return_tuple(const util::hv_algorithm::adaptive &algo, const unsigned int p_idx, std::vector<fitness_vector> points, const fitness_vector &r_point)
+{
+	util::hv_algorithm::adaptive::report rep;
+	algo.verify_before_compute(points, r_point);
+	if (p_idx >= points.size()) {
+		pagmo_throw(value_error, "Index of the individual is out of bounds.");
+	}
+	const double value = algo.exclusive(p_idx, points, r_point, rep);
+	return boost::python::make_tuple(value, rep.exact, rep.errors);
+}
+
+static inline boost::python::tuple adaptive_contributions_return_tuple(const util::hv_algorithm::adaptive &algo, std::vector<fitness_vector> points, const fitness_vector &r_point)
+{
+	util::hv_algorithm::adaptive::report rep;
+	algo.verify_before_compute(points, r_point);
+	const std::vector<double> values = algo.contributions(points, r_point, rep);
+	return boost::python::make_tuple(values, rep.exact, rep.errors);
+}
+
 void expose_hv_algorithm()
 {
 	class_<util::hv_algorithm::base,boost::noncopyable>("_base",no_init)
@@ -116,10 +144,15 @@ void expose_hv_algorithm()
 	algorithm_wrapper<util::hv_algorithm::hv4d>("hv4d","hv4d algorithm.");
 	algorithm_wrapper<util::hv_algorithm::fpl>("fpl","FPL algorithm.");
 	algorithm_wrapper<util::hv_algorithm::hoy>("hoy","HOY algorithm.");
-	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int>());
+	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int, const unsigned int>())
+		.add_property("threads", &util::hv_algorithm::wfg::get_threads);
 	class_<util::hv_algorithm::bf_approx, bases<util::hv_algorithm::base> >("bf_approx","Bringmann-Friedrich approximated algorithm.", 
 			init<const bool, const unsigned int, const double, const double, const double, const double, const double, const double>());
 	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double>());
+	class_<util::hv_algorithm::adaptive, bases<util::hv_algorithm::base> >("adaptive","Exact or approximated hypervolume, depending on a time or accuracy budget.", init<const double, const double, const double>())
+		.def("compute", &adaptive_compute_return_tuple, "Computes the hypervolume of the points, returns (hypervolume, exact, errors).")
+		.def("exclusive", &adaptive_exclusive_return_tuple, "Computes the exclusive contribution of a point, returns (contribution, exact, errors).")
+		.def("contributions", &adaptive_contributions_return_tuple, "Computes the exclusive contributions of the points, returns (contributions, exact, errors).");
 }
 
 void expose_hypervolume()
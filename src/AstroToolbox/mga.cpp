@@ -36,25 +36,29 @@
 
 using namespace std;
 
+// Sequences up to this length are evaluated without any heap allocation.
+static const int max_stack_sequence = 16;
+
 //the function return 0 if the input is right or -1 it there is something wrong
+//the function does not modify any shared state, hence it can be called concurrently
 
-int MGA(vector<double> t,	// it is the vector which provides time in modified julian date 2000.
+int MGA(const vector<double> &t,	// it is the vector which provides time in modified julian date 2000.
 								// The first entry is launch date, the next entries represent the time needed to
 								// fly from last swing-by to current swing-by.
-			mgaproblem problem,
+			const mgaproblem &problem,
 
 			/* OUTPUT values: */
-			vector<double>& rp,  // periplanets radius
-			vector<double>& DV,  // final delta-Vs
+			double *rp,  // periplanets radius (sequence size - 2 values)
+			double *DV,  // final delta-Vs (sequence size values)
 			double &obj_funct)   //objective function
 
 {
 	const int n = problem.sequence.size();
-	const vector<int> sequence = problem.sequence;
-	const vector<int> rev_flag = problem.rev_flag;// array containing 0 clockwise, 1 un-clockwise
-	customobject cust_obj = problem.asteroid;
+	const vector<int> &sequence = problem.sequence;
+	const vector<int> &rev_flag = problem.rev_flag;// array containing 0 clockwise, 1 un-clockwise
+	const customobject &cust_obj = problem.asteroid;
 
-	double MU[9] = {//1.32712440018e11, //SUN = 0
+	static const double MU[9] = {//1.32712440018e11, //SUN = 0
 					1.32712428e11,
 					22321,		// Gravitational constant of Mercury	= 1
 					324860,		// Gravitational constant of Venus		= 2
@@ -65,7 +69,7 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 					5.78e6,		// Gravitational constant of Uranus		= 7
 					6.8e6		// Gravitational constant of Neptune	= 8
 				    };
-	double penalty[9] = {0,
+	static const double penalty[9] = {0,
 		                0,        // Mercury
 						6351.8,   // Venus
 						6778.1,   // Earth
@@ -77,7 +81,7 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 						0         // Neptune
 	};
 
-	double penalty_coeffs[9] = {0,
+	static const double penalty_coeffs[9] = {0,
 								0,      // Mercury
 								0.01,   // Venus
 								0.01,   // Earth
@@ -109,9 +113,9 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 
 
 
-	double *vec, *rec;
-	vector<double*> r;    // {0...n-1} position
-	vector<double*> v;    // {0...n-1} velocity
+	// {0...n-1} positions and velocities, on the stack unless the sequence is very long
+	double r_stack[max_stack_sequence][3], v_stack[max_stack_sequence][3];
+	double (*r)[3] = r_stack, (*v)[3] = v_stack;
 
 	double T = 0.0;         // total time
 
@@ -121,13 +125,13 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 
 	if (n >= 2)
 	{
+		if (n > max_stack_sequence)
+		{
+			r = new double [n][3];
+			v = new double [n][3];
+		}
 		for ( i_count = 0; i_count < n; i_count++)
 		{
-			vec = new double [3];  // velocity and position are 3 D vector
-			rec = new double [3];
-			r.push_back(vec);
-			v.push_back(rec);
-
 			DV [i_count] = 0.0;
 		}
 
@@ -260,15 +264,18 @@ int MGA(vector<double> t,	// it is the vector which provides time in modified ju
 
 
 	// final clean
-	for ( i_count = 0;i_count < n;i_count++)
+	if (r != r_stack)
 	{
-		delete [] r[i_count];
-		delete [] v[i_count];
+		delete [] r;
+		delete [] v;
 	}
-	r.clear();
-	v.clear();
 	return 0;
 }
 
+int MGA(const vector<double> &t, const mgaproblem &problem, vector<double> &rp, vector<double> &DV, double &obj_funct)
+{
+	return MGA(t, problem, &rp[0], &DV[0], obj_funct);
+}
+
 
 
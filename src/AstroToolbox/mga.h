@@ -93,8 +93,16 @@ struct mgaproblem {
 
 int MGA( 
 		 //INPUTS
-		 std::vector<double>,
-		 mgaproblem, 
+		 const std::vector<double> &,
+		 const mgaproblem &, 
+		
+		 //OUTPUTS
+		 double *, double *, double&); 
+
+int MGA( 
+		 //INPUTS
+		 const std::vector<double> &,
+		 const mgaproblem &, 
 		
 		 //OUTPUTS
 		 std::vector <double>&, std::vector<double>&, double&); 
@@ -86,13 +86,13 @@ void get_celobj_r_and_v(const mgadsmproblem& problem, const double T, const int
 
 /**
  * Precomputes all velocities and positions of celestial objects of interest for the problem.
- * Before calling this function, r and v verctors must be pre-allocated with sufficient amount of entries.
+ * Before calling this function, r and v arrays must be allocated with sufficient amount of entries.
  *
  * problem - concerned problem
  * r       - [output] array of position vectors
  * v       - [output] array of velocity vectors
  */
-void precalculate_ers_and_vees(const vector<double>& t, const mgadsmproblem& problem, std::vector<double*>& r, std::vector<double*>& v)
+void precalculate_ers_and_vees(const double *t, const mgadsmproblem& problem, double (*r)[3], double (*v)[3])
 {
 	double T = t[0]; //time of departure
 
@@ -126,7 +126,7 @@ double get_celobj_mu(const mgadsmproblem& problem, const int i_count)
  * DV         - [output] velocity contributions table
  * v_sc_pl_in - [output] next hop input speed
  */
-void first_block(const vector<double>& t, const mgadsmproblem& problem, const std::vector<double*>& r, std::vector<double*>& v, std::vector<double>& DV, double v_sc_nextpl_in[3])
+void first_block(const double *t, const mgadsmproblem& problem, const double (*r)[3], const double (*v)[3], double *DV, double v_sc_nextpl_in[3])
 {
 	//First, some helper constants to make code more readable
 	const int n = problem.sequence.size();
@@ -200,7 +200,7 @@ void first_block(const vector<double>& t, const mgadsmproblem& problem, const st
 // ------
 // INTERMEDIATE BLOCK
 // WARNING: i_count starts from 0
-double intermediate_block(const vector<double>& t, const mgadsmproblem& problem, const std::vector<double*>& r, const std::vector<double*>& v, int i_count, const double v_sc_pl_in[], std::vector<double>& DV, double* v_sc_nextpl_in)
+double intermediate_block(const double *t, const mgadsmproblem& problem, const double (*r)[3], const double (*v)[3], int i_count, const double v_sc_pl_in[], double *DV, double* v_sc_nextpl_in)
 {
 	//[MR] A bunch of helper variables to simplify the code
 	const int n = problem.sequence.size();
@@ -285,7 +285,7 @@ double intermediate_block(const vector<double>& t, const mgadsmproblem& problem,
 
 // FINAL BLOCK
 //
-void final_block(const mgadsmproblem& problem, const std::vector<double*>& , const std::vector<double*>& v, const double v_sc_pl_in[], std::vector<double>& DV)
+void final_block(const mgadsmproblem& problem, const double (*v)[3], const double v_sc_pl_in[], double *DV)
 {
 	//[MR] A bunch of helper variables to simplify the code
 	const int n = problem.sequence.size();
@@ -320,6 +320,9 @@ void final_block(const mgadsmproblem& problem, const std::vector<double*>& , con
 }
 
 
+// Sequences up to this length are evaluated without any heap allocation.
+static const int max_stack_sequence = 16;
+
 int MGA_DSM(
 			/* INPUT values: */ //[MR] make this parameters const, if they are not modified and possibly references (especially 'problem').
 			const vector<double> &t,	// it is the vector which provides time in modified julian date 2000. [MR] ??? Isn't it the decision vetor ???
@@ -328,17 +331,43 @@ int MGA_DSM(
 			/* OUTPUT values: */
 			double &J    // output
 			)
+{
+	return MGA_DSM(&t[0], problem, J, &problem.DV[0], problem.vrelin_vec.empty() ? 0 : &problem.vrelin_vec[0]);
+}
+
+int MGA_DSM(
+			/* INPUT values: */
+			const double *t,	// decision vector
+			const mgadsmproblem& problem,
+
+			/* OUTPUT values: */
+			double &J,    // output
+			double *DV_out,    // DV contributions, can be null
+			double *vrelin_out    // squared relative velocities at the fly-bys, can be null
+			)
 {
 	//[MR] A bunch of helper variables to simplify the code
 	const int n = problem.sequence.size();
 
 	int i; //loop counter
 
-	//References to objects pre-allocated in the mgadsm struct
-	std::vector<double*>& r = problem.r;
-	std::vector<double*>& v = problem.v;
-
-	std::vector<double>& DV = problem.DV; //DV contributions
+	//Planets positions and velocities, DV contributions and relative velocities at the fly-bys: on the stack unless the
+	//sequence is very long
+	double r_stack[max_stack_sequence][3], v_stack[max_stack_sequence][3];
+	double DV_stack[max_stack_sequence + 1], vrelin_stack[max_stack_sequence];
+	double (*r)[3] = r_stack, (*v)[3] = v_stack;
+	double *DV = DV_out ? DV_out : DV_stack;
+	double *vrelin_vec = vrelin_out ? vrelin_out : vrelin_stack;
+	if (n > max_stack_sequence) {
+		r = new double[n][3];
+		v = new double[n][3];
+		if (!DV_out) {
+			DV = new double[n + 1];
+		}
+		if (!vrelin_out) {
+			vrelin_vec = new double[n];
+		}
+	}
 
 	precalculate_ers_and_vees(t, problem, r, v);
 
@@ -354,13 +383,13 @@ int MGA_DSM(
 		//copy previous output velocity to current input velocity
 		inter_pl_in_v[0] = inter_pl_out_v[0]; inter_pl_in_v[1] = inter_pl_out_v[1]; inter_pl_in_v[2] = inter_pl_out_v[2];
 
-		problem.vrelin_vec[i_count] = intermediate_block(t, problem, r, v, i_count, inter_pl_in_v,DV, inter_pl_out_v);
+		vrelin_vec[i_count] = intermediate_block(t, problem, r, v, i_count, inter_pl_in_v,DV, inter_pl_out_v);
 	}
 
 	//copy previous output velocity to current input velocity
 	inter_pl_in_v[0] = inter_pl_out_v[0]; inter_pl_in_v[1] = inter_pl_out_v[1]; inter_pl_in_v[2] = inter_pl_out_v[2];
 	// FINAL BLOCK
-	final_block(problem, r, v, inter_pl_in_v,
+	final_block(problem, v, inter_pl_in_v,
 		DV);
 
 	// **************************************************************************
@@ -492,5 +521,15 @@ int MGA_DSM(
 			J = 100000;   // there was an ERROR in time2distance
 	} // time2AU
 
+	if (r != r_stack) {
+		delete[] r;
+		delete[] v;
+		if (DV != DV_out) {
+			delete[] DV;
+		}
+		if (vrelin_vec != vrelin_out) {
+			delete[] vrelin_vec;
+		}
+	}
 	return 0;
 }
@@ -34,33 +34,7 @@ public:
 	mgadsmproblem(int t, const int *seq, const size_t &size_, const double &AUdist_, const double &DVtotal_, const double &DVonboard_,
 		const double &e_, const double &rp_):
 		size(size_),type(t),sequence(seq,seq + size),e(e_),rp(rp_),AUdist(AUdist_),DVtotal(DVtotal_),
-		DVonboard(DVonboard_),r(size),v(size),DV(size + 1),vrelin_vec(size-2) {
-		for (size_t i = 0; i < size; ++i) {
-			r[i] = new double[3];
-			v[i] = new double[3];
-			for (size_t j = 0; j < 3; ++j) {
-				r[i][j] = 0;
-				v[i][j] = 0;
-			}
-		}
-	}
-	mgadsmproblem(const mgadsmproblem &m):size(m.size),type(m.type),sequence(m.sequence),e(m.e),rp(m.rp),asteroid(m.asteroid),
-		AUdist(m.AUdist),DVtotal(m.DVtotal),DVonboard(m.DVonboard),r(m.size),v(m.size),DV(m.DV),vrelin_vec(m.vrelin_vec) {
-		for (size_t i = 0; i < size; ++i) {
-			r[i] = new double[3];
-			v[i] = new double[3];
-			for (size_t j = 0; j < 3; ++j) {
-				r[i][j] = m.r[i][j];
-				v[i][j] = m.v[i][j];
-			}
-		}
-	}
-	~mgadsmproblem() {
-		for (size_t i = 0; i < size; ++i) {
-			delete[] r[i];
-			delete[] v[i];
-		}
-	}
+		DVonboard(DVonboard_),DV(size + 1),vrelin_vec(size-2) {}
 	const size_t size;
 	int type;						//problem type
 	std::vector<int> sequence;				//fly-by sequence (ex: 3,2,3,3,5,is Earth-Venus-Earth-Earth-Jupiter)
@@ -71,11 +45,9 @@ public:
 	double DVtotal;						//Total DV allowed in km/s (only in case of time2AUs)
 	double DVonboard;					//Total DV on the spacecraft in km/s (only in case of time2AUs)
 
-	//Pre-allocated memory, in order to remove allocation of heap space in MGA_DSM calls
-	mutable std::vector<double*> r;		// = std::vector<double*>(n);
-	mutable std::vector<double*> v;		// = std::vector<double*>(n);
+	//Outputs of the last MGA_DSM call not given explicit output buffers (used to print the trajectories)
 	mutable std::vector<double> DV;		// = std::vector<double>(n+1);
-	mutable std::vector<double> vrelin_vec;	// = std::vector<double>(n+1);
+	mutable std::vector<double> vrelin_vec;	// = std::vector<double>(n-2);
 private:
 	friend class boost::serialization::access;
 	template<class Archive>
@@ -91,46 +63,21 @@ private:
 		ar & DVonboard;
 		ar & DV;
 		ar & vrelin_vec;
-		boost::serialization::split_member(ar, *this, version);	// spliting the serialization into save/load to handle "r" and "v" vectors of pointers
-	}
-	template<class Archive>
-	void save(Archive & ar, const unsigned int) const {
-		std::vector<std::vector<double> > r_values(size,std::vector<double>(3));
-		std::vector<std::vector<double> > v_values(size,std::vector<double>(3));
-		for (int i = 0; i < (int)size; ++i) {
-			for(int j = 0; j < 3; ++j){
-				r_values[(size_t)i][j] = r[i][j];
-			}
-		}
-		for (int i = 0; i < (int)size; ++i) {		
-			for(int j = 0; j < 3; ++j){
-				v_values[(size_t)i][j] = v[i][j];
-			}
-		}
-		ar << static_cast<const std::vector<std::vector<double> > &>(r_values);
-		ar << static_cast<const std::vector<std::vector<double> > &>(v_values);
-	}
-	template<class Archive>
-	void load(Archive & ar, const unsigned int) {
-		std::vector<std::vector<double> > r_values;
-		std::vector<std::vector<double> > v_values;
-		ar >> r_values;
-		ar >> v_values;
-
-		for (int i = 0; i < (int)size; ++i) {
-			for(int j = 0; j < 3; ++j){
-				r[(size_t)i][j] = r_values[i][j];
-			}
-		}
-		for (int i = 0; i < (int)size; ++i) {
-			for(int j = 0; j < 3; ++j){
-				v[(size_t)i][j] = v_values[i][j];
-			}
+		// Version 0 archives also stored the positions and velocities of the last MGA_DSM call: skip them.
+		if (version < 1) {
+			std::vector<std::vector<double> > r_values, v_values;
+			ar & r_values;
+			ar & v_values;
 		}
 	}
 };
 
+// Version 1: the positions and velocities of the last MGA_DSM call are no longer archived.
+BOOST_CLASS_VERSION(mgadsmproblem,1)
+
 
+// Stores the DV contributions and the squared relative velocities at the fly-bys into mgadsm.DV and mgadsm.vrelin_vec,
+// hence concurrent calls must not share mgadsm.
 int MGA_DSM(
 			/* INPUT values: */
 			const std::vector<double> &x ,	// it is the decision vector
@@ -140,4 +87,19 @@ int MGA_DSM(
 			double &J    // J output
 			);
 
+// Does not modify mgadsm, hence it can be called concurrently.
+int MGA_DSM(
+			/* INPUT values: */
+			const double *x ,	// it is the decision vector
+			const mgadsmproblem &mgadsm,  // contains the problem specific data
+
+			/* OUTPUT values: */
+			double &J,    // J output
+			double *DV,   // DV contributions (sequence size + 1 values), can be null
+			double *vrelin    // squared relative velocities at the fly-bys (sequence size - 2 values), can be null
+			);
+
+// Position and velocity of the i_count-th celestial object of the sequence at time T (mjd2000).
+void get_celobj_r_and_v(const mgadsmproblem& problem, const double T, const int i_count, double* r, double* v);
+
 #endif
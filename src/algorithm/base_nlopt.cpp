@@ -72,35 +72,30 @@ std::string base_nlopt::human_readable_extra() const
 	return oss.str();
 }
 
+// Fill grad with the entries of row of the Jacobian of the problem at x. The Jacobian is computed by problem::base::compute_jacobian(),
+// which caches it, so that the gradients of the constraints at the point where the gradient of the objective function was
+// computed cost no further evaluations. Note that the perturbed points may lie outside the bounds.
+void base_nlopt::fill_gradient(std::vector<double> &grad, const std::vector<double> &x, int row, nlopt_wrapper_data *d)
+{
+	int lenG;
+	d->prob->get_jacobian_pattern(lenG,d->iGfun,d->jGvar);
+	d->prob->compute_jacobian(d->G,x);
+	std::fill(grad.begin(),grad.end(),0.);
+	for (int k = 0; k < lenG; ++k) {
+		if (d->iGfun[k] == row) {
+			grad[d->jGvar[k]] = d->G[k];
+		}
+	}
+}
+
 // Objective function wrapper.
 double base_nlopt::objfun_wrapper(const std::vector<double> &x, std::vector<double> &grad, void* data)
 {
 	nlopt_wrapper_data *d = (nlopt_wrapper_data *)data;
 	pagmo_assert(d->f.size() == 1);
 
-	// Compute the gradient by central diffs if necessary TODO: also ipopt has this code (or similar)
-	// It should be moved elswhere in PaGMO. Plus be aware that here a chromsome outside the bounds
-	// can be created, thus invaidating its compatibility with the problem (exception will be thrown)
-
 	if (!grad.empty()) {
-		std::copy(x.begin(),x.end(),d->dx.begin());
-		double central_diff;
-		const double h0=1e-8;
-		double h;
-		double mem;
-		for (size_t i =0; i < d->dx.size(); ++i)
-		{
-			h = h0 * std::max(1.,fabs(d->dx[i]));
-			mem = d->dx[i];
-			d->dx[i] += h;
-			d->prob->objfun(d->f,d->dx);
-			central_diff = d->f[0];
-			d->dx[i] -= 2*h;
-			d->prob->objfun(d->f,d->dx);
-			central_diff = (central_diff-d->f[0]) / 2 / h;
-			grad[i] = central_diff;
-			d->dx[i] = mem;
-		}
+		fill_gradient(grad,x,0,d);
 	}
 
 	// Calculate the objective function.
@@ -116,29 +111,8 @@ double base_nlopt::constraints_wrapper(const std::vector<double> &x, std::vector
 	nlopt_wrapper_data *d = (nlopt_wrapper_data *)data;
 	pagmo_assert(d->c.size() == d->prob->get_c_dimension());
 
-	// Compute the gradient by central diffs (if necessary). TODO: also ipopt has this code (or similar)
-	// It should be moved elswhere in PaGMO. Plus be aware that here a chromsome outside the bounds
-	// can be created, thus invaidating its compatibility with the problem (exception will be thrown)
-
 	if (!grad.empty()) {
-		std::copy(x.begin(),x.end(),d->dx.begin());
-		double central_diff;
-		const double h0=1e-8;
-		double h;
-		double mem;
-		for (size_t i =0; i < d->dx.size(); ++i)
-		{
-			h = h0 * std::max(1.,fabs(d->dx[i]));
-			mem = d->dx[i];
-			d->dx[i] += h;
-			d->prob->compute_constraints(d->c,d->dx);
-			central_diff = d->c[d->c_comp];
-			d->dx[i] -= 2*h;
-			d->prob->compute_constraints(d->c,d->dx);
-			central_diff = (central_diff-d->c[d->c_comp]) / 2 / h;
-			grad[i] = central_diff;
-			d->dx[i] = mem;
-		}
+		fill_gradient(grad,x,boost::numeric_cast<int>(d->prob->get_f_dimension() + d->c_comp),d);
 	}
 
 	// Calculate the constraints.
@@ -181,7 +155,6 @@ void base_nlopt::evolve(population &pop) const
 
 	data_objfun.prob = &problem;
 	data_objfun.x.resize(problem.get_dimension());
-	data_objfun.dx.resize(problem.get_dimension());
 	data_objfun.f.resize(1);
 	
 	// Structure to pass data to the constraint function wrapper.
@@ -189,7 +162,6 @@ void base_nlopt::evolve(population &pop) const
 	for (problem::base::c_size_type i = 0; i < c_size; ++i) {
 		data_constrfun[i].prob = &problem;
 		data_constrfun[i].x.resize(problem.get_dimension());
-		data_constrfun[i].dx.resize(problem.get_dimension());
 		data_constrfun[i].c.resize(problem.get_c_dimension());
 		data_constrfun[i].c_comp = i;
 	}
@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <nlopt.hpp>
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../population.h"
@@ -66,12 +67,15 @@ class __PAGMO_VISIBLE base_nlopt: public base
 		{
 			problem::base const		*prob;
 			decision_vector			x;
-			decision_vector			dx;
+			std::vector<double>		G;
+			std::vector<int>		iGfun;
+			std::vector<int>		jGvar;
 			fitness_vector			f;
 			constraint_vector		c;
 			problem::base::c_size_type	c_comp;
 		};
 		int get_last_status() const;
+		static void fill_gradient(std::vector<double> &, const std::vector<double> &, int, nlopt_wrapper_data *);
 		static double objfun_wrapper(const std::vector<double> &, std::vector<double> &, void*);
 		static double constraints_wrapper(const std::vector<double> &, std::vector<double> &, void*);
 		virtual void set_local(size_t d) const;
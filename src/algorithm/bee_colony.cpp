@@ -105,6 +105,7 @@ void bee_colony::evolve(population &pop) const
 	decision_vector dummy(D,0);			//used for initialisation purposes
 	std::vector<decision_vector > X(NP,dummy);	//set of food sources
 	std::vector<fitness_vector> fit(NP);		//food sources fitness
+	const constraint_vector c;			//constraints (the problem is box constrained)
 
 	decision_vector temp_solution(D,0);
 
@@ -163,8 +164,8 @@ void bee_colony::evolve(population &pop) const
 			//If the new solution is better than the old one replace it with the mutant one and reset its trial counter
 			if(prob.compare_fitness(fnew, fit[ii])) {
 				X[ii][param2change] = temp_solution[param2change];
-				pop.set_x(ii,X[ii]);
-				prob.objfun(fit[ii], X[ii]); //update the fitness vector
+				fit[ii] = fnew; //update the fitness vector
+				pop.set_x(ii,X[ii],fit[ii],c);
 				trial[ii] = 0;
 			}
 			else {
@@ -236,8 +237,8 @@ void bee_colony::evolve(population &pop) const
 			//If the new solution is better than the old one replace it with the mutant one and reset its trial counter
 			if(prob.compare_fitness(fnew, fit[ii])) {
 				X[ii][param2change] = temp_solution[param2change];
-				pop.set_x(ii,X[ii]);
-				prob.objfun(fit[ii], X[ii]); //update the fitness vector
+				fit[ii] = fnew; //update the fitness vector
+				pop.set_x(ii,X[ii],fit[ii],c);
 				trial[ii] = 0;
 			}
 			else {
@@ -260,7 +261,8 @@ void bee_colony::evolve(population &pop) const
 				X[maxtrialindex][jj] = boost::uniform_real<double>(lb[jj],ub[jj])(m_drng);
 			}
 			trial[maxtrialindex] = 0;
-			pop.set_x(maxtrialindex,X[maxtrialindex]);
+			prob.objfun(fit[maxtrialindex], X[maxtrialindex]);
+			pop.set_x(maxtrialindex,X[maxtrialindex],fit[maxtrialindex],c);
 		}
 
 	} // end of main ABC loop
@@ -212,7 +212,9 @@ void cmaes::evolve(population &pop) const
 	MatrixXd Cold = MatrixXd::Identity(N,N);
 	VectorXd tmp = VectorXd::Zero(N);
 	std::vector<VectorXd> elite(mu,tmp);
-	decision_vector dumb(N,0);
+	std::vector<decision_vector> newpop_x(lam,decision_vector(N,0));
+	std::vector<fitness_vector> newpop_f(lam);
+	const std::vector<constraint_vector> newpop_c(lam);	// the problem is box constrained
 
 	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls
 	if ( (m_newpop.size() != lam) || ((unsigned int)(m_newpop[0].rows() ) != N) || (m_memory==false) ) {
@@ -307,29 +309,30 @@ void cmaes::evolve(population &pop) const
 			}
 		}
 
-		// 2 - We Evaluate the new population (if the problem is stochastic change seed first)
+		for (population::size_type i = 0; i<lam; ++i ) {
+			for (decision_vector::size_type j = 0; j<N; ++j ) {
+				newpop_x[i][j] = newpop[i](j);
+			}
+		}
+
+		// 2 - We Evaluate the new population (if the problem is stochastic change seed first). The whole
+		// population is evaluated at once and inserted with its fitness, so that it is not evaluated again
 		try
 		{	//TODO: check if it is really necessary to clear the pop, also
 			//would it make sense to use best_x also?
 			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
+			prob.batch_objfun(newpop_f,newpop_x);
 			for (population::size_type i = 0; i<lam; ++i ) {
-			  	for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.push_back(dumb);
+				pop.push_back(newpop_x[i],newpop_f[i],newpop_c[i]);
 			}
 			counteval += lam;
 		}
 		catch (const std::bad_cast& e)
 		{
 			// Reinsertion (original method)
-			for (population::size_type i = 0; i<lam; ++i ) {
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.set_x(i,dumb);
-			}
+			prob.batch_objfun(newpop_f,newpop_x);
+			pop.replace_generation(newpop_x,newpop_f,newpop_c);
 			counteval += lam;
 		}
 		
@@ -22,16 +22,18 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include <boost/random/uniform_int.hpp>
-#include <boost/random/uniform_real.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include "../exceptions.h"
 #include "../population.h"
+#include "../rng.h"
 #include "../types.h"
 #include "base.h"
 #include "de.h"
+#include "de_strategies.h"
 
 namespace pagmo { namespace algorithm {
 
@@ -104,20 +106,58 @@ void de::evolve(population &pop) const
 	if (m_gen == 0) {
 		return;
 	}
-	// Some vectors used during evolution are allocated here.
+	// Select the trial generator once: each strategy is a (mutation, crossover) pair
+	// instantiated at compile time, so the inner loop has no strategy dispatch.
+	typedef void (*trial_generator)(std::vector<decision_vector> &, const de_strategies::deme &, const double *,
+		const decision_vector &, const decision_vector &, std::size_t, double, double, rng_uint32 &, rng_double &, std::vector<char> &);
+	using namespace de_strategies;
+	static const trial_generator generators[10] = {
+		/*-------DE/best/1/exp--------------------------------------------------------------------*/
+		/*-------Our oldest strategy but still not bad. However, we have found several------------*/
+		/*-------optimization problems where misconvergence occurs.-------------------------------*/
+		&make_trials<exponential<best_1>,rng_uint32,rng_double>,
+		/*-------DE/rand/1/exp-------------------------------------------------------------------*/
+		/*-------This is one of my favourite strategies. It works especially well when the-------*/
+		/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
+		/*-------as a first guess.---------------------------------------------------------------*/
+		&make_trials<exponential<rand_1>,rng_uint32,rng_double>,
+		/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
+		/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and m_cr=1.------*/
+		/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
+		/*-------should play around with all three control variables.----------------------------*/
+		&make_trials<exponential<rand_to_best_1>,rng_uint32,rng_double>,
+		/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
+		&make_trials<exponential<best_2>,rng_uint32,rng_double>,
+		/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
+		&make_trials<exponential<rand_2>,rng_uint32,rng_double>,
+		/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
+		&make_trials<binomial<best_1>,rng_uint32,rng_double>,
+		&make_trials<binomial<rand_1>,rng_uint32,rng_double>,
+		&make_trials<binomial<rand_to_best_1>,rng_uint32,rng_double>,
+		&make_trials<binomial<best_2>,rng_uint32,rng_double>,
+		&make_trials<binomial<rand_2>,rng_uint32,rng_double>
+	};
+	const trial_generator make_generation_trials = generators[m_strategy - 1];
+
+	// Some vectors used during evolution are allocated here. The deme is kept in two
+	// contiguous buffers (current and next generation) that are swapped at each generation.
 	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
-	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
+	deme popold(NP,D), popnew(NP,D);
 	decision_vector gbX(D),gbIter(D);
 	fitness_vector newfitness(prob_f_dimension);	//new fitness of the mutaded candidate
 	fitness_vector gbfit(prob_f_dimension);	//global best fitness
 	std::vector<fitness_vector> fit(NP,gbfit);
+	std::vector<decision_vector> trial(NP,dummy);	//trial vectors of the current generation
+	std::vector<fitness_vector> trialfit(NP,gbfit);	//and their fitnesses
+	const constraint_vector c;	//constraints (the problem is box constrained)
+	std::vector<char> mask(Dc);	//crossover workspace
 
 	//We extract from pop the chromosomes and fitness associated
 	for (std::vector<double>::size_type i = 0; i < NP; ++i) {
-		popold[i] = pop.get_individual(i).cur_x;
+		popold.set(i,pop.get_individual(i).cur_x);
+		popnew.set(i,pop.get_individual(i).cur_x);
 		fit[i] = pop.get_individual(i).cur_f;
 	}
-	popnew = popold;
 
 	// Initialise the global bests
 	gbX=pop.champion().x;
@@ -126,196 +166,39 @@ void de::evolve(population &pop) const
 	gbIter = gbX;
 
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5;	//indexes to the selected population members
 	for (int gen = 0; gen < m_gen; ++gen) {
-		//Start of the loop through the deme
-		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-
-
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (m_strategy == 1) { /* strategy DE0 (not in our paper) */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (m_strategy == 2) { /* strategy DE1 in the techreport */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
+		//a) Mutation, crossover and feasibility of the whole deme
+		make_generation_trials(trial, popold, &gbIter[0], lb, ub, Dc, m_f, m_cr, m_urng, m_drng, mask);
 
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and m_cr=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (m_strategy == 3) { /* similiar to DE2 but generally better */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (m_strategy == 4) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (m_strategy == 5) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 6) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (m_strategy == 7) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (m_strategy == 8) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 9) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 10) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-
-
-			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
-			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = boost::uniform_real<double>(lb[i2],ub[i2])(m_drng);
-				++i2;
-			}
-
-			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
+		//b) how good? All the trial vectors of the generation are evaluated at once
+		prob.batch_objfun(trialfit, trial);
+		for (size_t i = 0; i < NP; ++i) {
+			tmp = trial[i];
+			newfitness = trialfit[i];
 			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
 				fit[i]=newfitness;
-				popnew[i] = tmp;
+				popnew.set(i,tmp);
 				// As a fitness improvment occured we move the point
 				// and thus can evaluate a new velocity
 				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				//updates x (with the fitness just computed) and v
+				pop.set_x(i,trial[i],newfitness,c);
 				pop.set_v(i,tmp);
 				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
 					/* if so...*/
 					gbfit=newfitness;          /* reset gbfit to new low...*/
-					gbX=popnew[i];
+					gbX=trial[i];
 				}
 			} else {
-				popnew[i] = popold[i];
+				std::copy(popold[i], popold[i] + D, popnew[i]);
 			}
-
-		}//End of the loop through the deme
+		}
 
 		/* Save best population member of current iteration */
 		gbIter = gbX;
 
 		/* swap population arrays. New generation becomes old one */
-		std::swap(popold, popnew);
+		popold.swap(popnew);
 
 
 		//9 - Check the exit conditions (every 40 generations)
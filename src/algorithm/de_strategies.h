@@ -0,0 +1,278 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_ALGORITHM_DE_STRATEGIES_H
+#define PAGMO_ALGORITHM_DE_STRATEGIES_H
+
+#include <algorithm>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../types.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Building blocks shared by the Differential Evolution family (de, de_1220, jde).
+/**
+ * The DE inner loop is made of a mutation (which vectors are combined into the mutant) and of
+ * a crossover (which components of the mutant end up in the trial). Here each mutation rule is a
+ * small functor exposing the number of distinct random population members it needs, and the crossovers
+ * are templates over the mutation, so that a strategy is resolved once per evolve call rather than once
+ * per individual and per generation.
+ */
+namespace de_strategies {
+
+/// Contiguous storage of a deme.
+/**
+ * The chromosomes are stored one after the other in a single buffer (row i holds individual i), so that
+ * a whole generation lives in one allocation and the mutation reads unit-stride rows.
+ */
+class deme
+{
+	public:
+		/// Constructor from number of individuals and dimension.
+		deme(std::size_t np = 0, std::size_t d = 0):m_data(np * d),m_dim(d) {}
+		/// Pointer to the i-th chromosome.
+		double *operator[](std::size_t i)
+		{
+			return &m_data[0] + i * m_dim;
+		}
+		/// Const pointer to the i-th chromosome.
+		const double *operator[](std::size_t i) const
+		{
+			return &m_data[0] + i * m_dim;
+		}
+		/// Copy a decision vector into the i-th row.
+		void set(std::size_t i, const decision_vector &x)
+		{
+			std::copy(x.begin(), x.end(), (*this)[i]);
+		}
+		/// Swap content with another deme.
+		void swap(deme &other)
+		{
+			m_data.swap(other.m_data);
+			std::swap(m_dim, other.m_dim);
+		}
+	private:
+		std::vector<double>	m_data;
+		std::size_t		m_dim;
+};
+
+/// Maximum number of distinct random population members used by any strategy of the DE family.
+static const int max_indices = 7;
+
+/// Number of distinct random members drawn by the 18 variants of de_1220 and jde.
+/**
+ * Indexed by variant (entry 0 is unused). The counts cover the members referenced both by the
+ * mutation and by the self-adaptation of F and CR, so that the indices r1 ... rk are exactly the ones
+ * the variant reads.
+ */
+static const int variant_indices[19] = {0, 3, 3, 2, 4, 5, 3, 3, 2, 4, 5, 6, 6, 7, 7, 7, 7, 7, 7};
+
+/// Draw k distinct population members, all different from i.
+/**
+ * Same rejection scheme as the classic DE implementation, but only k members are drawn.
+ *
+ * @param[out] r array of at least k indices.
+ * @param[in] k number of members to draw.
+ * @param[in] i index of the current individual.
+ * @param[in] idx generator of integers in [0,NP-1].
+ */
+template <class IdxGenerator>
+inline void draw_members(std::size_t *r, int k, std::size_t i, IdxGenerator &idx)
+{
+	for (int j = 0; j < k; ++j) {
+		bool again;
+		do {
+			r[j] = idx();
+			again = (r[j] == i);
+			for (int l = 0; l < j && !again; ++l) {
+				again = (r[j] == r[l]);
+			}
+		} while (again);
+	}
+}
+
+/// Arguments of a mutation: current individual, best of the previous generation, random members and F.
+struct mutation_args
+{
+	/// Current individual.
+	const double *x;
+	/// Best individual of the previous generation.
+	const double *best;
+	/// Random members.
+	const double *r[max_indices];
+	/// Weighting factor.
+	double F;
+};
+
+/// DE/best/1: best + F * (r0 - r1).
+struct best_1
+{
+	static const int indices = 2;
+	static double apply(const mutation_args &a, std::size_t n)
+	{
+		return a.best[n] + a.F * (a.r[0][n] - a.r[1][n]);
+	}
+};
+
+/// DE/rand/1: r0 + F * (r1 - r2).
+struct rand_1
+{
+	static const int indices = 3;
+	static double apply(const mutation_args &a, std::size_t n)
+	{
+		return a.r[0][n] + a.F * (a.r[1][n] - a.r[2][n]);
+	}
+};
+
+/// DE/rand-to-best/1: x + F * (best - x) + F * (r0 - r1).
+struct rand_to_best_1
+{
+	static const int indices = 2;
+	static double apply(const mutation_args &a, std::size_t n)
+	{
+		return a.x[n] + a.F * (a.best[n] - a.x[n]) + a.F * (a.r[0][n] - a.r[1][n]);
+	}
+};
+
+/// DE/best/2: best + F * (r0 + r1 - r2 - r3).
+struct best_2
+{
+	static const int indices = 4;
+	static double apply(const mutation_args &a, std::size_t n)
+	{
+		return a.best[n] + (a.r[0][n] + a.r[1][n] - a.r[2][n] - a.r[3][n]) * a.F;
+	}
+};
+
+/// DE/rand/2: r4 + F * (r0 + r1 - r2 - r3).
+struct rand_2
+{
+	static const int indices = 5;
+	static double apply(const mutation_args &a, std::size_t n)
+	{
+		return a.r[4][n] + (a.r[0][n] + a.r[1][n] - a.r[2][n] - a.r[3][n]) * a.F;
+	}
+};
+
+/// Exponential crossover.
+/**
+ * Starting from a random component, consecutive components are taken from the mutant as long as
+ * the coin flips succeed. This is inherently sequential, so it is kept as a scalar loop.
+ */
+template <class Mutation>
+struct exponential
+{
+	static const int indices = Mutation::indices;
+	template <class URng, class DRng>
+	static void apply(double *trial, const mutation_args &a, std::size_t Dc, double CR, URng &urng, DRng &drng, std::vector<char> &)
+	{
+		std::size_t n = boost::uniform_int<int>(0,Dc-1)(urng), L = 0;
+		do {
+			trial[n] = Mutation::apply(a,n);
+			n = (n+1)%Dc;
+			++L;
+		} while ((drng() < CR) && (L < Dc));
+	}
+};
+
+/// Binomial crossover.
+/**
+ * The coin flips are drawn first into a mask (one flip per component, plus one component
+ * forced to come from the mutant), then the trial is assembled in a single branch-free pass
+ * over the components that the compiler can vectorize.
+ */
+template <class Mutation>
+struct binomial
+{
+	static const int indices = Mutation::indices;
+	template <class URng, class DRng>
+	static void apply(double *trial, const mutation_args &a, std::size_t Dc, double CR, URng &urng, DRng &drng, std::vector<char> &mask)
+	{
+		const std::size_t jrand = boost::uniform_int<int>(0,Dc-1)(urng);
+		for (std::size_t n = 0; n < Dc; ++n) {
+			mask[n] = (drng() < CR);
+		}
+		mask[jrand] = 1;
+		const char *m = &mask[0];
+		for (std::size_t n = 0; n < Dc; ++n) {
+			const double v = Mutation::apply(a,n);
+			trial[n] = m[n] ? v : trial[n];
+		}
+	}
+};
+
+/// Build the trial vectors of a whole generation.
+/**
+ * Instantiated once per (mutation, crossover) pair. For each individual the needed random members are drawn,
+ * the trial is initialised with the individual itself, the crossover is applied on the continuous
+ * part and out of bounds components are resampled uniformly within the bounds.
+ *
+ * @param[out] trial trial vectors, one per individual, each of the problem dimension.
+ * @param[in] pop current deme.
+ * @param[in] best best chromosome of the previous generation.
+ * @param[in] lb lower bounds.
+ * @param[in] ub upper bounds.
+ * @param[in] Dc size of the continuous part.
+ * @param[in] F weighting factor.
+ * @param[in] CR crossover probability.
+ * @param[in,out] urng integer random number generator.
+ * @param[in,out] drng floating point random number generator.
+ * @param[in,out] mask workspace of size at least Dc.
+ */
+template <class Crossover, class URng, class DRng>
+inline void make_trials(std::vector<decision_vector> &trial, const deme &pop, const double *best, const decision_vector &lb,
+	const decision_vector &ub, std::size_t Dc, double F, double CR, URng &urng, DRng &drng, std::vector<char> &mask)
+{
+	const std::size_t NP = trial.size();
+	boost::variate_generator<URng &, boost::uniform_int<int> > idx(urng,boost::uniform_int<int>(0,NP-1));
+	std::size_t r[max_indices];
+	mutation_args a;
+	a.best = best;
+	a.F = F;
+	for (std::size_t i = 0; i < NP; ++i) {
+		draw_members(r, Crossover::indices, i, idx);
+		for (int j = 0; j < Crossover::indices; ++j) {
+			a.r[j] = pop[r[j]];
+		}
+		a.x = pop[i];
+		double *t = &trial[i][0];
+		std::copy(a.x, a.x + trial[i].size(), t);
+		Crossover::apply(t, a, Dc, CR, urng, drng, mask);
+		for (std::size_t n = 0; n < Dc; ++n) {
+			if ((t[n] < lb[n]) || (t[n] > ub[n])) {
+				t[n] = boost::uniform_real<double>(lb[n],ub[n])(drng);
+			}
+		}
+	}
+}
+
+}}}
+
+#endif
@@ -110,6 +110,7 @@ void firefly::evolve(population &pop) const
 	std::vector<decision_vector> X(NP,dummy);	//set of firefly positions
 	std::vector<decision_vector> X0(NP,dummy);	//set of firefly positions kept to calculate velocity
 	std::vector<fitness_vector> fit(NP);		//set of firefly positions fitness
+	const constraint_vector c;			//constraints (the problem is box constrained)
 
 	// Copy the fireflies position and their fitness
 	for ( population::size_type i = 0; i<NP; i++ ) {
@@ -181,7 +182,7 @@ void firefly::evolve(population &pop) const
 
 				prob.objfun(test_fit, X[ii]);
 				if(moveIItoJJ || prob.compare_fitness(test_fit, fit[ii])) { // only if moving ii towards jj or if new location has better fitness, update population and fitness
-					pop.set_x(ii, X[ii]);
+					pop.set_x(ii, X[ii], test_fit, c);
                                         fit[ii] = test_fit;
 				}
 				else {
@@ -26,13 +26,13 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <cstddef>
 #include <exception>
-#include <gsl/gsl_deriv.h>
 #include <gsl/gsl_multimin.h>
 #include <gsl/gsl_vector.h>
 #include <new>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../population.h"
@@ -50,7 +50,7 @@ namespace pagmo { namespace algorithm {
  *
  * @param[in] max_iter maximum number of iterations allowed.
  * @param[in] grad_tol tolerance when testing the norm of the gradient as stopping criterion.
- * @param[in] numdiff_step_size step size for the numerical computation of the gradient.
+ * @param[in] numdiff_step_size relative step size for the numerical computation of the gradient.
  * @param[in] tol accuracy of the line minimisation.
  * @param[in] step_size size of the first trial step.
  */
@@ -73,16 +73,8 @@ gsl_gradient::gsl_gradient(int max_iter, const double &grad_tol, const double &n
 	}
 }
 
-// Wrapper for the numerical differentiation of the objective function of a problem via GSL.
-double gsl_gradient::objfun_numdiff_wrapper(double x, void *params)
-{
-	objfun_numdiff_wrapper_params *pars = (objfun_numdiff_wrapper_params *)params;
-	pars->x[pars->coord] = x;
-	pars->prob->objfun(pars->f,pars->x);
-	return pars->f[0];
-}
-
-// Write into retval the gradient of the continuous part of the objective function of prob calculated in input.
+// Write into retval the gradient of the continuous part of the objective function of prob calculated in input,
+// via problem::base::compute_jacobian() with relative step step_size.
 void gsl_gradient::objfun_numdiff_central(gsl_vector *retval, const problem::base &prob, const decision_vector &input, const double &step_size)
 {
 	if (input.size() != prob.get_dimension()) {
@@ -93,21 +85,18 @@ void gsl_gradient::objfun_numdiff_central(gsl_vector *retval, const problem::bas
 	}
 	// Size of the continuous part of the problem.
 	const problem::base::size_type cont_size = prob.get_dimension() - prob.get_i_dimension();
-	// Structure to pass data to the wrapper.
-	objfun_numdiff_wrapper_params pars;
-	pars.x = input;
-	pars.f.resize(1);
-	pars.prob = &prob;
-	// GSL function.
-	gsl_function F;
-	F.function = &objfun_numdiff_wrapper;
-	F.params = (void *)&pars;
-	double result, abserr;
-	// Numerical differentiation component by component.
+	int lenG;
+	std::vector<int> iGfun, jGvar;
+	std::vector<double> G;
+	prob.get_jacobian_pattern(lenG,iGfun,jGvar);
+	prob.compute_jacobian(G,input,step_size);
 	for (problem::base::size_type i = 0; i < cont_size; ++i) {
-		pars.coord = i;
-		gsl_deriv_central(&F,input[i],step_size,&result,&abserr);
-		gsl_vector_set(retval,i,result);
+		gsl_vector_set(retval,i,0);
+	}
+	for (int k = 0; k < lenG; ++k) {
+		if (iGfun[k] == 0 && boost::numeric_cast<problem::base::size_type>(jGvar[k]) < cont_size) {
+			gsl_vector_set(retval,jGvar[k],G[k]);
+		}
 	}
 }
 
@@ -42,7 +42,8 @@ namespace pagmo { namespace algorithm {
 /// Wrapper for GSL minimisers with derivatives.
 /**
  * This class can be used to build easily a wrapper around a GSL minimiser with derivatives. The gradient of the
- * objective function will be calculated numerically via the gsl_deriv_central GSL function.
+ * objective function will be calculated numerically via problem::base::compute_jacobian(), using
+ * the step size for numerical differentiation as relative step.
  *
  * @see algorithm::base_gsl for more information.
  *
@@ -63,19 +64,6 @@ class __PAGMO_VISIBLE gsl_gradient: public base_gsl
 		 */
 		virtual const gsl_multimin_fdfminimizer_type *get_gsl_minimiser_ptr() const = 0;
 	private:
-		// Structure to feed parameters to the numerical differentiation wrapper.
-		struct objfun_numdiff_wrapper_params
-		{
-			// Pointer to the problem.
-			problem::base const		*prob;
-			// Decision vector.
-			decision_vector			x;
-			// Fitness vector.
-			fitness_vector			f;
-			// Coordinate of the gradient being computed.
-			problem::base::size_type 	coord;
-		};
-		static double objfun_numdiff_wrapper(double, void *);
 		static void objfun_numdiff_central(gsl_vector *, const problem::base &, const decision_vector &, const double &);
 		static void d_objfun_wrapper(const gsl_vector *, void *, gsl_vector *);
 		static void fd_objfun_wrapper(const gsl_vector *, void *, double *, gsl_vector *);
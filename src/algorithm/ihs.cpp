@@ -149,12 +149,8 @@ void ihs::evolve(population &pop) const
 				tmp.cur_x[i] = boost::uniform_int<int>(lb[i],ub[i])(m_urng);
 			}
 		}
-		// And we push him back
-		pop.push_back(tmp.cur_x);
-		// We locate the worst individual.
-		const population::size_type worst_idx = pop.get_worst_idx();
-		// And we get rid of him :)
-		pop.erase(worst_idx);
+		// And he takes the place of the worst individual, if he is not worse than him.
+		pop.replace_worst(tmp.cur_x);
 	}
 }
 
@@ -203,7 +203,7 @@ for(size_t i=0; i < NP; i++){
 		switch( prob->get_encoding() ) 
 		{
 		    case problem::base_tsp::FULL:
-		        fitness[i] = prob->objfun(prob->full2cities(my_pop[i]));
+		        fitness[i] = prob->objfun(prob->cities2full(my_pop[i]));
 		        break;
 		    case problem::base_tsp::RANDOMKEYS:
 		        fitness[i] = prob->objfun(prob->cities2randomkeys(my_pop[i], pop.get_individual(i).cur_x));
@@ -217,8 +217,12 @@ for(size_t i=0; i < NP; i++){
 
 decision_vector tmp_tour(Nv);
 bool stop, changed;
-size_t rnd_num, i2, pos1_c1, pos1_c2, pos2_c1, pos2_c2; //pos2_c1 denotes the position of city1 in parent2
+size_t rnd_num, i2, pos1_c1, pos1_c2, pos2_c1, pos2_c2, gap; //pos2_c1 denotes the position of city1 in parent2
 fitness_vector fitness_tmp;
+// When the objective is the tour length, inversions are screened with their length deltas
+// and the objective function is only called for the tours that improve on their parent.
+const bool incremental = prob->is_tour_length_objective();
+double delta;
 
 //InverOver main loop
 for(int iter = 0; iter < m_gen; iter++){
@@ -227,6 +231,7 @@ for(int iter = 0; iter < m_gen; iter++){
 		pos1_c1 = unif_Nv();
 		stop = false;
 		changed = false;
+		delta = 0;
 		while(!stop){
 			if(unif_01() < m_ri){
 				rnd_num = unif_Nvless1();
@@ -239,9 +244,13 @@ for(int iter = 0; iter < m_gen; iter++){
 				pos2_c2 = (pos2_c1 == Nv-1? 0:pos2_c1+1);
 				pos1_c2 = std::find(tmp_tour.begin(),tmp_tour.end(),my_pop[i2][pos2_c2])-tmp_tour.begin();
 			}
-			stop = (abs(pos1_c1-pos1_c2)==1 || abs(pos1_c1-pos1_c2)==Nv-1);
+			gap = (pos1_c1 > pos1_c2 ? pos1_c1-pos1_c2 : pos1_c2-pos1_c1);
+			stop = (gap==1 || gap==Nv-1);
 			if(!stop){
 				changed = true;
+				if(incremental){
+					delta += (pos1_c1<pos1_c2 ? prob->inversion_delta(tmp_tour,pos1_c1+1,pos1_c2) : prob->inversion_delta(tmp_tour,pos1_c2,pos1_c1-1));
+				}
 				if(pos1_c1<pos1_c2){
 					for(size_t l=0; l < (double (pos1_c2-pos1_c1-1)/2); l++){
 						std::swap(tmp_tour[pos1_c1+1+l],tmp_tour[pos1_c2-l]);}
@@ -257,10 +266,17 @@ for(int iter = 0; iter < m_gen; iter++){
 			}
 		} //end of while loop (looping over a single indvidual)
 		if(changed){
+			if(incremental){
+				fitness_tmp = fitness[i1];
+				fitness_tmp[0] += delta;
+				if(!prob->compare_fitness(fitness_tmp,fitness[i1])){
+					continue;
+				}
+			}
 			switch( prob->get_encoding() ) 
 			{
 			    case problem::base_tsp::FULL:
-			        fitness_tmp = prob->objfun(prob->full2cities(tmp_tour));
+			        fitness_tmp = prob->objfun(prob->cities2full(tmp_tour));
 			        break;
 			    case problem::base_tsp::RANDOMKEYS: //using "randomly" index 0 as a temporary template
 			        fitness_tmp = prob->objfun(prob->cities2randomkeys(tmp_tour, pop.get_individual(0).cur_x));
@@ -50,6 +50,10 @@ namespace pagmo { namespace algorithm {
  * chosen as in the original paper (city1 -> city2). Some papers invert the complementary part of the tour
  * (city2 -> city1).
  *
+ * Note4: When the problem objective is the tour length (see pagmo::problem::base_tsp::is_tour_length_objective)
+ * each inversion is costed with pagmo::problem::base_tsp::inversion_delta and the objective function is
+ * only called for offspring that improve on their parent.
+ *
  * @author Ingmar Getzner (ingmar.getzner@gmail.com)
  */
 class __PAGMO_VISIBLE inverover: public base
@@ -39,60 +39,44 @@ ipopt_problem::ipopt_problem(pagmo::population *pop) : m_pop(pop)
 	con.resize(m_pop->problem().get_c_dimension());
 
 	//We need to initialize the class members len_jac, iJfun, jJvar. We do this by first
-	//storing the information in duples, ordering using the std::sort algorithm and then assigning
-	//them to iJfun, jJvar. This is done to increase the constraint cache hits
-	::Ipopt::Index lenG;
-	std::vector< ::Ipopt::Index> iGfun,jGvar;
+	//storing the information in triples (row, column, position in the Jacobian of the problem), ordering
+	//using the std::sort algorithm and then assigning them to iJfun, jJvar, jac_entries.
+	//The Jacobian is computed by problem::base::compute_jacobian(), which perturbs together the columns
+	//not sharing any row, so the pattern declared in set_sparsity (if any) is what makes it cheap.
+	int lenG;
+	std::vector<int> iGfun,jGvar;
 	len_jac=0;
-	std::vector< boost::array< ::Ipopt::Index,2> > duples(0);
-	boost::array< ::Ipopt::Index,2> tmp;
+	std::vector< boost::array< ::Ipopt::Index,3> > triples(0);
+	boost::array< ::Ipopt::Index,3> tmp;
 
-
-	//If the problem has its set_sparsity implemented, store the values relevant to the constraints
-	try {
-		m_pop->problem().set_sparsity(lenG,iGfun,jGvar);
-		for (::Ipopt::Index i = 0; i<lenG; ++i)
+	m_pop->problem().get_jacobian_pattern(lenG,iGfun,jGvar);
+	for (::Ipopt::Index i = 0; i<lenG; ++i)
+	{
+		if (iGfun[i]!=0)
 		{
-			if (iGfun[i]!=0) //objective function gradient sparsity is not used by ipopt
-			{
-				tmp[0] = iGfun[i] - 1; //HERE WAS THE UNDEBUGGABLE!! -1 ffffffkkkkkk
-				tmp[1] = jGvar[i];
-				duples.push_back(tmp);
-				len_jac++;
-			}
-			else
-			{
-				affects_obj.push_back(jGvar[i]);
-			}
+			tmp[0] = iGfun[i] - 1; //HERE WAS THE UNDEBUGGABLE!! -1 ffffffkkkkkk
+			tmp[1] = jGvar[i];
+			tmp[2] = i;
+			triples.push_back(tmp);
+			len_jac++;
 		}
-		//We now reorder the entries so that the cache will be hit avoiding useless
-		//re-evaluations of the constraints in eval_jac_g when performing finite differences
-		std::sort (duples.begin(), duples.end(), cache_efficiency_criterion);
-	}
-	//Otherwise assume no sparsity
-	catch (not_implemented_error)
-	{
-		for (pagmo::problem::base::size_type j=0;j<m_pop->problem().get_dimension();++j)
+		else
 		{
-			affects_obj.push_back(j);
-			for (pagmo::problem::base::size_type i=0;i<m_pop->problem().get_c_dimension();++i)
-			{
-				tmp[0] = i;
-				tmp[1] = j;
-				duples.push_back(tmp);
-				len_jac++;
-			}
+			affects_obj.push_back(jGvar[i]);
+			obj_entries.push_back(i);
 		}
 	}
+	std::sort (triples.begin(), triples.end(), cache_efficiency_criterion);
 
-	//And we finally assign the ordered duples to iJfun, jJvar
+	//And we finally assign the ordered triples to iJfun, jJvar, jac_entries
 	iJfun.resize(len_jac);
 	jJvar.resize(len_jac);
+	jac_entries.resize(len_jac);
 	for (::Ipopt::Index i = 0;i<len_jac;++i)
 	{
-		iJfun[i] = duples[i][0];
-		jJvar[i] = duples[i][1];
-		//std::cout << "[" << iJfun[i] << "," << jJvar[i] << "]" << std::endl;
+		iJfun[i] = triples[i][0];
+		jJvar[i] = triples[i][1];
+		jac_entries[i] = triples[i][2];
 	}
 }
 
@@ -107,7 +91,7 @@ ipopt_problem::~ipopt_problem()
 //After sorting:
 //iJfun = [0,1,0,2,0,3]
 //jJvar = [0,0,1,1,2,2]
-bool ipopt_problem::cache_efficiency_criterion(boost::array<int,2> one,boost::array<int,2> two)
+bool ipopt_problem::cache_efficiency_criterion(boost::array<int,3> one,boost::array<int,3> two)
 {
 	if (one[1] < two[1]) {
 		return true;
@@ -213,28 +197,17 @@ bool ipopt_problem::eval_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x, I
 bool ipopt_problem::eval_grad_f(Ipopt::Index n, const Ipopt::Number* x, bool new_x, Ipopt::Number* grad_f)
 {
 	(void) new_x;
-	double central_diff;
-	const double h0=1e-8;
-	double h;
 	std::copy(x,x+n,dv.begin());
 	for (pagmo::decision_vector::size_type i=0; i<dv.size();++i)
 	{
 		grad_f[i] = 0;
 	}
 
-	double mem;
+	// The Jacobian is cached, eval_jac_g at the same point costs no further evaluations.
+	m_pop->problem().compute_jacobian(G,dv);
 	for (size_t i =0;i<affects_obj.size();++i)
 	{
-		h = h0 * std::max(1.,fabs(dv[affects_obj[i]]));
-		mem = dv[affects_obj[i]];
-		dv[affects_obj[i]] += h;
-		m_pop->problem().objfun(fit,dv);
-		central_diff = fit[0];
-		dv[affects_obj[i]] -= 2*h;
-		m_pop->problem().objfun(fit,dv);
-		central_diff = (central_diff-fit[0]) / 2 / h;
-		grad_f[affects_obj[i]] = central_diff;
-		dv[affects_obj[i]] = mem;
+		grad_f[affects_obj[i]] = G[obj_entries[i]];
 	}
 
 	return true;
@@ -268,23 +241,11 @@ bool ipopt_problem::eval_jac_g(Ipopt::Index n, const Ipopt::Number* x, bool new_
 		}
 	}
 	else {
-		double central_diff;
-		const double h0 = 1e-8;
-		double h;
-		double mem;
 		std::copy(x,x+n,dv.begin());
+		m_pop->problem().compute_jacobian(G,dv);
 		for (Ipopt::Index i=0;i<nele_jac;++i)
 		{
-			h = h0 * std::max(1.,fabs(dv[jJvar[i]]));
-			mem = dv[jJvar[i]];
-			dv[jJvar[i]] += h;
-			m_pop->problem().compute_constraints(con,dv);
-			central_diff = con[iJfun[i]];
-			dv[jJvar[i]] -= 2 * h;
-			m_pop->problem().compute_constraints(con,dv);
-			central_diff = (central_diff - con[iJfun[i]])/2/h;
-			values[i] = central_diff;
-			dv[jJvar[i]] = mem;
+			values[i] = G[jac_entries[i]];
 		}
 	}
 
@@ -102,12 +102,17 @@ private:
 	::Ipopt::Index len_jac;
 	//Sparse representation of the Jacobian
 	std::vector< ::Ipopt::Index> iJfun,jJvar;
+	//Position of the iJfun, jJvar entries in the Jacobian of the PaGMO problem
+	std::vector< ::Ipopt::Index> jac_entries;
 	//Contains the variables that effect the objective function
 	std::vector< ::Ipopt::Index> affects_obj;
-	//Sorting criteria for the iJfun, jJvar entries to achieve constraint cache efficiency
-	static bool cache_efficiency_criterion(boost::array<int,2>,boost::array<int,2>);
+	//Position of the affects_obj entries in the Jacobian of the PaGMO problem
+	std::vector< ::Ipopt::Index> obj_entries;
+	//Sorting criteria for the iJfun, jJvar entries
+	static bool cache_efficiency_criterion(boost::array<int,3>,boost::array<int,3>);
 	// Internal caches used during evolution.
 	::pagmo::decision_vector dv;
+	std::vector<double> G;
 	::pagmo::fitness_vector fit;
 	::pagmo::constraint_vector con;
 };
@@ -34,6 +34,7 @@
 #include "../types.h"
 #include "base.h"
 #include "jde.h"
+#include "de_strategies.h"
 
 namespace pagmo { namespace algorithm {
 
@@ -160,7 +161,9 @@ void jde::evolve(population &pop) const
 	double gbIterCR = m_cr[0];
 
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5,r6,r7;	//indexes to the selected population members
+	size_t r[de_strategies::max_indices] = {0};	//indexes to the selected population members
+	size_t r1,r2,r3,r4,r5,r6,r7;
+	const int n_members = de_strategies::variant_indices[m_variant];
 	for (int gen = 0; gen < m_gen; ++gen) {
 		//0 - Check the exit conditions (every 10 generations)
 		if (gen % 5 == 0) {
@@ -189,45 +192,16 @@ void jde::evolve(population &pop) const
 
 		//Start of the loop through the deme
 		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = p_idx();
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = p_idx();
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = p_idx();
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = p_idx();
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = p_idx();
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 7 !!!     */
-				r6 = p_idx();
-			} while ((r6==i) || (r6==r1) || (r6==r2) || (r6==r3) || (r6==r4) || (r6==r5));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 8 !!!     */
-				r7 = p_idx();
-			} while ((r7==i) || (r7==r1) || (r7==r2) || (r7==r3) || (r7==r4) || (r7==r5) || (r7==r6));
-
 			// Adapt amplification factor and crossover probability
 			double F=0, CR=0;
 			if (m_variant_adptv==1) {
 				F =  (r_dist() < 0.9) ? m_f[i]  : r_dist() * 0.9 + 0.1;
 				CR = (r_dist() < 0.9) ? m_cr[i] : r_dist();
 			}
+
+			// Pick only the random population members the variant reads
+			de_strategies::draw_members(r, n_members, i, p_idx);
+			r1 = r[0]; r2 = r[1]; r3 = r[2]; r4 = r[3]; r5 = r[4]; r6 = r[5]; r7 = r[6];
 					
 			/*-------DE/best/1/exp--------------------------------------------------------------------*/
 			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
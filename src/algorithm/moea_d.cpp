@@ -324,10 +324,10 @@ void moead::evolve(population &pop) const
 	
 	// We compute, for each weight vector, the m_T neighbouring ones
 	std::vector<std::vector<population::size_type> > neigh_idx;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(neigh_idx, weights);
+	pagmo::util::neighbourhood::euclidian::compute_neighbours(neigh_idx, weights, m_T);
 	for (unsigned int i=0; i < neigh_idx.size();++i) {
+		// The first element is the weight vector itself
 		neigh_idx[i].erase(neigh_idx[i].begin());
-		neigh_idx[i].erase(neigh_idx[i].begin()+m_T, neigh_idx[i].end());
 	}
 
 	// We create a decomposed problem which we will use not as a polymorphic problem,
@@ -420,8 +420,14 @@ void moead::evolve(population &pop) const
 	// We reset the population memory (TODO... can be made much more efficient)
 	std::vector<decision_vector> X(NP,candidate);
 	for (population::size_type i=0; i < X.size(); ++i) X[i] = pop.get_individual(i).cur_x;
+	// The final population is evaluated at once and inserted with its fitnesses and constraints.
+	// Offspring cannot be batched inside the main loop as each one depends on the previous replacements.
+	std::vector<fitness_vector> F;
+	std::vector<constraint_vector> C;
+	prob.batch_objfun(F,X);
+	prob.batch_compute_constraints(C,X);
 	pop.clear();
-	for (population::size_type i=0; i < X.size(); ++i) pop.push_back(X[i]);
+	for (population::size_type i=0; i < X.size(); ++i) pop.push_back(X[i],F[i],C[i]);
 }
 
 /// Algorithm name
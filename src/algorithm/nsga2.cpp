@@ -272,6 +272,10 @@ void nsga2::evolve(population &pop) const
 	std::vector<population::size_type> best_idx(NP), shuffle1(NP),shuffle2(NP);
 	population::size_type parent1_idx, parent2_idx;
 	decision_vector child1(D), child2(D);
+	std::vector<decision_vector> offspring;
+	std::vector<fitness_vector> offspring_f;
+	const constraint_vector c;	// constraints (the problem is box constrained)
+	offspring.reserve(NP);
 
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle1[i] = i;
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle2[i] = i;
@@ -285,6 +289,7 @@ void nsga2::evolve(population &pop) const
 		// We compute the crowding distance and the pareto rank of pop
 		pop.update_pareto_information();
 		population popnew(pop);
+		offspring.clear();
 
 		//We create some pseudo-random permutation of the poulation indexes
 		std::random_shuffle(shuffle1.begin(),shuffle1.end(),p_idx);
@@ -299,8 +304,8 @@ void nsga2::evolve(population &pop) const
 			crossover(child1, child2, parent1_idx,parent2_idx,pop);
 			mutate(child1,pop);
 			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
+			offspring.push_back(child1);
+			offspring.push_back(child2);
 
 			// We repeat with the shuffled list 2
 			parent1_idx = tournament_selection(shuffle2[i], shuffle2[i+1],pop);
@@ -308,9 +313,13 @@ void nsga2::evolve(population &pop) const
 			crossover(child1, child2, parent1_idx,parent2_idx,pop);
 			mutate(child1,pop);
 			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
-		} // popnew now contains 2NP individuals
+			offspring.push_back(child1);
+			offspring.push_back(child2);
+		}
+		// The offspring are evaluated all at once and inserted into popnew with their fitnesses
+		popnew.problem().batch_objfun(offspring_f,offspring);
+		for (std::vector<decision_vector>::size_type i=0; i < offspring.size(); ++i) popnew.push_back(offspring[i],offspring_f[i],c);
+		// popnew now contains 2NP individuals
 
 		// This method returns the sorted N best individuals in the population according to the crowded comparison operator
 		// defined in population.cpp
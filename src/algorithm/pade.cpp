@@ -245,9 +245,9 @@ void pade::evolve(population &pop) const
 	// Generate the weights for the NP decomposed problems
 	std::vector<fitness_vector> weights = generate_weights(prob.get_f_dimension(), NP);
 	
-	// We compute, for each weight vector, the neighbouring ones (this will form the topology later on)
+	// We compute, for each weight vector, the m_T neighbouring ones (this will form the topology later on)
 	std::vector<std::vector<population::size_type> > indices;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(indices, weights);
+	pagmo::util::neighbourhood::euclidian::compute_neighbours(indices, weights, m_T);
 
 	// Create the archipelago of NP islands:
 	// each island in the archipelago solves a different single-objective problem.
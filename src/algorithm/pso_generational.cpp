@@ -139,6 +139,7 @@ void pso_generational::evolve(population &pop) const
 
 	std::vector<decision_vector> lbX(swarm_size,dummy);	// particles' previous best positions
 	std::vector<fitness_vector>  lbfit(swarm_size);		// particles' fitness values at their previous best positions
+	const constraint_vector      c;				// constraints (the problem is box constrained)
 
 
 	std::vector< std::vector<int> > neighb(swarm_size);	// swarm topology (iterators over indexes of each particle's neighbors in the swarm)
@@ -336,15 +337,19 @@ void pso_generational::evolve(population &pop) const
 			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
 
-			// Re-evaluate wrt new seed the particle position and memory
+			// Re-evaluate wrt new seed the particle position and memory, all particles at once
+			std::vector<decision_vector> batch_x(X);
+			batch_x.insert( batch_x.end(), lbX.begin(), lbX.end() );
+			std::vector<fitness_vector> batch_f;
+			prob.batch_objfun( batch_f, batch_x );
 			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				// We re-evaluate the fitness of the particle memory
-				prob.objfun( lbfit[p], lbX[p] );
+				// We get here the new individual fitness
+				fit[p] = batch_f[p];
+				// and the fitness of the particle memory
+				lbfit[p] = batch_f[swarm_size + p];
 				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(lbX[p]);
-				pop.set_x(p,X[p]);
+				pop.push_back(lbX[p],lbfit[p],c);
+				pop.set_x(p,X[p],fit[p],c);
 				pop.set_v(p,V[p]);
 			}
 			//UPDATE BEST_FIT and BEST to account for the new seed
@@ -361,10 +366,9 @@ void pso_generational::evolve(population &pop) const
 		catch (const std::bad_cast& e)
 		{
 			//Only evaluate new position
+			prob.batch_objfun( fit, X );
 			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				pop.set_x(p,X[p]);
+				pop.set_x(p,X[p],fit[p],c);
 				pop.set_v(p,V[p]);
 			}
 		}
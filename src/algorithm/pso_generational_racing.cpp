@@ -50,12 +50,13 @@ using namespace util::racing;
  * (also outdegree) in the swarm topology. Particles have neighbours u to a radius of k = neighb_param / 2 in the ring. If the Randomly-varying neighbourhood topology is selected (neighb_type=4), neighb_param represents each particle's maximum outdegree in the swarm topology. The minimum outdegree is 1 (the particle always connects back to itself).
  * @param[in] nr_eval_per_x Expected number of times an objective function will be evaluated for each individual during racing.
  * @param[in] max_fevals Maximum allowed number of fevals as the additional termination condition to gen number
+ * @param[in] n_threads Number of threads used for the re-evaluations during racing (0 for the number of hardware threads), see pagmo::util::racing::race_pop::set_threads
  *
  * @throws value_error if m_omega is not in the [0,1] interval, eta1, eta2 are not in the [0,1] interval,
  * vcoeff is not in ]0,1], variant is not one of 1 .. 6, neighb_type is not one of 1 .. 4
  */
 
-pso_generational_racing::pso_generational_racing(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param, unsigned int nr_eval_per_x, unsigned int max_fevals): base(), m_gen(gen), m_omega(omega), m_eta1(eta1), m_eta2(eta2), m_vcoeff(vcoeff), m_variant(variant), m_neighb_type(neighb_type), m_neighb_param(neighb_param), m_nr_eval_per_x(nr_eval_per_x), m_fevals(0), m_max_fevals(max_fevals) {
+pso_generational_racing::pso_generational_racing(int gen, double omega, double eta1, double eta2, double vcoeff, int variant, int neighb_type, int neighb_param, unsigned int nr_eval_per_x, unsigned int max_fevals, unsigned int n_threads): base(), m_gen(gen), m_omega(omega), m_eta1(eta1), m_eta2(eta2), m_vcoeff(vcoeff), m_variant(variant), m_neighb_type(neighb_type), m_neighb_param(neighb_param), m_nr_eval_per_x(nr_eval_per_x), m_fevals(0), m_max_fevals(max_fevals), m_n_threads(n_threads), m_racing_speedup(1) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -320,6 +321,8 @@ void pso_generational_racing::evolve(population &pop) const
 	unsigned int racing_seed = m_urng();
 	util::racing::race_pop race_lbX(racing_seed);
 	util::racing::race_pop race_lbX_and_X(racing_seed);
+	race_lbX.set_threads(m_n_threads);
+	race_lbX_and_X.set_threads(m_n_threads);
 
 	racing__construct_race_environment(race_lbX, pop.problem(), lbX, std::vector<decision_vector>());
 
@@ -625,6 +628,10 @@ void pso_generational_racing::evolve(population &pop) const
 		}
 
 	} // end of main PSO loop
+
+	const double racing_wall_time = race_lbX.get_wall_time() + race_lbX_and_X.get_wall_time();
+	m_racing_speedup = (racing_wall_time > 0 ? (race_lbX.get_eval_time() + race_lbX_and_X.get_eval_time()) / racing_wall_time : 1.);
+
 	std::cout << "PSO terminated: gen = " << g << ", incurred fevals = " << m_fevals << std::endl;
 }
 
@@ -860,6 +867,24 @@ void pso_generational_racing::initialize_topology__adaptive_random( std::vector<
 }
 
 
+/// Number of threads used during racing
+/**
+ * @return the number of threads used for the re-evaluations during racing (0 for the number of hardware threads)
+ */
+unsigned int pso_generational_racing::get_threads() const
+{
+	return m_n_threads;
+}
+
+/// Speedup achieved during racing
+/**
+ * @return the ratio between the time spent in the re-evaluations during racing and the elapsed time, measured in the last call to evolve()
+ */
+double pso_generational_racing::get_racing_speedup() const
+{
+	return m_racing_speedup;
+}
+
 /// Algorithm name
 std::string pso_generational_racing::get_name() const
 {
@@ -882,6 +907,8 @@ std::string pso_generational_racing::human_readable_extra() const
 	s << "topology:" << m_neighb_type << ' ';
 	if( m_neighb_type == 2 || m_neighb_type == 4 )
 		s << "topology param.:" << m_neighb_param << ' ';
+	if( m_n_threads != 1 )
+		s << "threads:" << m_n_threads << ' ';
 	return s.str();
 }
 
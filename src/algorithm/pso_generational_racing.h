@@ -43,10 +43,12 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE pso_generational_racing: public base
 {
 public:
-	pso_generational_racing(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4, unsigned int nr_eval_per_x = 5, unsigned int max_fevals = std::numeric_limits<unsigned int>::max());
+	pso_generational_racing(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4, unsigned int nr_eval_per_x = 5, unsigned int max_fevals = std::numeric_limits<unsigned int>::max(), unsigned int n_threads = 1);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
+	unsigned int get_threads() const;
+	double get_racing_speedup() const;
 protected:	
 	std::string human_readable_extra() const;
 private:
@@ -69,7 +71,7 @@ private:
 private:
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<int &>(m_gen);
@@ -82,6 +84,12 @@ private:
 		ar & const_cast<int &>(m_neighb_param);
 		ar & m_fevals;
 		ar & const_cast<unsigned int&>(m_max_fevals);
+		// Version 0 archives predate the threaded racing: fall back to the serial re-evaluations.
+		if (version >= 1) {
+			ar & const_cast<unsigned int&>(m_n_threads);
+		} else {
+			const_cast<unsigned int&>(m_n_threads) = 1;
+		}
 	}
 	// Number of generations
 	const int m_gen;
@@ -106,10 +114,17 @@ private:
 	mutable unsigned int m_fevals;
 	// Maximum allowable fevals before algo terminates
 	const unsigned int m_max_fevals;
+	// Number of threads used for the re-evaluations during racing
+	const unsigned int m_n_threads;
+	// Speedup of the racing re-evaluations achieved in the last evolve call
+	mutable double m_racing_speedup;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::pso_generational_racing)
 
+// Version 1: number of threads used for the racing re-evaluations.
+BOOST_CLASS_VERSION(pagmo::algorithm::pso_generational_racing,1)
+
 #endif // PAGMO_ALGORITHM_PSO_GENERATIONAL_RACING_H
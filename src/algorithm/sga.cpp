@@ -120,9 +120,10 @@ void sga::evolve(population &pop) const
 	}
 	// Some vectors used during evolution are allocated here.
 	decision_vector dummy(D,0);			//used for initialisation purposes
-	std::vector<decision_vector > X(NP,dummy), Xnew(NP,dummy);
+	std::vector<decision_vector > X(NP,dummy), Xnew(NP,dummy), V(NP,dummy);
 
 	std::vector<fitness_vector > fit(NP);		//fitness
+	const std::vector<constraint_vector> c(NP);	//constraints (the problem is box constrained)
 
 	fitness_vector bestfit;
 	decision_vector bestX(D,0);
@@ -304,15 +305,14 @@ void sga::evolve(population &pop) const
 			
 			// We re-evaluate the best individual (for elitism)
 			prob.objfun(bestfit,bestX);
-			// Re-evaluate wrt new seed the particle position and memory
+			// Re-evaluate wrt new seed the particle position and memory. We evaluate here the new individuals fitness
+			prob.batch_objfun(fit,Xnew);
 			for (pagmo::population::size_type i = 0; i < NP;i++) {
-				// We evaluate here the new individual fitness
-				prob.objfun(fit[i],Xnew[i]);
 				// We update the velocity (in case coupling with PSO via archipelago)
 				//dummy = Xnew[i];
 				//std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
 				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(Xnew[i]);
+				pop.push_back(Xnew[i],fit[i],c[i]);
 				//pop.set_v(i,dummy);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
@@ -323,13 +323,14 @@ void sga::evolve(population &pop) const
 		catch (const std::bad_cast& e)
 		{
 			//4 - Evaluate the new population (deterministic problem)
+			prob.batch_objfun(fit,Xnew);
 			for (pagmo::population::size_type i = 0; i < NP;i++) {
-				prob.objfun(fit[i],Xnew[i]);
-				dummy = Xnew[i];
-				std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function and constraints)
-				pop.set_x(i,Xnew[i]);
-				pop.set_v(i,dummy);
+				std::transform(Xnew[i].begin(), Xnew[i].end(), pop.get_individual(i).cur_x.begin(), V[i].begin(),std::minus<double>());
+			}
+			//updates x (with the fitness just computed) and v
+			pop.replace_generation(Xnew,fit,c);
+			for (pagmo::population::size_type i = 0; i < NP;i++) {
+				pop.set_v(i,V[i]);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
 					bestX = Xnew[i];
@@ -347,8 +348,8 @@ void sga::evolve(population &pop) const
 			fit[worst] = bestfit;
 			dummy = Xnew[worst];
 			std::transform(dummy.begin(), dummy.end(), pop.get_individual(worst).cur_x.begin(), dummy.begin(),std::minus<double>());
-			//updates x and v (cache avoids to recompute the objective function)
-			pop.set_x(worst,Xnew[worst]);
+			//updates x (bestfit is its fitness) and v
+			pop.set_x(worst,Xnew[worst],fit[worst],c[worst]);
 			pop.set_v(worst,dummy);
 		}
 		X = Xnew;
@@ -84,7 +84,7 @@ sms_emoa::sms_emoa(const sms_emoa &orig) : base(),m_gen(orig.m_gen),m_sel_m(orig
  * @param[in] eta_c Distribution index for crossover
  * @param[in] m Mutation probability
  * @param[in] eta_m Distribution index for mutation
- * @param[in] hv_algorithm Hypervolume algorithm used for the computation of the least contributor
+ * @param[in] hv_algorithm Hypervolume algorithm used for the computation of the least contributor (e.g. pagmo::util::hv_algorithm::adaptive, to bound its cost on many objectives)
  * @throws value_error if gen is negative, crossover probability is not \f$ \in [0,1[\f$, mutation probability or mutation width is not \f$ \in [0,1]\f$,
  */
 sms_emoa::sms_emoa(pagmo::util::hv_algorithm::base_ptr hv_algorithm, int gen, int sel_m, double cr, double eta_c, double m, double eta_m):base(),
@@ -283,7 +283,9 @@ void sms_emoa::mutate(decision_vector& child, const pagmo::population& pop) cons
 }
 
 // Find the index of the least contributing individual
-population::size_type sms_emoa::evaluate_s_metric_selection(const population & pop) const
+// The tracker keeps the contributions of the last front across generations, so that only the contributions affected
+// by the points entering or leaving the front are recomputed.
+population::size_type sms_emoa::evaluate_s_metric_selection(const population & pop, pagmo::util::contribution_tracker &tracker) const
 {
 
 	std::vector< std::vector< population::size_type> > fronts = pop.compute_pareto_fronts();
@@ -306,15 +308,13 @@ population::size_type sms_emoa::evaluate_s_metric_selection(const population & p
 		pagmo::util::hypervolume hypvol(points);
 		fitness_vector r = hypvol.get_nadir_point(1.0);
 
-		population::size_type least_idx;
-
+		// A user-defined algorithm (possibly an approximated one) answers the least contributor query directly,
+		// the exact contributions are otherwise maintained incrementally by the tracker.
 		if (m_hv_algorithm) {
-			least_idx = hypvol.least_contributor(r, m_hv_algorithm);
-		} else {
-			least_idx = hypvol.least_contributor(r);
+			return last_front[hypvol.least_contributor(r, m_hv_algorithm)];
 		}
-
-		return last_front[least_idx];
+		tracker.assign(points, r);
+		return last_front[tracker.least_contributor()];
 	} else { // if m_sel_m == 2 && fronts.size() > 1
 		population::size_type max_dom_count = 0;
 		population::size_type individual_idx = 0;
@@ -361,6 +361,7 @@ void sms_emoa::evolve(population &pop) const
 	
 	population::size_type parent1_idx, parent2_idx;
 	decision_vector child1(D), child2(D);
+	pagmo::util::contribution_tracker tracker;
 	
 	// Main SMS-EMOA loop
 	for (int g = 0; g < m_gen; g++) {
@@ -372,7 +373,8 @@ void sms_emoa::evolve(population &pop) const
 		++m_fevals;
 		mutate(child1, pop);
 		pop.push_back(child1);
-		pop.erase(evaluate_s_metric_selection(pop));
+		// The order of the individuals is irrelevant here, so the last individual can fill the hole.
+		pop.erase_unordered(evaluate_s_metric_selection(pop, tracker));
 	}
 }
 
@@ -60,7 +60,7 @@ private:
 	void validate_parameters();
 	void crossover(decision_vector&, decision_vector&, pagmo::population::size_type, pagmo::population::size_type,const pagmo::population&) const;
 	void mutate(decision_vector&, const pagmo::population&) const;
-	population::size_type evaluate_s_metric_selection(const population & pop) const;
+	population::size_type evaluate_s_metric_selection(const population & pop, pagmo::util::contribution_tracker &) const;
 	
 	friend class boost::serialization::access;
 	template <class Archive>
@@ -22,14 +22,16 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/function.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
-#include <boost/thread/barrier.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_io.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <algorithm>
 #include <cstddef>
+#include <deque>
 #include <iostream>
 #include <iterator>
 #include <sstream>
@@ -65,9 +67,9 @@ void archipelago::check_migr_attributes() const
  * @param[in] dt distribution type.
  * @param[in] md migration direction.
  */
-archipelago::archipelago(distribution_type dt, migration_direction md):m_islands_sync_point(),m_topology(new topology::unconnected()),
+archipelago::archipelago(distribution_type dt, migration_direction md):m_topology(new topology::unconnected()),
 	m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_slots(),m_island_index(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_hist_mutex(),m_migr_hist(),m_hist_mode(history_full),m_hist_capacity(0),m_threads(0),m_pool()
 {
 	check_migr_attributes();
 }
@@ -82,8 +84,8 @@ archipelago::archipelago(distribution_type dt, migration_direction md):m_islands
  * @param[in] md migration direction.
  */
 archipelago::archipelago(const topology::base &t, distribution_type dt, migration_direction md):
-	m_islands_sync_point(),m_topology(),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_topology(),m_dist_type(dt),m_migr_dir(md),
+	m_slots(),m_island_index(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_hist_mutex(),m_migr_hist(),m_hist_mode(history_full),m_hist_capacity(0),m_threads(0),m_pool()
 {
 	// NOTE: we cannot set the topology in the initialiser list directly,
 	// since we do not know if the topology is suitable. Set it here.
@@ -105,8 +107,8 @@ archipelago::archipelago(const topology::base &t, distribution_type dt, migratio
  * @param[in] md migration direction.
  */
 archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n, int m, const topology::base &t, distribution_type dt, migration_direction md):
-	m_islands_sync_point(),m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
+	m_slots(),m_island_index(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_hist_mutex(),m_migr_hist(),m_hist_mode(history_full),m_hist_capacity(0),m_threads(0),m_pool()
 {
 	check_migr_attributes();
 	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
@@ -123,7 +125,7 @@ archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n
  *
  * @param[in] a archipelago to be copied.
  */
-archipelago::archipelago(const archipelago &a)
+archipelago::archipelago(const archipelago &a):m_threads(0),m_pool()
 {
 	a.join();
 	// Deep copy from islands pointers.
@@ -134,10 +136,17 @@ archipelago::archipelago(const archipelago &a)
 	m_topology = a.m_topology->clone();
 	m_dist_type = a.m_dist_type;
 	m_migr_dir = a.m_migr_dir;
-	m_migr_map = a.m_migr_map;
+	// Deep copy of the migration slots.
+	for (size_type i = 0; i < a.m_slots.size(); ++i) {
+		m_slots.push_back(slot_ptr(new migration_slot(*a.m_slots[i])));
+	}
 	m_drng = a.m_drng;
 	m_urng = a.m_urng;
 	m_migr_hist = a.m_migr_hist;
+	m_hist_mode = a.m_hist_mode;
+	m_hist_capacity = a.m_hist_capacity;
+	m_threads = a.m_threads;
+	rebuild_migration_index();
 }
 
 /// Assignment operator.
@@ -162,10 +171,19 @@ archipelago &archipelago::operator=(const archipelago &a)
 		m_topology = a.m_topology->clone();
 		m_dist_type = a.m_dist_type;
 		m_migr_dir = a.m_migr_dir;
-		m_migr_map = a.m_migr_map;
+		// Deep copy of the migration slots.
+		m_slots.clear();
+		for (size_type i = 0; i < a.m_slots.size(); ++i) {
+			m_slots.push_back(slot_ptr(new migration_slot(*a.m_slots[i])));
+		}
 		m_drng = a.m_drng;
 		m_urng = a.m_urng;
 		m_migr_hist = a.m_migr_hist;
+		m_hist_mode = a.m_hist_mode;
+		m_hist_capacity = a.m_hist_capacity;
+		m_threads = a.m_threads;
+		m_pool.reset(0);
+		rebuild_migration_index();
 	}
 	return *this;
 }
@@ -194,17 +212,71 @@ void archipelago::join() const
 
 archipelago::size_type archipelago::locate_island(const base_island &isl) const
 {
-	// TODO: iterate and increase a size type instead of using distance(), which returns a signed int.
-	// Also, assert the island is actually found here?
-	// TODO: also, this can be optimized with a hash table, if needed: build it at the beginning
-	// of the evolution, and destroy it at the end.
-	const_iterator it = m_container.begin();
-	for (; it != m_container.end(); ++it) {
-		if (&(*(*it)) == &isl) {
-			break;
+	// NOTE: the index is only modified while the archipelago is joined, so it can be read
+	// concurrently by the evolving islands.
+	const boost::unordered_map<const base_island *,size_type>::const_iterator it = m_island_index.find(&isl);
+	pagmo_assert(it != m_island_index.end());
+	return it->second;
+}
+
+// Rebuild the index of the islands and make sure there is one migration slot per island.
+// Do NOT use it if the archipelago has not been joined!
+void archipelago::rebuild_migration_index()
+{
+	m_island_index.clear();
+	for (size_type i = 0; i < m_container.size(); ++i) {
+		m_island_index[m_container[i].get()] = i;
+	}
+	while (m_slots.size() < m_container.size()) {
+		m_slots.push_back(new_slot());
+	}
+	m_slots.resize(m_container.size());
+}
+
+// Create an empty migration slot, whose rngs are seeded from the archipelago's rngs.
+archipelago::slot_ptr archipelago::new_slot()
+{
+	slot_ptr retval(new migration_slot());
+	retval->m_drng.seed(m_urng());
+	retval->m_urng.seed(m_urng());
+	return retval;
+}
+
+// Collect the content of the migration slots into a migration map (see migration_map_type).
+void archipelago::get_migration_map(migration_map_type &migr_map) const
+{
+	migr_map.clear();
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		lock_type lock(m_slots[i]->m_mutex);
+		if (m_slots[i]->m_inbox.size()) {
+			migr_map[i] = m_slots[i]->m_inbox;
+		}
+		if (m_slots[i]->m_outbox) {
+			migr_map[i][i] = *m_slots[i]->m_outbox;
+		}
+	}
+}
+
+// Fill the migration slots from a migration map.
+void archipelago::set_migration_map(const migration_map_type &migr_map)
+{
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		m_slots[i]->m_inbox.clear();
+		m_slots[i]->m_outbox.reset();
+	}
+	for (migration_map_type::const_iterator it = migr_map.begin(); it != migr_map.end(); ++it) {
+		if (it->first >= m_slots.size()) {
+			continue;
+		}
+		if (m_migr_dir == destination) {
+			const boost::unordered_map<size_type,emigrants_type>::const_iterator own = it->second.find(it->first);
+			if (own != it->second.end()) {
+				m_slots[it->first]->m_outbox.reset(new emigrants_type(own->second));
+			}
+		} else {
+			m_slots[it->first]->m_inbox = it->second;
 		}
 	}
-	return std::distance(m_container.begin(),it);
 }
 
 /// Add an island to the archipelago.
@@ -225,6 +297,7 @@ void archipelago::push_back(const base_island &isl)
 	m_container.push_back(isl.clone());
 	// Tell the island that it is living in an archipelago now.
 	m_container.back()->m_archi = this;
+	rebuild_migration_index();
 	// Insert the island in the topology.
 	m_topology->push_back();
 }
@@ -340,15 +413,27 @@ bool archipelago::check_island(const base_island &isl) const
 	return true;
 }
 
-// Reset island synchronisation barrier. This method is intended as a shortcut,
-// do NOT use it if the archipelago has not been joined!
-void archipelago::reset_barrier(const size_type &size)
+// Make sure that the thread pool has n threads, so that at most n islands evolve concurrently (or that it has the number of threads
+// requested via set_threads()). Do NOT use it if the archipelago has not been joined!
+void archipelago::init_pool(const size_type &n)
 {
-	if (size) {
-		m_islands_sync_point.reset(new boost::barrier(boost::numeric_cast<unsigned int>(size)));
+	const unsigned int n_threads = m_threads ? m_threads : boost::numeric_cast<unsigned int>(std::max<size_type>(n,1));
+	if (!m_pool || m_pool->get_size() != n_threads) {
+		// Join the old workers before starting the new ones.
+		m_pool.reset(0);
+		m_pool.reset(new thread_pool(n_threads));
 	}
 }
 
+// Submit an island evolution to the thread pool.
+thread_pool::task archipelago::submit(const boost::function<void ()> &f)
+{
+	if (!m_pool) {
+		init_pool(m_container.size());
+	}
+	return m_pool->submit(f);
+}
+
 // Return true if all islands in the archipelago have a m_archi pointer to this and the shared pointer count is 1, false otherwise. Used for debugging.
 bool archipelago::destruction_checks() const
 {
@@ -405,8 +490,40 @@ void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_t
  * @param[in] seed Seed for generating pseudo-random sequences
  */
 void archipelago::set_seeds(unsigned int seed) {
+	join();
 	m_drng.seed(seed);
 	m_urng.seed(seed+1); // we do not care if it overflows
+	// The migration rngs of the islands are derived from the archipelago's ones.
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		m_slots[i]->m_drng.seed(m_urng());
+		m_slots[i]->m_urng.seed(m_urng());
+	}
+}
+
+/// Get the number of worker threads.
+/**
+ * @return the number of worker threads requested via set_threads(), or zero if the archipelago uses one thread per island.
+ */
+unsigned int archipelago::get_threads() const
+{
+	return m_threads;
+}
+
+/// Set the number of worker threads.
+/**
+ * Set the number of worker threads of the pool running the islands' evolutions. If n is smaller than the number of islands,
+ * the evolutions of the islands will be queued and at most n islands will evolve at the same time. If n is zero (the default),
+ * the pool will have as many threads as islands (or as the batch size in evolve_batch()).
+ *
+ * Will call join() before changing the pool.
+ *
+ * @param[in] n number of worker threads.
+ */
+void archipelago::set_threads(unsigned int n)
+{
+	join();
+	m_threads = n;
+	m_pool.reset(0);
 }
 
 
@@ -423,28 +540,32 @@ void archipelago::pre_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	// The island's slot. Its rngs are used only by the island's own migrations, hence they need no lock.
+	migration_slot &slot = *m_slots[isl_idx];
 	//1. Obtain immigrants.
 	std::vector<std::pair<population::size_type, individual_type> > immigrants;
 	switch (m_migr_dir) {
 		case source:
 		{
-			lock_type lock(m_migr_mutex);
-			// For source migration direction, migration map contains islands' "inboxes". Or, in other words, it contains
+			// For source migration direction, the slots contain islands' "inboxes". Or, in other words, they contain
 			// the individuals that are destined to go into the island. Such inboxes have been assembled previously,
 			// during a post_evolution operation.
+			// Take the content of the inbox, leaving it empty for the next migrations.
+			boost::unordered_map<size_type,emigrants_type> inbox;
+			{
+				lock_type lock(slot.m_mutex);
+				inbox.swap(slot.m_inbox);
+			}
 			// Iterate over all the vectors of individuals provided by the different islands.
-			for (boost::unordered_map<size_type,std::vector<individual_type> >::iterator it = m_migr_map[isl_idx].begin();
-				it != m_migr_map[isl_idx].end(); ++it)
+			for (boost::unordered_map<size_type,emigrants_type>::iterator it = inbox.begin(); it != inbox.end(); ++it)
 			{
 				pagmo_assert(it->first < m_container.size());
 				build_immigrants_vector(immigrants,*m_container[it->first],isl,it->second);
 			}
-			// Delete stuff in the migration map.
-			m_migr_map.erase(isl_idx);
 			break;
 		}
 		case destination:
-			// For destination migration direction, items in the migration map behave like "outboxes", i.e. each one is a
+			// For destination migration direction, the slots behave like "outboxes", i.e. each one is a
 			// "database of best individuals" seen in the islands of the archipelago.
 			// Get neighbours connecting into isl.
 			const std::vector<topology::base::vertices_size_type> inv_adj_islands(m_topology->get_v_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
@@ -453,24 +574,25 @@ void archipelago::pre_evolution(base_island &isl)
 				switch (m_dist_type) {
 					case point_to_point:
 					{
-						lock_type lock(m_migr_mutex);
 						// Get the index of a random island connecting into isl.
 						boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,inv_adj_islands.size() - 1);
-						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(m_urng)]);
-						// Get the immigrants from the outbox of the random island. Note the redundant information in the last
-						// argument of the function.
-						pagmo_assert(m_migr_map[rn_isl_idx].size() <= 1);
-						build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,m_migr_map[rn_isl_idx][rn_isl_idx]);
+						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(slot.m_urng)]);
+						// Get the immigrants from the outbox of the random island.
+						const boost::shared_ptr<const emigrants_type> outbox = get_outbox(rn_isl_idx);
+						if (outbox) {
+							build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,*outbox);
+						}
 						break;
 					}
 					case broadcast:
 					{
-						lock_type lock(m_migr_mutex);
 						// For broadcast migration fetch immigrants from all neighbour islands' databases.
 						for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < inv_adj_islands.size(); ++i) {
 							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[i]);
-							pagmo_assert(m_migr_map[src_isl_idx].size() <= 1);
-							build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,m_migr_map[src_isl_idx][src_isl_idx]);
+							const boost::shared_ptr<const emigrants_type> outbox = get_outbox(src_isl_idx);
+							if (outbox) {
+								build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,*outbox);
+							}
 						}
 					}
 				}
@@ -478,12 +600,7 @@ void archipelago::pre_evolution(base_island &isl)
 	}
 	//2. Insert immigrants into population.
 	if (immigrants.size()) {
-		double next_rng;
-		{
-			lock_type lock(m_migr_mutex);
-			next_rng = m_drng();
-		}
-		if (next_rng < isl.m_migr_prob) {
+		if (slot.m_drng() < isl.m_migr_prob) {
 			// We re-evaluate the incoming individuals according
 			// to destination island's problem. This will make sure that stochastic problems
 			// are correctly dealt with
@@ -491,19 +608,51 @@ void archipelago::pre_evolution(base_island &isl)
 			// We then insert the incoming individuals into the population, storing how many from where
 			std::vector<std::pair<population::size_type, size_type> > rec_history;
 			rec_history = isl.accept_immigrants(immigrants);
-			lock_type lock(m_migr_mutex);
-			// Record the migration history.
-			for (size_t i =0; i< rec_history.size(); ++i) {
+			record_migr_history(rec_history,slot,isl_idx);
+		}
+	}
+}
+
+// Record the immigrants accepted by an island in the migration history, according to the history mode.
+void archipelago::record_migr_history(const std::vector<std::pair<population::size_type, size_type> > &rec_history, migration_slot &slot, const size_type &isl_idx)
+{
+	switch (m_hist_mode) {
+		case history_off:
+			break;
+		case history_aggregate:
+			// The counters live in the destination island's slot, which is only touched by the island itself.
+			for (size_t i = 0; i < rec_history.size(); ++i) {
+				slot.m_hist_counts[rec_history[i].second] += rec_history[i].first;
+			}
+			break;
+		case history_full:
+		case history_ring:
+		{
+			lock_type lock(m_hist_mutex);
+			for (size_t i = 0; i < rec_history.size(); ++i) {
 				m_migr_hist.push_back( boost::make_tuple(
 					rec_history[i].first,
 					rec_history[i].second,
-					locate_island(isl) )
+					isl_idx )
 				);
 			}
+			if (m_hist_mode == history_ring) {
+				while (m_migr_hist.size() > m_hist_capacity) {
+					m_migr_hist.pop_front();
+				}
+			}
 		}
 	}
 }
 
+// Get the current outbox snapshot of an island. The snapshot is never modified after its publication, so it can
+// be read after the lock has been released.
+boost::shared_ptr<const archipelago::emigrants_type> archipelago::get_outbox(const size_type &idx) const
+{
+	lock_type lock(m_slots[idx]->m_mutex);
+	return m_slots[idx]->m_outbox;
+}
+
 // This method will be called after each island isl has completed an evolution. Its purpose is to get individuals
 // emigrating from isl and put them at disposal of the other islands of the archipelago, according to the migration attributes
 // and the topology.
@@ -516,36 +665,36 @@ void archipelago::post_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
-	// Create the vector of emigrants.
-	std::vector<individual_type> emigrants;
+	migration_slot &slot = *m_slots[isl_idx];
 	switch (m_migr_dir) {
 		case source:
 		{
 			// Get the islands to which isl connects.
 			const std::vector<topology::base::vertices_size_type> adj_islands(m_topology->get_v_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
 			if (adj_islands.size()) {
-				emigrants = isl.get_emigrants();
+				const emigrants_type emigrants = isl.get_emigrants();
 				// Do something only if we have emigrants.
 				if (emigrants.size()) {
 					switch (m_dist_type)
 					{
 						case point_to_point:
 						{
-							lock_type lock(m_migr_mutex);
 							// For one-to-one migration choose a random neighbour island and put immigrants to its inbox.
 							boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,adj_islands.size() - 1);
-							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(m_urng)]);
-							m_migr_map[chosen_adj][isl_idx].insert(m_migr_map[chosen_adj][isl_idx].end(),emigrants.begin(),emigrants.end());
+							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(slot.m_urng)]);
+							lock_type lock(m_slots[chosen_adj]->m_mutex);
+							emigrants_type &box = m_slots[chosen_adj]->m_inbox[isl_idx];
+							box.insert(box.end(),emigrants.begin(),emigrants.end());
 							break;
 						}
 						case broadcast:
 						{
-							lock_type lock(m_migr_mutex);
-							// For broadcast migration put immigrants to all neighbour islands' inboxes.
+							// For broadcast migration put immigrants to all neighbour islands' inboxes, locking one inbox at a time.
 							for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < adj_islands.size(); ++i) {
-								m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx]
-									.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx].end(),
-									emigrants.begin(),emigrants.end());
+								migration_slot &dest = *m_slots[boost::numeric_cast<size_type>(adj_islands[i])];
+								lock_type lock(dest.m_mutex);
+								emigrants_type &box = dest.m_inbox[isl_idx];
+								box.insert(box.end(),emigrants.begin(),emigrants.end());
 							}
 						}
 					}
@@ -555,11 +704,11 @@ void archipelago::post_evolution(base_island &isl)
 		}
 		case destination:
 		{
-			// For destination migration direction, migration map behaves like "outboxes", i.e. each is a "database of best individuals" for corresponding island.
-			emigrants = isl.get_emigrants();
-			lock_type lock(m_migr_mutex);
-			pagmo_assert(m_migr_map[isl_idx].size() <= 1);
-			m_migr_map[isl_idx][isl_idx].swap(emigrants);
+			// For destination migration direction, the slots behave like "outboxes", i.e. each is a "database of best individuals" for corresponding island.
+			// The new snapshot is built outside the lock and then published by swapping the pointer.
+			boost::shared_ptr<const emigrants_type> outbox(new emigrants_type(isl.get_emigrants()));
+			lock_type lock(slot.m_mutex);
+			slot.m_outbox.swap(outbox);
 		}
 	}
 }
@@ -574,8 +723,7 @@ void archipelago::evolve(int n)
 {
 	join();
 	const iterator it_f = m_container.end();
-	// Reset thread barrier.
-	reset_barrier(m_container.size());
+	init_pool(m_container.size());
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
 		(*it)->evolve(n);
 	}
@@ -583,17 +731,23 @@ void archipelago::evolve(int n)
 
 /// Run the evolution for the given number of iterations in batches
 /**
- * Will iteratively call island::evolve(n) on batches of b islands of the archipelago and then return.
- * Each batch will wait to complete the n evolves before ending. It is typically called with n=1 as 
- * for n>1 this set-up creates a strange effect on the migration flux (the first batch that evolves does not
- * make use of the islands in the remaining batches)
+ * Will call island::evolve(n) on all the islands of the archipelago, in random order, allowing at most b of them to evolve
+ * at the same time, and then return: unless a number of threads has been set via set_threads(), the thread pool will have b worker
+ * threads, and an island starts evolving as soon as one of the running ones has completed its n evolves. It is typically called with n=1 as
+ * for n>1 this set-up creates a strange effect on the migration flux (the first islands that evolve do not
+ * make use of the islands that are still queued)
  *
  * \param[in] n number of time each island will be evolved.
  * \param[in] b the size of the batch of islands to evolve at the same time.
+ *
+ * @throws value_error if b is zero.
  */
 void archipelago::evolve_batch(int n, unsigned int b)
 {
 	join();
+	if (!b) {
+		pagmo_throw(value_error,"the batch size must be strictly positive");
+	}
 	container_type::size_type arch_size = this->get_size();
 	// Variate generators
 	boost::uniform_int<int> pop_idx(0,arch_size-1);
@@ -603,19 +757,12 @@ void archipelago::evolve_batch(int n, unsigned int b)
 	for(population::size_type i=0; i < shuffle.size(); ++i) shuffle[i] = i;
 	std::random_shuffle(shuffle.begin(), shuffle.end(), p_idx);
 	
-	for(size_type p = 0; p < arch_size/b + 1; ++p) {
-		if(p == arch_size/b) { //for the last batch of islands decrease the barrier
-			reset_barrier(arch_size - p*b);
-		} else {
-			reset_barrier(b);
-		}
-		for(size_type i=0; i<b && p*b+i < arch_size; ++i) {
-			m_container[shuffle[p*b+i]]->evolve(n);
-		}
-		for(size_type i=0; i<b && p*b+i < arch_size; ++i) {
-			m_container[shuffle[p*b+i]]->join();
-		}
+	// The size of the pool bounds the number of islands evolving at the same time.
+	init_pool(std::min<size_type>(b,arch_size));
+	for(size_type i = 0; i < arch_size; ++i) {
+		m_container[shuffle[i]]->evolve(n);
 	}
+	join();
 }
 
 /// Run the evolution for a minimum amount of time.
@@ -628,7 +775,7 @@ void archipelago::evolve_t(int t)
 {
 	join();
 	const iterator it_f = m_container.end();
-	reset_barrier(m_container.size());
+	init_pool(m_container.size());
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
 		(*it)->evolve_t(t);
 	}
@@ -701,6 +848,7 @@ void archipelago::set_island(const size_type &idx, const base_island &isl)
 	m_container[idx] = isl.clone();
 	// Tell the island that it is living in an archipelago now.
 	m_container[idx]->m_archi = this;
+	rebuild_migration_index();
 }
 
 /// Get vector of islands in the archipelago.
@@ -719,15 +867,12 @@ std::vector<base_island_ptr> archipelago::get_islands() const
 	return retval;
 }
 
-// Synchronise the start of evolution in each island so that all threads are created and initialised
-// before actually doing any computation.
-void archipelago::sync_island_start() const
-{
-	m_islands_sync_point->wait();
-}
-
 /// Dumps the archipelago migration history
 /**
+ * In history_aggregate mode, there is one item per (source,destination) pair, sorted by destination and source,
+ * where x is the total number of individuals accepted so far along the edge. In history_ring mode, only the most recent
+ * migrations are returned. In history_off mode, the returned string is empty.
+ *
  * @return A string formatted as follows: (x1,y1,z1)\n(x2,y2,z2)..... where x is the number of individuals
  * accepted in island z and coming from island y
  */
@@ -735,6 +880,19 @@ std::string archipelago::dump_migr_history() const
 {
 	join();
 	std::ostringstream oss;
+	if (m_hist_mode == history_aggregate) {
+		for (size_type i = 0; i < m_slots.size(); ++i) {
+			std::vector<std::pair<size_type,population::size_type> > counts(m_slots[i]->m_hist_counts.begin(),m_slots[i]->m_hist_counts.end());
+			std::sort(counts.begin(),counts.end());
+			for (size_type j = 0; j < counts.size(); ++j) {
+				oss << "(" << counts[j].second
+					<< "," << counts[j].first
+					<< "," << i << ")"
+					<< '\n';
+			}
+		}
+		return oss.str();
+	}
 	for (migr_hist_type::const_iterator it = m_migr_hist.begin(); it != m_migr_hist.end(); ++it) {
 		oss << "(" << (*it).get<0>()
 			<< "," << (*it).get<1>()
@@ -753,6 +911,51 @@ void archipelago::clear_migr_history()
 {
 	join();
 	m_migr_hist.clear();
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		m_slots[i]->m_hist_counts.clear();
+	}
+}
+
+/// Set the migration history mode.
+/**
+ * The default mode is history_full, which records every accepted migration. For long runs, history_ring bounds the
+ * memory used by the history to the given number of items, while history_aggregate only keeps a counter per
+ * (source,destination) edge. Changing the mode clears the history.
+ *
+ * @param[in] mode new migration history mode.
+ * @param[in] capacity maximum number of items recorded in history_ring mode (ignored by the other modes).
+ *
+ * @throws value_error if the mode is history_ring and the capacity is zero, or if the mode is invalid.
+ */
+void archipelago::set_migr_history(migr_history_mode mode, size_type capacity)
+{
+	if (mode < history_off || mode > history_aggregate) {
+		pagmo_throw(value_error,"invalid migration history mode");
+	}
+	if (mode == history_ring && !capacity) {
+		pagmo_throw(value_error,"the capacity of the migration history must be strictly positive");
+	}
+	clear_migr_history();
+	m_hist_mode = mode;
+	m_hist_capacity = (mode == history_ring) ? capacity : 0;
+}
+
+/// Get the migration history mode.
+/**
+ * @return the current migration history mode.
+ */
+archipelago::migr_history_mode archipelago::get_migr_history_mode() const
+{
+	return m_hist_mode;
+}
+
+/// Get the migration history capacity.
+/**
+ * @return the maximum number of items recorded in history_ring mode, zero in the other modes.
+ */
+archipelago::size_type archipelago::get_migr_history_capacity() const
+{
+	return m_hist_capacity;
 }
 
 /// Overload stream operator for pagmo::archipelago.
@@ -25,13 +25,15 @@
 #ifndef PAGMO_ARCHIPELAGO_H
 #define PAGMO_ARCHIPELAGO_H
 
+#include <boost/function.hpp>
 #include <boost/scoped_ptr.hpp>
-#include <boost/thread/barrier.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/serialization/map.hpp>
 #include <boost/unordered_map.hpp>
+#include <deque>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -44,6 +46,7 @@
 #include "problem/base.h"
 #include "rng.h"
 #include "serialization.h"
+#include "thread_pool.h"
 #include "topology/base.h"
 #include "topology/unconnected.h"
 
@@ -51,6 +54,15 @@ namespace pagmo {
 
 /// Archipelago class.
 /**
+ * Island evolutions are run as tasks by a thread pool owned by the archipelago. By default the pool has as many worker threads as islands,
+ * so that all islands evolve concurrently. The number of worker threads can be limited via set_threads(): this avoids oversubscribing the
+ * machine when the archipelago contains many more islands than available cores. The pool is created upon the first evolution and its threads
+ * are reused by the following ones.
+ *
+ * Migration does not go through a global lock: each island has its own migration slot (an inbox or an outbox, depending on the
+ * migration direction) with its own mutex and rngs, so that islands exchanging individuals with different neighbours do not contend.
+ * The seeds of the islands' rngs are derived from the archipelago's ones (see set_seeds()).
+ *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
  */
@@ -105,21 +117,65 @@ class __PAGMO_VISIBLE archipelago
 			 */
 			destination = 1
 		};
+		/// Migration history recording mode.
+		/**
+		 * Controls what the archipelago records about the accepted migrations, and hence what dump_migr_history() returns.
+		 */
+		enum migr_history_mode
+		{
+			/// No history is recorded.
+			history_off = 0,
+			/// Every accepted migration is recorded. Memory usage grows with the number of migrations.
+			history_full = 1,
+			/// Only the most recent accepted migrations are recorded, up to a given capacity.
+			history_ring = 2,
+			/// The number of individuals migrated along each (source,destination) edge is accumulated.
+			/**
+			 * Memory usage is bounded by the number of edges of the topology, and the counters are kept per destination island, so that
+			 * updating them requires no lock. This mode is cheap enough to be left on in long runs.
+			 */
+			history_aggregate = 3
+		};
 	private:
 		// Iterators.
 		typedef container_type::iterator iterator;
 		typedef container_type::const_iterator const_iterator;
-		// Container for migrating individuals. This a hash map containing hash maps as values.
+		// Vector of emigrants.
+		typedef std::vector<individual_type> emigrants_type;
+		// Container for migrating individuals, as it is exchanged with archives. This a hash map containing hash maps as values.
 		// Please NOTE carefully: in case of desination migration, item n in the outer hash map is supposed to contain a hash map with a single
 		// (n,emigrants vector) pair (in other words, containing redundantly n twice). In case of source migration, item n will contain a map of
 		// emigrants from other islands.
-		typedef boost::unordered_map<size_type,boost::unordered_map<size_type,std::vector<individual_type> > > migration_map_type;
+		typedef boost::unordered_map<size_type,boost::unordered_map<size_type,emigrants_type> > migration_map_type;
 		// Lock type.
 		typedef boost::lock_guard<boost::mutex> lock_type;
+		// Migration slot of an island.
+		// Each island owns the inbox (source migration) or the outbox (destination migration) through which
+		// migration flows, protected by a mutex of its own, and the rngs used during its migrations. The outbox
+		// is an immutable snapshot: it is replaced as a whole by the owner after each evolution, and the readers
+		// just grab a reference to the current snapshot and build their immigrants without holding any lock.
+		struct migration_slot
+		{
+			migration_slot() {}
+			migration_slot(const migration_slot &other):m_inbox(other.m_inbox),m_outbox(other.m_outbox),
+				m_hist_counts(other.m_hist_counts),m_drng(other.m_drng),m_urng(other.m_urng) {}
+			// Individuals sent to the island by the other islands, indexed by origin.
+			boost::unordered_map<size_type,emigrants_type>	m_inbox;
+			// Last individuals made available by the island.
+			boost::shared_ptr<const emigrants_type>		m_outbox;
+			// Number of individuals accepted by the island, indexed by origin (history_aggregate mode).
+			boost::unordered_map<size_type,population::size_type>	m_hist_counts;
+			// Rngs used by the migrations of the island.
+			rng_double					m_drng;
+			rng_uint32					m_urng;
+			// Protects m_inbox and the m_outbox pointer.
+			boost::mutex					m_mutex;
+		};
+		typedef boost::shared_ptr<migration_slot> slot_ptr;
 		// Migration history item: (n_individuals,orig_island,dest_island) tuple.
 		typedef boost::tuple<population::size_type,size_type,size_type> migr_hist_item;
-		// Container of migration history: vector of history items.
-		typedef std::vector<migr_hist_item> migr_hist_type;
+		// Container of migration history: deque of history items, so that the oldest items can be dropped in history_ring mode.
+		typedef std::deque<migr_hist_item> migr_hist_type;
 	public:
 		explicit archipelago(distribution_type = point_to_point, migration_direction = destination);
 		explicit archipelago(const topology::base &, distribution_type = point_to_point, migration_direction = destination);
@@ -143,74 +199,120 @@ class __PAGMO_VISIBLE archipelago
 		void interrupt();
 		std::string dump_migr_history() const;
 		void clear_migr_history();
+		void set_migr_history(migr_history_mode, size_type = 0);
+		migr_history_mode get_migr_history_mode() const;
+		size_type get_migr_history_capacity() const;
 		void set_island(const size_type &, const base_island &);
 		std::vector<base_island_ptr> get_islands() const;
 		base_island_ptr get_island(const size_type &) const;
 		void set_seeds(unsigned int);
+		unsigned int get_threads() const;
+		void set_threads(unsigned int);
 	private:
 		void pre_evolution(base_island &);
 		void post_evolution(base_island &);
-		void reset_barrier(const size_type &);
+		void init_pool(const size_type &);
+		thread_pool::task submit(const boost::function<void ()> &);
 		void build_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &,
 			const base_island &, base_island &,
 			const std::vector<individual_type> &) const;
 		void check_migr_attributes() const;
-		void sync_island_start() const;
 		size_type locate_island(const base_island &) const;
+		void rebuild_migration_index();
+		slot_ptr new_slot();
+		void get_migration_map(migration_map_type &) const;
+		void set_migration_map(const migration_map_type &);
+		boost::shared_ptr<const emigrants_type> get_outbox(const size_type &) const;
+		void record_migr_history(const std::vector<std::pair<population::size_type, size_type> > &, migration_slot &, const size_type &);
 		bool destruction_checks() const;
 		void reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &,
 			const base_island &) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int version)
+		void save(Archive &ar, const unsigned int) const
 		{
 			join();
-			ar & m_container;
-			ar & m_topology;
-			ar & m_dist_type;
-			ar & m_migr_dir;
-			ar & m_migr_map;
-			ar & m_drng;
-			ar & m_urng;
+			ar << m_container;
+			ar << m_topology;
+			ar << m_dist_type;
+			ar << m_migr_dir;
+			// The migration slots are archived in the format of the former single migration map.
+			migration_map_type migr_map;
+			get_migration_map(migr_map);
+			ar << migr_map;
+			ar << m_drng;
+			ar << m_urng;
+			ar << m_threads;
+			ar << m_hist_mode;
+			ar << m_hist_capacity;
 			// NOTE: this would need tuple serialization...
 			//ar & m_migr_hist;
-			boost::serialization::split_member(ar, *this, version);
 		}
-
-		template <class Archive>
-		void save(Archive &, const unsigned int) const
-		{}
 		template <class Archive>
-		void load(Archive &, const unsigned int)
+		void load(Archive &ar, const unsigned int version)
 		{
+			join();
+			ar >> m_container;
+			ar >> m_topology;
+			ar >> m_dist_type;
+			ar >> m_migr_dir;
+			migration_map_type migr_map;
+			ar >> migr_map;
+			ar >> m_drng;
+			ar >> m_urng;
+			if (version >= 1) {
+				ar >> m_threads;
+				ar >> m_hist_mode;
+				ar >> m_hist_capacity;
+			} else {
+				// Archives from version 0 predate the thread pool and the history modes: use the defaults.
+				m_threads = 0;
+				m_hist_mode = history_full;
+				m_hist_capacity = 0;
+			}
 			// NOTE: archi pointer is not saved during island serialization. Hence, upon loading,
 			// we are going to set the archi pointer of the islands to this. 
 			for (size_type i = 0; i < m_container.size(); ++i) {
 				m_container[i]->m_archi = this;
 			}
+			// Rebuild the island index and the migration slots, whose rngs are seeded from the archipelago's ones.
+			rebuild_migration_index();
+			set_migration_map(migr_map);
 			// NOTE: migr history is not saved, so upon loading we clear it.
 			m_migr_hist.clear();
 		}
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int version)
+		{
+			boost::serialization::split_member(ar, *this, version);
+		}
 		// Container of islands.
 		container_type				m_container;
-		// A barrier used to synchronise the start time of islands.
-		boost::scoped_ptr<boost::barrier>	m_islands_sync_point;
 		// Topology.
 		topology::base_ptr			m_topology;
 		// Distribution type.
 		distribution_type			m_dist_type;
 		// Migration direction.
 		migration_direction			m_migr_dir;
-		// Migration container.
-		migration_map_type			m_migr_map;
-		// Rngs used during migration.
+		// Per-island migration slots.
+		std::vector<slot_ptr>			m_slots;
+		// Index of the islands in the container.
+		boost::unordered_map<const base_island *,size_type>	m_island_index;
+		// Rngs used to seed the migration slots and by evolve_batch().
 		rng_double					m_drng;
 		rng_uint32					m_urng;
-		// Migration mutex.
-		boost::mutex				m_migr_mutex;
+		// Migration history mutex.
+		boost::mutex				m_hist_mutex;
 		// Migration history.
 		migr_hist_type				m_migr_hist;
+		// Migration history mode and capacity (history_ring mode).
+		migr_history_mode			m_hist_mode;
+		size_type				m_hist_capacity;
+		// Requested number of worker threads (0 for one thread per island).
+		unsigned int				m_threads;
+		// Thread pool running the islands' evolutions.
+		boost::scoped_ptr<thread_pool>		m_pool;
 
 };
 
@@ -218,4 +320,7 @@ std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const archipelago
 
 }
 
+// Version 1: number of worker threads and migration history mode.
+BOOST_CLASS_VERSION(pagmo::archipelago,1)
+
 #endif
@@ -88,6 +88,7 @@ base_island::base_island(const base_island &isl):m_pop(isl.get_population())
 	m_s_policy = isl.m_s_policy->clone();
 	m_r_policy = isl.m_r_policy->clone();
 	m_evo_thread.reset(0);
+	m_evo_task = thread_pool::task();
 }
 
 /// Constructor from population.
@@ -134,6 +135,7 @@ base_island &base_island::operator=(const base_island &isl)
 		m_s_policy = isl.m_s_policy->clone();
 		m_r_policy = isl.m_r_policy->clone();
 		m_evo_thread.reset(0);
+		m_evo_task = thread_pool::task();
 	}
 	return *this;
 }
@@ -208,12 +210,13 @@ std::string base_island::human_readable() const
 /// Join island.
 /**
  * This method is intended to block the flow of the program until any ongoing evolution has terminated.
- * The default implementation will join on the internal thread object if an evolution is ongoing,
- * otherwise it will be a no-op.
+ * The default implementation will wait for the evolution task submitted to the archipelago's thread pool and join on the
+ * internal thread object if an evolution is ongoing, otherwise it will be a no-op.
  * Re-implementation of this method should always call the default implementation.
  */
 void base_island::join() const
 {
+	m_evo_task.wait();
 	if (m_evo_thread && m_evo_thread->joinable()) {
 		m_evo_thread->join();
 	}
@@ -261,10 +264,6 @@ struct base_island::int_evolver {
 void base_island::int_evolver::juice_impl(boost::posix_time::ptime &start)
 {
 	start = boost::posix_time::microsec_clock::local_time();
-	// Synchronise start with all other threads if we are in an archi.
-	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
-	}
 	const raii_thread_hook hook(m_i);
 	for (std::size_t i = 0; i < m_n; ++i) {
 		// Call pre-evolve hooks.
@@ -280,7 +279,7 @@ void base_island::int_evolver::juice_impl(boost::posix_time::ptime &start)
 		}
 		m_i->m_pop.problem().post_evolution(m_i->m_pop);
 		// Set the interruption point.
-		boost::this_thread::interruption_point();
+		thread_pool::interruption_point();
 	}
 }
 
@@ -325,6 +324,10 @@ void base_island::evolve(int n)
 {
 	join();
 	const std::size_t n_evo = boost::numeric_cast<std::size_t>(n);
+	if (m_archi) {
+		m_evo_task = m_archi->submit(int_evolver(this,n_evo));
+		return;
+	}
 	try {
 		m_evo_thread.reset(new boost::thread(int_evolver(this,n_evo)));
 	} catch (...) {
@@ -345,10 +348,6 @@ void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
 {
 	boost::posix_time::time_duration diff;
 	start = boost::posix_time::microsec_clock::local_time();
-	// Synchronise start.
-	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
-	}
 	const raii_thread_hook hook(m_i);
 	do {
 		if (m_i->m_archi) {
@@ -361,7 +360,7 @@ void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
 		}
 		m_i->m_pop.problem().post_evolution(m_i->m_pop);
 		// Set the interruption point.
-		boost::this_thread::interruption_point();
+		thread_pool::interruption_point();
 		diff = boost::posix_time::microsec_clock::local_time() - start;
 		// Take care of negative timings.
 	} while (diff.total_milliseconds() < 0 || boost::numeric_cast<std::size_t>(diff.total_milliseconds()) < m_t);
@@ -408,6 +407,10 @@ void base_island::evolve_t(int t)
 {
 	join();
 	const std::size_t t_evo = boost::numeric_cast<std::size_t>(t);
+	if (m_archi) {
+		m_evo_task = m_archi->submit(t_evolver(this,t_evo));
+		return;
+	}
 	try {
 		m_evo_thread.reset(new boost::thread(t_evolver(this,t_evo)));
 	} catch (...) {
@@ -422,10 +425,11 @@ void base_island::evolve_t(int t)
  */
 void base_island::interrupt()
 {
+	m_evo_task.interrupt();
 	if (m_evo_thread) {
 		m_evo_thread->interrupt();
-		join();
 	}
+	join();
 }
 
 /// Query the status of the island.
@@ -434,6 +438,9 @@ void base_island::interrupt()
  */
 bool base_island::busy() const
 {
+	if (!m_evo_task.done()) {
+		return true;
+	}
 	if (!m_evo_thread) {
 		return false;
 	}
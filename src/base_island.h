@@ -40,6 +40,7 @@
 #include "population.h"
 #include "problem/base.h"
 #include "serialization.h"
+#include "thread_pool.h"
 #include "types.h"
 
 namespace pagmo
@@ -74,6 +75,8 @@ typedef boost::shared_ptr<base_island> base_island_ptr;
  *
  * When one of the evolution methods (evolve() or evolve_t()) is launched,
  * a local thread is opened and the perform_evolution() method is called from the new thread using as arguments the population and the algorithm stored in the island.
+ * If the island belongs to an archipelago, no thread is opened: the evolution is instead submitted as a task to the thread pool of the archipelago
+ * (see archipelago::set_threads()).
  *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
@@ -174,6 +177,8 @@ class __PAGMO_VISIBLE base_island
 		migration::base_r_policy_ptr		m_r_policy;
 		/// Evolution thread.
 		boost::scoped_ptr<boost::thread>	m_evo_thread;
+		/// Evolution task, used in place of the evolution thread when the island belongs to an archipelago.
+		thread_pool::task			m_evo_task;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -199,6 +204,7 @@ class __PAGMO_VISIBLE base_island
 			// Upon loading we are going to set the archi pointer and the evo thread to 0.
 			m_archi = 0;
 			m_evo_thread.reset(0);
+			m_evo_task = thread_pool::task();
 		}
 };
 
@@ -29,6 +29,7 @@
 #include "lambert_problem.h"
 #include "lambert_problemOLD.h"
 #include "planets/planet.h"
+#include "planets/eph_table.h"
 #include "planets/planet_ss.h"
 #include "planets/planet_js.h"
 #include "planets/planet_mpcorb.h"
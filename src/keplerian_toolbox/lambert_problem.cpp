@@ -24,6 +24,7 @@
 
 #include <boost/math/special_functions/acosh.hpp>
 #include <boost/math/special_functions/asinh.hpp>
+#include <algorithm>
 
 #include "lambert_problem.h"
 #include "core_functions/array3D_operations.h"
@@ -32,79 +33,181 @@
 
 namespace kep_toolbox {
 
-const array3D lambert_problem::default_r1 = {{1.0,0.0,0.0}};
-const array3D lambert_problem::default_r2 = {{0.0,1.0,0.0}};
+namespace {
 
-/// Constructor
-/** Constructs and solves a Lambert problem.
- *
- * \param[in] R1 first cartesian position
- * \param[in] R2 second cartesian position
- * \param[in] tof time of flight
- * \param[in] mu gravity parameter
- * \param[in] cw when 1 a retrograde orbit is assumed
- * \param[in] multi_revs maximum number of multirevolutions to compute
- */
-lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const double &tof, const double& mu, const int &cw, const int &multi_revs) :
-				m_r1(r1), m_r2(r2),m_tof(tof),m_mu(mu),m_has_converged(true), m_multi_revs(multi_revs)
+// Geometry of a Lambert problem: radial and tangential unit vectors at r1 and r2, their norms,
+// chord, semiperimeter, lambda (and its square) and non dimensional time of flight.
+struct lambert_geometry
 {
-	// 0 - Sanity checks
-	if (tof <= 0) {
-		throw_value_error("Time of flight is negative!");
+	array3D ir1, ir2, it1, it2;
+	double R1, R2, c, s, lambda, lambda2, T;
+};
+
+void dTdx(double &DT,double &DDT,double &DDDT,const double x, const double T, const double lambda)
+{
+	double l2 = lambda*lambda;
+	double l3 = l2*lambda;
+	double umx2 = 1.0-x*x;
+	double y = sqrt(1.0-l2*umx2);
+	double y2 = y*y;
+	double y3 = y2*y;
+	DT = 1.0/umx2 * (3.0*T*x-2.0+2.0*l3*x/y);
+	DDT = 1.0 / umx2 * (3.0*T+5.0*x*DT+2.0*(1.0-l2)*l3/y3);
+	DDDT = 1.0 / umx2 * (7.0*x*DDT+8.0*DT-6.0*(1.0-l2)*l2*l3*x/y3/y2);
+}
+
+void x2tof2(double &tof,const double x, const int N, const double lambda)
+{
+	double a = 1.0 / (1.0-x*x);
+	if (a>0)	//ellipse
+	{
+		double alfa = 2.0*acos(x);
+		double beta = 2.0 * asin (sqrt(lambda*lambda/a));
+		if (lambda<0.0) beta = -beta;
+		tof =  ((a * sqrt (a)* ( (alfa - sin(alfa)) - (beta - sin(beta)) + 2.0*M_PI*N)) / 2.0);
 	}
-	if (mu <= 0) {
-		throw_value_error("Gravity parameter is zero or negative!");
+	else
+	{
+		double alfa = 2.0*boost::math::acosh(x);
+		double beta = 2.0 * boost::math::asinh(sqrt(-lambda*lambda/a));
+		if (lambda<0.0) beta = -beta;
+		tof =  ( -a * sqrt (-a)* ( (beta - sinh(beta)) - (alfa - sinh(alfa)) ) / 2.0);
+	}
+}
+
+double hypergeometricF(double z, double tol) {
+	double Sj=1.0;
+	double Cj=1.0;
+	double err=1.0;
+	double Cj1=0.0;
+	double Sj1=0.0;
+	int j=0;
+	while (err > tol){
+		Cj1 = Cj*(3.0+j)*(1.0+j)/(2.5+j)*z/(j+1);
+		Sj1 = Sj + Cj1;
+		err=fabs(Cj1);
+		Sj = Sj1;
+		Cj=Cj1;
+		j=j+1;
+	}
+	return Sj;
+}
+
+void x2tof(double &tof,const double x, const int N, const double lambda)
+{
+	double battin = 0.01;
+	double lagrange = 0.2;
+	double dist = fabs(x-1);
+	if (dist < lagrange && dist > battin) { // We use Lagrange tof expression
+		x2tof2(tof,x,N,lambda);
+		return;
 	}
+	double K = lambda*lambda;
+	double E = x*x-1.0;
+	double rho = fabs(E);
+	double z = sqrt(1+K*E);
+	if (dist < battin) { // We use Battin series tof expression
+		double eta = z-lambda*x;
+		double S1 = 0.5*(1.0-lambda-x*eta);
+		double Q = hypergeometricF(S1,1e-11);
+		Q = 4.0/3.0*Q;
+		tof = (eta*eta*eta*Q+4.0*lambda*eta)/2.0 + N*M_PI / pow(rho,1.5);
+		return;
+	} else { // We use Lancaster tof expresion
+		double y=sqrt(rho);
+		double g = x*z - lambda*E;
+		double d = 0.0;
+		if (E<0) {
+			double l = acos(g);
+			d=N*M_PI+l;
+		} else {
+			double f = y*(z-lambda*x);
+			d=log(f+g);
+		}
+		tof = (x-lambda*z-d/y)/E;
+		return;
+	}
+}
+
+int householder(const double T, double& x0, const int N, const double eps, const int iter_max, const double lambda) {
+	int it=0;
+	double err = 1.0;
+	double xnew=0.0;
+	double tof=0.0, delta=0.0,DT=0.0,DDT=0.0,DDDT=0.0;
+	while ( (err>eps) && (it < iter_max) )
+	{
+			x2tof(tof,x0,N,lambda);
+			dTdx(DT,DDT,DDDT,x0,tof,lambda);
+			delta = tof-T;
+			double DT2 = DT*DT;
+			xnew = x0 - delta * (DT2-delta*DDT/2.0) / (DT*(DT2-delta*DDT) + DDDT*delta*delta/6.0);
+			err=fabs(x0-xnew);
+			x0=xnew;
+			it++;
+	}
+	return it;
+}
+
+// Computes the geometry of the problem. Returns false if the transfer plane contains the z axis, as the
+// direction of motion cannot be defined in that case.
+bool init_geometry(lambert_geometry &g, const array3D &r1, const array3D &r2, const double tof, const double mu, const int cw)
+{
 	// 1 - Getting lambda and T
-	m_c = sqrt( (r2[0]-r1[0])*(r2[0]-r1[0]) + (r2[1]-r1[1])*(r2[1]-r1[1]) + (r2[2]-r1[2])*(r2[2]-r1[2]));
-	double R1 = norm(m_r1);
-	double R2 = norm(m_r2);
-	m_s = (m_c+R1+R2) / 2.0;
-	array3D ir1,ir2,ih,it1,it2;
-	vers(ir1,r1);
-	vers(ir2,r2);
-	cross(ih,ir1,ir2);
+	g.c = sqrt( (r2[0]-r1[0])*(r2[0]-r1[0]) + (r2[1]-r1[1])*(r2[1]-r1[1]) + (r2[2]-r1[2])*(r2[2]-r1[2]));
+	g.R1 = norm(r1);
+	g.R2 = norm(r2);
+	g.s = (g.c+g.R1+g.R2) / 2.0;
+	array3D ih;
+	vers(g.ir1,r1);
+	vers(g.ir2,r2);
+	cross(ih,g.ir1,g.ir2);
 	vers(ih,ih);
 	if (ih[2] == 0) {
-		throw_value_error("The angular momentum vector has no z component, impossible to define automatically clock or counterclockwise");
+		return false;
 	}
-	double lambda2 = 1.0 - m_c/m_s;
-	m_lambda = sqrt(lambda2);
+	g.lambda2 = 1.0 - g.c/g.s;
+	g.lambda = sqrt(g.lambda2);
 
 	if (ih[2] < 0.0) // Transfer angle is larger than 180 degrees as seen from abive the z axis
 	{
-		m_lambda = -m_lambda;
-		cross(it1,ir1,ih);
-		cross(it2,ir2,ih);
+		g.lambda = -g.lambda;
+		cross(g.it1,g.ir1,ih);
+		cross(g.it2,g.ir2,ih);
 	} else {
-		cross(it1,ih,ir1);
-		cross(it2,ih,ir2);
+		cross(g.it1,ih,g.ir1);
+		cross(g.it2,ih,g.ir2);
 	}
-	vers(it1,it1);
-	vers(it2,it2);
+	vers(g.it1,g.it1);
+	vers(g.it2,g.it2);
 
 	if (cw) { // Retrograde motion
-		m_lambda = -m_lambda;
-		it1[0] = -it1[0]; it1[1] = -it1[1]; it1[2] = -it1[2];
-		it2[0] = -it2[0]; it2[1] = -it2[1]; it2[2] = -it2[2];
+		g.lambda = -g.lambda;
+		g.it1[0] = -g.it1[0]; g.it1[1] = -g.it1[1]; g.it1[2] = -g.it1[2];
+		g.it2[0] = -g.it2[0]; g.it2[1] = -g.it2[1]; g.it2[2] = -g.it2[2];
 	}
-	double lambda3 = m_lambda*lambda2;
-	double T = sqrt(2.0*m_mu/m_s/m_s/m_s) * m_tof;
-
-	// 2 - We now have lambda, T and we will find all x
-	// 2.1 - Let us first detect the maximum number of revolutions for which there exists a solution
-	m_Nmax = T/M_PI;
-	double T00 = acos(m_lambda) + m_lambda*sqrt(1.0-lambda2);
-	double T0 = (T00 + m_Nmax*M_PI);
-	double T1 = 2.0/3.0 * (1.0 - lambda3),DT=0.0,DDT=0.0,DDDT=0.0;
-	if (m_Nmax >0) {
-		if (T < T0) { // We use Halley iterations to find xM and TM
+	g.T = sqrt(2.0*mu/g.s/g.s/g.s) * tof;
+	return true;
+}
+
+// Maximum number of revolutions for which there exists a solution, cropped to multi_revs. The Halley
+// iterations locating the minimum time of flight are skipped altogether when only the 0 rev solution is needed.
+int find_Nmax(const lambert_geometry &g, const int multi_revs)
+{
+	if (multi_revs <= 0) {
+		return 0;
+	}
+	int Nmax = g.T/M_PI;
+	double T00 = acos(g.lambda) + g.lambda*sqrt(1.0-g.lambda2);
+	double T0 = (T00 + Nmax*M_PI);
+	double DT=0.0,DDT=0.0,DDDT=0.0;
+	if (Nmax >0) {
+		if (g.T < T0) { // We use Halley iterations to find xM and TM
 			int it=0;
 			double err = 1.0;
 			double T_min=T0;
 			double x_old=0.0,x_new = 0.0;
 			while (1) {
-				dTdx(DT,DDT,DDDT,x_old,T_min);
+				dTdx(DT,DDT,DDDT,x_old,T_min,g.lambda);
 				if (DT != 0.0) {
 						x_new = x_old - DT * DDT / (DDT * DDT - DT * DDDT / 2.0);
 				}
@@ -112,174 +215,238 @@ lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const dou
 				if ( (err<1e-13) || (it>12) ) {
 					break;
 				}
-				x2tof(T_min,x_new,m_Nmax);
+				x2tof(T_min,x_new,Nmax,g.lambda);
 				x_old=x_new;
 				it++;
 			}
-			if (T_min > T) {
-				m_Nmax -= 1;
+			if (T_min > g.T) {
+				Nmax -= 1;
 			}
 		}
 	}
-	// We exit this if clause with Mmax being the maximum number of revolutions
-	// for which there exists a solution. We crop it to m_multi_revs
-	m_Nmax = std::min(m_multi_revs,m_Nmax);
-
-	// 2.2 We now allocate the memory for the output variables
-	m_v1.resize(m_Nmax * 2 +1);
-	m_v2.resize(m_Nmax * 2 +1);
-	m_iters.resize(m_Nmax * 2 +1);
-	m_x.resize(m_Nmax * 2 +1);
+	return std::min(multi_revs,Nmax);
+}
 
-	// 3 - We may now find all solutions in x,y
-	// 3.1 0 rev solution
-	// 3.1.1 initial guess
-	if (T>=T00) {
-		m_x[0] = -(T-T00)/(T-T00+4);
-	} else if (T<=T1) {
-		m_x[0] = T1*(T1-T) / ( 2.0/5.0*(1-lambda2*lambda3) * T ) + 1;
-	} else {
-		m_x[0] = pow((T/T00),0.69314718055994529 / log(T1/T00)) - 1.0;
+// Finds x for the solution number i (0 rev, then left and right solutions for 1,2,... revs) and returns the Householder iterations taken.
+int find_x(double &x, const lambert_geometry &g, const int i)
+{
+	if (i == 0) {
+		// Initial guess
+		double lambda2 = g.lambda2;
+		double lambda3 = g.lambda*lambda2;
+		double T00 = acos(g.lambda) + g.lambda*sqrt(1.0-lambda2);
+		double T1 = 2.0/3.0 * (1.0 - lambda3);
+		if (g.T>=T00) {
+			x = -(g.T-T00)/(g.T-T00+4);
+		} else if (g.T<=T1) {
+			x = T1*(T1-g.T) / ( 2.0/5.0*(1-lambda2*lambda3) * g.T ) + 1;
+		} else {
+			x = pow((g.T/T00),0.69314718055994529 / log(T1/T00)) - 1.0;
+		}
+		// Householder iterations
+		return householder(g.T, x, 0.0, 1e-5, 15, g.lambda);
 	}
-	// 3.1.2 Householder iterations
-	m_iters[0] = householder(T, m_x[0], 0.0, 1e-5, 15);
-	// 3.2 multi rev solutions
+	const int N = (i+1)/2;
 	double tmp;
-	for (int i=1;i<m_Nmax+1;++i)
-	{
-		//3.2.1 left Householder iterations
-		tmp = pow((i*M_PI+M_PI) / (8.0*T), 2.0/3.0);
-		m_x[2*i-1] = (tmp-1)/(tmp+1);
-		m_iters[2*i-1] = householder(T, m_x[2*i-1], i, 1e-8, 15);
-		//3.2.1 right Householder iterations
-		tmp = pow((8.0*T)/(i*M_PI), 2.0/3.0);
-		m_x[2*i] = (tmp-1)/(tmp+1);
-		m_iters[2*i] = householder(T, m_x[2*i], i, 1e-8, 15);
+	if (i % 2) { // left Householder iterations
+		tmp = pow((N*M_PI+M_PI) / (8.0*g.T), 2.0/3.0);
+	} else { // right Householder iterations
+		tmp = pow((8.0*g.T)/(N*M_PI), 2.0/3.0);
 	}
+	x = (tmp-1)/(tmp+1);
+	return householder(g.T, x, N, 1e-8, 15, g.lambda);
+}
 
-	// 4 - For each found x value we reconstruct the terminal velocities
-	double gamma = sqrt(m_mu*m_s/2.0);
-	double rho = (R1-R2) / m_c;
+// Reconstructs the terminal velocities from x.
+void x2v(array3D &v1, array3D &v2, const lambert_geometry &g, const double x, const double mu)
+{
+	double lambda2 = g.lambda2;
+	double gamma = sqrt(mu*g.s/2.0);
+	double rho = (g.R1-g.R2) / g.c;
 	double sigma = sqrt(1-rho*rho);
-	double vr1,vt1,vr2,vt2,y;
-	for (size_t i=0;i< m_x.size();++i)
-	{
-		y = sqrt(1.0-lambda2+lambda2*m_x[i]*m_x[i]);
-		vr1 = gamma *((m_lambda*y-m_x[i])-rho*(m_lambda*y+m_x[i]))/R1;
-		vr2 = -gamma*((m_lambda*y-m_x[i])+rho*(m_lambda*y+m_x[i]))/R2;
-		double vt = gamma*sigma*(y+m_lambda*m_x[i]);
-		vt1 = vt/R1;
-		vt2 = vt/R2;
-		for (int j=0; j<3;++j) m_v1[i][j] = vr1 * ir1[j] + vt1 * it1[j];
-		for (int j=0; j<3;++j) m_v2[i][j] = vr2 * ir2[j] + vt2 * it2[j];
-	}
+	double y = sqrt(1.0-lambda2+lambda2*x*x);
+	double vr1 = gamma *((g.lambda*y-x)-rho*(g.lambda*y+x))/g.R1;
+	double vr2 = -gamma*((g.lambda*y-x)+rho*(g.lambda*y+x))/g.R2;
+	double vt = gamma*sigma*(y+g.lambda*x);
+	double vt1 = vt/g.R1;
+	double vt2 = vt/g.R2;
+	for (int j=0; j<3;++j) v1[j] = vr1 * g.ir1[j] + vt1 * g.it1[j];
+	for (int j=0; j<3;++j) v2[j] = vr2 * g.ir2[j] + vt2 * g.it2[j];
 }
 
-int lambert_problem::householder(const double T, double& x0, const int N,
-						const double eps, const int iter_max) {
-	int it=0;
-	double err = 1.0;
-	double xnew=0.0;
-	double tof=0.0, delta=0.0,DT=0.0,DDT=0.0,DDDT=0.0;
-	while ( (err>eps) && (it < iter_max) )
-	{
-			x2tof(tof,x0,N);
-			dTdx(DT,DDT,DDDT,x0,tof);
-			delta = tof-T;
-			double DT2 = DT*DT;
-			xnew = x0 - delta * (DT2-delta*DDT/2.0) / (DT*(DT2-delta*DDT) + DDDT*delta*delta/6.0);
-			err=fabs(x0-xnew);
-			x0=xnew;
-			it++;
+void check_inputs(const double tof, const double mu)
+{
+	if (tof <= 0) {
+		throw_value_error("Time of flight is negative!");
+	}
+	if (mu <= 0) {
+		throw_value_error("Gravity parameter is zero or negative!");
 	}
-	return it;
 }
 
-void lambert_problem::dTdx(double &DT,double &DDT,double &DDDT,const double x,
-							 const double T)
+void throw_no_z_component()
 {
-	double l2 = m_lambda*m_lambda;
-	double l3 = l2*m_lambda;
-	double umx2 = 1.0-x*x;
-	double y = sqrt(1.0-l2*umx2);
-	double y2 = y*y;
-	double y3 = y2*y;
-	DT = 1.0/umx2 * (3.0*T*x-2.0+2.0*l3*x/y);
-	DDT = 1.0 / umx2 * (3.0*T+5.0*x*DT+2.0*(1.0-l2)*l3/y3);
-	DDDT = 1.0 / umx2 * (7.0*x*DDT+8.0*DT-6.0*(1.0-l2)*l2*l3*x/y3/y2);
+	throw_value_error("The angular momentum vector has no z component, impossible to define automatically clock or counterclockwise");
+}
+
 }
 
-void lambert_problem::x2tof2(double &tof,const double x, const int N)
+const array3D lambert_problem::default_r1 = {{1.0,0.0,0.0}};
+const array3D lambert_problem::default_r2 = {{0.0,1.0,0.0}};
+
+/// Constructor
+/** Constructs and solves a Lambert problem.
+ *
+ * \param[in] R1 first cartesian position
+ * \param[in] R2 second cartesian position
+ * \param[in] tof time of flight
+ * \param[in] mu gravity parameter
+ * \param[in] cw when 1 a retrograde orbit is assumed
+ * \param[in] multi_revs maximum number of multirevolutions to compute
+ */
+lambert_problem::lambert_problem(const array3D &r1, const array3D &r2, const double &tof, const double& mu, const int &cw, const int &multi_revs) :
+				m_r1(r1), m_r2(r2),m_tof(tof),m_mu(mu),m_has_converged(true), m_multi_revs(multi_revs)
 {
-	double a = 1.0 / (1.0-x*x);
-	if (a>0)	//ellipse
-	{
-		double alfa = 2.0*acos(x);
-		double beta = 2.0 * asin (sqrt(m_lambda*m_lambda/a));
-		if (m_lambda<0.0) beta = -beta;
-		tof =  ((a * sqrt (a)* ( (alfa - sin(alfa)) - (beta - sin(beta)) + 2.0*M_PI*N)) / 2.0);
+	// 0 - Sanity checks
+	check_inputs(tof,mu);
+	// 1 - Getting lambda and T
+	lambert_geometry g;
+	if (!init_geometry(g,r1,r2,tof,mu,cw)) {
+		throw_no_z_component();
 	}
-	else
+	m_c = g.c;
+	m_s = g.s;
+	m_lambda = g.lambda;
+
+	// 2 - We detect the maximum number of revolutions for which there exists a solution
+	m_Nmax = find_Nmax(g,m_multi_revs);
+
+	// 2.2 We now allocate the memory for the output variables
+	m_v1.resize(m_Nmax * 2 +1);
+	m_v2.resize(m_Nmax * 2 +1);
+	m_iters.resize(m_Nmax * 2 +1);
+	m_x.resize(m_Nmax * 2 +1);
+
+	// 3 - We may now find all solutions in x,y and reconstruct the terminal velocities
+	for (size_t i=0;i< m_x.size();++i)
 	{
-		double alfa = 2.0*boost::math::acosh(x);
-		double beta = 2.0 * boost::math::asinh(sqrt(-m_lambda*m_lambda/a));
-		if (m_lambda<0.0) beta = -beta;
-		tof =  ( -a * sqrt (-a)* ( (beta - sinh(beta)) - (alfa - sinh(alfa)) ) / 2.0);
+		m_iters[i] = find_x(m_x[i],g,i);
+		x2v(m_v1[i],m_v2[i],g,m_x[i],m_mu);
 	}
 }
 
-void lambert_problem::x2tof(double &tof,const double x, const int N)
+/// Solves a Lambert problem into caller-provided storage
+/**
+ * Lightweight alternative to lambert_problem: no memory is allocated and only the solutions up to multi_revs revolutions
+ * are computed (the search for the maximum number of revolutions is skipped altogether when multi_revs is 0).
+ * The solutions are ordered as in lambert_problem::get_v1().
+ *
+ * \param[out] v1 velocities at r1, an array of at least 2*multi_revs+1 elements
+ * \param[out] v2 velocities at r2, an array of at least 2*multi_revs+1 elements
+ * \param[in] r1 first cartesian position
+ * \param[in] r2 second cartesian position
+ * \param[in] tof time of flight
+ * \param[in] mu gravity parameter
+ * \param[in] cw when 1 a retrograde orbit is assumed
+ * \param[in] multi_revs maximum number of multirevolutions to compute
+ *
+ * \return the number of solutions written in v1 and v2, i.e. 2*N_max+1
+ */
+int lambert_solve(array3D *v1, array3D *v2, const array3D &r1, const array3D &r2, const double &tof, const double &mu, const int &cw, const int &multi_revs)
 {
-	double battin = 0.01;
-	double lagrange = 0.2;
-	double dist = fabs(x-1);
-	if (dist < lagrange && dist > battin) { // We use Lagrange tof expression
-		x2tof2(tof,x,N);
-		return;
+	check_inputs(tof,mu);
+	lambert_geometry g;
+	if (!init_geometry(g,r1,r2,tof,mu,cw)) {
+		throw_no_z_component();
 	}
-	double K = m_lambda*m_lambda;
-	double E = x*x-1.0;
-	double rho = fabs(E);
-	double z = sqrt(1+K*E);
-	if (dist < battin) { // We use Battin series tof expression
-		double eta = z-m_lambda*x;
-		double S1 = 0.5*(1.0-m_lambda-x*eta);
-		double Q = hypergeometricF(S1,1e-11);
-		Q = 4.0/3.0*Q;
-		tof = (eta*eta*eta*Q+4.0*m_lambda*eta)/2.0 + N*M_PI / pow(rho,1.5);
-		return;
-	} else { // We use Lancaster tof expresion
-		double y=sqrt(rho);
-		double g = x*z - m_lambda*E;
-		double d = 0.0;
-		if (E<0) {
-			double l = acos(g);
-			d=N*M_PI+l;
-		} else {
-			double f = y*(z-m_lambda*x);
-			d=log(f+g);
-		}
-		tof = (x-m_lambda*z-d/y)/E;
-		return;
+	const int n_sol = find_Nmax(g,multi_revs) * 2 + 1;
+	double x;
+	for (int i = 0; i < n_sol; ++i) {
+		find_x(x,g,i);
+		x2v(v1[i],v2[i],g,x,mu);
 	}
+	return n_sol;
 }
 
-double lambert_problem::hypergeometricF(double z, double tol) {
-	double Sj=1.0;
-	double Cj=1.0;
-	double err=1.0;
-	double Cj1=0.0;
-	double Sj1=0.0;
-	int j=0;
-	while (err > tol){
-		Cj1 = Cj*(3.0+j)*(1.0+j)/(2.5+j)*z/(j+1);
-		Sj1 = Sj + Cj1;
-		err=fabs(Cj1);
-		Sj = Sj1;
-		Cj=Cj1;
-		j=j+1;
+/// Solves a Lambert problem for its 0 revolutions solution
+/**
+ * Equivalent to lambert_problem(r1,r2,tof,mu,cw,0).get_v1()[0] and get_v2()[0], without allocating memory.
+ *
+ * \param[out] v1 velocity at r1
+ * \param[out] v2 velocity at r2
+ * \param[in] r1 first cartesian position
+ * \param[in] r2 second cartesian position
+ * \param[in] tof time of flight
+ * \param[in] mu gravity parameter
+ * \param[in] cw when 1 a retrograde orbit is assumed
+ */
+void lambert_solve(array3D &v1, array3D &v2, const array3D &r1, const array3D &r2, const double &tof, const double &mu, const int &cw)
+{
+	lambert_solve(&v1,&v2,r1,r2,tof,mu,cw,0);
+}
+
+/// Resizes the batch
+/**
+ * \param[in] n number of Lambert problems in the batch
+ */
+void lambert_batch::resize(std::size_t n)
+{
+	for (int j = 0; j < 3; ++j) {
+		r1[j].resize(n);
+		r2[j].resize(n);
+		v1[j].resize(n);
+		v2[j].resize(n);
+	}
+	tof.resize(n);
+	ok.resize(n);
+}
+
+/// Size of the batch
+/**
+ * \return the number of Lambert problems in the batch
+ */
+std::size_t lambert_batch::size() const
+{
+	return tof.size();
+}
+
+/// Solves a batch of Lambert problems
+/**
+ * Computes the 0 revolutions solutions of all the problems in the batch, sharing the gravity parameter and the direction of motion.
+ * Each problem is solved by lambert_solve(), hence the velocities are exactly those it returns, and no memory is allocated per
+ * problem. Contrary to lambert_solve(), invalid problems (non positive time of flight, undefined direction of motion) do not throw:
+ * they are flagged in lambert_batch::ok and their velocities are left untouched.
+ *
+ * \param[in,out] b batch of problems, whose velocities and flags will be written
+ * \param[in] mu gravity parameter
+ * \param[in] cw when 1 a retrograde orbit is assumed
+ *
+ * \throws value_error if mu is not positive
+ */
+void lambert_solve_batch(lambert_batch &b, const double &mu, const int &cw)
+{
+	if (mu <= 0) {
+		throw_value_error("Gravity parameter is zero or negative!");
+	}
+	array3D r1, r2, v1, v2;
+	for (std::size_t i = 0; i < b.size(); ++i) {
+		b.ok[i] = 0;
+		if (b.tof[i] <= 0) {
+			continue;
+		}
+		r1[0] = b.r1[0][i]; r1[1] = b.r1[1][i]; r1[2] = b.r1[2][i];
+		r2[0] = b.r2[0][i]; r2[1] = b.r2[1][i]; r2[2] = b.r2[2][i];
+		try {
+			lambert_solve(v1,v2,r1,r2,b.tof[i],mu,cw);
+		} catch (...) {
+			continue;
+		}
+		for (int j = 0; j < 3; ++j) {
+			b.v1[j][i] = v1[j];
+			b.v2[j][i] = v2[j];
+		}
+		b.ok[i] = 1;
 	}
-	return Sj;
 }
 
 /// Gets velocity at r1
@@ -26,6 +26,7 @@
 #define KEP_TOOLBOX_LAMBERT_PROBLEM_H
 
 #include <cmath>
+#include <cstddef>
 #include<vector>
 
 #include "astro_constants.h"
@@ -69,11 +70,6 @@ public:
 	const std::vector<int>& get_iters() const;
 	int get_Nmax() const;
 private:
-	int householder(const double T, double& x0, const int N, const double eps, const int itermax);
-	void dTdx(double &DT,double &DDT,double &DDDT,const double x0, const double tof);
-	void x2tof(double &tof,const double x0, const int N);
-	void x2tof2(double &tof,const double x0, const int N);
-	double hypergeometricF(double z, double tol);
 	friend class boost::serialization::access;
 	template <class Archive>
 	void serialize(Archive &ar, const unsigned int)
@@ -110,6 +106,35 @@ private:
 
 };
 __KEP_TOOL_VISIBLE std::ostream &operator<<(std::ostream &, const lambert_problem &);
+
+__KEP_TOOL_VISIBLE int lambert_solve(array3D *, array3D *, const array3D &, const array3D &, const double &, const double &, const int &, const int &);
+__KEP_TOOL_VISIBLE void lambert_solve(array3D &, array3D &, const array3D &, const array3D &, const double &, const double &, const int &cw = 0);
+
+/// Batch of Lambert problems
+/**
+ * Structure-of-arrays storage for many Lambert problems solved at once by lambert_solve_batch(): the j-th cartesian component
+ * of r1 for the i-th problem is r1[j][i], and similarly for r2, v1 and v2. Inputs are r1, r2 and tof, outputs v1, v2 and ok
+ * (non zero when the i-th problem could be solved). The storage can be reused across calls to avoid reallocations.
+ */
+struct __KEP_TOOL_VISIBLE lambert_batch
+{
+	void resize(std::size_t);
+	std::size_t size() const;
+	/// First cartesian positions.
+	std::vector<double> r1[3];
+	/// Second cartesian positions.
+	std::vector<double> r2[3];
+	/// Times of flight.
+	std::vector<double> tof;
+	/// Velocities at r1 (0 rev solution).
+	std::vector<double> v1[3];
+	/// Velocities at r2 (0 rev solution).
+	std::vector<double> v2[3];
+	/// Convergence flags.
+	std::vector<char> ok;
+};
+
+__KEP_TOOL_VISIBLE void lambert_solve_batch(lambert_batch &, const double &, const int &cw = 0);
 } //namespaces
 
 #endif // KEP_TOOLBOX_LAMBERT_PROBLEM_H
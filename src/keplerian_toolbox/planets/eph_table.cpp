@@ -0,0 +1,186 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PyKEP development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://keptoolbox.sourceforge.net/index.html                            *
+ *   http://keptoolbox.sourceforge.net/credits.html                          *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "eph_table.h"
+#include "planet.h"
+#include "../exceptions.h"
+
+namespace kep_toolbox{
+
+// Maximum number of intervals between nodes.
+static const std::size_t max_intervals = 1u << 20;
+// Number of values stored for each node.
+static const std::size_t node_size = 12;
+
+/// Default constructor
+/**
+ * Constructs an empty table, covering no epoch.
+ */
+eph_table::eph_table():m_start(0.),m_end(-1.),m_step(1.),m_nodes() {}
+
+/// Constructor
+/**
+ * Builds the table of a planet over a window of epochs.
+ *
+ * \param[in] body planet whose ephemerides are tabulated
+ * \param[in] start first epoch of the window (mjd2000)
+ * \param[in] end last epoch of the window (mjd2000)
+ * \param[in] pos_tol maximum interpolation error on the position (SI units)
+ * \param[in] vel_tol maximum interpolation error on the velocity (SI units)
+ *
+ * \throws value_error if the window is empty, if the tolerances are not positive or if they cannot be met
+ * with about a million nodes
+ */
+eph_table::eph_table(const planet &body, const double &start, const double &end, const double &pos_tol, const double &vel_tol):
+	m_start(start),m_end(end),m_step((end - start) / 4),m_nodes()
+{
+	if (!(end > start)) {
+		throw_value_error("The end of the ephemerides window must follow its start");
+	}
+	if (!(pos_tol > 0) || !(vel_tol > 0)) {
+		throw_value_error("The ephemerides tolerances must be strictly positive");
+	}
+	std::size_t n_int = 4;
+	m_nodes.resize(node_size * (n_int + 1));
+	for (std::size_t k = 0; k <= n_int; ++k) {
+		node(body, m_start + k * m_step, &m_nodes[node_size * k]);
+	}
+	std::vector<double> mids, nodes;
+	double check[node_size];
+	array3D r, v;
+	while (true) {
+		// Compare the interpolated ephemerides a quarter, half and three quarters of the way between
+		// the nodes with the exact ones (the half way points are kept as the nodes of a refined table)
+		mids.resize(node_size * n_int);
+		double pos_err = 0., vel_err = 0.;
+		for (std::size_t k = 0; k < n_int; ++k) {
+			for (int q = 1; q < 4; ++q) {
+				double *exact = (q == 2) ? &mids[node_size * k] : check;
+				node(body, m_start + (k + q / 4.) * m_step, exact);
+				eval(&m_nodes[node_size * k], &m_nodes[node_size * (k + 1)], q / 4., m_step * ASTRO_DAY2SEC, r, v);
+				double dr = 0., dv = 0.;
+				for (int j = 0; j < 3; ++j) {
+					dr += (r[j] - exact[j]) * (r[j] - exact[j]);
+					dv += (v[j] - exact[3 + j]) * (v[j] - exact[3 + j]);
+				}
+				pos_err = std::max(pos_err, std::sqrt(dr));
+				vel_err = std::max(vel_err, std::sqrt(dv));
+			}
+		}
+		if (pos_err <= pos_tol && vel_err <= vel_tol) {
+			break;
+		}
+		if (2 * n_int > max_intervals) {
+			throw_value_error("The ephemerides tolerances cannot be met, try a smaller window or larger tolerances");
+		}
+		nodes.resize(node_size * (2 * n_int + 1));
+		for (std::size_t k = 0; k < n_int; ++k) {
+			std::copy(&m_nodes[node_size * k], &m_nodes[node_size * (k + 1)], &nodes[node_size * 2 * k]);
+			std::copy(&mids[node_size * k], &mids[node_size * (k + 1)], &nodes[node_size * (2 * k + 1)]);
+		}
+		std::copy(&m_nodes[node_size * n_int], &m_nodes[node_size * (n_int + 1)], &nodes[node_size * 2 * n_int]);
+		m_nodes.swap(nodes);
+		n_int *= 2;
+		m_step /= 2;
+	}
+}
+
+/// Gets the interpolated position and velocity
+/**
+ * The epoch must be within the window of the table (see covers()).
+ *
+ * \param[in] mjd2000 epoch in which ephemerides are required
+ * \param[out] r position at epoch (SI units)
+ * \param[out] v velocity at epoch (SI units)
+ */
+void eph_table::get_eph(const double &mjd2000, array3D &r, array3D &v) const
+{
+	const std::size_t n_int = m_nodes.size() / node_size - 1;
+	const double t = (mjd2000 - m_start) / m_step;
+	const std::size_t k = std::min(static_cast<std::size_t>(t), n_int - 1);
+	eval(&m_nodes[node_size * k], &m_nodes[node_size * (k + 1)], t - k, m_step * ASTRO_DAY2SEC, r, v);
+}
+
+/// Gets the first epoch of the window (mjd2000)
+double eph_table::get_start() const
+{
+	return m_start;
+}
+
+/// Gets the last epoch of the window (mjd2000)
+double eph_table::get_end() const
+{
+	return m_end;
+}
+
+/// Gets the spacing of the nodes (days)
+double eph_table::get_step() const
+{
+	return m_step;
+}
+
+/// Gets the number of nodes
+std::size_t eph_table::get_size() const
+{
+	return m_nodes.size() / node_size;
+}
+
+// Quintic Hermite interpolation between the nodes p0 and p1, h seconds apart, at the fraction s of the interval.
+// Position and velocity are interpolated separately (from position, velocity, acceleration and from velocity,
+// acceleration, jerk respectively), so that the velocity is accurate also for planets whose velocity is not
+// exactly the derivative of their position (e.g. when the orbital elements drift in time).
+void eph_table::eval(const double *p0, const double *p1, const double &s, const double &h, array3D &r, array3D &v)
+{
+	const double s2 = s * s, s3 = s2 * s, s4 = s3 * s, s5 = s4 * s;
+	// Basis functions for value, first and second derivative at the first and second node
+	const double h0 = 1 - 10 * s3 + 15 * s4 - 6 * s5, h1 = (s - 6 * s3 + 8 * s4 - 3 * s5) * h, h2 = (s2 - 3 * s3 + 3 * s4 - s5) / 2 * h * h;
+	const double h5 = 10 * s3 - 15 * s4 + 6 * s5, h4 = (-4 * s3 + 7 * s4 - 3 * s5) * h, h3 = (s3 - 2 * s4 + s5) / 2 * h * h;
+	for (int j = 0; j < 3; ++j) {
+		r[j] = h0 * p0[j] + h1 * p0[3 + j] + h2 * p0[6 + j] + h5 * p1[j] + h4 * p1[3 + j] + h3 * p1[6 + j];
+		v[j] = h0 * p0[3 + j] + h1 * p0[6 + j] + h2 * p0[9 + j] + h5 * p1[3 + j] + h4 * p1[6 + j] + h3 * p1[9 + j];
+	}
+}
+
+// Position, velocity, keplerian acceleration and its derivative of body at mjd2000.
+void eph_table::node(const planet &body, const double &mjd2000, double *p) const
+{
+	array3D r, v;
+	body.eph_impl(mjd2000, r, v);
+	const double R2 = r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+	const double R = std::sqrt(R2);
+	const double k = -body.get_mu_central_body() / (R2 * R);
+	const double rv = 3 * (r[0] * v[0] + r[1] * v[1] + r[2] * v[2]) / R2;
+	for (int j = 0; j < 3; ++j) {
+		p[j] = r[j];
+		p[3 + j] = v[j];
+		p[6 + j] = k * r[j];
+		p[9 + j] = k * (v[j] - rv * r[j]);
+	}
+}
+
+} /// End of namespace kep_toolbox
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PyKEP development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://keptoolbox.sourceforge.net/index.html                            *
+ *   http://keptoolbox.sourceforge.net/credits.html                          *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef KEP_TOOLBOX_EPH_TABLE_H
+#define KEP_TOOLBOX_EPH_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../serialization.h"
+#include "../config.h"
+#include "../astro_constants.h"
+
+namespace kep_toolbox{
+
+// Forward declaration.
+class planet;
+
+/// Interpolated ephemerides
+/**
+ * This class stores the position, velocity, keplerian acceleration and its derivative of a planet on equally
+ * spaced epochs of a given window. The ephemerides within the window are then obtained by quintic Hermite
+ * interpolation between the two enclosing nodes, which costs a few tens of floating point operations instead of the solution
+ * of Kepler's equation (or of whatever the planet uses to compute its ephemerides).
+ *
+ * The nodes spacing is halved until the interpolation error, measured at a quarter, half and three quarters of
+ * the way between consecutive nodes against the planet ephemerides, is below the requested tolerances.
+ * Keplerian planets converge quickly; planets whose velocity is not exactly the derivative of their position
+ * (e.g. planet_ss, whose orbital elements drift in time) converge slowly in position and need looser tolerances.
+ *
+ * The table cannot be modified once built, hence it can be safely shared among threads (see planet::set_eph_table()).
+ */
+class __KEP_TOOL_VISIBLE eph_table
+{
+public:
+	eph_table();
+	eph_table(const planet &, const double &, const double &, const double &, const double &);
+
+	/// Checks whether an epoch is within the window
+	/**
+	 * \param[in] mjd2000 epoch
+	 *
+	 * @return true if mjd2000 is within the window of the table
+	 */
+	bool covers(const double &mjd2000) const {return (mjd2000 >= m_start && mjd2000 <= m_end);}
+	void get_eph(const double &, array3D &, array3D &) const;
+	double get_start() const;
+	double get_end() const;
+	double get_step() const;
+	std::size_t get_size() const;
+private:
+	static void eval(const double *, const double *, const double &, const double &, array3D &, array3D &);
+	void node(const planet &, const double &, double *) const;
+
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & m_start;
+		ar & m_end;
+		ar & m_step;
+		ar & m_nodes;
+	}
+
+	double m_start;
+	double m_end;
+	double m_step;
+	// Position, velocity, acceleration and jerk (12 values) for each node.
+	std::vector<double> m_nodes;
+};
+
+} /// End of namespace kep_toolbox
+
+#endif // KEP_TOOLBOX_EPH_TABLE_H
@@ -53,10 +53,6 @@ planet::planet(const epoch& ref_epoch, const array6D& orbital_elements_, const d
 	if (mu_self_ <= 0) {
 		throw_value_error("The gravitational parameter of the planet needs to be strictly positive");
 	}
-	for (int i = 0; i < 3; ++i) {
-		cached_r[i] = 0;
-		cached_v[i] = 0;
-	}
 	planet::build_planet(ref_epoch, orbital_elements_, mu_central_body_, mu_self_, radius_, safe_radius_, name_);
 }
 
@@ -71,10 +67,6 @@ planet::planet(const epoch& ref_epoch, const array3D& r0, const array3D& v0, con
 	if (mu_self_ <= 0) {
 		throw_value_error("The gravitational parameter of the planet needs to be strictly positive");
 	}
-	for (int i = 0; i < 3; ++i) {
-		cached_r[i] = 0;
-		cached_v[i] = 0;
-	}
 	array6D orbital_elements;
 	ic2par(r0,v0, mu_central_body_, orbital_elements);
 	orbital_elements[5] = e2m(orbital_elements[5],orbital_elements[1]);
@@ -113,13 +105,11 @@ void planet::get_eph(const epoch& when, array3D &r, array3D &v) const{
 }
 
 void planet::get_eph(const double mjd2000, array3D &r, array3D &v) const {
-	if (cached_epoch_mjd2000 == boost::none || cached_epoch_mjd2000 != mjd2000)
-	{
-		this->eph_impl(mjd2000, cached_r, cached_v);
-		cached_epoch_mjd2000 = mjd2000;
+	if (m_eph_table && m_eph_table->covers(mjd2000)) {
+		m_eph_table->get_eph(mjd2000, r, v);
+	} else {
+		this->eph_impl(mjd2000, r, v);
 	}
-	r = cached_r;
-	v = cached_v; 
 }
 
 array3D planet::get_position(const epoch& when) const {
@@ -156,6 +146,51 @@ planet::~planet() {}
 
 std::string planet::get_name() const {return m_name;}
 
+/// Precomputes the ephemerides over a window of epochs
+/**
+ * Builds a kep_toolbox::eph_table from which get_eph() will interpolate the ephemerides of all the epochs
+ * in [start,end], instead of computing them. The table is shared with the copies of the planet made afterwards
+ * (e.g., by the problems or the islands using it), and it can be read concurrently from any thread.
+ *
+ * \param[in] start first epoch of the window
+ * \param[in] end last epoch of the window
+ * \param[in] pos_tol maximum interpolation error on the position (SI units)
+ * \param[in] vel_tol maximum interpolation error on the velocity (SI units)
+ *
+ * \throws value_error if the window is empty or if the tolerances cannot be met (see kep_toolbox::eph_table)
+ */
+void planet::set_eph_table(const epoch &start, const epoch &end, const double &pos_tol, const double &vel_tol) {
+	m_eph_table.reset(new eph_table(*this, start.mjd2000(), end.mjd2000(), pos_tol, vel_tol));
+}
+
+/// Removes the ephemerides table
+/**
+ * The ephemerides will be computed again for any epoch. Copies of the planet sharing the table are not affected.
+ */
+void planet::unset_eph_table() {
+	m_eph_table.reset();
+}
+
+/// Returns the ephemerides table
+/**
+ * @return pointer to the ephemerides table, null if none was set
+ */
+boost::shared_ptr<const eph_table> planet::get_eph_table() const {
+	return m_eph_table;
+}
+
+/// Thread safety of the ephemerides
+/**
+ * Whether the ephemerides of the same planet may be computed concurrently from several threads. Planets whose
+ * ephemerides mutate internal state must override this method and return false, and so must the wrappers of planets
+ * implemented in Python, which need the interpreter lock.
+ *
+ * @return true: the keplerian propagation only reads the planet.
+ */
+bool planet::is_thread_safe() const {
+	return true;
+}
+
 double planet::compute_period() const {
 	return 2* boost::math::constants::pi<double>() * std::sqrt(std::pow(get_elements()[0],3) / get_mu_central_body());
 
@@ -36,6 +36,7 @@
 #include "../exceptions.h"
 #include "../astro_constants.h"
 #include "../epoch.h"
+#include "eph_table.h"
 
 namespace kep_toolbox{
 
@@ -52,6 +53,10 @@ typedef boost::shared_ptr<planet> planet_ptr;
  * and its orbit. The orbit is internally represented by the planet cartesian coordinates
  * at a given reference epoch.
  *
+ * Ephemerides can optionally be interpolated from a precomputed kep_toolbox::eph_table (see set_eph_table()),
+ * which is shared (read-only) by all the copies of the planet. Computing the ephemerides does not modify the
+ * planet, hence the same planet can be queried concurrently from several threads.
+ *
  * @author Dario Izzo (dario.izzo _AT_ googlemail.com)
  */
 
@@ -208,6 +213,15 @@ public:
 	/// Computes the orbital period
 	double compute_period() const;
 
+	virtual bool is_thread_safe() const;
+
+	/** @name Ephemerides table */
+	//@{
+	void set_eph_table(const epoch &, const epoch &, const double &pos_tol = 1000., const double &vel_tol = 1e-3);
+	void unset_eph_table();
+	boost::shared_ptr<const eph_table> get_eph_table() const;
+	//@}
+
 protected:
 	/// Builds the planet assiging all values to members
 	/**
@@ -225,9 +239,10 @@ protected:
 private:
 	virtual void eph_impl(const double mjd2000, array3D &r, array3D &v) const;
 
+	friend class eph_table;
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & keplerian_elements;
 		ar & mean_motion;
@@ -237,6 +252,11 @@ private:
 		ar & mu_self;
 		ar & mu_central_body;
 		ar & m_name;
+		if (version >= 1) {
+			ar & m_eph_table;
+		} else {
+			m_eph_table.reset();
+		}
 	}
 // Serialization code (END)
 
@@ -248,11 +268,10 @@ protected:
 	double safe_radius;
 	double mu_self;
 	double mu_central_body;
-	mutable boost::optional<double> cached_epoch_mjd2000;
-	mutable array3D cached_r;
-	mutable array3D cached_v;
 
 	std::string m_name;
+	// Interpolated ephemerides, shared by the copies of the planet.
+	boost::shared_ptr<eph_table> m_eph_table;
 
 };
 
@@ -261,6 +280,8 @@ __KEP_TOOL_VISIBLE std::ostream &operator<<(std::ostream &s, const planet &body)
 
 // Serialization code
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(kep_toolbox::planet)
+// Version 1: interpolated ephemerides table.
+BOOST_CLASS_VERSION(kep_toolbox::planet,1)
 // Serialization code (END)
 
 #endif // KEP_TOOLBOX_PLANET_H
@@ -71,6 +71,14 @@ catch (SatelliteException& e)
 		throw_value_error(e.what());
 }
 
+/// Thread safety of the ephemerides
+/**
+ * @return false: the SGP4 propagator updates its integrator state at each call.
+ */
+bool planet_tle::is_thread_safe() const {
+	return false;
+}
+
 void planet_tle::eph_impl(const double mjd2000, array3D &r, array3D &v) const{
 	Vector position;
 	Vector velocity;
@@ -59,6 +59,7 @@ public:
 	 */
 	planet_tle(const std::string & = "1 23177U 94040C   06175.45752052  .00000386  00000-0  76590-3 0    95", const std::string & = "2 23177   7.0496 179.8238 7258491 296.0482   8.3061  2.25906668 97438");
 	planet_ptr clone() const;
+	bool is_thread_safe() const;
 	/// Computes the planet/system position and velocity w.r.t the Sun
 	/**
 		* \param[in] when Epoch in which ephemerides are required
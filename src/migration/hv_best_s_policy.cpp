@@ -44,14 +44,27 @@ namespace pagmo { namespace migration {
  * @param[in] rate migration rate.
  * @param[in] type migration rate type.
  * @param[in] nadir_eps epsilon value for the nadir point computation
+ * @param[in] hv_algorithm hypervolume algorithm used for the computation of the contributions, chosen dynamically if null
+ * (e.g. pagmo::util::hv_algorithm::adaptive, to bound its cost on many objectives)
  *
  * @see base_s_policy::base_s_policy.
  */
-hv_best_s_policy::hv_best_s_policy(const double &rate, rate_type type, const double nadir_eps):base_s_policy(rate,type), m_nadir_eps(nadir_eps) { }
+hv_best_s_policy::hv_best_s_policy(const double &rate, rate_type type, const double nadir_eps, const util::hv_algorithm::base_ptr hv_algorithm):
+	base_s_policy(rate,type), m_nadir_eps(nadir_eps), m_hv_algorithm(hv_algorithm) {}
 
 base_s_policy_ptr hv_best_s_policy::clone() const
 {
-	return base_s_policy_ptr(new hv_best_s_policy(*this));
+	// The hypervolume algorithm is cloned as well, as the algorithms may keep a state (e.g., random number generators).
+	return base_s_policy_ptr(new hv_best_s_policy(m_rate, m_type, m_nadir_eps, m_hv_algorithm ? m_hv_algorithm->clone() : m_hv_algorithm));
+}
+
+/// Get the hypervolume algorithm
+/**
+ * @return shared pointer to the hypervolume algorithm used for the computation of the contributions (null if it is chosen dynamically).
+ */
+util::hv_algorithm::base_ptr hv_best_s_policy::get_hv_algorithm() const
+{
+	return m_hv_algorithm;
 }
 
 bool hv_best_s_policy::sort_point_pairs_desc(const std::pair<unsigned int, double> &a, const std::pair<unsigned int, double> &b)
@@ -127,7 +140,7 @@ std::vector<population::individual_type> hv_best_s_policy::select(population &po
 
 			}
 			hypervolume hv(fronts_f[front_idx], false);
-			std::vector<double> c = hv.contributions(refpoint);
+			std::vector<double> c = (m_hv_algorithm ? hv.contributions(refpoint, m_hv_algorithm) : hv.contributions(refpoint));
 
 			std::vector<std::pair<unsigned int, double> > point_pairs;
 			point_pairs.resize(true_front_size);
@@ -46,14 +46,27 @@ namespace pagmo { namespace migration {
  * @param[in] rate migration rate.
  * @param[in] type migration rate type.
  * @param[in] nadir_eps epsilon value for the nadir point computation
+ * @param[in] hv_algorithm hypervolume algorithm used for the computation of the contributions, chosen dynamically if null
+ * (e.g. pagmo::util::hv_algorithm::adaptive, to bound its cost on many objectives)
  *
  * @see base_r_policy::base_r_policy.
  */
-hv_fair_r_policy::hv_fair_r_policy(const double &rate, rate_type type, const double nadir_eps):base_r_policy(rate,type), m_nadir_eps(nadir_eps) {}
+hv_fair_r_policy::hv_fair_r_policy(const double &rate, rate_type type, const double nadir_eps, const util::hv_algorithm::base_ptr hv_algorithm):
+	base_r_policy(rate,type), m_nadir_eps(nadir_eps), m_hv_algorithm(hv_algorithm) {}
 
 base_r_policy_ptr hv_fair_r_policy::clone() const
 {
-	return base_r_policy_ptr(new hv_fair_r_policy(*this));
+	// The hypervolume algorithm is cloned as well, as the algorithms may keep a state (e.g., random number generators).
+	return base_r_policy_ptr(new hv_fair_r_policy(m_rate, m_type, m_nadir_eps, m_hv_algorithm ? m_hv_algorithm->clone() : m_hv_algorithm));
+}
+
+/// Get the hypervolume algorithm
+/**
+ * @return shared pointer to the hypervolume algorithm used for the computation of the contributions (null if it is chosen dynamically).
+ */
+util::hv_algorithm::base_ptr hv_fair_r_policy::get_hv_algorithm() const
+{
+	return m_hv_algorithm;
 }
 
 // Selection implementation.
@@ -183,10 +196,10 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 				copy(fronts_f[front_idx + 1].begin(), fronts_f[front_idx +1].end(), back_inserter(merged_front));
 
 				hypervolume hv(merged_front, false);
-				c = hv.contributions(refpoint);
+				c = (m_hv_algorithm ? hv.contributions(refpoint, m_hv_algorithm) : hv.contributions(refpoint));
 			} else {
 				hypervolume hv(fronts_f[front_idx], false);
-				c = hv.contributions(refpoint);
+				c = (m_hv_algorithm ? hv.contributions(refpoint, m_hv_algorithm) : hv.contributions(refpoint));
 			}
 
 			// Initiate the pairs and sort by second item (exclusive volume)
@@ -239,11 +252,11 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	std::vector<std::pair<unsigned int, double> >::iterator it;
 
 	for(it = available_immigrants.begin() ; it != available_immigrants.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = (m_hv_algorithm ? hv.exclusive((*it).first, refpoint, m_hv_algorithm) : hv.exclusive((*it).first, refpoint));
 	}
 
 	for(it = discarded_islanders.begin() ; it != discarded_islanders.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = (m_hv_algorithm ? hv.exclusive((*it).first, refpoint, m_hv_algorithm) : hv.exclusive((*it).first, refpoint));
 	}
 
 	// Sort islanders and immigrants according to exclusive hypervolume
@@ -31,6 +31,7 @@
 #include "../config.h"
 #include "../population.h"
 #include "../serialization.h"
+#include "../util/hypervolume.h"
 #include "base.h"
 #include "base_r_policy.h"
 
@@ -51,21 +52,30 @@ namespace pagmo { namespace migration {
 class __PAGMO_VISIBLE hv_fair_r_policy: public base_r_policy
 {
 public:
-	hv_fair_r_policy(const double &rate = 1, rate_type type = absolute, double nadir_eps = 1.0);
+	hv_fair_r_policy(const double &rate = 1, rate_type type = absolute, double nadir_eps = 1.0, const util::hv_algorithm::base_ptr hv_algorithm = util::hv_algorithm::base_ptr());
 	base_r_policy_ptr clone() const;
+	util::hv_algorithm::base_ptr get_hv_algorithm() const;
 	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> >
 		select(const std::vector<population::individual_type> &, const population &) const;
 private:
 	static bool ind_cmp(const std::pair<unsigned int, double> &, const std::pair<unsigned int, double> &);
 	static bool sort_point_pairs_asc(const std::pair<unsigned int, double> &a, const std::pair<unsigned int, double> &b);
 	const double m_nadir_eps;
+	// Algorithm used for the computation of the contributions (chosen dynamically if null)
+	util::hv_algorithm::base_ptr m_hv_algorithm;
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base_r_policy>(*this);
 		ar & const_cast<double &>(m_nadir_eps);
+		// Version 0 archives predate the configurable algorithm: fall back to the dynamic choice.
+		if (version >= 1) {
+			ar & m_hv_algorithm;
+		} else {
+			m_hv_algorithm.reset();
+		}
 	}
 };
 
@@ -73,4 +83,7 @@ private:
 
 BOOST_CLASS_EXPORT_KEY(pagmo::migration::hv_fair_r_policy)
 
+// Version 1: hypervolume algorithm used for the contributions.
+BOOST_CLASS_VERSION(pagmo::migration::hv_fair_r_policy,1)
+
 #endif
@@ -45,14 +45,27 @@ namespace pagmo { namespace migration {
  * @param[in] rate migration rate.
  * @param[in] type migration rate type.
  * @param[in] nadir_eps epsilon value for the nadir point computation
+ * @param[in] hv_algorithm hypervolume algorithm used for the computation of the contributions, chosen dynamically if null
+ * (e.g. pagmo::util::hv_algorithm::adaptive, to bound its cost on many objectives)
  *
  * @see base_r_policy::base_r_policy.
  */
-hv_greedy_r_policy::hv_greedy_r_policy(const double &rate, rate_type type, const double nadir_eps):base_r_policy(rate,type), m_nadir_eps(nadir_eps) {}
+hv_greedy_r_policy::hv_greedy_r_policy(const double &rate, rate_type type, const double nadir_eps, const util::hv_algorithm::base_ptr hv_algorithm):
+	base_r_policy(rate,type), m_nadir_eps(nadir_eps), m_hv_algorithm(hv_algorithm) {}
 
 base_r_policy_ptr hv_greedy_r_policy::clone() const
 {
-	return base_r_policy_ptr(new hv_greedy_r_policy(*this));
+	// The hypervolume algorithm is cloned as well, as the algorithms may keep a state (e.g., random number generators).
+	return base_r_policy_ptr(new hv_greedy_r_policy(m_rate, m_type, m_nadir_eps, m_hv_algorithm ? m_hv_algorithm->clone() : m_hv_algorithm));
+}
+
+/// Get the hypervolume algorithm
+/**
+ * @return shared pointer to the hypervolume algorithm used for the computation of the contributions (null if it is chosen dynamically).
+ */
+util::hv_algorithm::base_ptr hv_greedy_r_policy::get_hv_algorithm() const
+{
+	return m_hv_algorithm;
 }
 
 // Selection implementation.
@@ -174,7 +187,7 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 		// Initiate the hypervolume object and compute the least contributor
 		hypervolume hv(fronts_f[front_idx], false);
 		hv.set_copy_points(false);
-		unsigned int lc_idx = hv.least_contributor(refpoint);
+		unsigned int lc_idx = (m_hv_algorithm ? hv.least_contributor(refpoint, m_hv_algorithm) : hv.least_contributor(refpoint));
 
 		// Fix the index shift
 		unsigned int orig_lc_idx = fronts_i[front_idx][orig_indices[lc_idx]];
@@ -220,11 +233,11 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	std::vector<std::pair<unsigned int, double> >::iterator it;
 
 	for(it = available_immigrants.begin() ; it != available_immigrants.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = (m_hv_algorithm ? hv.exclusive((*it).first, refpoint, m_hv_algorithm) : hv.exclusive((*it).first, refpoint));
 	}
 
 	for(it = discarded_islanders.begin() ; it != discarded_islanders.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = (m_hv_algorithm ? hv.exclusive((*it).first, refpoint, m_hv_algorithm) : hv.exclusive((*it).first, refpoint));
 	}
 
 	// Sort islanders and immigrants according to exclusive hypervolume
@@ -43,14 +43,27 @@ namespace pagmo { namespace migration {
  * @param[in] rate migration rate.
  * @param[in] type migration rate type.
  * @param[in] nadir_eps epsilon value for the nadir point computation
+ * @param[in] hv_algorithm hypervolume algorithm used for the computation of the contributions, chosen dynamically if null
+ * (e.g. pagmo::util::hv_algorithm::adaptive, to bound its cost on many objectives)
  *
  * @see base_s_policy::base_s_policy.
  */
-hv_greedy_s_policy::hv_greedy_s_policy(const double &rate, rate_type type, const double nadir_eps):base_s_policy(rate,type), m_nadir_eps(nadir_eps) { }
+hv_greedy_s_policy::hv_greedy_s_policy(const double &rate, rate_type type, const double nadir_eps, const util::hv_algorithm::base_ptr hv_algorithm):
+	base_s_policy(rate,type), m_nadir_eps(nadir_eps), m_hv_algorithm(hv_algorithm) {}
 
 base_s_policy_ptr hv_greedy_s_policy::clone() const
 {
-	return base_s_policy_ptr(new hv_greedy_s_policy(*this));
+	// The hypervolume algorithm is cloned as well, as the algorithms may keep a state (e.g., random number generators).
+	return base_s_policy_ptr(new hv_greedy_s_policy(m_rate, m_type, m_nadir_eps, m_hv_algorithm ? m_hv_algorithm->clone() : m_hv_algorithm));
+}
+
+/// Get the hypervolume algorithm
+/**
+ * @return shared pointer to the hypervolume algorithm used for the computation of the contributions (null if it is chosen dynamically).
+ */
+util::hv_algorithm::base_ptr hv_greedy_s_policy::get_hv_algorithm() const
+{
+	return m_hv_algorithm;
 }
 
 std::vector<population::individual_type> hv_greedy_s_policy::select(population &pop) const
@@ -118,7 +131,7 @@ std::vector<population::individual_type> hv_greedy_s_policy::select(population &
 			// Compute the greatest contributor
 			hypervolume hv(fronts_f[front_idx], false);
 			hv.set_copy_points(false);
-			unsigned int gc_idx = hv.greatest_contributor(refpoint);
+			unsigned int gc_idx = (m_hv_algorithm ? hv.greatest_contributor(refpoint, m_hv_algorithm) : hv.greatest_contributor(refpoint));
 			result.push_back(pop.get_individual(fronts_i[front_idx][orig_indices[gc_idx]]));
 			
 			// Remove it from the front along with its index
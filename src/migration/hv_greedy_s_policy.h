@@ -30,6 +30,7 @@
 #include "../config.h"
 #include "../population.h"
 #include "../serialization.h"
+#include "../util/hypervolume.h"
 #include "base.h"
 #include "base_s_policy.h"
 
@@ -52,18 +53,27 @@ namespace pagmo { namespace migration {
 class __PAGMO_VISIBLE hv_greedy_s_policy: public base_s_policy
 {
 public:
-	hv_greedy_s_policy(const double &rate = 1, rate_type type = absolute, double nadir_eps = 1.0);
+	hv_greedy_s_policy(const double &rate = 1, rate_type type = absolute, double nadir_eps = 1.0, const util::hv_algorithm::base_ptr hv_algorithm = util::hv_algorithm::base_ptr());
 	base_s_policy_ptr clone() const;
+	util::hv_algorithm::base_ptr get_hv_algorithm() const;
 	std::vector<population::individual_type> select(population &) const;
 private:
 	const double m_nadir_eps;
+	// Algorithm used for the computation of the contributions (chosen dynamically if null)
+	util::hv_algorithm::base_ptr m_hv_algorithm;
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base_s_policy>(*this);
 		ar & const_cast<double &>(m_nadir_eps);
+		// Version 0 archives predate the configurable algorithm: fall back to the dynamic choice.
+		if (version >= 1) {
+			ar & m_hv_algorithm;
+		} else {
+			m_hv_algorithm.reset();
+		}
 	}
 };
 
@@ -71,4 +81,7 @@ private:
 
 BOOST_CLASS_EXPORT_KEY(pagmo::migration::hv_greedy_s_policy)
 
+// Version 1: hypervolume algorithm used for the contributions.
+BOOST_CLASS_VERSION(pagmo::migration::hv_greedy_s_policy,1)
+
 #endif
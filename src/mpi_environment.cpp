@@ -22,27 +22,178 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
 #include <cstdlib>
+#include <deque>
+#include <istream>
+#include <list>
+#include <map>
 #include <mpi.h>
+#include <ostream>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "exceptions.h"
 #include "algorithm/base.h"
 #include "population.h"
+#include "problem/base.h"
 #include "mpi_environment.h"
 
 namespace pagmo
 {
 
+namespace {
+
+// Kinds of messages sent by the root node to the slaves.
+enum message_kind {shutdown_message = 0, evolve_message = 1};
+
+// Status of the replies sent by the slaves to the root node.
+enum reply_status {reply_ok = 0, reply_miss = 1, reply_error = 2};
+
+// Temporarily detach the problem from a population, so that only the individuals are (de)serialized.
+class problem_detacher: private boost::noncopyable
+{
+	public:
+		explicit problem_detacher(population &pop):m_pop(pop),m_prob()
+		{
+			m_prob.swap(population_access::get_problem_ptr(m_pop));
+		}
+		~problem_detacher()
+		{
+			m_prob.swap(population_access::get_problem_ptr(m_pop));
+		}
+	private:
+		population		&m_pop;
+		problem::base_ptr	m_prob;
+};
+
+// Cache key of a serialized object.
+std::pair<std::size_t,std::size_t> make_key(const std::vector<char> &bytes)
+{
+	return std::make_pair(boost::hash_range(bytes.begin(),bytes.end()),bytes.size());
+}
+
+// Move the record of key at the front of the list of the most recently used records. Returns false if the key was not present,
+// or if it was present with different bytes (i.e., in case of hash collision): in this case the record is replaced, and the least
+// recently used records exceeding the capacity are discarded.
+bool lru_touch(std::list<std::pair<std::pair<std::size_t,std::size_t>,boost::shared_ptr<const std::vector<char> > > > &records,
+	const std::pair<std::size_t,std::size_t> &key, const boost::shared_ptr<const std::vector<char> > &bytes)
+{
+	typedef std::list<std::pair<std::pair<std::size_t,std::size_t>,boost::shared_ptr<const std::vector<char> > > >::iterator iterator;
+	for (iterator it = records.begin(); it != records.end(); ++it) {
+		if (it->first != key) {
+			continue;
+		}
+		if (it->second == bytes || *it->second == *bytes) {
+			it->second = bytes;
+			records.splice(records.begin(),records,it);
+			return true;
+		}
+		records.erase(it);
+		break;
+	}
+	records.push_front(std::make_pair(key,bytes));
+	if (records.size() > mpi_environment::remote_cache_capacity) {
+		records.pop_back();
+	}
+	return false;
+}
+
+// Same as above for the caches of the slaves, storing the actual objects.
+template <class Ptr>
+void cache_insert(std::list<std::pair<std::pair<std::size_t,std::size_t>,Ptr> > &cache, const std::pair<std::size_t,std::size_t> &key, const Ptr &ptr)
+{
+	typedef typename std::list<std::pair<std::pair<std::size_t,std::size_t>,Ptr> >::iterator iterator;
+	for (iterator it = cache.begin(); it != cache.end(); ++it) {
+		if (it->first == key) {
+			cache.erase(it);
+			break;
+		}
+	}
+	cache.push_front(std::make_pair(key,ptr));
+	if (cache.size() > mpi_environment::remote_cache_capacity) {
+		cache.pop_back();
+	}
+}
+
+template <class Ptr>
+Ptr cache_find(std::list<std::pair<std::pair<std::size_t,std::size_t>,Ptr> > &cache, const std::pair<std::size_t,std::size_t> &key)
+{
+	typedef typename std::list<std::pair<std::pair<std::size_t,std::size_t>,Ptr> >::iterator iterator;
+	for (iterator it = cache.begin(); it != cache.end(); ++it) {
+		if (it->first == key) {
+			cache.splice(cache.begin(),cache,it);
+			return cache.front().second;
+		}
+	}
+	return Ptr();
+}
+
+}
+
 bool mpi_environment::m_initialised = false;
 bool mpi_environment::m_multithread = false;
+int mpi_environment::m_size = 0;
+int mpi_environment::m_rank = 0;
+boost::scoped_ptr<boost::thread> mpi_environment::m_progress_thread;
+boost::mutex mpi_environment::m_progress_mutex;
+boost::condition_variable mpi_environment::m_progress_cond;
+std::deque<boost::shared_ptr<mpi_environment::exchange_state> > mpi_environment::m_pending;
+bool mpi_environment::m_stop = false;
+boost::mutex mpi_environment::m_cache_mutex;
+std::map<int,std::list<std::pair<mpi_environment::cache_key,mpi_environment::bytes_ptr> > > mpi_environment::m_remote_problems;
+std::map<int,std::list<std::pair<mpi_environment::cache_key,mpi_environment::bytes_ptr> > > mpi_environment::m_remote_algorithms;
+const std::size_t mpi_environment::remote_cache_capacity;
+
+/// Default constructor.
+/**
+ * Construct a handle that does not refer to any exchange.
+ */
+mpi_environment::future::future():m_state()
+{}
+
+mpi_environment::future::future(const boost::shared_ptr<exchange_state> &state):m_state(state)
+{}
+
+/// Wait for the reply.
+/**
+ * Will block until the reply has been received. No-op if the handle does not refer to any exchange.
+ */
+void mpi_environment::future::wait() const
+{
+	if (!m_state) {
+		return;
+	}
+	boost::unique_lock<boost::mutex> lock(m_state->m_mutex);
+	while (!m_state->m_done) {
+		m_state->m_cond.wait(lock);
+	}
+}
+
+/// Query the status of the exchange.
+/**
+ * @return true if the reply has been received or if the handle does not refer to any exchange, false otherwise.
+ */
+bool mpi_environment::future::done() const
+{
+	if (!m_state) {
+		return true;
+	}
+	boost::lock_guard<boost::mutex> lock(m_state->m_mutex);
+	return m_state->m_done;
+}
 
 /// Default constructor.
 /**
  * Initialises the MPI environment with MPI_Init_thread. pagmo::mpi_environment objects should be created only in the main
- * thread of execution.
+ * thread of execution. On the root node, the progress thread handling the communication with the slaves is started.
  * 
  * @throws std::runtime_error if another instance of this class has already been created,
  * or if the MPI implementation does not support at least the MPI_THREAD_SERIALIZED thread level and this is the root node,
@@ -59,6 +210,8 @@ mpi_environment::mpi_environment()
 	if (thread_level_provided >= MPI_THREAD_MULTIPLE) {
 		m_multithread = true;
 	}
+	MPI_Comm_size(MPI_COMM_WORLD,&m_size);
+	MPI_Comm_rank(MPI_COMM_WORLD,&m_rank);
 	if (get_rank()) {
 		// If this is a slave, it will have to stop here, listen for jobs, execute them, and exit()
 		// when signalled to do so.
@@ -72,18 +225,29 @@ mpi_environment::mpi_environment()
 	if (get_size() < 2) {
 		pagmo_throw(std::runtime_error,"the size of the MPI world must be at least 2");
 	}
+	// From now on, all the communication of the root node goes through the progress thread.
+	m_stop = false;
+	m_progress_thread.reset(new boost::thread(&mpi_environment::progress));
 }
 
 /// Destructor.
 /**
- * Will send a shutdown signal to all processes with nonzero rank and call MPI_Finalize().
+ * Will stop the progress thread, send a shutdown signal to all processes with nonzero rank and call MPI_Finalize().
  */
 mpi_environment::~mpi_environment()
 {
 	// In theory this should never be called by the slaves.
 	pagmo_assert(!get_rank());
 	pagmo_assert(m_initialised);
-	std::pair<boost::shared_ptr<population>,algorithm::base_ptr> shutdown_payload;
+	// Let the progress thread complete the exchanges in flight, then stop it.
+	{
+		boost::lock_guard<boost::mutex> lock(m_progress_mutex);
+		m_stop = true;
+	}
+	m_progress_cond.notify_all();
+	m_progress_thread->join();
+	m_progress_thread.reset();
+	const int shutdown_payload = shutdown_message;
 	for (int i = 1; i < get_size(); ++i) {
 		// Send the shutdown signal to all slaves.
 		send(shutdown_payload,i);
@@ -120,7 +284,7 @@ bool mpi_environment::iprobe(int source)
 
 /// MPI world size.
 /**
- * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ * This method is always thread-safe.
  * 
  * @return the MPI world size.
  * 
@@ -129,14 +293,12 @@ bool mpi_environment::iprobe(int source)
 int mpi_environment::get_size()
 {
 	check_init();
-	int retval;
-	MPI_Comm_size(MPI_COMM_WORLD,&retval);
-	return retval;
+	return m_size;
 }
 
 /// MPI rank.
 /**
- * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ * This method is always thread-safe.
  * 
  * @return the MPI rank of the process.
  * 
@@ -145,9 +307,7 @@ int mpi_environment::get_size()
 int mpi_environment::get_rank()
 {
 	check_init();
-	int retval;
-	MPI_Comm_rank(MPI_COMM_WORLD,&retval);
-	return retval;
+	return m_rank;
 }
 
 /// Thread-safety of the MPI implementation.
@@ -165,41 +325,335 @@ bool mpi_environment::is_multithread()
 	return m_multithread;
 }
 
+// Blocking send of a raw buffer.
+void mpi_environment::send_buffer(const std::vector<char> &buffer, int destination)
+{
+	check_init();
+	// Send size and payload in a single message, the receiver will probe for the size.
+	const int size = boost::numeric_cast<int>(buffer.size());
+	MPI_Send(static_cast<void *>(buffer.empty() ? 0 : const_cast<char *>(&buffer[0])),size,MPI_CHAR,destination,0,MPI_COMM_WORLD);
+}
+
+// Blocking receive of a raw buffer.
+void mpi_environment::recv_buffer(std::vector<char> &buffer, int source)
+{
+	check_init();
+	MPI_Status status;
+	// Wait for the message and get its size.
+	MPI_Probe(source,0,MPI_COMM_WORLD,&status);
+	int size;
+	MPI_Get_count(&status,MPI_CHAR,&size);
+	buffer.resize(boost::numeric_cast<std::vector<char>::size_type>(size));
+	// Receive the payload.
+	MPI_Recv(static_cast<void *>(buffer.empty() ? 0 : &buffer[0]),size,MPI_CHAR,source,0,MPI_COMM_WORLD,&status);
+}
+
+// Post a raw buffer to the progress thread. The content of buffer is moved into the exchange.
+mpi_environment::future mpi_environment::post_buffer(std::vector<char> &buffer, int destination)
+{
+	check_init();
+	const boost::shared_ptr<exchange_state> state(new exchange_state(destination));
+	state->m_out.swap(buffer);
+	enqueue(state);
+	return future(state);
+}
+
+// Reset the state of a problem which does not define it, so that equal problems serialize to the same bytes.
+void mpi_environment::reset_transient_state(const problem::base &prob)
+{
+	prob.reset_caches();
+	prob.m_fevals = 0;
+	prob.m_cevals = 0;
+	std::fill(prob.m_tmp_f1.begin(),prob.m_tmp_f1.end(),0.);
+	std::fill(prob.m_tmp_f2.begin(),prob.m_tmp_f2.end(),0.);
+	std::fill(prob.m_tmp_c1.begin(),prob.m_tmp_c1.end(),0.);
+	std::fill(prob.m_tmp_c2.begin(),prob.m_tmp_c2.end(),0.);
+}
+
+// Account for the evaluations performed remotely.
+void mpi_environment::add_evals(const problem::base &prob, unsigned int fevals, unsigned int cevals)
+{
+	prob.m_fevals += fevals;
+	prob.m_cevals += cevals;
+}
+
+/// Default constructor.
+mpi_environment::problem_payload::problem_payload():m_prob(),m_bytes(),m_key()
+{}
+
+/// Evolve a population on a remote processor.
+/**
+ * Evolve pop with algo on the slave processor, which must not be busy with other evolutions. Problem and algorithm are
+ * sent only if they are not in the cache of the slave (see \ref mpi_model "the MPI model"); the evaluations performed remotely are accounted
+ * for in the problem of pop. If the slave fails to send back the evolved population, pop is left untouched.
+ * The problem of pop is serialized only if payload does not already refer to it: otherwise the bytes stored in payload are reused.
+ * This method is thread-safe (provided that concurrent calls use different payloads), and it can be called only from the root node.
+ *
+ * @param[in,out] pop population to be evolved.
+ * @param[in] algo algorithm used for the evolution.
+ * @param[in] processor rank of the slave.
+ * @param[in,out] payload serialized problem of the island evolving pop.
+ *
+ * @throws std::runtime_error if the MPI environment has not been initialised or if the slave cannot handle the request.
+ */
+void mpi_environment::remote_evolve(population &pop, const algorithm::base &algo, int processor, problem_payload &payload)
+{
+	check_init();
+	// Problem and algorithm are serialized once, the bytes are used both to compute
+	// the cache keys and as payload on cache misses.
+	if (payload.m_prob != population_access::get_problem_ptr(pop)) {
+		boost::shared_ptr<std::vector<char> > bytes(new std::vector<char>());
+		const problem::base_ptr prob = pop.problem().clone();
+		reset_transient_state(*prob);
+		binary_save(*bytes,prob);
+		payload.m_prob = population_access::get_problem_ptr(pop);
+		payload.m_key = make_key(*bytes);
+		payload.m_bytes = bytes;
+	}
+	const bytes_ptr prob_bytes = payload.m_bytes;
+	boost::shared_ptr<std::vector<char> > algo_bytes(new std::vector<char>());
+	binary_save(*algo_bytes,algo.clone());
+	const cache_key prob_key = payload.m_key, algo_key = make_key(*algo_bytes);
+	bool send_prob, send_algo;
+	{
+		boost::lock_guard<boost::mutex> lock(m_cache_mutex);
+		send_prob = !lru_touch(m_remote_problems[processor],prob_key,prob_bytes);
+		send_algo = !lru_touch(m_remote_algorithms[processor],algo_key,algo_bytes);
+	}
+	while (true) {
+		std::vector<char> buffer;
+		{
+			vector_char_sink sink(buffer);
+			std::ostream os(&sink);
+			boost::archive::binary_oarchive oa(os);
+			const int kind = evolve_message;
+			oa << kind << prob_key << algo_key << send_prob << send_algo;
+			if (send_prob) {
+				oa << *prob_bytes;
+			}
+			if (send_algo) {
+				oa << *algo_bytes;
+			}
+			problem_detacher detacher(pop);
+			const population &cpop = pop;
+			oa << cpop;
+		}
+		const future reply = post_buffer(buffer,processor);
+		reply.wait();
+		vector_char_source source(reply.m_state->m_in);
+		std::istream is(&source);
+		boost::archive::binary_iarchive ia(is);
+		int status;
+		ia >> status;
+		if (status == reply_miss) {
+			if (send_prob && send_algo) {
+				pagmo_throw(std::runtime_error,"the slave could not find the problem or the algorithm it was sent");
+			}
+			// Fall back to a full send.
+			send_prob = true;
+			send_algo = true;
+			continue;
+		}
+		if (status == reply_ok) {
+			unsigned int fevals, cevals;
+			ia >> fevals >> cevals;
+			population in(pop.problem());
+			{
+				problem_detacher detacher(in);
+				ia >> in;
+			}
+			// Take the evolved individuals, keep the problem.
+			pop.swap(in);
+			population_access::get_problem_ptr(pop).swap(population_access::get_problem_ptr(in));
+			add_evals(pop.problem(),fevals,cevals);
+		}
+		return;
+	}
+}
+
+// Hand over an exchange to the progress thread.
+void mpi_environment::enqueue(const boost::shared_ptr<exchange_state> &state)
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_progress_mutex);
+		if (!m_progress_thread || m_stop) {
+			pagmo_throw(std::runtime_error,"the MPI progress thread is not running: exchanges can be posted only from the root node");
+		}
+		m_pending.push_back(state);
+	}
+	m_progress_cond.notify_all();
+}
+
+// Advance the exchange: post the receive as soon as the reply is announced and test the requests.
+// Returns true if the state of the exchange changed.
+bool mpi_environment::progress_exchange(exchange_state &ex)
+{
+	bool retval = false;
+	int flag;
+	if (!ex.m_sent) {
+		MPI_Test(&ex.m_send_req,&flag,MPI_STATUS_IGNORE);
+		if (flag) {
+			ex.m_sent = true;
+			retval = true;
+		}
+	}
+	if (!ex.m_recv_posted) {
+		MPI_Status status;
+		MPI_Iprobe(ex.m_destination,0,MPI_COMM_WORLD,&flag,&status);
+		if (flag) {
+			int size;
+			MPI_Get_count(&status,MPI_CHAR,&size);
+			ex.m_in.resize(boost::numeric_cast<std::vector<char>::size_type>(size));
+			MPI_Irecv(static_cast<void *>(ex.m_in.empty() ? 0 : &ex.m_in[0]),size,MPI_CHAR,ex.m_destination,0,MPI_COMM_WORLD,&ex.m_recv_req);
+			ex.m_recv_posted = true;
+			retval = true;
+		}
+	}
+	if (ex.m_recv_posted && !ex.m_received) {
+		MPI_Test(&ex.m_recv_req,&flag,MPI_STATUS_IGNORE);
+		if (flag) {
+			ex.m_received = true;
+			retval = true;
+		}
+	}
+	return retval;
+}
+
+// Body of the progress thread: the only thread of the root node calling MPI while the environment is alive.
+// When no exchange is in flight the thread sleeps on a condition variable, otherwise it keeps testing the pending
+// requests, backing off progressively (up to 1 ms) while nothing happens.
+void mpi_environment::progress()
+{
+	std::list<boost::shared_ptr<exchange_state> > active;
+	unsigned int idle = 0;
+	while (true) {
+		std::deque<boost::shared_ptr<exchange_state> > incoming;
+		{
+			boost::unique_lock<boost::mutex> lock(m_progress_mutex);
+			while (active.empty() && m_pending.empty() && !m_stop) {
+				m_progress_cond.wait(lock);
+			}
+			if (active.empty() && m_pending.empty()) {
+				pagmo_assert(m_stop);
+				break;
+			}
+			incoming.swap(m_pending);
+		}
+		bool changed = !incoming.empty();
+		for (std::deque<boost::shared_ptr<exchange_state> >::iterator it = incoming.begin(); it != incoming.end(); ++it) {
+			exchange_state &ex = **it;
+			MPI_Isend(static_cast<void *>(&ex.m_out[0]),boost::numeric_cast<int>(ex.m_out.size()),MPI_CHAR,ex.m_destination,0,MPI_COMM_WORLD,&ex.m_send_req);
+			active.push_back(*it);
+		}
+		std::list<boost::shared_ptr<exchange_state> >::iterator it = active.begin();
+		while (it != active.end()) {
+			exchange_state &ex = **it;
+			if (progress_exchange(ex)) {
+				changed = true;
+			}
+			if (ex.m_sent && ex.m_received) {
+				// Release the send buffer and wake up the waiting island.
+				std::vector<char>().swap(ex.m_out);
+				{
+					boost::lock_guard<boost::mutex> lock(ex.m_mutex);
+					ex.m_done = true;
+				}
+				ex.m_cond.notify_all();
+				it = active.erase(it);
+			} else {
+				++it;
+			}
+		}
+		if (changed) {
+			idle = 0;
+		} else if (++idle < 100) {
+			boost::this_thread::yield();
+		} else {
+			boost::this_thread::sleep(boost::posix_time::microseconds(std::min<unsigned int>(idle,1000)));
+		}
+	}
+}
+
 void mpi_environment::listen()
 {
-	std::pair<boost::shared_ptr<population>,algorithm::base_ptr> payload;
+	// Problems and algorithms received from the root node, most recently used first.
+	std::list<std::pair<cache_key,problem::base_ptr> > problems;
+	std::list<std::pair<cache_key,algorithm::base_ptr> > algorithms;
+	std::vector<char> buffer, reply;
 	while (true) {
 		// Receive the payload from the master.
-		recv(payload,0);
-		// If the payload is empty, it is the shutdown payload.
-		if (payload.first.get() == 0) {
-			pagmo_assert(payload.second.get() == 0);
+		recv_buffer(buffer,0);
+		vector_char_source source(buffer);
+		std::istream is(&source);
+		boost::archive::binary_iarchive ia(is);
+		int kind;
+		ia >> kind;
+		if (kind == shutdown_message) {
 			break;
 		}
-
-		// Create copy of data received
-		const boost::shared_ptr<population> pop_copy(new population(*payload.first));
+		pagmo_assert(kind == evolve_message);
+		cache_key prob_key, algo_key;
+		bool has_prob, has_algo;
+		ia >> prob_key >> algo_key >> has_prob >> has_algo;
+		if (has_prob) {
+			std::vector<char> bytes;
+			ia >> bytes;
+			problem::base_ptr prob;
+			binary_load(bytes,prob);
+			cache_insert(problems,prob_key,prob);
+		}
+		if (has_algo) {
+			std::vector<char> bytes;
+			ia >> bytes;
+			algorithm::base_ptr algo;
+			binary_load(bytes,algo);
+			cache_insert(algorithms,algo_key,algo);
+		}
+		const problem::base_ptr prob = cache_find(problems,prob_key);
+		const algorithm::base_ptr cached_algo = cache_find(algorithms,algo_key);
+		if (!prob || !cached_algo) {
+			binary_save(reply,static_cast<int>(reply_miss));
+			send_buffer(reply,0);
+			continue;
+		}
+		// The cached objects are never modified: the evolution works on copies.
+		population pop(*prob);
+		{
+			problem_detacher detacher(pop);
+			ia >> pop;
+		}
+		const algorithm::base_ptr algo = cached_algo->clone();
+		const unsigned int fevals = pop.problem().get_fevals(), cevals = pop.problem().get_cevals();
 		try {
 			// Perform the evolution.
-			payload.second->evolve(*payload.first);
+			algo->evolve(pop);
 		} catch (const std::exception &e) {
-			std::cout << "MPI Remote Error during island evolution using " << payload.second->get_name() << ": " << e.what() << std::endl;
+			std::cout << "MPI Remote Error during island evolution using " << algo->get_name() << ": " << e.what() << std::endl;
 		} catch (...) {
-			std::cout << "MPI Remote Error during island evolution using " << payload.second->get_name() << ", unknown exception caught. :(" << std::endl;
+			std::cout << "MPI Remote Error during island evolution using " << algo->get_name() << ", unknown exception caught. :(" << std::endl;
 		}
 
-		try {                
-			// Send back to the master the evolved population.
-			send(payload.first,0);
+		try {
+			reply.clear();
+			vector_char_sink sink(reply);
+			std::ostream os(&sink);
+			boost::archive::binary_oarchive oa(os);
+			const int status = reply_ok;
+			const unsigned int delta_fevals = pop.problem().get_fevals() - fevals, delta_cevals = pop.problem().get_cevals() - cevals;
+			oa << status << delta_fevals << delta_cevals;
+			problem_detacher detacher(pop);
+			const population &cpop = pop;
+			oa << cpop;
 		} catch (const boost::archive::archive_exception &e) {
-			std::cout << "MPI Send Error during island evolution using " << payload.second->get_name() << ": " << e.what() << std::endl;
-			// Send back to the master the original population.
-			send(pop_copy,0);
+			std::cout << "MPI Send Error during island evolution using " << algo->get_name() << ": " << e.what() << std::endl;
+			// The master will keep the original population.
+			binary_save(reply,static_cast<int>(reply_error));
 		} catch (...) {
-			std::cout << "MPI Send Error during island evolution using " << payload.second->get_name() << ", unknown exception caught. :(" << std::endl;
-			// Send back to the master the original population.
-			send(pop_copy,0);
-                }
+			std::cout << "MPI Send Error during island evolution using " << algo->get_name() << ", unknown exception caught. :(" << std::endl;
+			binary_save(reply,static_cast<int>(reply_error));
+		}
+		// Send back to the master the evolved population.
+		send_buffer(reply,0);
 	}
 	// Destroy the MPI environment before exiting.
 	MPI_Finalize();
@@ -25,16 +25,25 @@
 #ifndef PAGMO_MPI_ENVIRONMENT_H
 #define PAGMO_MPI_ENVIRONMENT_H
 
-#include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/utility.hpp>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <map>
 #include <mpi.h>
-#include <sstream>
-#include <string>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "config.h"
+#include "exceptions.h"
+#include "serialization.h"
 
 /*!
 \page mpi_support MPI support in PaGMO
@@ -48,16 +57,17 @@ In order to enable and use MPI support in PaGMO a standard-compliant MPI impleme
 on all systems participating to the cluster. PaGMO uses basic MPI 1.2 calls such as MPI_Recv, MPI_Send etc., and does not employ any function
 specific to MPI 2.x.
 
-For best performance, the root node of the MPI cluster (i.e., the node where mpiexec/mpirun is launched) should have a thread-safe
-MPI implementation. This means that a call to MPI_Query_thread should ideally return MPI_THREAD_MULTIPLE. It is possible to run PaGMO
-also if MPI_Query_thread returns MPI_THREAD_SERIALIZED, but in this case there will be a performance penalty. With any lesser level of thread
-support in the root node, PaGMO will refuse to operate in MPI mode.
+The root node of the MPI cluster (i.e., the node where mpiexec/mpirun is launched) must support at least the MPI_THREAD_SERIALIZED thread level
+(i.e., a call to MPI_Query_thread must return MPI_THREAD_SERIALIZED or MPI_THREAD_MULTIPLE): on the root node all the communication is performed by a dedicated
+progress thread, distinct from the main thread. With any lesser level of thread support in the root node, PaGMO will refuse to operate in MPI mode.
 
 @see http://www.fz-juelich.de/jsc/juropa/www3/MPI_Query_thread.html
 
 In a PaGMO MPI cluster, problem, population and algorithm instances are sent from the master node to the slave nodes where the optimisation process
 takes place. In order for the objects to be sent over the network, they need to be serializable. Serialization for all classes shipped with PaGMO is
 already implemented. The writer of new PaGMO classes will need to make sure that her own classes are serializable. 
+Objects are transferred as Boost binary archives (see pagmo::binary_save()), one MPI message per transfer: all the nodes of the cluster
+must thus share the same architecture and Boost version.
 
 Additionally, it must always kept in mind that when working with MPI each processor is living inside a separate process: aside from the objects serialized
 and dispatched around in the cluster, there is no other form of communication. For instance, problems or algorithms employing a shared memory state
@@ -83,6 +93,16 @@ Whenever an evolution method is called from from a pagmo::mpi_island, the island
 erase the processor ID from the list and dispatch the evolution to that processor. At the end of the evolution, the island retrieves the payload and adds the processor ID back
 to the list of available processors.
 
+On the root node, islands never call MPI directly: they serialize their payload and hand it to the progress thread of pagmo::mpi_environment, which posts
+nonblocking sends and receives for all the evolutions in flight and wakes up each island as soon as its reply has arrived.
+
+Slave processes are persistent workers: they keep a cache of the last problems and algorithms they received
+(see pagmo::mpi_environment::remote_cache_capacity), identified by a hash of their serialized content. Problems and algorithms are sent only if they are not
+already cached on the processor the evolution is dispatched to: otherwise only the individuals of the population travel over the network, together with
+a reference to the cached objects. Should a slave miss a referenced object, the root node transparently sends it again.
+The root node keeps the serialized content of the objects cached by each slave and compares it whenever the hashes match, so that a hash
+collision results in the object being sent again. Each island serializes its problem only once, until it switches to a different problem.
+
 Whenever the number of MPI islands is at least equal to the MPI world size, it might happen that one or more islands are not able to acquire any processor at the beginning of
 the evolution, all the processors being busy. In such case a fair priority queue is created, and the islands waiting for a processor to be released are added to the
 end of the queue. Whenever a processor is released, the queue is notified and the first island in the queue acquires the processor and procedes as above.
@@ -161,6 +181,18 @@ where hfile.txt is your hostfile.
 namespace pagmo
 {
 
+// Forward declarations.
+class population;
+
+namespace algorithm {
+class base;
+}
+
+namespace problem {
+class base;
+typedef boost::shared_ptr<base> base_ptr;
+}
+
 /// MPI environment class.
 /**
  * This class is used to initialise the PaGMO MPI environment: an instance of this class should be created
@@ -179,9 +211,82 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 		static bool is_multithread();
 		static int get_size();
 		static int get_rank();
+	private:
+		// Shared state of a request/reply exchange handled by the progress thread.
+		struct exchange_state
+		{
+			explicit exchange_state(int destination):m_destination(destination),m_sent(false),m_recv_posted(false),
+				m_received(false),m_done(false) {}
+			const int			m_destination;
+			std::vector<char>		m_out;
+			std::vector<char>		m_in;
+			MPI_Request			m_send_req;
+			MPI_Request			m_recv_req;
+			bool				m_sent;
+			bool				m_recv_posted;
+			bool				m_received;
+			boost::mutex			m_mutex;
+			boost::condition_variable	m_cond;
+			bool				m_done;
+		};
+	public:
+		/// Handle to the reply of a remote processor.
+		/**
+		 * Returned by mpi_environment::post(). Copies of a handle refer to the same exchange.
+		 */
+		class __PAGMO_VISIBLE future
+		{
+				friend class mpi_environment;
+			public:
+				future();
+				void wait() const;
+				bool done() const;
+				/// Retrieve the reply.
+				/**
+				 * Will block until the reply has been received, and then deserialize it into retval.
+				 *
+				 * @param[out] retval instance of class T that will contain the reply.
+				 *
+				 * @throws std::runtime_error if the handle does not refer to any exchange.
+				 */
+				template <class T>
+				void get(T &retval) const
+				{
+					if (!m_state) {
+						pagmo_throw(std::runtime_error,"the future does not refer to any MPI exchange");
+					}
+					wait();
+					binary_load(m_state->m_in,retval);
+				}
+			private:
+				explicit future(const boost::shared_ptr<exchange_state> &);
+				boost::shared_ptr<exchange_state>	m_state;
+		};
+		/// Post MPI payload and return a handle to the reply.
+		/**
+		 * Serialize payload in the calling thread and queue it for the progress thread of the root node, which will send it to the processor
+		 * with ID destination and collect the message sent back by that processor. This method is thread-safe, and it can be called
+		 * only from the root node.
+		 *
+		 * @param[in] payload instance of class T that will be sent to destination.
+		 * @param[in] destination rank of the processor to which the message will be sent.
+		 *
+		 * @return handle to the reply of destination.
+		 *
+		 * @throws std::runtime_error if the MPI environment has not been initialised.
+		 */
+		template <class T>
+		static future post(const T &payload, int destination)
+		{
+			check_init();
+			std::vector<char> buffer;
+			binary_save(buffer,payload);
+			return post_buffer(buffer,destination);
+		}
 		/// Receive MPI payload.
 		/**
-		 * Receive an instance of class T from the processor with ID source and store it into retval.
+		 * Receive an instance of class T from the processor with ID source and store it into retval. This is a blocking call: on the root node
+		 * it must not be used while the progress thread is running (see post()).
 		 * This method is thread-safe only if mpi_environment::is_multithread returns true.
 		 * 
 		 * @param[out] retval instance of class T that will contain the payload.
@@ -190,25 +295,15 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 		template <class T>
 		static void recv(T &retval, int source)
 		{
-			check_init();
-			MPI_Status status;
-			// First receive the size.
-			int size;
-			MPI_Recv(static_cast<void *>(&size),1,MPI_INT,source,0,MPI_COMM_WORLD,&status);
-			// Prepare the vector of chars.
-			std::vector<char> buffer_char(boost::numeric_cast<std::vector<char>::size_type>(size),0);
-			// Receive the payload.
-			MPI_Recv(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,source,1,MPI_COMM_WORLD,&status);
-			// Build the string from the vector.
-			const std::string buffer_str(buffer_char.begin(),buffer_char.end());
+			std::vector<char> buffer;
+			recv_buffer(buffer,source);
 			// Unpickle the payload.
-			std::stringstream ss(buffer_str);
-			boost::archive::text_iarchive ia(ss);
-			ia >> retval;
+			binary_load(buffer,retval);
 		}
 		/// Send MPI payload.
 		/**
-		 * Send an instance of class T to the processor with ID destination.
+		 * Send an instance of class T to the processor with ID destination. This is a blocking call: on the root node
+		 * it must not be used while the progress thread is running (see post()).
 		 * This method is thread-safe only if mpi_environment::is_multithread returns true.
 		 * 
 		 * @param[in] payload instance of class T that will be sent to destination.
@@ -217,24 +312,62 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 		template <class T>
 		static void send(const T &payload, int destination)
 		{
-			check_init();
-			std::stringstream ss;
-			boost::archive::text_oarchive oa(ss);
-			oa << payload;
-			const std::string buffer_str(ss.str());
-			std::vector<char> buffer_char(buffer_str.begin(),buffer_str.end());
-			// Send the size.
-			int size = boost::numeric_cast<int>(buffer_char.size());
-			MPI_Send(static_cast<void *>(&size),1,MPI_INT,destination,0,MPI_COMM_WORLD);
-			// Send the string.
-			MPI_Send(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,destination,1,MPI_COMM_WORLD);
+			// Pickle the payload directly into the send buffer.
+			std::vector<char> buffer;
+			binary_save(buffer,payload);
+			send_buffer(buffer,destination);
 		}
+		/// Serialized problem of an island.
+		/**
+		 * Used by remote_evolve() to serialize the problem of an island only when the island switches to a different problem
+		 * object (e.g., via base_island::set_population()), rather than on every evolution. A default-constructed instance
+		 * does not refer to any problem.
+		 */
+		class __PAGMO_VISIBLE problem_payload
+		{
+				friend class mpi_environment;
+			public:
+				problem_payload();
+			private:
+				// The problem is held so that its address cannot be reused by another problem while the bytes are kept.
+				problem::base_ptr				m_prob;
+				boost::shared_ptr<const std::vector<char> >	m_bytes;
+				std::pair<std::size_t,std::size_t>		m_key;
+		};
 		static bool iprobe(int);
+		static void remote_evolve(population &, const algorithm::base &, int, problem_payload &);
+		/// Capacity of the problem and algorithm caches of each slave.
+		static const std::size_t remote_cache_capacity = 16;
 	private:
+		// Key of the remote caches: hash and size of the serialized object.
+		typedef std::pair<std::size_t,std::size_t> cache_key;
+		// Serialized object shared by the payloads of the islands and by the records of the slave caches.
+		typedef boost::shared_ptr<const std::vector<char> > bytes_ptr;
 		static void listen();
 		static void check_init();
+		static void send_buffer(const std::vector<char> &, int);
+		static void recv_buffer(std::vector<char> &, int);
+		static future post_buffer(std::vector<char> &, int);
+		static void reset_transient_state(const problem::base &);
+		static void add_evals(const problem::base &, unsigned int, unsigned int);
+		static void enqueue(const boost::shared_ptr<exchange_state> &);
+		static void progress();
+		static bool progress_exchange(exchange_state &);
 		static bool	m_initialised;
 		static bool	m_multithread;
+		static int	m_size;
+		static int	m_rank;
+		// Progress thread data.
+		static boost::scoped_ptr<boost::thread>				m_progress_thread;
+		static boost::mutex						m_progress_mutex;
+		static boost::condition_variable				m_progress_cond;
+		static std::deque<boost::shared_ptr<exchange_state> >		m_pending;
+		static bool							m_stop;
+		// Keys and bytes of the objects cached by each slave, as seen from the root node. The bytes are compared
+		// on a key hit, so that a hash collision is treated as a miss.
+		static boost::mutex							m_cache_mutex;
+		static std::map<int,std::list<std::pair<cache_key,bytes_ptr> > >	m_remote_problems;
+		static std::map<int,std::list<std::pair<cache_key,bytes_ptr> > >	m_remote_algorithms;
 };
 
 }
@@ -22,11 +22,9 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/condition_variable.hpp>
-#include <boost/thread/thread.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <list>
@@ -49,7 +47,6 @@ namespace pagmo
 
 boost::mutex mpi_island::m_proc_mutex;
 boost::condition_variable mpi_island::m_proc_cond;
-boost::mutex mpi_island::m_mpi_mutex;
 std::list<mpi_island const *> mpi_island::m_queue;
 boost::scoped_ptr<std::set<int> > mpi_island::m_available_processors;
 
@@ -59,7 +56,7 @@ boost::scoped_ptr<std::set<int> > mpi_island::m_available_processors;
  */
 mpi_island::mpi_island(const algorithm::base &a, const problem::base &p, int n, const double &migr_prob,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	base_island(a,p,n,migr_prob,s_policy,r_policy)
+	base_island(a,p,n,migr_prob,s_policy,r_policy),m_payload()
 {}
 
 /// Constructor from population.
@@ -68,20 +65,21 @@ mpi_island::mpi_island(const algorithm::base &a, const problem::base &p, int n,
  */
 mpi_island::mpi_island(const algorithm::base &a, const population &pop, const double &migr_prob,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	base_island(a,pop,migr_prob,s_policy,r_policy)
+	base_island(a,pop,migr_prob,s_policy,r_policy),m_payload()
 {}
 
 /// Copy constructor.
 /**
  * @see pagmo::base_island constructors.
  */
-mpi_island::mpi_island(const mpi_island &isl):base_island(isl)
+mpi_island::mpi_island(const mpi_island &isl):base_island(isl),m_payload()
 {}
 
 /// Assignment operator.
 mpi_island &mpi_island::operator=(const mpi_island &isl)
 {
 	base_island::operator=(isl);
+	m_payload = mpi_environment::problem_payload();
 	return *this;
 }
 
@@ -93,47 +91,19 @@ base_island_ptr mpi_island::clone() const
 // Method that perform the actual evolution for the island population, and is used to distribute the computation load over multiple processors
 void mpi_island::perform_evolution(const algorithm::base &algo, population &pop) const
 {
-	// Create copy of data to be transmitted - will use a std::pair for packing everything in a single object.
-	const boost::shared_ptr<population> pop_copy(new population(pop));
-	const algorithm::base_ptr algo_copy = algo.clone();
-	const std::pair<boost::shared_ptr<population>,algorithm::base_ptr> out(pop_copy,algo_copy);
 	const int processor = acquire_processor();
-	if (mpi_environment::is_multithread()) {
-		mpi_environment::send(out,processor);
-	} else {
-		// Lock down MPI mutex before sending.
-		boost::lock_guard<boost::mutex> lock(m_mpi_mutex);
-		mpi_environment::send(out,processor);
-	}
-	bool successful = false;
-	boost::shared_ptr<population> in;
+	// The slave caches problems and algorithms: in general only the individuals will be sent. The communication
+	// is carried out by the progress thread of the MPI environment.
 	try {
-		if (mpi_environment::is_multithread()) {
-			mpi_environment::recv(in,processor);
-		} else {
-			while (true) {
-				{
-					boost::lock_guard<boost::mutex> lock(m_mpi_mutex);
-					if (mpi_environment::iprobe(processor)) {
-						mpi_environment::recv(in,processor);
-						break;
-					}
-				}
-				boost::this_thread::sleep(boost::posix_time::milliseconds(10));
-			}
-		}
-		successful = true;
+		mpi_environment::remote_evolve(pop,algo,processor,m_payload);
 	} catch (const boost::archive::archive_exception &e) {
-		std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
+		std::cout << "MPI Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
+	} catch (const std::exception &e) {
+		std::cout << "MPI Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
 	} catch (...) {
-		std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ", unknown exception caught. :(" << std::endl;
+		std::cout << "MPI Error during island evolution using " << algo.get_name() << ", unknown exception caught. :(" << std::endl;
 	}
 	release_processor(processor);
-	if (successful) {
-		// NOTE: implement via population::swap (to be written) in order to avoid
-		// extra copying?
-		pop = *in;
-	}
 }
 
 /// Return a string identifying the island's type.
@@ -39,6 +39,7 @@
 #include "migration/base_s_policy.h"
 #include "migration/best_s_policy.h"
 #include "migration/fair_r_policy.h"
+#include "mpi_environment.h"
 #include "population.h"
 #include "problem/base.h"
 #include "serialization.h"
@@ -108,9 +109,10 @@ class __PAGMO_VISIBLE mpi_island: public base_island
 		int acquire_processor() const;
 		void release_processor(int) const;
 	private:
+		// Serialized problem of the island, reused by the evolutions until the problem changes. Not copied nor archived.
+		mutable mpi_environment::problem_payload	m_payload;
 		static boost::mutex				m_proc_mutex;
 		static boost::condition_variable		m_proc_cond;
-		static boost::mutex				m_mpi_mutex;
 		static boost::scoped_ptr<std::set<int> >	m_available_processors;
 		static std::list<mpi_island const *>		m_queue;
 };
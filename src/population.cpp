@@ -66,7 +66,8 @@ problem::base_ptr &population_access::get_problem_ptr(population &pop)
  *
  * @throw value_error if n is negative.
  */
-population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
+population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_pareto_engine(pareto_engine::INCREMENTAL), m_dom_dirty(false),
+	m_evaluation_check(false), m_tournament_dirty(true), m_soa(), m_soa_active(false), m_soa_dirty(false), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
 {
 	if (n < 0) {
 		pagmo_throw(value_error,"number of individuals cannot be negative");
@@ -101,7 +102,9 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
  * @param[in] p population used to initialise this.
  */
 population::population(const population &p):m_prob(p.m_prob->clone()),m_container(p.m_container),m_dom_list(p.m_dom_list),m_dom_count(p.m_dom_count),
-	m_champion(p.m_champion), m_pareto_rank(p.m_pareto_rank), m_crowding_d(p.m_crowding_d),m_drng(p.m_drng),m_urng(p.m_urng)
+	m_pareto_engine(p.m_pareto_engine),m_dom_dirty(p.m_dom_dirty),m_evaluation_check(p.m_evaluation_check),
+	m_worst_tree(p.m_worst_tree),m_best_tree(p.m_best_tree),m_tournament_dirty(p.m_tournament_dirty),
+	m_soa(p.m_soa),m_soa_active(p.m_soa_active),m_soa_dirty(p.m_soa_dirty),m_champion(p.m_champion), m_pareto_rank(p.m_pareto_rank), m_crowding_d(p.m_crowding_d),m_drng(p.m_drng),m_urng(p.m_urng)
 {}
 
 /// Assignment operator.
@@ -121,6 +124,15 @@ population &population::operator=(const population &p)
 		m_container = p.m_container;
 		m_dom_list = p.m_dom_list;
 		m_dom_count = p.m_dom_count;
+		m_pareto_engine = p.m_pareto_engine;
+		m_dom_dirty = p.m_dom_dirty;
+		m_evaluation_check = p.m_evaluation_check;
+		m_worst_tree = p.m_worst_tree;
+		m_best_tree = p.m_best_tree;
+		m_tournament_dirty = p.m_tournament_dirty;
+		m_soa = p.m_soa;
+		m_soa_active = p.m_soa_active;
+		m_soa_dirty = p.m_soa_dirty;
 		m_champion = p.m_champion;
 		m_pareto_rank = p.m_pareto_rank;
 		m_crowding_d = p.m_crowding_d;
@@ -130,6 +142,47 @@ population &population::operator=(const population &p)
 	return *this;
 }
 
+// Members of the individuals and the matrices mirroring them in the structure-of-arrays view, in the same order.
+static const int n_soa_members = 7;
+static std::vector<double> population::individual_type::*const individual_members[n_soa_members] = {
+	&population::individual_type::cur_x, &population::individual_type::cur_v, &population::individual_type::cur_c, &population::individual_type::cur_f,
+	&population::individual_type::best_x, &population::individual_type::best_c, &population::individual_type::best_f
+};
+static util::soa_matrix population::soa_type::*const soa_members[n_soa_members] = {
+	&population::soa_type::cur_x, &population::soa_type::cur_v, &population::soa_type::cur_c, &population::soa_type::cur_f,
+	&population::soa_type::best_x, &population::soa_type::best_c, &population::soa_type::best_f
+};
+
+/// Swap content.
+/**
+ * Swap the content of this with the content of p, problem included, without copying.
+ *
+ * @param[in,out] p population whose content will be swapped with this.
+ */
+void population::swap(population &p)
+{
+	m_prob.swap(p.m_prob);
+	m_container.swap(p.m_container);
+	m_dom_list.swap(p.m_dom_list);
+	m_dom_count.swap(p.m_dom_count);
+	std::swap(m_pareto_engine,p.m_pareto_engine);
+	std::swap(m_dom_dirty,p.m_dom_dirty);
+	std::swap(m_evaluation_check,p.m_evaluation_check);
+	m_worst_tree.swap(p.m_worst_tree);
+	m_best_tree.swap(p.m_best_tree);
+	std::swap(m_tournament_dirty,p.m_tournament_dirty);
+	for (int k = 0; k < n_soa_members; ++k) {
+		(m_soa.*soa_members[k]).swap(p.m_soa.*soa_members[k]);
+	}
+	std::swap(m_soa_active,p.m_soa_active);
+	std::swap(m_soa_dirty,p.m_soa_dirty);
+	std::swap(m_champion,p.m_champion);
+	m_pareto_rank.swap(p.m_pareto_rank);
+	m_crowding_d.swap(p.m_crowding_d);
+	std::swap(m_drng,p.m_drng);
+	std::swap(m_urng,p.m_urng);
+}
+
 // Update the domination list and the domination count when the individual at position n has changed
 void population::update_dom(const size_type &n)
 {
@@ -142,6 +195,15 @@ void population::update_dom(const size_type &n)
 	const size_type size = m_container.size();
 	pagmo_assert(m_dom_list.size() == size && m_dom_count.size() == size && n < size);
 
+	// The tournament trees are kept up to date by both engines.
+	update_tournament(n);
+
+	// The lazy engine just invalidates the domination structures, they will be recomputed when needed.
+	if (m_pareto_engine == pareto_engine::LAZY_SORT) {
+		m_dom_dirty = true;
+		return;
+	}
+
 	// Decrease the domination count for the individuals that were dominated
 	for  (size_type i = 0; i < m_dom_list[n].size(); ++i) {
 		m_dom_count[ m_dom_list[n][i] ]--;
@@ -190,6 +252,7 @@ void population::init_velocity(const size_type &idx)
 		width = (m_prob->get_ub()[j] - m_prob->get_lb()[j]) / 2;
 		m_container[idx].cur_v[j] = boost::uniform_real<double>(-width,width)(m_drng);
 	}
+	update_soa(idx);
 }
 
 /// Computes the mean curent velocity of all individuals in the population
@@ -261,6 +324,7 @@ void population::reinit(const size_type &idx)
 	update_champion(idx);
 	// Update the domination lists.
 	update_dom(idx);
+	update_soa(idx);
 }
 
 
@@ -282,6 +346,98 @@ const population::individual_type &population::get_individual(const size_type &i
 	return m_container[idx];
 }
 
+/// Get the structure-of-arrays view of the individuals.
+/**
+ * The returned matrices hold, in their i-th rows, the vectors of the i-th individual (see get_individual()): for instance
+ * soa().cur_x.row(i) points to a contiguous copy of get_individual(i).cur_x. The rows are aligned and the components of
+ * all the individuals are found at a fixed stride, so that they can be handed over to code expecting matrices (e.g., through Eigen).
+ *
+ * The view is a copy of the individuals, which must be enabled with set_soa_storage(): from then on it is kept up to date by all the
+ * methods which modify the population, at the cost of copying the vectors of each modified individual once more. The matrices are
+ * invalidated (but the returned reference is not) by any modification of the population. The rows of best vectors which are not
+ * defined yet are filled with zeroes.
+ *
+ * @return const reference to the structure-of-arrays view.
+ *
+ * @throws value_error if the view is not enabled.
+ */
+const population::soa_type &population::soa() const
+{
+	if (!m_soa_active) {
+		pagmo_throw(value_error,"the structure-of-arrays view is not enabled, see set_soa_storage()");
+	}
+	if (m_soa_dirty) {
+		rebuild_soa();
+	}
+	return m_soa;
+}
+
+/// Enable or disable the structure-of-arrays view.
+/**
+ * Enabling the view builds it right away, disabling it frees its memory and
+ * spares the population the cost of keeping it up to date. The view is disabled by default.
+ *
+ * @param[in] flag true to enable the view, false to disable it.
+ */
+void population::set_soa_storage(bool flag)
+{
+	m_soa_active = flag;
+	rebuild_soa();
+}
+
+/// Get the status of the structure-of-arrays view.
+/**
+ * @return true if the structure-of-arrays view is being kept up to date.
+ */
+bool population::get_soa_storage() const
+{
+	return m_soa_active;
+}
+
+// Copy v into row idx of m, unless v is undefined (the best vectors of individuals being appended).
+static void mirror_row(util::soa_matrix &m, const population::size_type &idx, const std::vector<double> &v)
+{
+	if (v.size() == m.cols()) {
+		m.set_row(idx,v);
+	}
+}
+
+// Rebuild the whole structure-of-arrays mirror, or free it if it is not active.
+void population::rebuild_soa() const
+{
+	const std::vector<double>::size_type dims[n_soa_members] = {
+		m_prob->get_dimension(), m_prob->get_dimension(), m_prob->get_c_dimension(), m_prob->get_f_dimension(),
+		m_prob->get_dimension(), m_prob->get_c_dimension(), m_prob->get_f_dimension()
+	};
+	for (int k = 0; k < n_soa_members; ++k) {
+		util::soa_matrix &m = m_soa.*soa_members[k];
+		m.reset(dims[k]);
+		if (m_soa_active) {
+			m.resize(size());
+			for (size_type i = 0; i < size(); ++i) {
+				mirror_row(m,i,m_container[i].*individual_members[k]);
+			}
+		}
+	}
+	m_soa_dirty = false;
+}
+
+// Copy the individual in position idx into the structure-of-arrays mirror, growing the mirror if the individual has just been appended.
+void population::update_soa(const size_type &idx)
+{
+	if (!m_soa_active || m_soa_dirty) {
+		return;
+	}
+	pagmo_assert(idx < size());
+	for (int k = 0; k < n_soa_members; ++k) {
+		util::soa_matrix &m = m_soa.*soa_members[k];
+		if (m.rows() != size()) {
+			m.resize(size());
+		}
+		mirror_row(m,idx,m_container[idx].*individual_members[k]);
+	}
+}
+
 /// Get domination list.
 /**
  * Will return a vector containing the indices of the individuals dominated by the individual in position idx. Will fail if
@@ -298,6 +454,9 @@ const std::vector<population::size_type> &population::get_domination_list(const
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
+	if (m_dom_dirty) {
+		rebuild_dom();
+	}
 	return m_dom_list[idx];
 }
 
@@ -316,6 +475,16 @@ population::size_type population::get_domination_count(const size_type &idx) con
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
+	if (m_dom_dirty) {
+		// Count directly the dominating individuals, there is no need to rebuild all the lists.
+		size_type retval = 0;
+		for (size_type i = 0; i < size(); ++i) {
+			if (i != idx && m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[idx].best_f,m_container[idx].best_c)) {
+				++retval;
+			}
+		}
+		return retval;
+	}
 	return m_dom_count[idx];
 }
 
@@ -362,17 +531,54 @@ double population::get_crowding_d(const size_type &idx) const
 }
 
 // This functor is used to sort (minimization assumed) along a particular fitness dimension.
-// Needed for the computations of the crowding distance
+// Needed for the computations of the crowding distance. Ties are broken by position so that
+// the result does not depend on the order in which the front was assembled.
 struct one_dim_fit_comp {
 	one_dim_fit_comp(const population &pop, fitness_vector::size_type dim):m_pop(pop), m_dim(dim) {};
 	bool operator()(const population::size_type& idx1, const population::size_type& idx2) const
 	{
-		return m_pop.get_individual(idx1).cur_f[m_dim] < m_pop.get_individual(idx2).cur_f[m_dim];
+		const double f1 = m_pop.get_individual(idx1).cur_f[m_dim], f2 = m_pop.get_individual(idx2).cur_f[m_dim];
+		if (f1 == f2) {
+			return idx1 < idx2;
+		}
+		return f1 < f2;
 	}
 	const population& m_pop;
 	fitness_vector::size_type m_dim;
 };
 
+// This functor defines the presorting used by the lazy Pareto engine. It is a linear extension of
+// the default problem::base::compare_fc (i.e. if i1 dominates i2 then i1 comes first): feasible individuals
+// come first, infeasible ones are ordered by constraint violation, feasible ones lexicographically
+// by fitness. Ties are broken by position.
+struct pareto_presort_comp {
+	pareto_presort_comp(const population &pop):m_pop(pop) {};
+	bool operator()(const population::size_type& idx1, const population::size_type& idx2) const
+	{
+		const population::individual_type &i1 = m_pop.get_individual(idx1), &i2 = m_pop.get_individual(idx2);
+		const bool test1 = m_pop.problem().feasibility_c(i1.best_c), test2 = m_pop.problem().feasibility_c(i2.best_c);
+		if (test1 != test2) {
+			return test1;
+		}
+		if (!test1) {
+			if (m_pop.problem().compare_constraints(i1.best_c,i2.best_c)) {
+				return true;
+			}
+			if (m_pop.problem().compare_constraints(i2.best_c,i1.best_c)) {
+				return false;
+			}
+		} else {
+			for (fitness_vector::size_type i = 0; i < i1.best_f.size(); ++i) {
+				if (i1.best_f[i] != i2.best_f[i]) {
+					return i1.best_f[i] < i2.best_f[i];
+				}
+			}
+		}
+		return idx1 < idx2;
+	}
+	const population& m_pop;
+};
+
 
 /// Update Pareto Information
 /**
@@ -390,6 +596,11 @@ void population::update_pareto_information() const {
 	std::fill(m_pareto_rank.begin(), m_pareto_rank.end(), 0);
 	std::fill(m_crowding_d.begin(), m_crowding_d.end(), 0);
 
+	if (m_pareto_engine == pareto_engine::LAZY_SORT) {
+		non_dominated_sort();
+		return;
+	}
+
 	// We define some utility vectors .....
 	std::vector<population::size_type> F,S;
 
@@ -427,6 +638,107 @@ void population::update_pareto_information() const {
 }
 
 
+// Efficient non-dominated sort (ENS-BS) used by the lazy Pareto engine.
+//
+// Individuals are visited in an order compatible with the domination relation (see pareto_presort_comp),
+// so that when an individual is visited all of its dominators have already been assigned to a front. As
+// a front that does not dominate an individual is never followed by one that does, the front of each
+// individual can be found by binary search, with O(N log N) domination checks in the best case
+// and O(N^2) in the worst case, and no domination lists stored.
+//
+// NOTE: the presorting assumes the default compare_fc semantics (Pareto dominance on the fitness of feasible
+// individuals, constraint comparison otherwise). Problems reimplementing compare_fc_impl() in a way
+// not compatible with it should stick to the incremental engine.
+void population::non_dominated_sort() const
+{
+	std::vector<size_type> order(size());
+	for (size_type i = 0; i < order.size(); ++i) {
+		order[i] = i;
+	}
+	std::sort(order.begin(),order.end(),pareto_presort_comp(*this));
+
+	std::vector<std::vector<size_type> > fronts;
+	for (size_type k = 0; k < order.size(); ++k) {
+		const individual_type &ind = m_container[order[k]];
+		size_type lo = 0, hi = fronts.size();
+		while (lo < hi) {
+			const size_type mid = lo + (hi - lo) / 2;
+			// The last individuals added to a front are the most similar to the current one,
+			// so we scan the front backwards.
+			bool dominated = false;
+			for (size_type j = fronts[mid].size(); j > 0 && !dominated; --j) {
+				const individual_type &other = m_container[fronts[mid][j - 1]];
+				dominated = m_prob->compare_fc(other.best_f,other.best_c,ind.best_f,ind.best_c);
+			}
+			if (dominated) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		if (lo == fronts.size()) {
+			fronts.push_back(std::vector<size_type>());
+		}
+		fronts[lo].push_back(order[k]);
+		m_pareto_rank[order[k]] = lo;
+	}
+	for (size_type i = 0; i < fronts.size(); ++i) {
+		std::sort(fronts[i].begin(),fronts[i].end());
+		update_crowding_d(fronts[i]);
+	}
+}
+
+// Recompute from scratch the domination lists and counts (lazy engine only).
+void population::rebuild_dom() const
+{
+	const size_type size = m_container.size();
+	m_dom_list.assign(size,std::vector<size_type>());
+	m_dom_count.assign(size,0);
+	for (size_type i = 0; i < size; ++i) {
+		for (size_type j = i + 1; j < size; ++j) {
+			if (m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[j].best_f,m_container[j].best_c)) {
+				m_dom_list[i].push_back(j);
+				++m_dom_count[j];
+			} else if (m_prob->compare_fc(m_container[j].best_f,m_container[j].best_c,m_container[i].best_f,m_container[i].best_c)) {
+				m_dom_list[j].push_back(i);
+				++m_dom_count[i];
+			}
+		}
+	}
+	m_dom_dirty = false;
+}
+
+/// Set the Pareto bookkeeping engine.
+/**
+ * With pareto_engine::INCREMENTAL (the default) the domination list and count of each individual are updated
+ * on every set_x(), push_back() and erase(), which costs O(N) domination checks per modification and O(N^2) memory.
+ * With pareto_engine::LAZY_SORT modifications only invalidate the domination information: update_pareto_information()
+ * (and hence compute_pareto_fronts(), get_best_idx(), ...) use an efficient non-dominated sort, get_domination_count()
+ * counts the dominating individuals directly and get_domination_list() rebuilds all the lists only when called.
+ * Pareto ranks, crowding distances, domination counts and fronts are the same for both engines, as long as problem::base::compare_fc
+ * retains its default semantics.
+ *
+ * @param[in] e the engine to be used.
+ */
+void population::set_pareto_engine(pareto_engine::type e)
+{
+	if (e == pareto_engine::INCREMENTAL && m_dom_dirty) {
+		rebuild_dom();
+	}
+	m_pareto_engine = e;
+}
+
+/// Get the Pareto bookkeeping engine.
+/**
+ * @return the engine currently in use.
+ *
+ * @see population::set_pareto_engine()
+ */
+population::pareto_engine::type population::get_pareto_engine() const
+{
+	return m_pareto_engine;
+}
+
 /// Update Crowding Distance
 /**
  * This method computes the crowding distance of the entire population. This distance is saved
@@ -671,6 +983,82 @@ bool population::trivial_comparison_operator::operator()(const size_type &idx1,
 	return m_pop.problem().compare_fc(m_pop.get_individual(idx1).cur_f, m_pop.get_individual(idx1).cur_c, m_pop.get_individual(idx2).cur_f,m_pop.get_individual(idx2).cur_c);
 }
 
+// Leaf value of the tournament trees beyond the last individual.
+static const population::size_type no_individual = static_cast<population::size_type>(-1);
+
+// The worst of the individuals in positions idx1 and idx2, idx1 on ties.
+population::size_type population::worse_individual(const size_type &idx1, const size_type &idx2) const
+{
+	if (idx1 == no_individual) {
+		return idx2;
+	}
+	if (idx2 == no_individual) {
+		return idx1;
+	}
+	return m_prob->compare_fc(m_container[idx1].cur_f,m_container[idx1].cur_c,m_container[idx2].cur_f,m_container[idx2].cur_c) ? idx2 : idx1;
+}
+
+// The best of the individuals in positions idx1 and idx2, idx1 on ties.
+population::size_type population::better_individual(const size_type &idx1, const size_type &idx2) const
+{
+	if (idx1 == no_individual) {
+		return idx2;
+	}
+	if (idx2 == no_individual) {
+		return idx1;
+	}
+	return m_prob->compare_fc(m_container[idx2].cur_f,m_container[idx2].cur_c,m_container[idx1].cur_f,m_container[idx1].cur_c) ? idx2 : idx1;
+}
+
+// Rebuild the tournament trees if they are outdated, or if the population was resized behind their back
+// (as racing_population does). As the left child wins ties, the roots are the first worst and best individuals
+// in positional order, as std::max_element() and std::min_element() would return.
+void population::rebuild_tournament() const
+{
+	const size_type n = size(), leaves = m_worst_tree.size() / 2;
+	if (!m_tournament_dirty && leaves >= n && n && m_worst_tree[leaves + n - 1] == n - 1 &&
+		(leaves == n || m_worst_tree[leaves + n] == no_individual))
+	{
+		return;
+	}
+	size_type cap = 1;
+	while (cap < n) {
+		cap *= 2;
+	}
+	m_worst_tree.assign(2 * cap,no_individual);
+	for (size_type i = 0; i < n; ++i) {
+		m_worst_tree[cap + i] = i;
+	}
+	for (size_type k = cap - 1; k > 0; --k) {
+		m_worst_tree[k] = worse_individual(m_worst_tree[2 * k],m_worst_tree[2 * k + 1]);
+	}
+	m_best_tree.assign(m_worst_tree.begin() + cap,m_worst_tree.end());
+	m_best_tree.insert(m_best_tree.begin(),cap,no_individual);
+	for (size_type k = cap - 1; k > 0; --k) {
+		m_best_tree[k] = better_individual(m_best_tree[2 * k],m_best_tree[2 * k + 1]);
+	}
+	m_tournament_dirty = false;
+}
+
+// Update the tournament trees when the individual in position idx has changed (or has been removed, if idx is not smaller than size()).
+void population::update_tournament(const size_type &idx) const
+{
+	if (m_tournament_dirty || m_prob->get_f_dimension() != 1) {
+		return;
+	}
+	const size_type leaves = m_worst_tree.size() / 2;
+	if (idx >= leaves) {
+		m_tournament_dirty = true;
+		return;
+	}
+	size_type k = leaves + idx;
+	m_worst_tree[k] = m_best_tree[k] = idx < size() ? idx : no_individual;
+	for (k /= 2; k > 0; k /= 2) {
+		m_worst_tree[k] = worse_individual(m_worst_tree[2 * k],m_worst_tree[2 * k + 1]);
+		m_best_tree[k] = better_individual(m_best_tree[2 * k],m_best_tree[2 * k + 1]);
+	}
+}
+
 /// Get position of worst individual.
 /**
  * The definition of what makes an individual worst with respect to another differs in single objective
@@ -694,14 +1082,12 @@ population::size_type population::get_worst_idx() const
 	if (!size()) {
 		pagmo_throw(value_error,"empty population, cannot compute position of worst individual");
 	}
-	container_type::const_iterator it;
 	if (m_prob->get_f_dimension() == 1) {
-		it = std::max_element(m_container.begin(),m_container.end(),trivial_comparison_operator(*this));
-	}
-	else {
-		update_pareto_information();
-		it = std::max_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
+		rebuild_tournament();
+		return m_worst_tree[1];
 	}
+	update_pareto_information();
+	container_type::const_iterator it = std::max_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
 	return boost::numeric_cast<size_type>(std::distance(m_container.begin(),it));
 }
 
@@ -727,14 +1113,13 @@ population::size_type population::get_best_idx() const
 	if (!size()) {
 		pagmo_throw(value_error,"empty population, cannot compute position of best individual");
 	}
-	container_type::const_iterator it;
 	if (m_prob->get_f_dimension() == 1) {
-		it = std::min_element(m_container.begin(),m_container.end(),trivial_comparison_operator(*this));
+		rebuild_tournament();
+		return m_best_tree[1];
 	}
-	else {
-		update_pareto_information();
-		it = std::min_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
-	}	return boost::numeric_cast<size_type>(std::distance(m_container.begin(),it));
+	update_pareto_information();
+	container_type::const_iterator it = std::min_element(m_container.begin(),m_container.end(),crowded_comparison_operator(*this));
+	return boost::numeric_cast<size_type>(std::distance(m_container.begin(),it));
 }
 
 /// Get positions of N best individuals.
@@ -853,8 +1238,8 @@ std::string population::human_readable() const
 		oss << "\nList of individuals:\n";
 		for (size_type i = 0; i < size(); ++i) {
 			oss << '#' << i << ":\n";
-			oss << m_container[i] << "\tDominates:\t\t\t" << m_dom_list[i] << '\n';
-			oss << "\tIs dominated by:\t\t" << m_dom_count[i] << "\tindividuals" << '\n';
+			oss << m_container[i] << "\tDominates:\t\t\t" << get_domination_list(i) << '\n';
+			oss << "\tIs dominated by:\t\t" << get_domination_count(i) << "\tindividuals" << '\n';
 		}
 	}
 	if (m_champion.x.size()) {
@@ -878,6 +1263,52 @@ void population::update_champion(const size_type &idx)
 	}
 }
 
+// Update the best decision, fitness and constraint vectors of individual in position idx, if needed.
+void population::update_best(const size_type &idx)
+{
+	// NOTE: we update the bests in two cases:
+	// - the bests are empty, meaning they are not defined and we are being called by push_back()
+	// - the bests are defined, but they are worse than the currents.
+	pagmo_assert((!m_container[idx].best_x.size() && !m_container[idx].best_f.size()) ||
+		(m_container[idx].best_x.size() && m_container[idx].best_f.size()));
+	if (!m_container[idx].best_x.size() ||
+		m_prob->compare_fc(m_container[idx].cur_f,m_container[idx].cur_c,m_container[idx].best_f,m_container[idx].best_c))
+	{
+		m_container[idx].best_x = m_container[idx].cur_x;
+		m_container[idx].best_f = m_container[idx].cur_f;
+		m_container[idx].best_c = m_container[idx].cur_c;
+	}
+}
+
+// Check a decision vector and the fitness and constraint vectors handed over by the caller.
+void population::check_evaluation(const decision_vector &x, const fitness_vector &f, const constraint_vector &c) const
+{
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	if (c.size() != m_prob->get_c_dimension()) {
+		pagmo_throw(value_error,"constraint vector is not compatible with problem");
+	}
+	if (m_evaluation_check && (m_prob->objfun(x) != f || m_prob->compute_constraints(x) != c)) {
+		pagmo_throw(value_error,"fitness or constraint vector does not match the evaluation of the decision vector");
+	}
+}
+
+// Set the current vectors of individual in position idx to pre-evaluated ones, and update all the bookkeeping.
+void population::assign_individual(const size_type &idx, const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	m_container[idx].cur_x = x;
+	m_container[idx].cur_f = f;
+	m_container[idx].cur_c = c;
+	update_best(idx);
+	update_champion(idx);
+	update_dom(idx);
+	update_soa(idx);
+}
+
 /// Set the decision vector of individual at position idx to x.
 /**
  * Will update best values of individual and champion if needed. Will fail if problem::base::verify_x() on x returns false.
@@ -901,22 +1332,236 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	// Update current constraints vector.
 	m_prob->compute_constraints(m_container[idx].cur_c,x);
 	// If needed, update the best decision, fitness and constraint vectors for the individual.
-	// NOTE: we update the bests in two cases:
-	// - the bests are empty, meaning they are not defined and we are being called by push_back()
-	// - the bests are defined, but they are worse than the currents.
-	pagmo_assert((!m_container[idx].best_x.size() && !m_container[idx].best_f.size()) ||
-		(m_container[idx].best_x.size() && m_container[idx].best_f.size()));
-	if (!m_container[idx].best_x.size() ||
-		m_prob->compare_fc(m_container[idx].cur_f,m_container[idx].cur_c,m_container[idx].best_f,m_container[idx].best_c))
-	{
-		m_container[idx].best_x = m_container[idx].cur_x;
-		m_container[idx].best_f = m_container[idx].cur_f;
-		m_container[idx].best_c = m_container[idx].cur_c;
-	}
+	update_best(idx);
 	// Update the champion.
 	update_champion(idx);
 	// Updated domination lists.
 	update_dom(idx);
+	update_soa(idx);
+}
+
+/// Set the decision vector of individual at position idx to x, with its fitness and constraints already evaluated.
+/**
+ * Same as set_x(const size_type &, const decision_vector &), but f and c are trusted to be the fitness and constraint
+ * vectors of x, so that algorithms which have already evaluated x do not pay for a second evaluation.
+ * With set_evaluation_check() enabled, x is re-evaluated and compared with f and c.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] x decision vector to be set for the individual at position idx.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ *
+ * @throws index_error if idx is not smaller than size().
+ * @throws value_error if x, f or c are not compatible with the problem, or if the evaluation check fails.
+ */
+void population::set_x(const size_type &idx, const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	check_evaluation(x,f,c);
+	assign_individual(idx,x,f,c);
+}
+
+/// Replace all the individuals with pre-evaluated ones.
+/**
+ * Equivalent to calling set_x(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &)
+ * on each individual, i.e., velocities and best vectors are kept, but the domination information is rebuilt once
+ * for the whole generation instead of being updated after each individual.
+ *
+ * @param[in] x decision vectors of the new generation, one per individual.
+ * @param[in] f fitness vectors of x.
+ * @param[in] c constraint vectors of x.
+ *
+ * @throws value_error if the sizes of x, f and c differ from size(), if any of their elements is not compatible with the problem,
+ * or if the evaluation check fails.
+ */
+void population::replace_generation(const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f,
+	const std::vector<constraint_vector> &c)
+{
+	if (x.size() != size() || f.size() != size() || c.size() != size()) {
+		pagmo_throw(value_error,"the new generation must have the same size as the population");
+	}
+	// Check everything first, so that the population is left untouched on failure.
+	for (size_type i = 0; i < size(); ++i) {
+		check_evaluation(x[i],f[i],c[i]);
+	}
+	for (size_type i = 0; i < size(); ++i) {
+		m_container[i].cur_x = x[i];
+		m_container[i].cur_f = f[i];
+		m_container[i].cur_c = c[i];
+		update_best(i);
+		update_champion(i);
+		update_soa(i);
+	}
+	m_tournament_dirty = true;
+	if (m_pareto_engine == pareto_engine::LAZY_SORT) {
+		m_dom_dirty = true;
+	} else {
+		rebuild_dom();
+	}
+}
+
+/// Replace the worst individual with a new one, if the new one is not worse.
+/**
+ * Steady-state replacement: the individual with decision vector x is evaluated and then passed to
+ * replace_worst(const decision_vector &, const fitness_vector &, const constraint_vector &).
+ *
+ * @param[in] x decision vector of the new individual.
+ *
+ * @return true if the new individual entered the population.
+ *
+ * @throws value_error if the population is empty or x is not compatible with the problem.
+ */
+bool population::replace_worst(const decision_vector &x)
+{
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	fitness_vector f(m_prob->get_f_dimension());
+	constraint_vector c(m_prob->get_c_dimension());
+	m_prob->objfun(f,x);
+	m_prob->compute_constraints(c,x);
+	return replace_worst(x,f,c);
+}
+
+/// Replace the worst individual with a pre-evaluated new one, if the new one is not worse.
+/**
+ * The outcome is the same as push_back() followed by the erase() of the worst individual (see get_worst_idx()),
+ * but the population is not shifted around: the new individual takes the place of the worst one.
+ * Its velocity is initialised randomly and its memory is reset, as for a newly appended individual.
+ *
+ * For single-objective problems the worst individual is tracked in a tournament tree and the new individual is compared only to it.
+ * The domination bookkeeping is the same as for set_x(): with pareto_engine::INCREMENTAL the relations of the new individual
+ * with all the others are recomputed, hence a replacement still costs O(N) domination checks, while with pareto_engine::LAZY_SORT
+ * it is deferred to the next query. For multi-objective problems the worst
+ * individual depends on the whole population, so the new individual is appended, the worst one is computed
+ * and then removed via erase_unordered().
+ *
+ * f and c are trusted to be the fitness and constraint vectors of x (see set_evaluation_check()).
+ *
+ * @param[in] x decision vector of the new individual.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ *
+ * @return true if the new individual entered the population.
+ *
+ * @throws value_error if the population is empty, x, f or c are not compatible with the problem, or the evaluation check fails.
+ */
+bool population::replace_worst(const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	if (!size()) {
+		pagmo_throw(value_error,"empty population, cannot replace the worst individual");
+	}
+	check_evaluation(x,f,c);
+	if (m_prob->get_f_dimension() != 1) {
+		append_individual();
+		const size_type new_idx = m_container.size() - 1;
+		assign_individual(new_idx,x,f,c);
+		init_velocity(new_idx);
+		const size_type worst_idx = get_worst_idx();
+		erase_unordered(worst_idx);
+		return worst_idx != new_idx;
+	}
+	const size_type worst_idx = get_worst_idx();
+	if (m_prob->compare_fc(m_container[worst_idx].cur_f,m_container[worst_idx].cur_c,f,c)) {
+		return false;
+	}
+	// Forget the memory of the replaced individual, so that the bests are set to the new currents.
+	m_container[worst_idx].best_x.clear();
+	m_container[worst_idx].best_f.clear();
+	m_container[worst_idx].best_c.clear();
+	assign_individual(worst_idx,x,f,c);
+	init_velocity(worst_idx);
+	return true;
+}
+
+/// Erase individual idx, moving the last individual into its position
+/**
+ * Same as erase(), except that the order of the individuals is not preserved: the last individual is moved into position idx
+ * instead of shifting all the individuals after idx. The domination lists only need to forget idx and rename the last
+ * individual, and no individual is copied around, which makes this the method of choice for steady-state algorithms.
+ *
+ * @param[in] idx index of the individual to be erased
+ *
+ * @throws index_error if idx is out of range
+ */
+void population::erase_unordered(const size_type &idx)
+{
+	pagmo_assert(m_dom_list.size() == size() && m_dom_count.size() == size());
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	const size_type last = size() - 1;
+	if (m_pareto_engine == pareto_engine::LAZY_SORT) {
+		m_dom_dirty = true;
+	} else {
+		for (size_type i = 0; i < m_dom_list[idx].size(); ++i) {
+			m_dom_count[m_dom_list[idx][i]]--;
+		}
+		for (size_type i = 0; i < size(); ++i) {
+			if (i == idx) {
+				continue;
+			}
+			std::vector<size_type> &dom_list = m_dom_list[i];
+			// The order of the domination lists is not relevant.
+			std::vector<size_type>::iterator it = std::find(dom_list.begin(),dom_list.end(),idx);
+			if (it != dom_list.end()) {
+				*it = dom_list.back();
+				dom_list.pop_back();
+			}
+			std::replace(dom_list.begin(),dom_list.end(),last,idx);
+		}
+	}
+	if (idx != last) {
+		individual_type &ind = m_container[idx], &last_ind = m_container[last];
+		ind.cur_x.swap(last_ind.cur_x);
+		ind.cur_v.swap(last_ind.cur_v);
+		ind.cur_c.swap(last_ind.cur_c);
+		ind.cur_f.swap(last_ind.cur_f);
+		ind.best_x.swap(last_ind.best_x);
+		ind.best_c.swap(last_ind.best_c);
+		ind.best_f.swap(last_ind.best_f);
+		m_dom_list[idx].swap(m_dom_list[last]);
+		m_dom_count[idx] = m_dom_count[last];
+	}
+	m_container.pop_back();
+	m_dom_list.pop_back();
+	m_dom_count.pop_back();
+	if (m_soa_active && !m_soa_dirty) {
+		for (int k = 0; k < n_soa_members; ++k) {
+			(m_soa.*soa_members[k]).copy_row(last,idx);
+			(m_soa.*soa_members[k]).resize(last);
+		}
+	}
+	if (idx != last) {
+		update_tournament(idx);
+	}
+	update_tournament(last);
+}
+
+/// Enable or disable the evaluation check.
+/**
+ * When enabled, the methods inserting pre-evaluated individuals re-evaluate the decision vectors and throw
+ * if the fitness or constraint vectors provided do not match. This is meant to debug algorithms and is disabled by default,
+ * as it doubles the number of objective function evaluations.
+ *
+ * @param[in] flag true to enable the check.
+ */
+void population::set_evaluation_check(bool flag)
+{
+	m_evaluation_check = flag;
+}
+
+/// Get the evaluation check flag.
+/**
+ * @return true if the evaluation check is enabled.
+ *
+ * @see population::set_evaluation_check()
+ */
+bool population::get_evaluation_check() const
+{
+	return m_evaluation_check;
 }
 
 /// Erase individual idx
@@ -936,6 +1581,20 @@ void population::erase(const population::size_type & idx) {
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid individual position");
 	}
+	// The individuals after idx change position.
+	m_tournament_dirty = true;
+	if (m_soa_active && !m_soa_dirty) {
+		for (int k = 0; k < n_soa_members; ++k) {
+			(m_soa.*soa_members[k]).erase(idx);
+		}
+	}
+	if (m_pareto_engine == pareto_engine::LAZY_SORT) {
+		m_container.erase(m_container.begin() + idx);
+		m_dom_count.erase(m_dom_count.begin() + idx);
+		m_dom_list.erase(m_dom_list.begin() + idx);
+		m_dom_dirty = true;
+		return;
+	}
 	for (population::size_type i = 0; i < m_dom_list[idx].size(); ++i) {
 		m_dom_count[m_dom_list[idx][i]]--;
 	}
@@ -958,19 +1617,9 @@ void population::erase(const population::size_type & idx) {
 	}
 }
 
-/// Append individual with given decision vector.
-/**
- * A new individual with decision vector x will be appended at the end of the population.
- * Velocity will be initialised randomly (as described in reinit()).
- *
- * @param[in] x decision vector of the individual to be appended.
- */
-void population::push_back(const decision_vector &x)
+// Append an individual with sized current vectors and undefined bests.
+void population::append_individual()
 {
-	if (!m_prob->verify_x(x)) {
-		pagmo_throw(value_error,"decision vector is not compatible with problem");
-
-	}
 	// Store sizes temporarily.
 	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
 	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
@@ -986,12 +1635,48 @@ void population::push_back(const decision_vector &x)
 	m_container.back().cur_f.resize(f_size);
 	// NOTE: do not allocate space for bests, as they are not defined yet. set_x will take
 	// care of it.
+	update_soa(m_container.size() - 1);
+}
+
+/// Append individual with given decision vector.
+/**
+ * A new individual with decision vector x will be appended at the end of the population.
+ * Velocity will be initialised randomly (as described in reinit()).
+ *
+ * @param[in] x decision vector of the individual to be appended.
+ */
+void population::push_back(const decision_vector &x)
+{
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+
+	}
+	append_individual();
 	// Set the individual.
 	set_x(m_container.size() - 1,x);
 	// Initialise randomly the velocity vector.
 	init_velocity(m_container.size() - 1);
 }
 
+/// Append individual with given decision vector, fitness and constraints.
+/**
+ * Same as push_back(const decision_vector &), but f and c are trusted to be the fitness and constraint vectors of x
+ * (see set_x(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &)).
+ *
+ * @param[in] x decision vector of the individual to be appended.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ *
+ * @throws value_error if x, f or c are not compatible with the problem, or if the evaluation check fails.
+ */
+void population::push_back(const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	check_evaluation(x,f,c);
+	append_individual();
+	assign_individual(m_container.size() - 1,x,f,c);
+	init_velocity(m_container.size() - 1);
+}
+
 /// Set the velocity vector of individual at position idx.
 /**
  * Will fail if dimension of v differs from the problem dimension.
@@ -1009,6 +1694,7 @@ void population::set_v(const size_type &idx, const decision_vector &v)
 	}
 	// Set decision vector.
 	m_container[idx].cur_v = v;
+	update_soa(idx);
 }
 
 /// Get constant reference to internal problem::base object.
@@ -1052,6 +1738,11 @@ void population::clear()
 	m_container.clear();
 	m_dom_list.clear();
 	m_dom_count.clear();
+	m_dom_dirty = false;
+	m_worst_tree.clear();
+	m_best_tree.clear();
+	m_tournament_dirty = true;
+	rebuild_soa();
 	m_crowding_d.clear();
 	m_pareto_rank.clear();
 	m_champion = champion_type();
@@ -1088,16 +1779,23 @@ population::const_iterator population::end() const
  * @param[in] active_set Indices of individuals that should participate in the race. If empty, race on the whole population.
  * @param[in] race_best If true winners are the best, otherwise winners are the worst
  * @param[in] screen_output If true some screen output is produced
+ * @param[in] n_threads Number of threads used for the re-evaluations (0 for the number of hardware threads)
+ * @param[out] speedup If not null, will be set to the speedup achieved by the parallel re-evaluations
  *
  * @return Indices of the individuals that remain in the race in the end, a.k.a the winners.
  *
- * @see pagmo::util::racing::race
+ * @see pagmo::util::racing::race_pop
  */
-std::pair<std::vector<population::size_type>, unsigned int> population::race(const size_type n_final, const unsigned int min_trials, const unsigned int max_count, double delta, const std::vector<size_type>& active_set, const bool race_best, const bool screen_output) const
+std::pair<std::vector<population::size_type>, unsigned int> population::race(const size_type n_final, const unsigned int min_trials, const unsigned int max_count, double delta, const std::vector<size_type>& active_set, const bool race_best, const bool screen_output, const unsigned int n_threads, double *speedup) const
 {
 	unsigned int seed = m_urng();
 	util::racing::race_pop m_race_pop(*this, seed);
-	return m_race_pop.run(n_final, min_trials, max_count, delta, active_set, util::racing::race_pop::MAX_BUDGET, race_best, screen_output);
+	m_race_pop.set_threads(n_threads);
+	std::pair<std::vector<population::size_type>, unsigned int> retval = m_race_pop.run(n_final, min_trials, max_count, delta, active_set, util::racing::race_pop::MAX_BUDGET, race_best, screen_output);
+	if (speedup) {
+		*speedup = m_race_pop.get_speedup();
+	}
+	return retval;
 }
 
 /// Number of dominated individuals.
@@ -36,6 +36,7 @@
 #include "rng.h"
 #include "serialization.h"
 #include "types.h"
+#include "util/soa_matrix.h"
 
 namespace pagmo
 {
@@ -62,6 +63,9 @@ typedef boost::shared_ptr<base> base_ptr;
  * (identified by their positional index in the population) which I dominates, and a 'domination count' containing the number
  * of individuals that dominate I. Individual I1 is dominated by individual I2 if problem::base::compare_fc
  * on the fitness and constraints vectors of I1 and I2 respectively returns true.
+ * How this information is maintained is selected via set_pareto_engine(): the default engine (pareto_engine::INCREMENTAL)
+ * keeps the domination lists up to date on every modification of the population, while pareto_engine::LAZY_SORT
+ * only marks them as outdated and computes Pareto ranks on demand through an efficient non-dominated sort.
  * The best/worst individuals in the population are computed according to the crowding distance operator (in case of multi-objective problems)
  *
  * @author Francesco Biscani (bluescarni@gmail.com)
@@ -185,6 +189,27 @@ class __PAGMO_VISIBLE population
 					boost::serialization::split_member(ar,*this,version);
 				}
 		};
+		/// Structure-of-arrays view of the individuals.
+		/**
+		* One contiguous matrix per member of individual_type, whose i-th row mirrors the corresponding vector of the i-th individual.
+		*/
+		struct soa_type
+		{
+				/// Current decision vectors.
+				util::soa_matrix	cur_x;
+				/// Current velocity vectors.
+				util::soa_matrix	cur_v;
+				/// Current constraint vectors.
+				util::soa_matrix	cur_c;
+				/// Current fitness vectors.
+				util::soa_matrix	cur_f;
+				/// Best decision vectors so far.
+				util::soa_matrix	best_x;
+				/// Best constraint vectors so far.
+				util::soa_matrix	best_c;
+				/// Best fitness vectors so far.
+				util::soa_matrix	best_f;
+		};
 		/// Underlying container type.
 		typedef std::vector<individual_type> container_type;
 
@@ -193,13 +218,22 @@ class __PAGMO_VISIBLE population
 
 		/// Const iterator.
 		typedef container_type::const_iterator const_iterator;
+		/// Pareto bookkeeping engine info
+		struct pareto_engine {
+			/// Engine type, incremental domination lists or lazy non-dominated sorting
+			enum type {INCREMENTAL = 0, LAZY_SORT = 1};
+		};
 		explicit population(const problem::base &, int = 0, const boost::uint32_t &seed = getSeed());
         static boost::uint32_t getSeed(){
 			return rng_generator::get<rng_uint32>()();
 		}
 		population(const population &);
 		population &operator=(const population &);
+		void swap(population &);
 		const individual_type &get_individual(const size_type &) const;
+		const soa_type &soa() const;
+		void set_soa_storage(bool);
+		bool get_soa_storage() const;
 
 		// Multi-Objective stuff
 		const std::vector<size_type> &get_domination_list(const size_type &) const;
@@ -211,6 +245,8 @@ class __PAGMO_VISIBLE population
 		std::vector<std::vector<size_type> > compute_pareto_fronts() const;
 		fitness_vector compute_ideal() const;
 		fitness_vector compute_nadir() const;
+		void set_pareto_engine(pareto_engine::type);
+		pareto_engine::type get_pareto_engine() const;
 
 		const problem::base &problem() const;
 		const champion_type &champion() const;
@@ -220,9 +256,18 @@ class __PAGMO_VISIBLE population
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_x(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &);
 		void set_v(const size_type &, const decision_vector &);
 		void push_back(const decision_vector &);
+		void push_back(const decision_vector &, const fitness_vector &, const constraint_vector &);
+		void replace_generation(const std::vector<decision_vector> &, const std::vector<fitness_vector> &,
+			const std::vector<constraint_vector> &);
+		bool replace_worst(const decision_vector &);
+		bool replace_worst(const decision_vector &, const fitness_vector &, const constraint_vector &);
+		void set_evaluation_check(bool);
+		bool get_evaluation_check() const;
 		void erase(const size_type &);
+		void erase_unordered(const size_type &);
 		size_type size() const;
 		const_iterator begin() const;
 		const_iterator end() const;
@@ -242,7 +287,9 @@ class __PAGMO_VISIBLE population
 									double delta = 0.05,
 									const std::vector<size_type>& = std::vector<size_type>(),
 									const bool race_best = true,
-									const bool screen_output = false) const;
+									const bool screen_output = false,
+									const unsigned int n_threads = 1,
+									double *speedup = 0) const;
 
 		struct crowded_comparison_operator {
 			crowded_comparison_operator(const population &);
@@ -261,23 +308,59 @@ class __PAGMO_VISIBLE population
 	private:
 		void init_velocity(const size_type &);
 		void update_champion(const size_type &);
+		void update_best(const size_type &);
+		void append_individual();
+		void assign_individual(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &);
+		void check_evaluation(const decision_vector &, const fitness_vector &, const constraint_vector &) const;
+
+		// Tournament trees (single-objective only)
+		size_type worse_individual(const size_type &, const size_type &) const;
+		size_type better_individual(const size_type &, const size_type &) const;
+		void rebuild_tournament() const;
+		void update_tournament(const size_type &) const;
+
+		// Structure-of-arrays mirror
+		void rebuild_soa() const;
 
 		// Multi-objective stuff
 		void update_crowding_d(std::vector<size_type>) const;
+		void rebuild_dom() const;
+		void non_dominated_sort() const;
 
 	protected:
 		void update_dom(const size_type &);
+		void update_soa(const size_type &);
 
 	private:
 		// Data members + their serialization
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & m_prob;
 			ar & m_container;
 			ar & m_dom_list;
 			ar & m_dom_count;
+			if (version >= 1) {
+				ar & m_pareto_engine;
+				ar & m_dom_dirty;
+				ar & m_evaluation_check;
+				ar & m_soa_active;
+			} else {
+				m_pareto_engine = pareto_engine::INCREMENTAL;
+				m_dom_dirty = false;
+				m_evaluation_check = false;
+				m_soa_active = false;
+			}
+			// The tournament trees and the structure-of-arrays mirror are not archived: they are rebuilt from the individuals when
+			// they are next needed.
+			if (Archive::is_loading::value) {
+				m_worst_tree.clear();
+				m_best_tree.clear();
+				m_tournament_dirty = true;
+				m_soa = soa_type();
+				m_soa_dirty = true;
+			}
 			ar & m_pareto_rank;
 			ar & m_crowding_d;
 			ar & m_champion;
@@ -290,11 +373,28 @@ class __PAGMO_VISIBLE population
 		// Container of individuals. Needs to be protected so that a derived class can override
 		// the set_x mechanism avoiding function re-evaluations. (use this option at your own risk)
 		container_type					m_container;
-		// List of dominated individuals.
-		std::vector<std::vector<size_type> >		m_dom_list;
+		// List of dominated individuals. Mutable as the lazy engine rebuilds it on demand.
+		mutable std::vector<std::vector<size_type> >	m_dom_list;
 		// Domination Count (number of dominant individuals)
-		std::vector<size_type>				m_dom_count;
+		mutable std::vector<size_type>			m_dom_count;
 	private:
+		// Pareto bookkeeping engine.
+		pareto_engine::type				m_pareto_engine;
+		// True when m_dom_list and m_dom_count are outdated (lazy engine only).
+		mutable bool					m_dom_dirty;
+		// Re-evaluate and compare the fitness and constraints handed over to the pre-evaluated insertion methods.
+		bool						m_evaluation_check;
+		// Tournament trees over the current fitness and constraints of the individuals (single-objective problems only):
+		// node k holds the worst (best) individual among nodes 2k and 2k+1, the leaves start at half the size of the tree.
+		mutable std::vector<size_type>			m_worst_tree;
+		mutable std::vector<size_type>			m_best_tree;
+		// True when the tournament trees must be rebuilt.
+		mutable bool					m_tournament_dirty;
+		// Structure-of-arrays mirror of m_container, kept up to date while enabled (see set_soa_storage()).
+		mutable soa_type				m_soa;
+		bool						m_soa_active;
+		// True when the mirror must be rebuilt before use (after loading from an archive).
+		mutable bool					m_soa_dirty;
 		// Population champion.
 		champion_type					m_champion;
 		// Pareto rank
@@ -343,4 +443,7 @@ inline void load_construct_data(Archive &ar, pagmo::population *pop, const unsig
 
 }} //namespaces
 
+// Version 1: Pareto engine, evaluation check and structure-of-arrays view settings.
+BOOST_CLASS_VERSION(pagmo::population,1)
+
 #endif
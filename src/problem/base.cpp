@@ -25,11 +25,14 @@
 // 30/01/10 Created by Francesco Biscani.
 
 #include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/numeric/conversion/bounds.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
 #include <cmath>
 #include <climits>
 #include <cstddef>
@@ -43,6 +46,7 @@
 
 #include "../exceptions.h"
 #include "../population.h"
+#include "../thread_pool.h"
 #include "../types.h"
 #include "base.h"
 
@@ -66,15 +70,15 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_batch_threads(1),
+	m_jac_pattern_ok(false),
+	m_jac_step(0)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -112,15 +116,15 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_batch_threads(1),
+	m_jac_pattern_ok(false),
+	m_jac_step(0)
 {
 	if (c_tol.size() != static_cast<constraint_vector::size_type>(nc) ) {
 		pagmo_throw(value_error,"invalid constraints vector dimension");
@@ -165,15 +169,15 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_batch_threads(1),
+	m_jac_pattern_ok(false),
+	m_jac_step(0)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -216,15 +220,15 @@ base::base(const decision_vector &lb, const decision_vector &ub, int ni, int nf,
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_batch_threads(1),
+	m_jac_pattern_ok(false),
+	m_jac_step(0)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -571,10 +575,7 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 		pagmo_throw(value_error,"wrong decision vector size when calling objective function");
 	}
 	// Look into the cache.
-	typedef decision_vector_cache_type::iterator x_iterator;
-	typedef fitness_vector_cache_type::iterator f_iterator;
-	const x_iterator x_it = std::find(m_decision_vector_cache_f.begin(),m_decision_vector_cache_f.end(),x);
-	if (x_it == m_decision_vector_cache_f.end()) {
+	if (!m_fitness_cache.get(f,x)) {
 		// Fitness is not into memory. Calculate it.
 		objfun_impl(f,x);
 		// Increase function evaluation counter.
@@ -583,30 +584,86 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 		if (f.size() != m_f_dimension) {
 			pagmo_throw(value_error,"fitness dimension was changed inside objfun_impl()");
 		}
-		// Store the decision vector and the newly-calculated fitness in the front of the buffers.
-		m_decision_vector_cache_f.push_front(x);
-		m_fitness_vector_cache.push_front(f);
+		// Store the decision vector and the newly-calculated fitness in the cache.
+		m_fitness_cache.put(x,f);
+	}
+}
+
+/// Write the fitnesses of a batch of pagmo::decision_vector into a vector of pagmo::fitness_vector.
+/**
+ * Equivalent to calling objfun() on each element of x, but the decision vectors that are not found in the fitness cache
+ * are handed over all at once to batch_objfun_impl(), whose default implementation can evaluate them in parallel (see set_batch_threads()).
+ * The newly-computed fitnesses are stored in the fitness cache, which keeps only the last get_cache_capacity() ones: to insert the
+ * batch into a population without re-evaluating it, use the population methods accepting pre-computed fitness and constraint vectors.
+ *
+ * @param[out] f vector of fitness vectors, which will be resized to the size of x.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ *
+ * @throws value_error if the dimension of any element of x is different from the problem dimension.
+ */
+void base::batch_objfun(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	typedef std::vector<decision_vector>::size_type batch_size_type;
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"wrong decision vector size when calling batch objective function");
+		}
+	}
+	f.resize(x.size());
+	// Look into the cache and record which decision vectors still need to be evaluated.
+	std::vector<batch_size_type> missing;
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		f[i].resize(m_f_dimension);
+		if (!m_fitness_cache.get(f[i],x[i])) {
+			missing.push_back(i);
+		}
+	}
+	if (missing.empty()) {
+		return;
+	}
+	if (missing.size() == x.size()) {
+		// Nothing was cached, avoid copying the batch around.
+		batch_objfun_impl(f,x);
 	} else {
-		// Compute the corresponding iterator in the fitness vector cache.
-		f_iterator f_it = m_fitness_vector_cache.begin();
-		std::advance(f_it,std::distance(m_decision_vector_cache_f.begin(),x_it));
-		pagmo_assert(f_it != m_fitness_vector_cache.end());
-		// Assign to the fitness vector the value in the cache.
-		f = *f_it;
-		// Move the content of the current positions to the front of the buffers, and shift everything else down
-		// by one position.
-		x_iterator tmp_x_it = m_decision_vector_cache_f.begin();
-		f_iterator tmp_f_it = m_fitness_vector_cache.begin();
-		while (x_it != tmp_x_it) {
-			x_it->swap(*tmp_x_it);
-			f_it->swap(*tmp_f_it);
-			++tmp_x_it;
-			++tmp_f_it;
+		std::vector<decision_vector> x_missing(missing.size());
+		std::vector<fitness_vector> f_missing(missing.size(),fitness_vector(m_f_dimension));
+		for (batch_size_type i = 0; i < missing.size(); ++i) {
+			x_missing[i] = x[missing[i]];
+		}
+		batch_objfun_impl(f_missing,x_missing);
+		for (batch_size_type i = 0; i < missing.size(); ++i) {
+			f[missing[i]].swap(f_missing[i]);
 		}
-		pagmo_assert(tmp_f_it == f_it);
+	}
+	m_fevals += boost::numeric_cast<unsigned int>(missing.size());
+	for (batch_size_type i = 0; i < missing.size(); ++i) {
+		if (f[missing[i]].size() != m_f_dimension) {
+			pagmo_throw(value_error,"fitness dimension was changed inside batch_objfun_impl()");
+		}
+		m_fitness_cache.put(x[missing[i]],f[missing[i]]);
 	}
 }
 
+/// Implementation of batch fitness computation.
+/**
+ * Write into f[i] the fitness of x[i]. This function is not to be called directly, it is invoked by batch_objfun() with f already
+ * sized as x and with fitness vectors of the correct dimension.
+ *
+ * The default implementation calls objfun_impl() on every element of x. If more than one thread was requested via set_batch_threads(),
+ * the batch is split in contiguous chunks, one per thread: the first chunk is evaluated by this in the calling thread, the others
+ * by clones of this on the shared thread pool (see thread_pool::shared()), so that objfun_impl() is not required to be thread-safe (problems
+ * declaring to be, see is_thread_safe(), are shared instead). The clones are kept for the subsequent batches until reset_caches()
+ * is called. Problems that can evaluate many decision vectors more efficiently at once (e.g., vectorised or remote evaluations)
+ * can override this method.
+ *
+ * @param[out] f fitness vectors into which the fitnesses of x will be written.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ */
+void base::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	batch_evaluate(f,x,&base::objfun_impl);
+}
+
 /// Compare fitness vectors.
 /**
  * Will perform sanity checks on v_f1 and v_f2 and then will call base::compare_fitness_impl().
@@ -881,10 +938,7 @@ void base::compute_constraints(constraint_vector &c, const decision_vector &x) c
 		return;
 	}
 	// Look into the cache.
-	typedef decision_vector_cache_type::iterator x_iterator;
-	typedef constraint_vector_cache_type::iterator c_iterator;
-	const x_iterator x_it = std::find(m_decision_vector_cache_c.begin(),m_decision_vector_cache_c.end(),x);
-	if (x_it == m_decision_vector_cache_c.end()) {
+	if (!m_constraint_cache.get(c,x)) {
 		// Constraint vector is not into memory. Calculate it.
 		compute_constraints_impl(c,x);
 		m_cevals++;
@@ -892,27 +946,8 @@ void base::compute_constraints(constraint_vector &c, const decision_vector &x) c
 		if (c.size() != get_c_dimension()) {
 			pagmo_throw(value_error,"constraints dimension was changed inside compute_constraints_impl()");
 		}
-		// Store the decision vector and the newly-calculated constraint vector in the front of the buffers.
-		m_decision_vector_cache_c.push_front(x);
-		m_constraint_vector_cache.push_front(c);
-	} else {
-		// Compute the corresponding iterator in the constraint vector cache.
-		c_iterator c_it = m_constraint_vector_cache.begin();
-		std::advance(c_it,std::distance(m_decision_vector_cache_c.begin(),x_it));
-		pagmo_assert(c_it != m_constraint_vector_cache.end());
-		// Assign to the fitness vector the value in the cache.
-		c = *c_it;
-		// Move the content of the current positions to the front of the buffers, and shift everything else down
-		// by one position.
-		x_iterator tmp_x_it = m_decision_vector_cache_c.begin();
-		c_iterator tmp_c_it = m_constraint_vector_cache.begin();
-		while (x_it != tmp_x_it) {
-			x_it->swap(*tmp_x_it);
-			c_it->swap(*tmp_c_it);
-			++tmp_x_it;
-			++tmp_c_it;
-		}
-		pagmo_assert(tmp_c_it == c_it);
+		// Store the decision vector and the newly-calculated constraint vector in the cache.
+		m_constraint_cache.put(x,c);
 	}
 }
 
@@ -936,6 +971,118 @@ constraint_vector base::compute_constraints(const decision_vector &x) const
 	return c;
 }
 
+/// Write the constraints of a batch of pagmo::decision_vector into a vector of pagmo::constraint_vector.
+/**
+ * Equivalent to calling compute_constraints() on each element of x, with the same batching and caching behaviour as batch_objfun().
+ *
+ * @param[out] c vector of constraint vectors, which will be resized to the size of x.
+ * @param[in] x decision vectors whose constraints will be computed.
+ *
+ * @throws value_error if the dimension of any element of x is different from the problem dimension.
+ */
+void base::batch_compute_constraints(std::vector<constraint_vector> &c, const std::vector<decision_vector> &x) const
+{
+	typedef std::vector<decision_vector>::size_type batch_size_type;
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"invalid decision vector size during batch constraint computation");
+		}
+	}
+	c.resize(x.size());
+	// Do not do anything else if constraints size is 0.
+	if (!m_c_dimension) {
+		for (batch_size_type i = 0; i < x.size(); ++i) {
+			c[i].clear();
+		}
+		return;
+	}
+	std::vector<batch_size_type> missing;
+	for (batch_size_type i = 0; i < x.size(); ++i) {
+		c[i].resize(m_c_dimension);
+		if (!m_constraint_cache.get(c[i],x[i])) {
+			missing.push_back(i);
+		}
+	}
+	if (missing.empty()) {
+		return;
+	}
+	if (missing.size() == x.size()) {
+		batch_compute_constraints_impl(c,x);
+	} else {
+		std::vector<decision_vector> x_missing(missing.size());
+		std::vector<constraint_vector> c_missing(missing.size(),constraint_vector(m_c_dimension));
+		for (batch_size_type i = 0; i < missing.size(); ++i) {
+			x_missing[i] = x[missing[i]];
+		}
+		batch_compute_constraints_impl(c_missing,x_missing);
+		for (batch_size_type i = 0; i < missing.size(); ++i) {
+			c[missing[i]].swap(c_missing[i]);
+		}
+	}
+	m_cevals += boost::numeric_cast<unsigned int>(missing.size());
+	for (batch_size_type i = 0; i < missing.size(); ++i) {
+		if (c[missing[i]].size() != m_c_dimension) {
+			pagmo_throw(value_error,"constraints dimension was changed inside batch_compute_constraints_impl()");
+		}
+		m_constraint_cache.put(x[missing[i]],c[missing[i]]);
+	}
+}
+
+/// Implementation of batch constraint computation.
+/**
+ * Write into c[i] the constraint vector of x[i]. This function is not to be called directly, it is invoked by batch_compute_constraints()
+ * with c already sized as x and with constraint vectors of the correct dimension.
+ *
+ * The default implementation calls compute_constraints_impl() on every element of x, possibly in parallel as explained in batch_objfun_impl().
+ *
+ * @param[out] c constraint vectors into which the constraints of x will be written.
+ * @param[in] x decision vectors whose constraints will be computed.
+ */
+void base::batch_compute_constraints_impl(std::vector<constraint_vector> &c, const std::vector<decision_vector> &x) const
+{
+	batch_evaluate(c,x,&base::compute_constraints_impl);
+}
+
+// Evaluate impl on the elements of x, splitting the work among m_batch_threads threads.
+void base::batch_evaluate(std::vector<std::vector<double> > &out, const std::vector<decision_vector> &x, eval_impl_type impl) const
+{
+	unsigned int n_threads = m_batch_threads;
+	if (!n_threads) {
+		n_threads = std::max<unsigned int>(boost::thread::hardware_concurrency(),1u);
+	}
+	const std::size_t n_chunks = std::min<std::size_t>(n_threads,x.size());
+	if (n_chunks <= 1) {
+		batch_evaluate_chunk(this,out,x,impl,0,x.size());
+		return;
+	}
+	// Problems are not required to be thread-safe, hence (unless they declare to be) every additional chunk is evaluated by its own
+	// copy of the problem. The copies are created on first use and reused by the subsequent batches.
+	const bool shared = is_thread_safe();
+	std::vector<base_ptr> &clones = m_batch_clones.m_clones;
+	while (!shared && clones.size() < n_chunks - 1) {
+		clones.push_back(clone());
+	}
+	// Chunk boundaries: the first x.size() % n_chunks chunks get one extra element.
+	std::vector<boost::function<void ()> > tasks;
+	std::size_t begin = 0;
+	for (std::size_t i = 0; i < n_chunks; ++i) {
+		const std::size_t end = begin + x.size() / n_chunks + (i < x.size() % n_chunks ? 1 : 0);
+		tasks.push_back(boost::bind(&base::batch_evaluate_chunk,(shared || !i) ? this : clones[i - 1].get(),boost::ref(out),boost::cref(x),
+			impl,begin,end));
+		begin = end;
+	}
+	thread_pool::shared().run_all(tasks);
+}
+
+// Evaluate impl on the elements of x in the [begin,end[ range using prob.
+void base::batch_evaluate_chunk(const base *prob, std::vector<std::vector<double> > &out, const std::vector<decision_vector> &x,
+	eval_impl_type impl, std::size_t begin, std::size_t end)
+{
+	for (std::size_t i = begin; i < end; ++i) {
+		(prob->*impl)(out[i],x[i]);
+	}
+}
+
 /// Test feasibility of decision vector.
 /**
  * This method will compute the constraint vector associated to x and test it with feasibility_c().
@@ -1128,6 +1275,10 @@ bool base::verify_x(const decision_vector &x) const
 void base::normalise_bounds()
 {
 	pagmo_assert(m_lb.size() >= m_i_dimension);
+	// The dense Jacobian pattern depends on the bounds.
+	m_jac_pattern_ok = false;
+	m_jac_x.clear();
+	m_batch_clones.m_clones.clear();
 	// Flag to be set if we had to fix the bounds.
 	bool bounds_fixed = false;
 	for (size_type i = 0; i < m_lb.size() - m_i_dimension; ++i) {
@@ -1240,13 +1391,15 @@ void base::estimate_sparsity(const decision_vector &x0, int& lenG, std::vector<i
 		pagmo_throw(value_error,"cannot estimate pattern from this decision vector: not compatible with problem");
 	}
 	size_type Dc = m_lb.size() - m_i_dimension;
-	fitness_vector f0(m_f_dimension),f_new(m_f_dimension);
+	fitness_vector f0(m_f_dimension);
 	objfun(f0,x0);
-	constraint_vector c0(m_c_dimension),c_new(m_c_dimension);
+	constraint_vector c0(m_c_dimension);
 	compute_constraints(c0,x0);
-	decision_vector x_new = x0;
 	iGfun.resize(0);jGvar.resize(0); lenG=0;
 
+	// The perturbed points are evaluated as one batch.
+	std::vector<decision_vector> x_new;
+	std::vector<size_type> perturbed;
 	for (size_type j=0;j<Dc;++j)
 	{
 		//we perturb the component of x0 only if ub>lb, if ub=lb the variable is assumed
@@ -1254,18 +1407,25 @@ void base::estimate_sparsity(const decision_vector &x0, int& lenG, std::vector<i
 		//useful, but it also requires that the algorithm treat those variables accordingly (i.e.
 		//it does not allow them to be outside the box bounds)
 		if (m_ub[j] == m_lb[j]) continue;
-		x_new[j] = x0[j] +  std::max(std::fabs(x0[j]), 1.0) * 1e-8;
-		objfun(f_new,x_new);
-		compute_constraints(c_new,x_new);
+		x_new.push_back(x0);
+		x_new.back()[j] = x0[j] +  std::max(std::fabs(x0[j]), 1.0) * 1e-8;
+		perturbed.push_back(j);
+	}
+	std::vector<fitness_vector> f_new;
+	std::vector<constraint_vector> c_new;
+	evaluate_perturbations(f_new,c_new,x_new);
+
+	for (std::vector<size_type>::size_type k=0;k<perturbed.size();++k)
+	{
+		const size_type j = perturbed[k];
 		for (size_type i=0;i<m_f_dimension;++i)
 		{
-			if (f_new[i]!=f0[i]) {iGfun.push_back(i); jGvar.push_back(j); lenG++;}
+			if (f_new[k][i]!=f0[i]) {iGfun.push_back(i); jGvar.push_back(j); lenG++;}
 		}
 		for (size_type i=0;i<m_c_dimension;++i)
 		{
-			if (c_new[i]!=c0[i]) {iGfun.push_back(i+m_f_dimension); jGvar.push_back(j); lenG++;}
+			if (c_new[k][i]!=c0[i]) {iGfun.push_back(i+m_f_dimension); jGvar.push_back(j); lenG++;}
 		}
-		x_new[j] = x0[j];
 	}
 
 }
@@ -1283,7 +1443,7 @@ void base::estimate_sparsity(const decision_vector &x0, int& lenG, std::vector<i
 void base::estimate_sparsity(int& lenG, std::vector<int>& iGfun, std::vector<int>& jGvar) const {
 
 	size_type Dc = m_lb.size() - m_i_dimension;
-	fitness_vector f0(m_f_dimension),f_new(m_f_dimension);
+	fitness_vector f0(m_f_dimension);
 	decision_vector x0(Dc);
 	// Double precision random number generator.
 	rng_double drng(rng_generator::get<rng_double>());
@@ -1293,11 +1453,13 @@ void base::estimate_sparsity(int& lenG, std::vector<int>& iGfun, std::vector<int
 	}
 
 	objfun(f0,x0);
-	constraint_vector c0(m_c_dimension),c_new(m_c_dimension);
+	constraint_vector c0(m_c_dimension);
 	compute_constraints(c0,x0);
-	decision_vector x_new = x0;
 	iGfun.resize(0);jGvar.resize(0); lenG=0;
 
+	// The perturbed points are evaluated as one batch.
+	std::vector<decision_vector> x_new;
+	std::vector<decision_vector::size_type> perturbed;
 	for (decision_vector::size_type j=0;j<Dc;++j)
 	{
 		//we perturb the component of x0 only if ub>lb, if ub=lb the variable is assumed
@@ -1305,18 +1467,25 @@ void base::estimate_sparsity(int& lenG, std::vector<int>& iGfun, std::vector<int
 		//useful, but it also requires that the algorithm treat those variables accordingly (i.e.
 		//it does not allow them to go outside the box bounds)
 		if (m_ub[j] == m_lb[j]) continue;
-		x_new[j] = boost::uniform_real<double>(m_lb[j],m_ub[j])(drng);
-		objfun(f_new,x_new);
-		compute_constraints(c_new,x_new);
+		x_new.push_back(x0);
+		x_new.back()[j] = boost::uniform_real<double>(m_lb[j],m_ub[j])(drng);
+		perturbed.push_back(j);
+	}
+	std::vector<fitness_vector> f_new;
+	std::vector<constraint_vector> c_new;
+	evaluate_perturbations(f_new,c_new,x_new);
+
+	for (std::vector<decision_vector::size_type>::size_type k=0;k<perturbed.size();++k)
+	{
+		const decision_vector::size_type j = perturbed[k];
 		for (fitness_vector::size_type i=0;i<m_f_dimension;++i)
 		{
-			if (f_new[i]!=f0[i]) {iGfun.push_back(i); jGvar.push_back(j); lenG++;}
+			if (f_new[k][i]!=f0[i]) {iGfun.push_back(i); jGvar.push_back(j); lenG++;}
 		}
 		for (constraint_vector::size_type i=0;i<m_c_dimension;++i)
 		{
-			if (c_new[i]!=c0[i]) {iGfun.push_back(i+m_f_dimension); jGvar.push_back(j); lenG++;}
+			if (c_new[k][i]!=c0[i]) {iGfun.push_back(i+m_f_dimension); jGvar.push_back(j); lenG++;}
 		}
-		x_new[j] = x0[j];
 	}
 }
 
@@ -1412,10 +1581,307 @@ void base::post_evolution(population &pop) const
  */
 void base::reset_caches() const
 {
-	m_decision_vector_cache_f = decision_vector_cache_type(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity));
-	m_fitness_vector_cache = fitness_vector_cache_type(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity));
-	m_decision_vector_cache_c = decision_vector_cache_type(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity));
-	m_constraint_vector_cache = constraint_vector_cache_type(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity));
+	m_fitness_cache.clear();
+	m_constraint_cache.clear();
+	m_jac_x.clear();
+	m_batch_clones.m_clones.clear();
+}
+
+/// Get the capacity of the internal caches.
+/**
+ * @return the maximum number of entries stored in each of the fitness and constraint caches.
+ */
+std::size_t base::get_cache_capacity() const
+{
+	return m_fitness_cache.get_capacity();
+}
+
+/// Set the capacity of the internal caches.
+/**
+ * Set the maximum number of decision vectors remembered by each of the fitness and constraint caches. When a cache is full, the least recently
+ * used entry is evicted. A capacity of zero disables caching.
+ *
+ * @param[in] capacity new capacity of the caches.
+ */
+void base::set_cache_capacity(std::size_t capacity)
+{
+	m_fitness_cache.set_capacity(capacity);
+	m_constraint_cache.set_capacity(capacity);
+}
+
+/// Get the quantization step of the internal caches.
+/**
+ * @return the quantization step used when looking up decision vectors in the caches.
+ */
+double base::get_cache_quantum() const
+{
+	return m_fitness_cache.get_quantum();
+}
+
+/// Set the quantization step of the internal caches.
+/**
+ * By default decision vectors are compared bitwise when looking them up in the caches. If quantum is strictly positive,
+ * two decision vectors will instead be considered identical if all their components round to the same multiple of quantum.
+ * The caches are emptied by this method.
+ *
+ * @param[in] quantum new quantization step (0 for bitwise comparison).
+ *
+ * @throws value_error if quantum is negative.
+ */
+void base::set_cache_quantum(const double &quantum)
+{
+	m_fitness_cache.set_quantum(quantum);
+	m_constraint_cache.set_quantum(quantum);
+}
+
+/// Return the number of cache hits.
+/**
+ * @return the number of fitness and constraint computations that were served by the caches.
+ */
+unsigned int base::get_cache_hits() const
+{
+	return m_fitness_cache.get_hits() + m_constraint_cache.get_hits();
+}
+
+/// Return the number of cache misses.
+/**
+ * @return the number of fitness and constraint computations that could not be served by the caches.
+ */
+unsigned int base::get_cache_misses() const
+{
+	return m_fitness_cache.get_misses() + m_constraint_cache.get_misses();
+}
+
+/// Get the number of batch evaluation threads.
+/**
+ * @return the number of threads used by the default implementations of batch_objfun_impl() and batch_compute_constraints_impl().
+ */
+unsigned int base::get_batch_threads() const
+{
+	return m_batch_threads;
+}
+
+/// Set the number of batch evaluation threads.
+/**
+ * Set the number of threads used by the default implementations of batch_objfun_impl() and batch_compute_constraints_impl().
+ * The default value of 1 evaluates batches serially in the calling thread. A value of 0 selects the number of hardware threads available.
+ * Each additional thread evaluates its share of the batch on a clone of the problem, unless the problem is thread-safe (see is_thread_safe()).
+ * The threads are taken from the shared thread pool (see thread_pool::shared()).
+ *
+ * @param[in] n number of threads.
+ */
+void base::set_batch_threads(unsigned int n)
+{
+	m_batch_threads = n;
+}
+
+/// Thread safety of the evaluation methods.
+/**
+ * A problem is thread-safe if objfun_impl() and compute_constraints_impl() can be called concurrently on the same instance,
+ * i.e., if they do not modify any state of the problem. The default batch evaluation methods then share the problem among
+ * their threads instead of cloning it. Problems overriding this method to return true must keep this guarantee.
+ *
+ * @return false.
+ */
+bool base::is_thread_safe() const
+{
+	return false;
+}
+
+/// Sparsity pattern of the Jacobian.
+/**
+ * Returns the entries of the Jacobian computed by compute_jacobian(), with the same convention as set_sparsity(): row i < get_f_dimension()
+ * is the i-th objective, row get_f_dimension() + k is the k-th constraint and column j is the j-th component of the decision vector.
+ * The pattern is the one declared by set_sparsity() or, if the problem does not implement it, the dense pattern of the continuous
+ * part of the decision vector, leaving out the components whose bounds coincide (see estimate_sparsity()). It is computed on first use.
+ *
+ * @param[out] lenG number of entries.
+ * @param[out] iGfun row indices of the entries.
+ * @param[out] jGvar column indices of the entries.
+ *
+ * @throws value_error if set_sparsity() returns an invalid pattern.
+ */
+void base::get_jacobian_pattern(int &lenG, std::vector<int> &iGfun, std::vector<int> &jGvar) const
+{
+	update_jacobian_pattern();
+	iGfun = m_jac_rows;
+	jGvar = m_jac_cols;
+	lenG = boost::numeric_cast<int>(m_jac_rows.size());
+}
+
+/// Finite-difference Jacobian.
+/**
+ * Writes into G the central-difference derivatives of the objective function and of the constraints at x, for the entries
+ * returned by get_jacobian_pattern() and in the same order. The derivatives with respect to \f$ x_j \f$ use the step
+ * \f$ h_j = \mbox{step} \cdot \max(1,|x_j|) \f$.
+ *
+ * Columns not sharing any row of the objective function (resp. of the constraints) are perturbed together when evaluating the objective function
+ * (resp. the constraints), so that a sparse Jacobian costs two evaluations per group of columns rather than per column. All the perturbed points
+ * are evaluated as one batch (see batch_objfun(), batch_compute_constraints() and set_batch_threads()).
+ * The last Jacobian is cached: asking again for it at the same point with the same step (e.g., for the gradient of each constraint
+ * after the gradient of the objective function) does not cost any further evaluation.
+ *
+ * The perturbed points are not clipped to the bounds.
+ *
+ * @param[out] G values of the entries of the Jacobian.
+ * @param[in] x decision vector.
+ * @param[in] step relative finite-difference step.
+ *
+ * @throws value_error if the dimension of x is wrong or step is not positive.
+ */
+void base::compute_jacobian(std::vector<double> &G, const decision_vector &x, const double &step) const
+{
+	if (x.size() != get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when computing the Jacobian");
+	}
+	if (!(step > 0)) {
+		pagmo_throw(value_error,"the finite-difference step must be positive");
+	}
+	update_jacobian_pattern();
+	if (m_jac_x.size() && step == m_jac_step && x == m_jac_x) {
+		G = m_jac_values;
+		return;
+	}
+	// Points perturbed forward (2g) and backward (2g + 1) along the columns of group g.
+	typedef std::vector<std::vector<size_type> >::size_type group_size_type;
+	std::vector<decision_vector> x_f(2 * m_jac_f_groups.size(),x), x_c(2 * m_jac_c_groups.size(),x);
+	std::vector<group_size_type> f_group(get_dimension()), c_group(get_dimension());
+	for (group_size_type g = 0; g < m_jac_f_groups.size(); ++g) {
+		for (std::vector<size_type>::size_type k = 0; k < m_jac_f_groups[g].size(); ++k) {
+			const size_type j = m_jac_f_groups[g][k];
+			const double h = step * std::max(1.,std::fabs(x[j]));
+			x_f[2 * g][j] += h;
+			x_f[2 * g + 1][j] -= h;
+			f_group[j] = g;
+		}
+	}
+	for (group_size_type g = 0; g < m_jac_c_groups.size(); ++g) {
+		for (std::vector<size_type>::size_type k = 0; k < m_jac_c_groups[g].size(); ++k) {
+			const size_type j = m_jac_c_groups[g][k];
+			const double h = step * std::max(1.,std::fabs(x[j]));
+			x_c[2 * g][j] += h;
+			x_c[2 * g + 1][j] -= h;
+			c_group[j] = g;
+		}
+	}
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	if (x_f.size()) {
+		batch_objfun(f,x_f);
+	}
+	if (x_c.size()) {
+		batch_compute_constraints(c,x_c);
+	}
+	G.resize(m_jac_rows.size());
+	for (std::vector<int>::size_type k = 0; k < m_jac_rows.size(); ++k) {
+		const size_type i = boost::numeric_cast<size_type>(m_jac_rows[k]), j = boost::numeric_cast<size_type>(m_jac_cols[k]);
+		const double h = step * std::max(1.,std::fabs(x[j]));
+		if (i < m_f_dimension) {
+			const group_size_type g = f_group[j];
+			G[k] = (f[2 * g][i] - f[2 * g + 1][i]) / 2 / h;
+		} else {
+			const group_size_type g = c_group[j];
+			G[k] = (c[2 * g][i - m_f_dimension] - c[2 * g + 1][i - m_f_dimension]) / 2 / h;
+		}
+	}
+	m_jac_x = x;
+	m_jac_step = step;
+	m_jac_values = G;
+}
+
+// Compute the Jacobian pattern and group its columns, unless already done.
+void base::update_jacobian_pattern() const
+{
+	if (m_jac_pattern_ok) {
+		return;
+	}
+	const size_type n_rows = m_f_dimension + m_c_dimension;
+	m_jac_rows.clear();
+	m_jac_cols.clear();
+	try {
+		int lenG = 0;
+		set_sparsity(lenG,m_jac_rows,m_jac_cols);
+		if (lenG < 0 || m_jac_rows.size() < static_cast<std::vector<int>::size_type>(lenG) ||
+			m_jac_cols.size() < static_cast<std::vector<int>::size_type>(lenG))
+		{
+			pagmo_throw(value_error,"invalid sparsity pattern");
+		}
+		m_jac_rows.resize(lenG);
+		m_jac_cols.resize(lenG);
+		for (int k = 0; k < lenG; ++k) {
+			if (m_jac_rows[k] < 0 || m_jac_rows[k] >= boost::numeric_cast<int>(n_rows) ||
+				m_jac_cols[k] < 0 || m_jac_cols[k] >= boost::numeric_cast<int>(get_dimension()))
+			{
+				pagmo_throw(value_error,"invalid sparsity pattern");
+			}
+		}
+	} catch (const not_implemented_error &) {
+		m_jac_rows.clear();
+		m_jac_cols.clear();
+		for (size_type j = 0; j < get_dimension() - m_i_dimension; ++j) {
+			if (m_ub[j] == m_lb[j]) {
+				continue;
+			}
+			for (size_type i = 0; i < n_rows; ++i) {
+				m_jac_rows.push_back(boost::numeric_cast<int>(i));
+				m_jac_cols.push_back(boost::numeric_cast<int>(j));
+			}
+		}
+	}
+	group_jacobian_columns(m_jac_f_groups,0,m_f_dimension);
+	group_jacobian_columns(m_jac_c_groups,m_f_dimension,n_rows);
+	m_jac_pattern_ok = true;
+}
+
+// Group greedily the columns having entries in the rows [row_begin,row_end) of the Jacobian pattern: each column joins
+// the first group whose columns do not share any of those rows with it.
+void base::group_jacobian_columns(std::vector<std::vector<size_type> > &groups, const size_type &row_begin, const size_type &row_end) const
+{
+	// Rows of each column.
+	std::vector<std::vector<size_type> > col_rows(get_dimension());
+	for (std::vector<int>::size_type k = 0; k < m_jac_rows.size(); ++k) {
+		const size_type i = boost::numeric_cast<size_type>(m_jac_rows[k]);
+		if (i >= row_begin && i < row_end) {
+			col_rows[m_jac_cols[k]].push_back(i - row_begin);
+		}
+	}
+	// Rows touched by each group.
+	std::vector<std::vector<char> > group_rows;
+	groups.clear();
+	for (size_type j = 0; j < get_dimension(); ++j) {
+		if (col_rows[j].empty()) {
+			continue;
+		}
+		std::vector<std::vector<size_type> >::size_type g = 0;
+		for (; g < groups.size(); ++g) {
+			std::vector<size_type>::size_type k = 0;
+			while (k < col_rows[j].size() && !group_rows[g][col_rows[j][k]]) {
+				++k;
+			}
+			if (k == col_rows[j].size()) {
+				break;
+			}
+		}
+		if (g == groups.size()) {
+			groups.push_back(std::vector<size_type>());
+			group_rows.push_back(std::vector<char>(row_end - row_begin,0));
+		}
+		groups[g].push_back(j);
+		for (std::vector<size_type>::size_type k = 0; k < col_rows[j].size(); ++k) {
+			group_rows[g][col_rows[j][k]] = 1;
+		}
+	}
+}
+
+// Evaluate the objective function and the constraints on a batch of perturbed points.
+void base::evaluate_perturbations(std::vector<fitness_vector> &f, std::vector<constraint_vector> &c, const std::vector<decision_vector> &x) const
+{
+	batch_objfun(f,x);
+	if (m_c_dimension) {
+		batch_compute_constraints(c,x);
+	} else {
+		c.assign(x.size(),constraint_vector());
+	}
 }
 
 }} //namespaces
@@ -32,18 +32,19 @@
 // #define BOOST_CB_DISABLE_DEBUG 
 
 #include <algorithm>
-#include <boost/circular_buffer.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <cstddef>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../exceptions.h"
 #include "../serialization.h"
 #include "../types.h"
+#include "../util/eval_cache.h"
 //#include "base_meta.h"
 
 namespace pagmo
@@ -51,6 +52,8 @@ namespace pagmo
 // Fwd declarations.
 class population;
 class island;
+class mpi_environment;
+namespace util { namespace racing { class race_pop; } }
 
 /// Problem namespace.
 /**
@@ -115,7 +118,10 @@ typedef boost::shared_ptr<base> base_ptr;
  * by the problem are always used instead during the migration of decision vectors from one island to the other.
  *
  * \section Caching
- * A caching mechanism is implemented to make sure the objective function is never evaluated twice on the very same chromosome
+ * A caching mechanism is implemented to make sure the objective function is never evaluated twice on the very same chromosome.
+ * Fitness and constraint vectors are stored in hash-indexed least-recently-used caches (see util::eval_cache) whose capacity
+ * (cache_capacity entries by default) can be changed via set_cache_capacity(). Decision vectors are compared bitwise unless a quantization
+ * step is set via set_cache_quantum(). The number of cache hits and misses can be queried via get_cache_hits() and get_cache_misses().
  *
  * \section Serialization
  * The problem classes are serialized for the purpose of transmitting their corresponding objects over a distributed environment, as being part of the population class.
@@ -149,12 +155,13 @@ class __PAGMO_VISIBLE base
 {
 		// Meta problems need to be able to access protected virtual functions
 		friend class base_meta;
-		// Underlying containers used for caching decision and fitness vectors.
-		typedef boost::circular_buffer<decision_vector> decision_vector_cache_type;
-		typedef boost::circular_buffer<fitness_vector> fitness_vector_cache_type;
-		typedef boost::circular_buffer<constraint_vector> constraint_vector_cache_type;
+		// The MPI environment needs to reset the transient state (caches, counters) when hashing
+		// problems for the remote caches, and to report back the remote evaluations.
+		friend class pagmo::mpi_environment;
+		// The racing of populations reports back the evaluations done on its copies of the problem.
+		friend class pagmo::util::racing::race_pop;
 	public:
-		/// Capacity of the internal caches.
+		/// Default capacity of the internal caches.
 		static const std::size_t cache_capacity = 5;
 		/// Problem's size type: the same as pagmo::decision_vector's size type.
 		typedef decision_vector::size_type size_type;
@@ -187,10 +194,8 @@ class __PAGMO_VISIBLE base
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 			m_c_tol(nc,c_tol),
-			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),m_batch_threads(1),
+			m_jac_pattern_ok(false),m_jac_step(0)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -236,10 +241,8 @@ class __PAGMO_VISIBLE base
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 			m_c_tol(nc,c_tol),
-			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_fitness_cache(cache_capacity),m_constraint_cache(cache_capacity),m_batch_threads(1),
+			m_jac_pattern_ok(false),m_jac_step(0)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -414,6 +417,7 @@ class __PAGMO_VISIBLE base
 		//@}
 		constraint_vector compute_constraints(const decision_vector &) const;
 		void compute_constraints(constraint_vector &, const decision_vector &) const;
+		void batch_compute_constraints(std::vector<constraint_vector> &, const std::vector<decision_vector> &) const;
 		bool compare_constraints(const constraint_vector &, const constraint_vector &) const;
 		bool test_constraint(const constraint_vector &, const c_size_type &) const;
 		bool feasibility_x(const decision_vector &) const;
@@ -454,8 +458,36 @@ return base_ptr(new derived_problem(*this));
 		//@{
 		fitness_vector objfun(const decision_vector &) const;
 		void objfun(fitness_vector &, const decision_vector &) const;
+		void batch_objfun(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 		bool compare_fitness(const fitness_vector &, const fitness_vector &) const;
 		void reset_caches() const;
+		//@}
+		/** @name Caching.
+		 * Methods used to configure and monitor the fitness and constraint caches.
+		 */
+		//@{
+		std::size_t get_cache_capacity() const;
+		void set_cache_capacity(std::size_t);
+		double get_cache_quantum() const;
+		void set_cache_quantum(const double &);
+		unsigned int get_cache_hits() const;
+		unsigned int get_cache_misses() const;
+		//@}
+		/** @name Batch evaluation.
+		 * Methods used to configure the parallel evaluation of batches of decision vectors.
+		 */
+		//@{
+		unsigned int get_batch_threads() const;
+		void set_batch_threads(unsigned int);
+		virtual bool is_thread_safe() const;
+		//@}
+		/** @name Derivatives.
+		 * Methods used to compute the finite-difference Jacobian of the objective function and of the constraints.
+		 */
+		//@{
+		void get_jacobian_pattern(int &, std::vector<int> &, std::vector<int> &) const;
+		void compute_jacobian(std::vector<double> &, const decision_vector &, const double & = 1e-8) const;
+		//@}
 	public:
 		const std::vector<constraint_vector>& get_best_c(void) const;
 		const std::vector<decision_vector>& get_best_x(void) const;
@@ -472,8 +504,18 @@ return base_ptr(new derived_problem(*this));
 		 * @param[in] x decision vector whose fitness will be calculated.
 		 */
 		virtual void objfun_impl(fitness_vector &f, const decision_vector &x) const = 0;
+		virtual void batch_objfun_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
+		virtual void batch_compute_constraints_impl(std::vector<constraint_vector> &, const std::vector<decision_vector> &) const;
 		//@}
 	private:
+		// Pointer to one of the single-vector evaluation methods (objfun_impl() or compute_constraints_impl()).
+		typedef void (base::*eval_impl_type)(std::vector<double> &, const decision_vector &) const;
+		void batch_evaluate(std::vector<std::vector<double> > &, const std::vector<decision_vector> &, eval_impl_type) const;
+		static void batch_evaluate_chunk(const base *, std::vector<std::vector<double> > &, const std::vector<decision_vector> &,
+			eval_impl_type, std::size_t, std::size_t);
+		void update_jacobian_pattern() const;
+		void group_jacobian_columns(std::vector<std::vector<size_type> > &, const size_type &, const size_type &) const;
+		void evaluate_perturbations(std::vector<fitness_vector> &, std::vector<constraint_vector> &, const std::vector<decision_vector> &) const;
 		void normalise_bounds();
 		// Construct from iterators.
 		template <class Iterator1, class Iterator2>
@@ -500,7 +542,7 @@ return base_ptr(new derived_problem(*this));
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & const_cast<size_type &>(m_i_dimension);
 			ar & const_cast<f_size_type &>(m_f_dimension);
@@ -509,10 +551,18 @@ return base_ptr(new derived_problem(*this));
 			ar & m_lb;
 			ar & m_ub;
 			ar & const_cast<std::vector<double> &>(m_c_tol);
-			ar & m_decision_vector_cache_f;
-			ar & m_fitness_vector_cache;
-			ar & m_decision_vector_cache_c;
-			ar & m_constraint_vector_cache;
+			if (version < 1) {
+				// Archives from version 0 store the caches as circular buffers of decision vectors and of fitness/constraint
+				// vectors: their content is discarded and the caches start empty.
+				boost::circular_buffer<std::vector<double> > legacy_cache;
+				for (int i = 0; i < 4; ++i) {
+					ar & legacy_cache;
+				}
+				reset_caches();
+			} else {
+				ar & m_fitness_cache;
+				ar & m_constraint_cache;
+			}
 			ar & m_tmp_f1;
 			ar & m_tmp_f2;
 			ar & m_tmp_c1;
@@ -522,6 +572,9 @@ return base_ptr(new derived_problem(*this));
 			ar & m_best_c;
 			ar & m_fevals;
 			ar & m_cevals;
+			if (version >= 1) {
+				ar & m_batch_threads;
+			}
 		}
 
 		// Data members.
@@ -539,14 +592,10 @@ return base_ptr(new derived_problem(*this));
 		decision_vector				m_ub;
 		// Tolerance for constraints analysis.
 		const std::vector<double>   m_c_tol;
-		// Decision vector cache for fitness.
-		mutable decision_vector_cache_type	m_decision_vector_cache_f;
 		// Fitness vector cache.
-		mutable fitness_vector_cache_type	m_fitness_vector_cache;
-		// Decision vector cache for constraints.
-		mutable decision_vector_cache_type	m_decision_vector_cache_c;
+		mutable util::eval_cache		m_fitness_cache;
 		// Constraint vector cache.
-		mutable constraint_vector_cache_type	m_constraint_vector_cache;
+		mutable util::eval_cache		m_constraint_cache;
 		// Temporary storage used during decision_vector comparisons.
 		mutable fitness_vector			m_tmp_f1;
 		mutable fitness_vector			m_tmp_f2;
@@ -562,6 +611,33 @@ return base_ptr(new derived_problem(*this));
 		// Number of function and constraints evaluations
 		mutable unsigned int                    m_fevals;
 		mutable unsigned int                    m_cevals;
+		// Number of threads used by the default batch evaluation methods.
+		unsigned int				m_batch_threads;
+		// Copies of the problem used by the additional batch evaluation threads. A copy of the problem starts
+		// without them, so that two problems never share the same copies. Not archived.
+		struct batch_clones_type
+		{
+			batch_clones_type():m_clones() {}
+			batch_clones_type(const batch_clones_type &):m_clones() {}
+			batch_clones_type &operator=(const batch_clones_type &)
+			{
+				m_clones.clear();
+				return *this;
+			}
+			std::vector<base_ptr>	m_clones;
+		};
+		mutable batch_clones_type		m_batch_clones;
+		// Jacobian pattern (same convention as set_sparsity()) and groups of columns sharing no objective (resp. constraint) row,
+		// computed on first use. Not archived: they are rebuilt on demand.
+		mutable std::vector<int>		m_jac_rows;
+		mutable std::vector<int>		m_jac_cols;
+		mutable std::vector<std::vector<size_type> >	m_jac_f_groups;
+		mutable std::vector<std::vector<size_type> >	m_jac_c_groups;
+		mutable bool				m_jac_pattern_ok;
+		// Last Jacobian computed, with the point and the relative step it was computed with.
+		mutable decision_vector			m_jac_x;
+		mutable double				m_jac_step;
+		mutable std::vector<double>		m_jac_values;
 };
 
 std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
@@ -570,5 +646,7 @@ std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
 }
 
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(pagmo::problem::base)
+// Version 1: hash-indexed evaluation caches and number of batch evaluation threads.
+BOOST_CLASS_VERSION(pagmo::problem::base,1)
 
 #endif
@@ -22,8 +22,14 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+
 #include "base_stochastic.h"
 #include "../serialization.h"
+#include "../thread_pool.h"
 
 namespace pagmo { namespace problem {
 
@@ -90,6 +96,45 @@ unsigned int base_stochastic::get_seed() const {
 	return m_seed;
 }
 
+/// Runs trials in parallel
+/**
+ * Splits the trials [0,n_trials) in contiguous blocks, one per thread, and calls job(problem, begin, end) on each
+ * block. The first block is run in the calling thread on the original problem, the others on the shared thread pool
+ * (see thread_pool::shared()), each on its own copy of the original problem (stored in copies, which is grown on demand
+ * so that the copies can be reused by the subsequent calls). Meant for the derived classes averaging expensive trials.
+ * If the original problem is not thread-safe (see problem::base::is_thread_safe()), all the trials are run serially in the
+ * calling thread.
+ *
+ * @param[in] original problem used by the calling thread.
+ * @param[in,out] copies copies of the original problem used by the other threads.
+ * @param[in] n_threads number of threads (0 for the number of hardware threads).
+ * @param[in] n_trials number of trials.
+ * @param[in] job callable object evaluating a block of trials.
+ *
+ * @see thread_pool::run_all()
+ */
+void base_stochastic::run_trials(const base &original, std::vector<base_ptr> &copies, unsigned int n_threads, unsigned int n_trials,
+	const boost::function<void (const base &, unsigned int, unsigned int)> &job)
+{
+	if (n_threads == 0) {
+		n_threads = std::max(1u, boost::thread::hardware_concurrency());
+	}
+	n_threads = std::min(n_threads, n_trials);
+	if (n_threads <= 1 || !original.is_thread_safe()) {
+		job(original, 0, n_trials);
+		return;
+	}
+	while (copies.size() < n_threads - 1) {
+		copies.push_back(original.clone());
+	}
+	std::vector<boost::function<void ()> > tasks;
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		const base &prob = (t == 0 ? original : *copies[t - 1]);
+		tasks.push_back(boost::bind(job, boost::cref(prob), (t * n_trials) / n_threads, ((t + 1) * n_trials) / n_threads));
+	}
+	thread_pool::shared().run_all(tasks);
+}
+
 }} //namespaces
 
 //BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::base_stochastic);
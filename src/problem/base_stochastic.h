@@ -25,6 +25,9 @@
 #ifndef PAGMO_PROBLEM_BASE_STOCHASTIC_H
 #define PAGMO_PROBLEM_BASE_STOCHASTIC_H
 
+#include <boost/function.hpp>
+#include <vector>
+
 #include "base.h"
 #include "../serialization.h"
 #include "../rng.h"
@@ -62,6 +65,9 @@ class __PAGMO_VISIBLE base_stochastic : public base
 
 		unsigned int get_seed() const;
 		void set_seed(unsigned int) const; //This is marked const as m_seed is mutable (needs to be)
+	protected:
+		static void run_trials(const base &, std::vector<base_ptr> &, unsigned int, unsigned int,
+			const boost::function<void (const base &, unsigned int, unsigned int)> &);
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -195,4 +195,60 @@ namespace pagmo { namespace problem {
         return m_n_cities; 
     }
 
+    /// Length of a closed tour
+    /**
+     * Sums base_tsp::distance along the tour, including the edge from the last city back to the first one.
+     *
+     * @param[in] tour a chromosome in the CITIES encoding
+     * @return the length of the closed tour
+     */
+    double base_tsp::tour_length(const decision_vector &tour) const
+    {
+        pagmo_assert(tour.size() == m_n_cities && m_n_cities > 0);
+        double retval = 0;
+        for (decision_vector::size_type i = 0; i < m_n_cities - 1; ++i) {
+            retval += distance(tour[i], tour[i+1]);
+        }
+        return retval + distance(tour[m_n_cities-1], tour[0]);
+    }
+
+    /// Change in tour length caused by an inversion
+    /**
+     * Computes the difference between the length of the closed tour obtained reversing the cities
+     * in the positions [i,j] of tour and the length of tour, without building the new tour.
+     * The edges entering and leaving the segment are replaced, hence the cost is constant for symmetric
+     * distances. The default implementation makes no assumption on symmetry and also accounts for the
+     * reversed direction of the edges inside the segment, at a cost linear in its size.
+     * Derived classes knowing their distances to be symmetric may reimplement this method.
+     *
+     * @param[in] tour a chromosome in the CITIES encoding
+     * @param[in] i position of the first city of the segment to be reversed
+     * @param[in] j position of the last city of the segment to be reversed, j - i + 1 must be smaller than the number of cities
+     * @return the length of the inverted tour minus the length of tour
+     */
+    double base_tsp::inversion_delta(const decision_vector &tour, decision_vector::size_type i, decision_vector::size_type j) const
+    {
+        pagmo_assert(tour.size() == m_n_cities && i <= j && j < m_n_cities && j - i + 1 < m_n_cities);
+        const double prev = tour[i == 0 ? m_n_cities - 1 : i - 1];
+        const double next = tour[j == m_n_cities - 1 ? 0 : j + 1];
+        double retval = distance(prev, tour[j]) + distance(tour[i], next) - distance(prev, tour[i]) - distance(tour[j], next);
+        for (decision_vector::size_type k = i; k < j; ++k) {
+            retval += distance(tour[k+1], tour[k]) - distance(tour[k], tour[k+1]);
+        }
+        return retval;
+    }
+
+    /// Tells whether the objective function is the length of the closed tour
+    /**
+     * When true, base_tsp::tour_length and base_tsp::inversion_delta are consistent with the objective function
+     * and algorithms can use them to evaluate moves incrementally. The default implementation returns false,
+     * since TSP variants may add costs or constraints that distances alone do not capture.
+     *
+     * @return false
+     */
+    bool base_tsp::is_tour_length_objective() const
+    {
+        return false;
+    }
+
 }} //namespaces
@@ -58,6 +58,11 @@ namespace pagmo { namespace problem {
  * http://en.wikipedia.org/wiki/Travelling_salesman_problem#Integer_linear_programming_formulation
  * It is used to create TSP problems that are integer linear programming problems. (e.g. [0,1,0,1,0,0,0,0,1,0,1,0] -> [0,2,3,1])
  *
+ * Local search algorithms (e.g. pagmo::algorithm::inverover) can evaluate moves incrementally through
+ * base_tsp::inversion_delta, which only looks at the edges a move changes. Problems whose objective is
+ * the length of the closed tour should reimplement base_tsp::is_tour_length_objective to return true, so that
+ * such algorithms know the delta is a valid fitness difference.
+ *
  * @author Dario Izzo (dario.izzo@gmail.com)
  */
 
@@ -90,6 +95,13 @@ class __PAGMO_VISIBLE base_tsp: public base
         // Pure virtual method returning the distance between cities
         virtual double distance(decision_vector::size_type, decision_vector::size_type) const = 0;
 
+        /** @name Incremental evaluation of tours.*/
+        //@{
+        double tour_length(const decision_vector &) const;
+        virtual double inversion_delta(const decision_vector &, decision_vector::size_type, decision_vector::size_type) const;
+        virtual bool is_tour_length_objective() const;
+        //@}
+
     private:
         friend class boost::serialization::access;
         template <class Archive>
@@ -38,7 +38,7 @@ namespace pagmo { namespace problem {
  * 
  * @see problem::base constructors.
  */
-cassini_1::cassini_1(unsigned int objectives):base(6,0,objectives),Delta_V(6),rp(4),t(6)
+cassini_1::cassini_1(unsigned int objectives):base(6,0,objectives)
 {
 	if (objectives != 1 && objectives !=2) {
 		pagmo_throw(value_error,"Cassini_1 problem has either one or two objectives");
@@ -71,6 +71,7 @@ base_ptr cassini_1::clone() const
 /// Implementation of the objective function.
 void cassini_1::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
+	double rp[4], Delta_V[6];
 	MGA(x,problem,rp,Delta_V,f[0]);
 	if (get_f_dimension() == 2) {
 		f[1] = (x[2]+x[3]+x[4]+x[5]); // + std::max(0.0,f[0] - 20) * 365.25;
@@ -82,6 +83,17 @@ std::string cassini_1::get_name() const
 	return "Cassini 1";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated by MGA() on the stack.
+ *
+ * @return true.
+ */
+bool cassini_1::is_thread_safe() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::cassini_1)
@@ -53,7 +53,7 @@ base_ptr cassini_2::clone() const
 /// Implementation of the objective function.
 void cassini_2::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	MGA_DSM(x, problem,f[0]);
+	MGA_DSM(&x[0], problem, f[0], 0, 0);
 }
 
 /// Outputs a stream with the trajectory data
@@ -132,6 +132,17 @@ std::string cassini_2::get_name() const
 	return "Cassini 2";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated by MGA_DSM() with stack buffers only.
+ *
+ * \return true.
+ */
+bool cassini_2::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::cassini_2)
@@ -53,6 +53,7 @@ class __PAGMO_VISIBLE cassini_2: public base
 		base_ptr clone() const;
 		std::string pretty(const std::vector<double> &x) const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
@@ -33,7 +33,7 @@ namespace pagmo { namespace problem {
 /**
  * @see problem::base constructors.
  */
-gtoc_1::gtoc_1():base(8),Delta_V(8),rp(6),t(8)
+gtoc_1::gtoc_1():base(8)
 {
 	// Set bounds.
 	const double lb[8] = {3000,14,14,14,14,100,366,300};
@@ -72,6 +72,7 @@ base_ptr gtoc_1::clone() const
 /// Implementation of the objective function.
 void gtoc_1::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
+	double rp[6], Delta_V[8];
 	MGA(x,problem,rp,Delta_V,f[0]);
 }
 
@@ -80,6 +81,17 @@ std::string gtoc_1::get_name() const
 	return "GTOC_1";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated by MGA() on the stack.
+ *
+ * @return true.
+ */
+bool gtoc_1::is_thread_safe() const
+{
+	return true;
+}
+
 
 
 }}
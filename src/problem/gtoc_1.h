@@ -55,29 +55,33 @@ class __PAGMO_VISIBLE gtoc_1: public base
 		gtoc_1();
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & problem;
-			ar & Delta_V;
-			ar & rp;
-			ar & t;
+			// Version 0 archives also stored the buffers of the last MGA call: skip them.
+			if (version < 1) {
+				std::vector<double> Delta_V, rp, t;
+				ar & Delta_V;
+				ar & rp;
+				ar & t;
+			}
 		}
 		mgaproblem problem;
-		//Variables used in the call to MGA
-		mutable std::vector<double> Delta_V;
-		mutable std::vector<double> rp;
-		mutable std::vector<double> t;
 };
 
 }}
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::gtoc_1)
 
+// Version 1: the buffers of the last MGA call are no longer archived.
+BOOST_CLASS_VERSION(pagmo::problem::gtoc_1,1)
+
 #endif // PAGMO_PROBLEM_GTOC_1_H
@@ -107,7 +107,7 @@ base_ptr laplace::clone() const
 void laplace::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	f[0] = 0;
-	MGA_DSM(x, problem, f[0]);
+	MGA_DSM(&x[0], problem, f[0], 0, 0);
 	const size_t sequence_size = (x.size() + 2) / 4;
 	double totaltime = 0;
 	for (size_t i = 0; i < sequence_size - 1 ; ++i) {
@@ -189,6 +189,17 @@ std::string laplace::get_name() const
 	return "Laplace";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * MGA_DSM() is called without output buffers, hence the problem data is only read.
+ *
+ * \return true.
+ */
+bool laplace::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::laplace)
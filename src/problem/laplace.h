@@ -70,6 +70,7 @@ class __PAGMO_VISIBLE laplace: public base
 		laplace(const std::vector<int> & = std::vector<int>(get_default_sequence(),get_default_sequence() + 5));
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 		std::string pretty(const std::vector<double> &x) const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
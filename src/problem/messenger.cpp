@@ -52,7 +52,7 @@ base_ptr messenger::clone() const
 /// Implementation of the objective function.
 void messenger::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	MGA_DSM(x, problem,f[0]);
+	MGA_DSM(&x[0], problem, f[0], 0, 0);
 }
 
 /// Implementation of the sparsity structure.
@@ -77,6 +77,17 @@ std::string messenger::get_name() const
 	return "Messenger";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The objective function only reads the problem data.
+ *
+ * @return true.
+ */
+bool messenger::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::messenger)
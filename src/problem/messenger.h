@@ -56,6 +56,7 @@ class __PAGMO_VISIBLE messenger: public base
 		messenger();
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
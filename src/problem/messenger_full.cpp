@@ -56,7 +56,7 @@ base_ptr messenger_full::clone() const
 /// Implementation of the objective function.
 void messenger_full::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	MGA_DSM(x, problem,f[0]);
+	MGA_DSM(&x[0], problem, f[0], 0, 0);
 }
 
 /// Outputs a stream with the trajectory data
@@ -133,6 +133,17 @@ std::string messenger_full::get_name() const
 	return "Messenger full";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * Evaluations keep all intermediate results on the stack.
+ *
+ * \return true.
+ */
+bool messenger_full::is_thread_safe() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::messenger_full)
@@ -119,85 +119,77 @@ void mga_1dsm_alpha::objfun_impl(fitness_vector &f, const decision_vector &x) co
 {
 try {
 	double common_mu = m_seq[0]->get_mu_central_body();
-	// 1 - we 'decode' the chromosome recording the various times of flight (days) in the list T
-	std::vector<double> T(m_n_legs,0.0);
+	// 1 - we 'decode' the chromosome: the time of flight (days) of the leg i is x[1] * -log(x[6+4*i]) / alpha_sum
 	double alpha_sum = 0;
-	
-	for (size_t i = 0; i < m_n_legs; ++i) {
-		double tmp = -log(x[6+4*i]);
-		alpha_sum+= tmp;
-		T[i] = x[1] * tmp;
-	}
 	for (size_t i = 0; i < m_n_legs; ++i) {
-		T[i] /= alpha_sum;
+		alpha_sum += -log(x[6+4*i]);
 	}
 
-	// 2 - We compute the epochs and ephemerides of the planetary encounters
-	std::vector<kep_toolbox::epoch>   t_P(m_n_legs + 1);
-	std::vector<kep_toolbox::array3D> r_P(m_n_legs + 1);
-	std::vector<kep_toolbox::array3D> v_P(m_n_legs + 1);
-	std::vector<double> DV(m_n_legs + 1);
-	for (size_t i = 0; i<(m_n_legs + 1); ++i) {
-		t_P[i] = kep_toolbox::epoch(x[0] + std::accumulate(T.begin(), T.begin()+i, 0.0));
-		m_seq[i]->get_eph(t_P[i], r_P[i], v_P[i]);
-	}
+	// The legs are evaluated in sequence: only the planets at the two ends of the current leg are kept, and the times of
+	// flight and DSMs are summed as they are computed (in the same order std::accumulate would use).
+	kep_toolbox::array3D r_P, v_P, r_P_next, v_P_next;
+	double T_sum = 0.0, DV_sum = 0.0;
+	m_seq[0]->get_eph(x[0], r_P, v_P);
 
-	// 3 - We start with the first leg
+	// 2 - We start with the first leg
 	double theta = 2*boost::math::constants::pi<double>()*x[2];
 	double phi = acos(2*x[3]-1)-boost::math::constants::pi<double>() / 2;
 
 	kep_toolbox::array3D Vinf = { {x[4]*cos(phi)*cos(theta), x[4]*cos(phi)*sin(theta), x[4]*sin(phi)} };
 	kep_toolbox::array3D v0;
-	kep_toolbox::sum(v0, v_P[0], Vinf);
-	kep_toolbox::array3D r(r_P[0]), v(v0);
-	kep_toolbox::propagate_lagrangian(r,v,x[5]*T[0]*ASTRO_DAY2SEC,common_mu);
+	kep_toolbox::sum(v0, v_P, Vinf);
+	kep_toolbox::array3D r(r_P), v(v0);
+	double T = x[1] * -log(x[6]) / alpha_sum;
+	kep_toolbox::propagate_lagrangian(r,v,x[5]*T*ASTRO_DAY2SEC,common_mu);
 
 	// Lambert arc to reach seq[1]
-	double dt = (1-x[5])*T[0]*ASTRO_DAY2SEC;
-	kep_toolbox::lambert_problem l(r,r_P[1],dt,common_mu);
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
+	T_sum += T;
+	m_seq[1]->get_eph(x[0] + T_sum, r_P_next, v_P_next);
+	double dt = (1-x[5])*T*ASTRO_DAY2SEC;
+	kep_toolbox::array3D v_end_l, v_beg_l;
+	kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P_next,dt,common_mu);
 
 	// First DSM occuring at time nu1*T1
 	kep_toolbox::diff(v, v_beg_l, v);
-	DV[0] = kep_toolbox::norm(v);
+	DV_sum += kep_toolbox::norm(v);
 
-	// 4 - And we proceed with each successive leg (if any)
+	// 3 - And we proceed with each successive leg (if any)
 	kep_toolbox::array3D v_out;
 	for (size_t i = 1; i<m_n_legs; ++i) {
+		r_P = r_P_next;
+		v_P = v_P_next;
 		// Fly-by
-		kep_toolbox::fb_prop(v_out, v_end_l, v_P[i], x[8+(i-1)*4] * m_seq[i]->get_radius(), x[7+(i-1)*4], m_seq[i]->get_mu_self());
+		kep_toolbox::fb_prop(v_out, v_end_l, v_P, x[8+(i-1)*4] * m_seq[i]->get_radius(), x[7+(i-1)*4], m_seq[i]->get_mu_self());
 		// s/c propagation before the DSM
-		r = r_P[i];
+		r = r_P;
 		v = v_out;
-		kep_toolbox::propagate_lagrangian(r,v,x[9+(i-1)*4]*T[i]*ASTRO_DAY2SEC,common_mu);
+		T = x[1] * -log(x[6+4*i]) / alpha_sum;
+		kep_toolbox::propagate_lagrangian(r,v,x[9+(i-1)*4]*T*ASTRO_DAY2SEC,common_mu);
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
-		dt = (1-x[9+(i-1)*4])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu);
-	  	v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		T_sum += T;
+		m_seq[i+1]->get_eph(x[0] + T_sum, r_P_next, v_P_next);
+		dt = (1-x[9+(i-1)*4])*T*ASTRO_DAY2SEC;
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P_next,dt,common_mu);
 
 		// DSM occuring at time nu2*T2
 		kep_toolbox::diff(v, v_beg_l, v);
-		DV[i] = kep_toolbox::norm(v);
+		DV_sum += kep_toolbox::norm(v);
 	}
 	
 	// Last Delta-v
-	kep_toolbox::diff(v, v_end_l, v_P[m_n_legs]);
-	DV[m_n_legs] = kep_toolbox::norm(v);
-	
+	kep_toolbox::diff(v, v_end_l, v_P_next);
 	
 	// Now we return the objective(s) function
-	f[0] = std::accumulate(DV.begin(),DV.end()-1,0.0); 
+	f[0] = DV_sum;
 	if (m_add_vinf_dep) {
 		f[0] += x[4];
 	}
 	if (m_add_vinf_arr) {
-		f[0] += DV[DV.size()-1];
+		f[0] += kep_toolbox::norm(v);
 	}
 	if (get_f_dimension() == 2){
-		f[1] = std::accumulate(T.begin(),T.end(),0.0);
+		f[1] = T_sum;
 	} 
 //Here the lambert solver or the lagrangian propagator went wrong
 } catch (...) {
@@ -268,9 +260,8 @@ std::string mga_1dsm_alpha::pretty(const std::vector<double> &x) const {
 
 	// Lambert arc to reach seq[1]
 	double dt = (1-x[5])*T[0]*ASTRO_DAY2SEC;
-	kep_toolbox::lambert_problem l(r,r_P[1],dt,common_mu);
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
+	kep_toolbox::array3D v_end_l, v_beg_l;
+	kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[1],dt,common_mu);
 
 	// First DSM occuring at time nu1*T1
 	kep_toolbox::diff(v, v_beg_l, v);
@@ -294,9 +285,7 @@ std::string mga_1dsm_alpha::pretty(const std::vector<double> &x) const {
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		dt = (1-x[9+(i-1)*4])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu);
-	  	v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[i+1],dt,common_mu);
 
 		// DSM occuring at time nu2*T2
 		kep_toolbox::diff(v, v_beg_l, v);
@@ -318,6 +307,22 @@ std::string mga_1dsm_alpha::get_name() const
 	return "MGA-1DSM (alpha-encoding)";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated on the stack and the planets are only read.
+ *
+ * @return true if all the planets of the sequence are thread-safe (see kep_toolbox::planet::is_thread_safe()).
+ */
+bool mga_1dsm_alpha::is_thread_safe() const
+{
+	for (std::vector<kep_toolbox::planet_ptr>::size_type i = 0; i < m_seq.size(); ++i) {
+		if (!m_seq[i]->is_thread_safe()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /// Sets the mission time of flight
 /**
  * This setter changes the problem bounds as to define a minimum and a maximum allowed total time of flight
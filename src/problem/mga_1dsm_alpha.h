@@ -75,6 +75,7 @@ class __PAGMO_VISIBLE mga_1dsm_alpha: public base
 		base_ptr clone() const;
 		
 		std::string get_name() const;
+		bool is_thread_safe() const;
 		std::string pretty(const std::vector<double> &x) const;
 		void set_tof(const double, const double);
 		void set_launch_window(const kep_toolbox::epoch&, const kep_toolbox::epoch&);
@@ -119,84 +119,66 @@ base_ptr mga_1dsm_tof::clone() const
 	return base_ptr(new mga_1dsm_tof(*this));
 }
 
+// Propagates the spacecraft along the leg-th leg up to its DSM. On entry (r_P,v_P) is the planet at the start of the leg (ignored
+// for the first leg, whose departure planet is computed here), v_end_l the arrival velocity of the previous Lambert arc and T the
+// time of flight accumulated so far. On exit (r,v) is the spacecraft state just before the DSM, (r_P,v_P) the planet at the end of
+// the leg and T includes the leg. Returns the time of flight of the Lambert arc from the DSM to the planet (in seconds).
+// Shared by objfun_impl() and batch_objfun_impl(), so that both compute the same fitnesses.
+double mga_1dsm_tof::propagate_leg(kep_toolbox::array3D &r, kep_toolbox::array3D &v, kep_toolbox::array3D &r_P, kep_toolbox::array3D &v_P,
+	double &T, const kep_toolbox::array3D &v_end_l, const decision_vector &x, size_t leg) const
+{
+	const double common_mu = m_seq[0]->get_mu_central_body();
+	if (leg == 0) {
+		// Launch
+		m_seq[0]->get_eph(x[0], r_P, v_P);
+		double theta = 2*boost::math::constants::pi<double>()*x[1];
+		double phi = acos(2*x[2]-1)-boost::math::constants::pi<double>() / 2;
+		kep_toolbox::array3D Vinf = { {x[3]*cos(phi)*cos(theta), x[3]*cos(phi)*sin(theta), x[3]*sin(phi)} };
+		kep_toolbox::sum(v, v_P, Vinf);
+	} else {
+		// Fly-by
+		kep_toolbox::fb_prop(v, v_end_l, v_P, x[3+4*leg] * m_seq[leg]->get_radius(), x[2+4*leg], m_seq[leg]->get_mu_self());
+	}
+	// s/c propagation before the DSM
+	r = r_P;
+	kep_toolbox::propagate_lagrangian(r,v,x[4+4*leg]*x[5+4*leg]*ASTRO_DAY2SEC,common_mu);
+	// Planet at the end of the leg
+	T += x[5+4*leg];
+	m_seq[leg+1]->get_eph(x[0] + T, r_P, v_P);
+	return (1-x[4+4*leg])*x[5+4*leg]*ASTRO_DAY2SEC;
+}
+
 /// Implementation of the objective function.
 void mga_1dsm_tof::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 try {
 	double common_mu = m_seq[0]->get_mu_central_body();
-	// 1 -  we 'decode' the chromosome recording the various times of flight (days) in the list T
-	std::vector<double> T(m_n_legs,0.0);
-	
-	for (size_t i = 0; i < m_n_legs; ++i) {
-		T[i] = x[5 + i*4];
-	}
-
-	// 2 - We compute the epochs and ephemerides of the planetary encounters
-	std::vector<kep_toolbox::epoch>   t_P(m_n_legs + 1);
-	std::vector<kep_toolbox::array3D> r_P(m_n_legs + 1);
-	std::vector<kep_toolbox::array3D> v_P(m_n_legs + 1);
-	std::vector<double> DV(m_n_legs + 1);
-	for (size_t i = 0; i<(m_n_legs + 1); ++i) {
-		t_P[i] = kep_toolbox::epoch(x[0] + std::accumulate(T.begin(), T.begin()+i, 0.0));
-		m_seq[i]->get_eph(t_P[i], r_P[i], v_P[i]);
-	}
-
-	// 3 - We start with the first leg
-	double theta = 2*boost::math::constants::pi<double>()*x[1];
-	double phi = acos(2*x[2]-1)-boost::math::constants::pi<double>() / 2;
-
-	kep_toolbox::array3D Vinf = { {x[3]*cos(phi)*cos(theta), x[3]*cos(phi)*sin(theta), x[3]*sin(phi)} };
-	kep_toolbox::array3D v0;
-	kep_toolbox::sum(v0, v_P[0], Vinf);
-	kep_toolbox::array3D r(r_P[0]), v(v0);
-	kep_toolbox::propagate_lagrangian(r,v,x[4]*T[0]*ASTRO_DAY2SEC,common_mu);
-
-	// Lambert arc to reach seq[1]
-	double dt = (1-x[4])*T[0]*ASTRO_DAY2SEC;
-	kep_toolbox::lambert_problem l(r,r_P[1],dt,common_mu);
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-
-	// First DSM occuring at time nu1*T1
-	kep_toolbox::diff(v, v_beg_l, v);
-	DV[0] = kep_toolbox::norm(v);
-
-	// 4 - And we proceed with each successive leg (if any)
-	kep_toolbox::array3D v_out;
-	for (size_t i = 1; i<m_n_legs; ++i) {
-		// Fly-by
-		kep_toolbox::fb_prop(v_out, v_end_l, v_P[i], x[7+(i-1)*4] * m_seq[i]->get_radius(), x[6+(i-1)*4], m_seq[i]->get_mu_self());
-		// s/c propagation before the DSM
-		r = r_P[i];
-		v = v_out;
-		kep_toolbox::propagate_lagrangian(r,v,x[8+(i-1)*4]*T[i]*ASTRO_DAY2SEC,common_mu);
-
-		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
-		dt = (1-x[8+(i-1)*4])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu);
-	  	v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
-
-		// DSM occuring at time nu2*T2
+	// The legs are evaluated in sequence: only the planets at the two ends of the current leg are kept, and the times of
+	// flight and DSMs are summed as they are computed (in the same order std::accumulate would use).
+	kep_toolbox::array3D r_P, v_P, r, v, v_beg_l, v_end_l;
+	double T_sum = 0.0, DV_sum = 0.0;
+	for (size_t leg = 0; leg < m_n_legs; ++leg) {
+		const double dt = propagate_leg(r, v, r_P, v_P, T_sum, v_end_l, x, leg);
+		// Lambert arc to reach the next planet
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P,dt,common_mu);
+		// DSM
 		kep_toolbox::diff(v, v_beg_l, v);
-		DV[i] = kep_toolbox::norm(v);
+		DV_sum += kep_toolbox::norm(v);
 	}
 	
 	// Last Delta-v
-	kep_toolbox::diff(v, v_end_l, v_P[m_n_legs]);
-	DV[m_n_legs] = kep_toolbox::norm(v);
-	
+	kep_toolbox::diff(v, v_end_l, v_P);
 	
 	// Now we return the objective(s) function
-	f[0] = std::accumulate(DV.begin(),DV.end()-1,0.0); 
+	f[0] = DV_sum;
 	if (m_add_vinf_dep) {
 		f[0] += x[3];
 	}
 	if (m_add_vinf_arr) {
-		f[0] += DV[DV.size()-1];
+		f[0] += kep_toolbox::norm(v);
 	}
 	if (get_f_dimension() == 2){
-		f[1] = std::accumulate(T.begin(),T.end(),0.0);
+		f[1] = T_sum;
 	} 
 //Here the lambert solver or the lagrangian propagator went wrong
 } catch (...) {
@@ -207,6 +189,95 @@ try {
 } 
 }
 
+/// Implementation of the batch objective function.
+/**
+ * Evaluates the trajectories leg by leg, so that the Lambert arcs of the same leg of all the trajectories are solved together
+ * by kep_toolbox::lambert_solve_batch(). Each leg is computed by the same code as in objfun_impl(), hence the fitnesses are
+ * identical to those it returns. When more than one
+ * batch thread was requested (see base::set_batch_threads()), the default parallel implementation is used instead.
+ *
+ * @param[out] f fitness vectors into which the fitnesses of x will be written.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ */
+void mga_1dsm_tof::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_batch_threads() != 1 || x.size() < 2) {
+		base::batch_objfun_impl(f,x);
+		return;
+	}
+	const double common_mu = m_seq[0]->get_mu_central_body();
+	const std::vector<decision_vector>::size_type n = x.size();
+	// State of each trajectory: the planet last reached (r_P, v_P), the spacecraft position and velocity at the DSM (r, v),
+	// the velocity at the end of the last Lambert arc, the DV and time of flight accumulated so far.
+	std::vector<kep_toolbox::array3D> r_P(n), v_P(n), r(n), v(n), v_end_l(n);
+	std::vector<double> DV(n,0.0), T_tot(n,0.0);
+	std::vector<char> ok(n,1);
+	// Indices of the trajectories still being evaluated and their Lambert problems.
+	std::vector<std::vector<decision_vector>::size_type> active;
+	kep_toolbox::lambert_batch lb;
+	kep_toolbox::array3D v_beg_l;
+	for (size_t leg = 0; leg < m_n_legs; ++leg) {
+		active.clear();
+		lb.resize(n);
+		for (std::vector<decision_vector>::size_type i = 0; i < n; ++i) {
+			if (!ok[i]) {
+				continue;
+			}
+			try {
+				const double dt = propagate_leg(r[i], v[i], r_P[i], v_P[i], T_tot[i], v_end_l[i], x[i], leg);
+				const std::vector<decision_vector>::size_type k = active.size();
+				for (int j = 0; j < 3; ++j) {
+					lb.r1[j][k] = r[i][j];
+					lb.r2[j][k] = r_P[i][j];
+				}
+				lb.tof[k] = dt;
+				active.push_back(i);
+			} catch (...) {
+				ok[i] = 0;
+			}
+		}
+		// Lambert arcs to reach the next planet
+		lb.resize(active.size());
+		kep_toolbox::lambert_solve_batch(lb,common_mu);
+		// DSM
+		for (std::vector<decision_vector>::size_type k = 0; k < active.size(); ++k) {
+			const std::vector<decision_vector>::size_type i = active[k];
+			if (!lb.ok[k]) {
+				ok[i] = 0;
+				continue;
+			}
+			for (int j = 0; j < 3; ++j) {
+				v_beg_l[j] = lb.v1[j][k];
+				v_end_l[i][j] = lb.v2[j][k];
+			}
+			kep_toolbox::diff(v[i], v_beg_l, v[i]);
+			DV[i] += kep_toolbox::norm(v[i]);
+		}
+	}
+
+	for (std::vector<decision_vector>::size_type i = 0; i < n; ++i) {
+		if (!ok[i]) {
+			f[i][0] = boost::numeric::bounds<double>::highest();
+			if (get_f_dimension() == 2){
+				f[i][1] = boost::numeric::bounds<double>::highest();
+			}
+			continue;
+		}
+		f[i][0] = DV[i];
+		if (m_add_vinf_dep) {
+			f[i][0] += x[i][3];
+		}
+		if (m_add_vinf_arr) {
+			// Last Delta-v
+			kep_toolbox::diff(v[i], v_end_l[i], v_P[i]);
+			f[i][0] += kep_toolbox::norm(v[i]);
+		}
+		if (get_f_dimension() == 2){
+			f[i][1] = T_tot[i];
+		}
+	}
+}
+
 /// Outputs a stream with the trajectory data
 /**
  * While the chromosome contains all necessary information to describe a trajectory, mission analysis
@@ -262,9 +333,8 @@ std::string mga_1dsm_tof::pretty(const std::vector<double> &x, bool extended_out
 
 	// Lambert arc to reach seq[1]
 	double dt = (1-x[4])*T[0]*ASTRO_DAY2SEC;
-	kep_toolbox::lambert_problem l(r,r_P[1],dt,common_mu);
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
+	kep_toolbox::array3D v_end_l, v_beg_l;
+	kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[1],dt,common_mu);
 
 	if(extended_output) s << "r_arr: " << r_P[1] << "\nv_arr: " << v_end_l << std::endl;
 	kep_toolbox::diff(v_misc, v_end_l,v_P[1]);
@@ -298,9 +368,7 @@ std::string mga_1dsm_tof::pretty(const std::vector<double> &x, bool extended_out
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		dt = (1-x[8+(i-1)*4])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu);
-	  	v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[i+1],dt,common_mu);
 
 		// DSM occuring at time nu2*T2
 		kep_toolbox::diff(v, v_beg_l, v);
@@ -328,6 +396,22 @@ std::string mga_1dsm_tof::get_name() const
 	return "MGA-1DSM (tof-encoding)";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The objective function (and its leg by leg batch version) keeps all its state on the stack and only reads the planets.
+ *
+ * @return true if all the planets of the sequence are thread-safe (see kep_toolbox::planet::is_thread_safe()).
+ */
+bool mga_1dsm_tof::is_thread_safe() const
+{
+	for (std::vector<kep_toolbox::planet_ptr>::size_type i = 0; i < m_seq.size(); ++i) {
+		if (!m_seq[i]->is_thread_safe()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /// Sets the mission time of flight
 /**
  * This setter changes the problem bounds as to define a minimum and a maximum allowed total time of flight
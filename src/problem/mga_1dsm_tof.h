@@ -72,6 +72,7 @@ class __PAGMO_VISIBLE mga_1dsm_tof: public base
 		base_ptr clone() const;
 		
 		std::string get_name() const;
+		bool is_thread_safe() const;
 		std::string pretty(const std::vector<double> &x, bool extended_output = false) const;
 		void set_tof(const std::vector<boost::array<double,2> >);
 		void set_launch_window(const kep_toolbox::epoch&, const kep_toolbox::epoch&);
@@ -80,9 +81,12 @@ class __PAGMO_VISIBLE mga_1dsm_tof: public base
 		std::vector<std::vector<double> > get_tof() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void batch_objfun_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 		std::string human_readable_extra() const;
 		
 	private:
+		double propagate_leg(kep_toolbox::array3D &, kep_toolbox::array3D &, kep_toolbox::array3D &, kep_toolbox::array3D &, double &,
+			const kep_toolbox::array3D &, const decision_vector &, size_t) const;
 		static const std::vector<kep_toolbox::planet_ptr> construct_default_sequence() {
 			std::vector<kep_toolbox::planet_ptr> retval;
 			retval.push_back(kep_toolbox::planet_ss("earth").clone());
@@ -119,51 +119,42 @@ void mga_incipit::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 try {
 	double common_mu = m_seq[0]->get_mu_central_body();
-	// 1 -  we 'decode' the chromosome recording the various times of flight (days) in the list T
-	std::vector<double> T(m_seq.size(),0.0);
-	
-	for (size_t i = 0; i<m_seq.size(); ++i) {
-		T[i] = x[4*i+3];
-	}
-	// 2 - We compute the epochs and ephemerides of the planetary encounters
-	std::vector<kep_toolbox::epoch>   t_P(m_seq.size());
-	std::vector<kep_toolbox::array3D> r_P(m_seq.size());
-	std::vector<kep_toolbox::array3D> v_P(m_seq.size());
-	std::vector<double> DV(m_seq.size());
-	for (size_t i = 0; i<r_P.size(); ++i) {
-		t_P[i] = kep_toolbox::epoch(x[0] + std::accumulate(T.begin(),T.begin()+1+i,0.0));
-		m_seq[i]->get_eph(t_P[i], r_P[i], v_P[i]);
-	}
+	// The legs are evaluated in sequence: only the planets at the two ends of the current leg are kept, and the times of
+	// flight (x[4*i+3], days) and DVs are summed as they are computed (in the same order std::accumulate would use).
+	kep_toolbox::array3D r_P, v_P, r_P_prev, v_P_prev;
+	double T_sum = x[3], DV_sum = 0.0;
+	m_seq[0]->get_eph(x[0] + T_sum, r_P, v_P);
 
-	// 3 - We start with the first leg
+	// 1 - We start with the first leg
 	double theta = 2*boost::math::constants::pi<double>()*x[1];
 	double phi = acos(2*x[2]-1)-boost::math::constants::pi<double>() / 2;
 	double d,d2,ra,ra2;
 	kep_toolbox::array3D r = { {ASTRO_JR*1000*cos(phi)*sin(theta), ASTRO_JR*1000*cos(phi)*cos(theta), ASTRO_JR*1000*sin(phi)} };
 	kep_toolbox::array3D v;
-	kep_toolbox::lambert_problem l(r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu,false,false);
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P,x[3]*ASTRO_DAY2SEC,common_mu,false);
 
-	DV[0] = std::abs(kep_toolbox::norm(v_beg_l)-3400.0);
+	DV_sum += std::abs(kep_toolbox::norm(v_beg_l)-3400.0);
 	
-	// 4 - And we proceed with each successive leg (if any)
+	// 2 - And we proceed with each successive leg (if any)
 	kep_toolbox::array3D v_out;
 	for (size_t i = 1; i<m_seq.size(); ++i) {
+		r_P_prev = r_P;
+		v_P_prev = v_P;
+		T_sum += x[4*i+3];
+		m_seq[i]->get_eph(x[0] + T_sum, r_P, v_P);
 		// Fly-by
-		kep_toolbox::fb_prop(v_out, v_end_l, v_P[i-1], x[4*i+1] * m_seq[i-1]->get_radius(), x[4*i], m_seq[i-1]->get_mu_self());
-	    r = r_P[i-1];
+		kep_toolbox::fb_prop(v_out, v_end_l, v_P_prev, x[4*i+1] * m_seq[i-1]->get_radius(), x[4*i], m_seq[i-1]->get_mu_self());
+	    r = r_P_prev;
 		v = v_out;
 		// s/c propagation before the DSM
-		kep_toolbox::propagate_lagrangian(r,v,x[4*i+2]*T[i]*ASTRO_DAY2SEC,common_mu);
-		kep_toolbox::closest_distance(d, ra, r_P[i-1], v_out, r, v, common_mu);
+		kep_toolbox::propagate_lagrangian(r,v,x[4*i+2]*x[4*i+3]*ASTRO_DAY2SEC,common_mu);
+		kep_toolbox::closest_distance(d, ra, r_P_prev, v_out, r, v, common_mu);
 
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
-		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
-		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i], v_end_l, common_mu);
+		double dt = (1-x[4*i+2])*x[4*i+3]*ASTRO_DAY2SEC;
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P,dt,common_mu,false);
+		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P, v_end_l, common_mu);
 		if (d < d2)
 		{
 			d = d/ASTRO_JR;
@@ -173,10 +164,10 @@ try {
 
 		// DSM occuring at time nu2*T2
 		kep_toolbox::diff(v_out, v_beg_l, v);
-		DV[i] = kep_toolbox::norm(v_out) + std::max((2.0-d),0.0) * 1000.0;
+		DV_sum += kep_toolbox::norm(v_out) + std::max((2.0-d),0.0) * 1000.0;
 	}
 	// Now we return the objective(s) function
-	f[0] = std::accumulate(DV.begin(),DV.end(),0.0); 
+	f[0] = DV_sum; 
 //Here the lambert solver or the lagrangian propagator went wrong
 } catch (...) {
 	f[0] = boost::numeric::bounds<double>::highest();
@@ -225,9 +216,8 @@ std::string mga_incipit::pretty(const std::vector<double> &x) const {
 	kep_toolbox::array3D r = { {ASTRO_JR * 1000*cos(phi)*sin(theta), ASTRO_JR * 1000*cos(phi)*cos(theta), ASTRO_JR * 1000*sin(phi)} };
 	kep_toolbox::array3D v;
 	
-	kep_toolbox::lambert_problem l(r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu,false,false);
-	kep_toolbox::array3D v_beg_l = l.get_v1()[0];
-	kep_toolbox::array3D v_end_l = l.get_v2()[0];
+	kep_toolbox::array3D v_beg_l, v_end_l;
+	kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[0],T[0]*ASTRO_DAY2SEC,common_mu,false);
 	kep_toolbox::closest_distance(d,ra,r,v_beg_l, r_P[0], v_end_l, common_mu);
 
 	DV[0] = std::abs(kep_toolbox::norm(v_beg_l)-3400.0);
@@ -257,9 +247,7 @@ std::string mga_incipit::pretty(const std::vector<double> &x) const {
 		
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[i],dt,common_mu,false);
 		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i], v_end_l, common_mu);
 		
 		if (d < d2)
@@ -300,6 +288,22 @@ std::string mga_incipit::get_name() const
 	return "MGA-INCIPIT (CAPTURE AT JUPITER)";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated on the stack and the planets are only read.
+ *
+ * @return true if all the planets of the sequence are thread-safe (see kep_toolbox::planet::is_thread_safe()).
+ */
+bool mga_incipit::is_thread_safe() const
+{
+	for (std::vector<kep_toolbox::planet_ptr>::size_type i = 0; i < m_seq.size(); ++i) {
+		if (!m_seq[i]->is_thread_safe()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 
 /// Gets the times of flight
 /**
@@ -63,6 +63,7 @@ class __PAGMO_VISIBLE mga_incipit_cstrs: public base
 		base_ptr clone() const;
 		
 		std::string get_name() const;
+		bool is_thread_safe() const;
 		std::string pretty(const std::vector<double> &x) const;
 		void set_tof(const std::vector<std::vector<double> >&);
 		const std::vector<std::vector<double> >& get_tof() const;
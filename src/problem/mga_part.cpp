@@ -123,42 +123,34 @@ void mga_part::objfun_impl(fitness_vector &f, const decision_vector &x) const
 try {
 	double d,ra,d2,ra2;
 	double common_mu = m_seq[0]->get_mu_central_body();
-	// 1 -  we 'decode' the chromosome recording the various times of flight (days) in the list T
-	std::vector<double> T(m_seq.size()-1,0.0);
-	
-	for (size_t i = 0; i < (m_seq.size()-1); ++i) {
-		T[i] = x[4*i+3];
-	}
-	// 2 - We compute the epochs and ephemerides of the planetary encounters
-	std::vector<kep_toolbox::epoch>   t_P(m_seq.size());
-	std::vector<kep_toolbox::array3D> r_P(m_seq.size());
-	std::vector<kep_toolbox::array3D> v_P(m_seq.size());
-	std::vector<double> DV(m_seq.size() - 1);
-	for (size_t i = 0; i<m_seq.size(); ++i) {
-		t_P[i] = kep_toolbox::epoch(m_t0.mjd2000() + std::accumulate(T.begin(),T.begin()+i,0.0));
-		m_seq[i]->get_eph(t_P[i], r_P[i], v_P[i]);
-	}
+	// The legs are evaluated in sequence: only the planets at the two ends of the current leg are kept, and the times of
+	// flight (x[4*i+3], days) and DVs are summed as they are computed (in the same order std::accumulate would use).
+	kep_toolbox::array3D r_P, v_P, r_P_next, v_P_next;
+	double T_sum = 0.0, DV_sum = 0.0;
+	m_seq[0]->get_eph(m_t0.mjd2000(), r_P_next, v_P_next);
 
-	// 3 - We loop over the legs
+	// We loop over the legs
 	kep_toolbox::array3D v_out,r,v;
 	kep_toolbox::array3D v_beg_l,v_end_l;
-	kep_toolbox::sum(v_end_l, m_vinf_in, v_P[0]);
+	kep_toolbox::sum(v_end_l, m_vinf_in, v_P_next);
 	for (size_t i = 0; i<(m_seq.size()-1); ++i) {
+		r_P = r_P_next;
+		v_P = v_P_next;
+		T_sum += x[4*i+3];
+		m_seq[i+1]->get_eph(m_t0.mjd2000() + T_sum, r_P_next, v_P_next);
 		// Fly-by
-		kep_toolbox::fb_prop(v_out, v_end_l, v_P[i], x[4*i+1] * m_seq[i]->get_radius(), x[4*i], m_seq[i]->get_mu_self());
+		kep_toolbox::fb_prop(v_out, v_end_l, v_P, x[4*i+1] * m_seq[i]->get_radius(), x[4*i], m_seq[i]->get_mu_self());
 		// s/c propagation before the DSM
-		r = r_P[i];
+		r = r_P;
 		v = v_out;
 		
-		kep_toolbox::propagate_lagrangian(r,v,x[4*i+2]*T[i]*ASTRO_DAY2SEC,common_mu);
-		kep_toolbox::closest_distance(d, ra, r_P[i], v_out, r, v, common_mu);
+		kep_toolbox::propagate_lagrangian(r,v,x[4*i+2]*x[4*i+3]*ASTRO_DAY2SEC,common_mu);
+		kep_toolbox::closest_distance(d, ra, r_P, v_out, r, v, common_mu);
 		
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
-		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
-		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i+1], v_end_l, common_mu);
+		double dt = (1-x[4*i+2])*x[4*i+3]*ASTRO_DAY2SEC;
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P_next,dt,common_mu,false);
+		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P_next, v_end_l, common_mu);
 		
 		if (d < d2)
 		{
@@ -170,10 +162,10 @@ try {
 		// DSM occuring at time nu2*T2
 		kep_toolbox::diff(v_out, v_beg_l, v);
 		// Penalized if the JR is too small (<0.2)
-		DV[i] = kep_toolbox::norm(v_out) + std::max((2.0-d),0.0) * 1000.0;
+		DV_sum += kep_toolbox::norm(v_out) + std::max((2.0-d),0.0) * 1000.0;
 	}
 	// Now we return the objective(s) function
-	f[0] = std::accumulate(DV.begin(),DV.end(),0.0); 
+	f[0] = DV_sum; 
 //Here the lambert solver or the lagrangian propagator went wrong
 } catch (...) {
 	f[0] = boost::numeric::bounds<double>::highest();
@@ -236,9 +228,7 @@ std::string mga_part::pretty(const std::vector<double> &x) const {
 		
 		// Lambert arc to reach Earth during (1-nu2)*T2 (second segment)
 		double dt = (1-x[4*i+2])*T[i]*ASTRO_DAY2SEC;
-		kep_toolbox::lambert_problem l2(r,r_P[i+1],dt,common_mu,false,false);
-		v_end_l = l2.get_v2()[0];
-		v_beg_l = l2.get_v1()[0];
+		kep_toolbox::lambert_solve(v_beg_l,v_end_l,r,r_P[i+1],dt,common_mu,false);
 		kep_toolbox::closest_distance(d2,ra2,r,v_beg_l, r_P[i+1], v_end_l, common_mu);
 		
 		if (d < d2)
@@ -281,6 +271,22 @@ std::string mga_part::get_name() const
 	return "MGA-PART (a part of the jupiter moon tour)";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated on the stack and the planets are only read.
+ *
+ * @return true if all the planets of the sequence are thread-safe (see kep_toolbox::planet::is_thread_safe()).
+ */
+bool mga_part::is_thread_safe() const
+{
+	for (std::vector<kep_toolbox::planet_ptr>::size_type i = 0; i < m_seq.size(); ++i) {
+		if (!m_seq[i]->is_thread_safe()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /// Sets the times of flight
 /**
  * This setter changes the problem bounds as to define a minimum and a maximum allowed total time of flight
@@ -22,9 +22,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <boost/bind.hpp>
 #include <boost/functional/hash.hpp>
+#include <boost/ref.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -48,10 +51,12 @@ namespace pagmo { namespace problem {
  * @param[in] param_second Standard deviation of the Gaussian noise / Upper bound of the uniform noise
  * @param[in] distribution Two types of distributions for the noise are currently supported: NORMAL or UNIFORM
  * @param[in] seed seed for the underlying rng
+ * @param[in] n_threads number of threads evaluating the trials (0 for the number of hardware threads). Values other than 1 are
+ * honoured only if the original problem is thread-safe (see problem::base::is_thread_safe()), otherwise the trials are run serially.
  * @see problem::base_stochastic constructors.
  */
 
-noisy::noisy(const base & p, unsigned int trials, const double param_first, const double param_second, noise_type distribution, unsigned int seed):
+noisy::noisy(const base & p, unsigned int trials, const double param_first, const double param_second, noise_type distribution, unsigned int seed, unsigned int n_threads):
 	base_stochastic((int)p.get_dimension(),
 		 p.get_i_dimension(),
 		 p.get_f_dimension(),
@@ -65,7 +70,9 @@ noisy::noisy(const base & p, unsigned int trials, const double param_first, cons
 	m_decision_vector_hash(),
 	m_param_first(param_first),
 	m_param_second(param_second),
-	m_noise_type(distribution)
+	m_noise_type(distribution),
+	m_n_threads(n_threads),
+	m_trial_problems()
 {
 	if(distribution == UNIFORM && param_first > param_second){
 		pagmo_throw(value_error, "Bounds specified for the uniform noise are not valid.");
@@ -83,7 +90,9 @@ noisy::noisy(const noisy &prob):
 	m_decision_vector_hash(),
 	m_param_first(prob.m_param_first),
 	m_param_second(prob.m_param_second),
-	m_noise_type(prob.m_noise_type) {}
+	m_noise_type(prob.m_noise_type),
+	m_n_threads(prob.m_n_threads),
+	m_trial_problems() {}
 
 /// Clone method.
 base_ptr noisy::clone() const
@@ -125,22 +134,26 @@ double noisy::get_param_second() const
 	return m_param_second;
 }
 
+/**
+ * Returns the number of threads evaluating the trials.
+ */
+unsigned int noisy::get_threads() const
+{
+	return m_n_threads;
+}
+
 /// Implementation of the objective function.
 /// Add noises to the computed fitness vector.
 void noisy::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	//1 - Initialize a temporary fitness vector storing one trial result
-	//and we use it also to init the return value 
-	fitness_vector tmp(f.size(),0.0);
-	f=tmp;
-	//2 - We set the seed
-	m_drng.seed(m_seed+m_decision_vector_hash(x));
-	//3 - We average upon multiple runs
+	//1 - We compute all the trials, possibly in parallel
+	std::vector<fitness_vector> trials(m_trials, fitness_vector(f.size(), 0.0));
+	run_trials(*m_original_problem, m_trial_problems, m_n_threads, m_trials, boost::bind(&noisy::trials_f, this, _1, boost::cref(x), boost::ref(trials), _2, _3));
+	//2 - We average upon them, always in the same order
+	std::fill(f.begin(), f.end(), 0.0);
 	for (unsigned int j=0; j< m_trials; ++j) {
-		m_original_problem->objfun(tmp, x);
-		inject_noise_f(tmp);
 		for (fitness_vector::size_type i=0; i<f.size();++i) {
-			f[i] = f[i] + tmp[i] / (double)m_trials;
+			f[i] = f[i] + trials[j][i] / (double)m_trials;
 		}
 	}
 }
@@ -149,44 +162,64 @@ void noisy::objfun_impl(fitness_vector &f, const decision_vector &x) const
 /// Add noises to the computed constraint vector.
 void noisy::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	//1 - Initialize a temporary constraint vector storing one trial result
-	//and we use it also to init the return value 
-	constraint_vector tmp(c.size(),0.0);
-	c=tmp;
-	//2 - We set the seed
-	m_drng.seed(m_seed+m_decision_vector_hash(x));
-	//3 - We average upon multiple runs
+	//1 - We compute all the trials, possibly in parallel
+	std::vector<constraint_vector> trials(m_trials, constraint_vector(c.size(), 0.0));
+	run_trials(*m_original_problem, m_trial_problems, m_n_threads, m_trials, boost::bind(&noisy::trials_c, this, _1, boost::cref(x), boost::ref(trials), _2, _3));
+	//2 - We average upon them, always in the same order
+	std::fill(c.begin(), c.end(), 0.0);
 	for (unsigned int j=0; j< m_trials; ++j) {
-		m_original_problem->compute_constraints(tmp, x);
-		inject_noise_c(tmp);
 		for (constraint_vector::size_type i=0; i<c.size();++i) {
-			c[i] = c[i] + tmp[i] / (double)m_trials;
+			c[i] = c[i] + trials[j][i] / (double)m_trials;
 		}
 	}
 }
 
+// Noisy fitness vectors of the trials [begin,end).
+void noisy::trials_f(const base &prob, const decision_vector &x, std::vector<fitness_vector> &trials, unsigned int begin, unsigned int end) const
+{
+	const boost::uint64_t stream = m_decision_vector_hash(x);
+	for (unsigned int j = begin; j < end; ++j) {
+		rng_counter rng(m_seed, stream, j);
+		prob.objfun(trials[j], x);
+		inject_noise_f(trials[j], rng);
+	}
+}
+
+// Noisy constraint vectors of the trials [begin,end).
+void noisy::trials_c(const base &prob, const decision_vector &x, std::vector<constraint_vector> &trials, unsigned int begin, unsigned int end) const
+{
+	const boost::uint64_t stream = m_decision_vector_hash(x);
+	for (unsigned int j = begin; j < end; ++j) {
+		rng_counter rng(m_seed, stream, j);
+		prob.compute_constraints(trials[j], x);
+		inject_noise_c(trials[j], rng);
+	}
+}
+
 /// Apply noise on a fitness vector
-void noisy::inject_noise_f(fitness_vector& f) const
+void noisy::inject_noise_f(fitness_vector& f, rng_counter &rng) const
 {
+	boost::normal_distribution<double> normal_dist(m_normal_dist);
 	for(f_size_type i = 0; i < f.size(); i++){
 		if(m_noise_type == NORMAL){
-			f[i] += m_normal_dist(m_drng)*m_param_second+m_param_first;
+			f[i] += normal_dist(rng)*m_param_second+m_param_first;
 		}
 		else if(m_noise_type == UNIFORM){
-			f[i] += m_uniform_dist(m_drng)*(m_param_second-m_param_first)+m_param_first;
+			f[i] += m_uniform_dist(rng)*(m_param_second-m_param_first)+m_param_first;
 		}
 	}
 }
 
 /// Apply noise on a constraint vector
-void noisy::inject_noise_c(constraint_vector& c) const
+void noisy::inject_noise_c(constraint_vector& c, rng_counter &rng) const
 {
+	boost::normal_distribution<double> normal_dist(m_normal_dist);
 	for(c_size_type i = 0; i < c.size(); i++){
 		if(m_noise_type == NORMAL){
-			c[i] += m_normal_dist(m_drng)*m_param_second+m_param_first;
+			c[i] += normal_dist(rng)*m_param_second+m_param_first;
 		}
 		else if(m_noise_type == UNIFORM){
-			c[i] += m_uniform_dist(m_drng)*(m_param_second-m_param_first)+m_param_first;
+			c[i] += m_uniform_dist(rng)*(m_param_second-m_param_first)+m_param_first;
 		}
 	}
 }
@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_NOISY_H
 
 #include <string>
+#include <vector>
 #include <boost/functional/hash.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
@@ -49,6 +50,10 @@ namespace pagmo{ namespace problem {
  * NOTE: for m_trials->infinity one recovers a deterministic problem, but the objective function computation
  * soon becomes very expensive. The trade-off is to keep m_trials small, while being able to get good convergence. 
  *
+ * The noise of each trial is drawn from a pagmo::rng_counter stream addressed by the seed, the hash of the decision vector
+ * and the index of the trial. Trials are thus independent of each other, and they can be split among several threads
+ * (each with its own copy of the original problem) without changing the result.
+ *
  * @author Yung-Siang Liau (liauys@gmail.com)
  * @author Dario Izzo (dario.izzo@gmail.com)
  */
@@ -67,7 +72,8 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 			 const double param_first = 0.0,
 			 const double param_second = 0.1,
 			 noise_type = NORMAL,
-			 unsigned int seed = 0u);
+			 unsigned int seed = 0u,
+			 unsigned int n_threads = 1);
 		
 		//copy constructor
 		noisy(const noisy &);
@@ -77,6 +83,7 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 		void set_noise_param(double, double);
 		double get_param_first() const;
 		double get_param_second() const;
+		unsigned int get_threads() const;
 
 	protected:
 		std::string human_readable_extra() const;
@@ -84,12 +91,14 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
 
 	private:
-		void inject_noise_f(fitness_vector&) const;
-		void inject_noise_c(constraint_vector&) const;
+		void inject_noise_f(fitness_vector&, rng_counter &) const;
+		void inject_noise_c(constraint_vector&, rng_counter &) const;
+		void trials_f(const base &, const decision_vector &, std::vector<fitness_vector> &, unsigned int, unsigned int) const;
+		void trials_c(const base &, const decision_vector &, std::vector<constraint_vector> &, unsigned int, unsigned int) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base_stochastic>(*this);
 			ar & m_original_problem;
@@ -99,6 +108,12 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 			ar & m_param_first;
 			ar & m_param_second;
 			ar & m_noise_type;
+			// Version 0 archives predate the threaded trials: fall back to the serial evaluation.
+			if (version >= 1) {
+				ar & const_cast<unsigned int &>(m_n_threads);
+			} else {
+				const_cast<unsigned int &>(m_n_threads) = 1;
+			}
 		}
 
 		base_ptr m_original_problem;
@@ -109,10 +124,16 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 		double m_param_first;
 		double m_param_second;
 		noise_type m_noise_type;
+		const unsigned int m_n_threads;
+		// Copies of m_original_problem used by the threads other than the calling one (not serialized).
+		mutable std::vector<base_ptr> m_trial_problems;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::noisy)
 
+// Version 1: number of threads evaluating the trials.
+BOOST_CLASS_VERSION(pagmo::problem::noisy,1)
+
 #endif // PAGMO_PROBLEM_NOISY_H
@@ -22,9 +22,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <boost/bind.hpp>
 #include <boost/functional/hash.hpp>
+#include <boost/ref.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -42,11 +45,13 @@ namespace pagmo { namespace problem {
  * @param[in] trials sample size to average over in objective / constraint function
  * @param[in] param_rho neighbourhood size
  * @param[in] seed seed of the underlying rng
+ * @param[in] n_threads number of threads evaluating the trials (0 for the number of hardware threads). Values other than 1 are
+ * honoured only if the original problem is thread-safe (see problem::base::is_thread_safe()), otherwise the trials are run serially.
  *
  * @see problem::base_stochastic constructors.
  */
 
-robust::robust(const base & p, unsigned int trials, const double param_rho, unsigned int seed):
+robust::robust(const base & p, unsigned int trials, const double param_rho, unsigned int seed, unsigned int n_threads):
 	base_stochastic((int)p.get_dimension(),
 		 p.get_i_dimension(),
 		 p.get_f_dimension(),
@@ -57,7 +62,9 @@ robust::robust(const base & p, unsigned int trials, const double param_rho, unsi
 	m_normal_dist(0, 1),
 	m_uniform_dist(0, 1),
 	m_trials(trials),
-	m_rho(param_rho)
+	m_rho(param_rho),
+	m_n_threads(n_threads),
+	m_trial_problems()
 {
 	if(param_rho < 0){
 		pagmo_throw(value_error, "Rho should be greater than 0");
@@ -71,7 +78,9 @@ robust::robust(const robust &prob):
 	 m_original_problem(prob.m_original_problem->clone()),
 	 m_uniform_dist(0, prob.m_rho),
 	 m_trials(prob.m_trials),
-	 m_rho(prob.m_rho) {}
+	 m_rho(prob.m_rho),
+	 m_n_threads(prob.m_n_threads),
+	 m_trial_problems() {}
 
 /// Clone method.
 base_ptr robust::clone() const
@@ -98,24 +107,27 @@ double robust::get_rho() const
 	return m_rho;
 }
 
+/**
+ * Returns the number of threads evaluating the trials.
+ */
+unsigned int robust::get_threads() const
+{
+	return m_n_threads;
+}
+
 /// Implementation of the objective function.
 /// Add noises to the decision vector before calling the actual objective function.
 void robust::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	// Temporary storage used for averaging
-	fitness_vector tmp(f.size(),0.0);
-	f = tmp;
-
-	// Set the seed
-	m_drng.seed(m_seed);
+	// Evaluate all the trials, possibly in parallel
+	std::vector<fitness_vector> trials(m_trials, fitness_vector(f.size(), 0.0));
+	run_trials(*m_original_problem, m_trial_problems, m_n_threads, m_trials, boost::bind(&robust::trials_f, this, _1, boost::cref(x), boost::ref(trials), _2, _3));
 
-	// Perturb decision vector and evaluate
-	decision_vector x_perturbed(x);
+	// Average upon them, always in the same order
+	std::fill(f.begin(), f.end(), 0.0);
 	for(unsigned int i = 0; i < m_trials; ++i){
-		inject_noise_x(x_perturbed);
-		m_original_problem->objfun(tmp, x_perturbed);
 		for(fitness_vector::size_type j = 0; j < f.size(); ++j){
-			f[j] += tmp[j] / (double)m_trials;
+			f[j] += trials[i][j] / (double)m_trials;
 		}
 	}
 }
@@ -124,38 +136,61 @@ void robust::objfun_impl(fitness_vector &f, const decision_vector &x) const
 /// Add noises to the decision vector before calling the actual constraint function.
 void robust::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	// Temporary storage used for averaging
-	constraint_vector tmp(c.size(), 0.0);
-	c = tmp;
+	// Evaluate all the trials, possibly in parallel
+	std::vector<constraint_vector> trials(m_trials, constraint_vector(c.size(), 0.0));
+	run_trials(*m_original_problem, m_trial_problems, m_n_threads, m_trials, boost::bind(&robust::trials_c, this, _1, boost::cref(x), boost::ref(trials), _2, _3));
 
-	// Set the seed
-	m_drng.seed(m_seed);
-
-	// Perturb decision vector and evaluate
-	decision_vector x_perturbed(x);
+	// Average upon them, always in the same order
+	std::fill(c.begin(), c.end(), 0.0);
 	for(unsigned int i = 0; i < m_trials; ++i){
-		inject_noise_x(x_perturbed);
-		m_original_problem->compute_constraints(tmp, x_perturbed);
 		for(constraint_vector::size_type j = 0; j < c.size(); ++j){
-			c[j] = tmp[j] / (double)m_trials;
+			c[j] += trials[i][j] / (double)m_trials;
 		}
 	}
 }
 
+// Fitness vectors of the trials [begin,end). Each trial perturbs x independently, drawing
+// from the substream of its index (the perturbations do not depend on x, as before).
+void robust::trials_f(const base &prob, const decision_vector &x, std::vector<fitness_vector> &trials, unsigned int begin, unsigned int end) const
+{
+	decision_vector x_perturbed(x.size());
+	for(unsigned int i = begin; i < end; ++i){
+		rng_counter rng(m_seed, 0, i);
+		x_perturbed = x;
+		inject_noise_x(x_perturbed, rng);
+		prob.objfun(trials[i], x_perturbed);
+	}
+}
+
+// Constraint vectors of the trials [begin,end).
+void robust::trials_c(const base &prob, const decision_vector &x, std::vector<constraint_vector> &trials, unsigned int begin, unsigned int end) const
+{
+	decision_vector x_perturbed(x.size());
+	for(unsigned int i = begin; i < end; ++i){
+		rng_counter rng(m_seed, 0, i);
+		x_perturbed = x;
+		inject_noise_x(x_perturbed, rng);
+		prob.compute_constraints(trials[i], x_perturbed);
+	}
+}
+
 /// Apply noise on the decision vector based on rho
-void robust::inject_noise_x(decision_vector &x) const
+void robust::inject_noise_x(decision_vector &x, rng_counter &rng) const
 {
+	boost::normal_distribution<double> normal_dist(m_normal_dist);
+	boost::random::uniform_real_distribution<double> uniform_dist(0, 1);
+
 	// We follow the algorithm at
 	// http://math.stackexchange.com/questions/87230/picking-random-points-in-the-volume-of-sphere-with-uniform-probability
 
 	// 0. Define the radius
-	double radius = m_rho * pow(m_uniform_dist(m_drng),1.0/x.size());
+	double radius = m_rho * pow(uniform_dist(rng),1.0/x.size());
 
 	// 1. Sampling N(0,1) on each dimension
 	std::vector<double> perturbation(x.size(), 0.0);
 	double c2=0;
 	for(size_type i = 0; i < perturbation.size(); i++){
-		perturbation[i] = m_normal_dist(m_drng);
+		perturbation[i] = normal_dist(rng);
 		c2 += perturbation[i]*perturbation[i];
 	}
 
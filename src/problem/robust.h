@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_ROBUST_H
 
 #include <string>
+#include <vector>
 #include <boost/functional/hash.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
@@ -44,6 +45,10 @@ namespace pagmo{ namespace problem {
  * chromosome. The solution to the resulting problem is robust
  * to input noises in the given neighbourhood.
  *
+ * The perturbation of each trial is drawn from a pagmo::rng_counter stream addressed by the seed and the index
+ * of the trial, so that the trials can be split among several threads (each with its own copy of the original
+ * problem) without changing the result.
+ *
  * @author Yung-Siang Liau (liauys@gmail.com)
  * @author Dario Izzo (dario.izzo@gmail.com)
  *
@@ -56,7 +61,8 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		robust(const base & = ackley(1),
 			   unsigned int trials = 1,
 			   const double param_rho = 0.1,
-			   unsigned int seed = 0u);
+			   unsigned int seed = 0u,
+			   unsigned int n_threads = 1);
 		
 		//copy constructor
 		robust(const robust &);
@@ -65,6 +71,7 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 
 		void set_rho(double);
 		double get_rho() const;
+		unsigned int get_threads() const;
 
 	protected:
 		std::string human_readable_extra() const;
@@ -72,11 +79,13 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
 
 	private:
-		void inject_noise_x(decision_vector &) const;
+		void inject_noise_x(decision_vector &, rng_counter &) const;
+		void trials_f(const base &, const decision_vector &, std::vector<fitness_vector> &, unsigned int, unsigned int) const;
+		void trials_c(const base &, const decision_vector &, std::vector<constraint_vector> &, unsigned int, unsigned int) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base_stochastic>(*this);
 			ar & m_original_problem;
@@ -84,6 +93,12 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 			ar & m_uniform_dist;
 			ar & m_trials;
 			ar & m_rho;
+			// Version 0 archives predate the threaded trials: fall back to the serial evaluation.
+			if (version >= 1) {
+				ar & const_cast<unsigned int &>(m_n_threads);
+			} else {
+				const_cast<unsigned int &>(m_n_threads) = 1;
+			}
 		}
 
 		base_ptr m_original_problem;
@@ -91,10 +106,16 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		mutable boost::random::uniform_real_distribution<double> m_uniform_dist;
 		unsigned int m_trials;
 		double m_rho;
+		const unsigned int m_n_threads;
+		// Copies of m_original_problem used by the threads other than the calling one (not serialized).
+		mutable std::vector<base_ptr> m_trial_problems;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::robust)
 
+// Version 1: number of threads evaluating the trials.
+BOOST_CLASS_VERSION(pagmo::problem::robust,1)
+
 #endif // PAGMO_PROBLEM_ROBUST_H
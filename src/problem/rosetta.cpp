@@ -61,7 +61,7 @@ base_ptr rosetta::clone() const
 /// Implementation of the objective function.
 void rosetta::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	MGA_DSM(x, problem,f[0]);
+	MGA_DSM(&x[0], problem, f[0], 0, 0);
 }
 
 /// Implementation of the sparsity structure.
@@ -86,6 +86,17 @@ std::string rosetta::get_name() const
 	return "Rosetta";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The trajectory is evaluated by MGA_DSM() with stack buffers only.
+ *
+ * @return true.
+ */
+bool rosetta::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::rosetta)
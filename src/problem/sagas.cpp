@@ -55,7 +55,7 @@ base_ptr sagas::clone() const
 /// Implementation of the objective function.
 void sagas::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	MGA_DSM(x, problem,f[0]);
+	MGA_DSM(&x[0], problem, f[0], 0, 0);
 }
 
 /// Implementation of the sparsity structure.
@@ -80,6 +80,17 @@ std::string sagas::get_name() const
 	return "Sagas";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The objective function only reads the problem data.
+ *
+ * @return true.
+ */
+bool sagas::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::sagas)
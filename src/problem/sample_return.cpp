@@ -40,7 +40,7 @@ static const int AE[2] = {10,3};
  * Instantiates the sample_return problem
  */
 sample_return::sample_return(const ::kep_toolbox::planet &asteroid, const double &Tmax):base(12), m_target(asteroid.clone()),
-	 m_leg1(total_DV_rndv,EA,2,0,0,0,0,0), m_leg2(total_DV_rndv,AE,2,0,0,0,0,0),x_leg1(6),x_leg2(6),m_Tmax(Tmax)
+	 m_leg1(total_DV_rndv,EA,2,0,0,0,0,0), m_leg2(total_DV_rndv,AE,2,0,0,0,0,0),m_Tmax(Tmax)
 {
 	::kep_toolbox::epoch start_lw(2020,1,1);
 	::kep_toolbox::epoch end_lw(2035,1,1);
@@ -73,12 +73,20 @@ base_ptr sample_return::clone() const
 	return base_ptr(new sample_return(*this));
 }
 
-/// Implementation of the objective function.
-void sample_return::objfun_impl(fitness_vector &f, const decision_vector &x) const
+/// Splits the decision vector in the two legs and computes their DVs
+/**
+ * Uses caller-provided buffers only, so that concurrent evaluations do not interfere.
+ *
+ * \param[in] x decision vector.
+ * \param[out] x_leg1 decision vector of the Earth-asteroid leg (6 values).
+ * \param[out] x_leg2 decision vector of the asteroid-Earth leg (6 values).
+ * \param[out] DV1 DV contributions of the first leg (3 values).
+ * \param[out] DV2 DV contributions of the second leg (3 values).
+ */
+void sample_return::compute_legs(const decision_vector &x, double *x_leg1, double *x_leg2, double *DV1, double *DV2) const
 {
-	//We split the decision vector in the two legs
-	std::copy(x.begin(),x.begin()+6,x_leg1.begin());
-	std::copy(x.begin()+6,x.begin()+12,x_leg2.begin());
+	std::copy(x.begin(),x.begin()+6,x_leg1);
+	std::copy(x.begin()+6,x.begin()+12,x_leg2);
 
 	x_leg1[4] = x_leg1[4] * m_Tmax;
 	x_leg2[4] = (m_Tmax - x_leg1[4] - x_leg2[0]) * x_leg2[4];
@@ -86,10 +94,17 @@ void sample_return::objfun_impl(fitness_vector &f, const decision_vector &x) con
 	//We account for the waiting time
 	x_leg2[0] += x_leg1[0] + x_leg1[4];
 	double dummy = 0;
-	MGA_DSM(x_leg1, m_leg1, dummy);
-	MGA_DSM(x_leg2, m_leg2, dummy);
-	f[0] = m_leg1.DV[0] + m_leg1.DV[1] + m_leg1.DV[2] +
-		m_leg2.DV[0] + m_leg2.DV[1] + std::max(0.0,m_leg2.DV[2] - 5.5);
+	MGA_DSM(x_leg1, m_leg1, dummy, DV1, 0);
+	MGA_DSM(x_leg2, m_leg2, dummy, DV2, 0);
+}
+
+/// Implementation of the objective function.
+void sample_return::objfun_impl(fitness_vector &f, const decision_vector &x) const
+{
+	double x_leg1[6], x_leg2[6], DV1[3], DV2[3];
+	compute_legs(x,x_leg1,x_leg2,DV1,DV2);
+	f[0] = DV1[0] + DV1[1] + DV1[2] +
+		DV2[0] + DV2[1] + std::max(0.0,DV2[2] - 5.5);
 
 }
 
@@ -108,40 +123,36 @@ std::string sample_return::pretty(const std::vector<double> &x) const
 	std::ostringstream s;
 	s.precision(15);
 	s << std::scientific;
-	//We split the decision vector in the two legs
-	std::copy(x.begin(),x.begin()+6,x_leg1.begin());
-	std::copy(x.begin()+6,x.begin()+12,x_leg2.begin());
-
-	x_leg1[4] = x_leg1[4] * m_Tmax;
-	x_leg2[4] = (m_Tmax - x_leg1[4] - x_leg2[0]) * x_leg2[4];
-
-	//We account for the waiting time
-	x_leg2[0] += x_leg1[0] + x_leg1[4];
-	double dummy = 0;
-	MGA_DSM(x_leg1, m_leg1, dummy);
-	MGA_DSM(x_leg2, m_leg2, dummy);
+	double x_leg1[6], x_leg2[6], DV1[3], DV2[3];
+	compute_legs(x,x_leg1,x_leg2,DV1,DV2);
 
 	s << "Departure epoch (mjd2000):\t" << x[0] << '\n';
 	s << "Departure epoch:\t\t" << ::kep_toolbox::epoch(x[0],::kep_toolbox::epoch::MJD2000) << '\n';
-	s << "Escape velocity:\t\t" << m_leg1.DV[0] << '\n';
+	s << "Escape velocity:\t\t" << DV1[0] << '\n';
 	s << "dsm1 epoch:\t\t\t" << ::kep_toolbox::epoch(x[0] + x[5]*x[4],::kep_toolbox::epoch::MJD2000) << '\n';
-	s << "dsm1 magnitude\t\t\t" << m_leg1.DV[1] << " \n";
+	s << "dsm1 magnitude\t\t\t" << DV1[1] << " \n";
 	s << "Asteroid arrival epoch: \t" << ::kep_toolbox::epoch(x[0] + x[4],::kep_toolbox::epoch::MJD2000) << '\n';
-	s << "Breaking manouvre:\t\t" << m_leg1.DV[2] << '\n' << std::endl;
+	s << "Breaking manouvre:\t\t" << DV1[2] << '\n' << std::endl;
 
 	s << "Departure epoch (mjd2000):\t" << x[0] + x[4] + x[6] << '\n';
 	s << "Departure epoch:\t\t" << ::kep_toolbox::epoch(x[0] + x[4] + x[6],::kep_toolbox::epoch::MJD2000) << '\n';
-	s << "Escape velocity:\t\t" << m_leg2.DV[0] << '\n';
+	s << "Escape velocity:\t\t" << DV2[0] << '\n';
 	s << "dsm2 epoch:\t\t\t" << ::kep_toolbox::epoch(x[0]+x[4]+x[6]+x[11]*x[10],::kep_toolbox::epoch::MJD2000) << '\n';
-	s << "dsm2 magnitude\t\t\t" << m_leg2.DV[1] << " \n";
+	s << "dsm2 magnitude\t\t\t" << DV2[1] << " \n";
 	s << "Earth arrival epoch: \t\t" << ::kep_toolbox::epoch(x[0]+x[4]+x[6]+x[10],::kep_toolbox::epoch::MJD2000) << '\n';
-	s << "Arrival Vinf:\t\t\t" << m_leg2.DV[2] << '\n';
+	s << "Arrival Vinf:\t\t\t" << DV2[2] << '\n';
 	s << "Total time of flight:\t\t" << x[4]+x[6]+x[10] << '\n' << std::endl;
 
-	s << "Earth-ephemerides at departure:\t\t" << m_leg1.r[0][0] << " " << m_leg1.r[0][1] << " " << m_leg1.r[0][2] << std::endl;
-	s << "Asteroid-ephemerides at arrival:\t" << m_leg1.r[1][0] << " " << m_leg1.r[1][1] << " " << m_leg1.r[1][2] << std::endl;
-	s << "Asteroid-ephemerides at departure:\t" << m_leg2.r[0][0] << " " << m_leg2.r[0][1] << " " << m_leg2.r[0][2] << std::endl;
-	s << "Earth-ephemerides at arrival:\t\t" << m_leg2.r[1][0] << " " << m_leg2.r[1][1] << " " << m_leg2.r[1][2] << std::endl;
+	//Ephemerides at the start and at the end of each leg
+	double r[4][3], v[3];
+	get_celobj_r_and_v(m_leg1, x_leg1[0], 0, r[0], v);
+	get_celobj_r_and_v(m_leg1, x_leg1[0] + x_leg1[4], 1, r[1], v);
+	get_celobj_r_and_v(m_leg2, x_leg2[0], 0, r[2], v);
+	get_celobj_r_and_v(m_leg2, x_leg2[0] + x_leg2[4], 1, r[3], v);
+	s << "Earth-ephemerides at departure:\t\t" << r[0][0] << " " << r[0][1] << " " << r[0][2] << std::endl;
+	s << "Asteroid-ephemerides at arrival:\t" << r[1][0] << " " << r[1][1] << " " << r[1][2] << std::endl;
+	s << "Asteroid-ephemerides at departure:\t" << r[2][0] << " " << r[2][1] << " " << r[2][2] << std::endl;
+	s << "Earth-ephemerides at arrival:\t\t" << r[3][0] << " " << r[3][1] << " " << r[3][2] << std::endl;
 
 
 
@@ -150,21 +161,11 @@ std::string sample_return::pretty(const std::vector<double> &x) const
 
 /// Computes the Delta-Vs
 std::vector<double> sample_return::get_delta_v(const std::vector<double> &x) const {
-	//We split the decision vector in the two legs
-	std::copy(x.begin(),x.begin()+6,x_leg1.begin());
-	std::copy(x.begin()+6,x.begin()+12,x_leg2.begin());
-
-	x_leg1[4] = x_leg1[4] * m_Tmax;
-	x_leg2[4] = (m_Tmax - x_leg1[4] - x_leg2[0]) * x_leg2[4];
-
-	//We account for the waiting time
-	x_leg2[0] += x_leg1[0] + x_leg1[4];
-	double dummy = 0;
-	MGA_DSM(x_leg1, m_leg1, dummy);
-	MGA_DSM(x_leg2, m_leg2, dummy);
+	double x_leg1[6], x_leg2[6], DV1[3], DV2[3];
+	compute_legs(x,x_leg1,x_leg2,DV1,DV2);
 	std::vector<double> retval;
-	for (int i=0;i<3;++i) retval.push_back(m_leg1.DV[i]);
-	for (int i=0;i<3;++i) retval.push_back(m_leg2.DV[i]);
+	for (int i=0;i<3;++i) retval.push_back(DV1[i]);
+	for (int i=0;i<3;++i) retval.push_back(DV2[i]);
 	return retval;
 }
 
@@ -189,6 +190,17 @@ std::string sample_return::get_name() const
 	return "Sample return";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * Both legs are evaluated into local buffers by compute_legs().
+ *
+ * \return true.
+ */
+bool sample_return::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::sample_return)
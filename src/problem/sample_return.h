@@ -54,27 +54,31 @@ class __PAGMO_VISIBLE sample_return: public base
 		std::string pretty(const std::vector<double> &x) const;
 		std::vector<double> get_delta_v(const std::vector<double> &x) const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
 	private:
+		void compute_legs(const decision_vector &, double *, double *, double *, double *) const;
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_target;
 			ar & m_leg1;
 			ar & m_leg2;
-			ar & x_leg1;
-			ar & x_leg2;
+			// Version 0 archives also stored the decision vectors of the last evaluation of the legs: skip them.
+			if (version < 1) {
+				std::vector<double> x_leg1, x_leg2;
+				ar & x_leg1;
+				ar & x_leg2;
+			}
 			ar & const_cast<double &>(m_Tmax);
 		}
 		::kep_toolbox::planet_ptr	m_target;
-		mutable mgadsmproblem		m_leg1;
-		mutable mgadsmproblem		m_leg2;
-		mutable std::vector<double>	x_leg1;
-		mutable std::vector<double>	x_leg2;
+		mgadsmproblem			m_leg1;
+		mgadsmproblem			m_leg2;
 		const double			m_Tmax;
 
 };
@@ -83,4 +87,7 @@ class __PAGMO_VISIBLE sample_return: public base
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::sample_return)
 
+// Version 1: the decision vectors of the legs are no longer archived.
+BOOST_CLASS_VERSION(pagmo::problem::sample_return,1)
+
 #endif // PAGMO_SAMPLE_RETURN_H
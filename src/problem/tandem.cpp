@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <string>
 
 #include "tandem.h"
@@ -68,7 +69,7 @@ const int tandem::sequence[5] = {1,1,1,1,1};
 * \param[in] probid This is an integer number from 1 to 24 encoding the fly-by sequence to be used (default is EVEES). Check http://www.esa.int/gsp/ACT/inf/op/globopt/TandEM.htm for more information
 * \param[in] tof_ (in years) This is a number setting the constraint on the total time of flight (10 from the GTOP database). If -1 (default) an unconstrained problem is instantiated
 */
-tandem::tandem(const int probid, const double tof_):base(18), problem(orbit_insertion,sequence,5,0,0,0,0.98531407996358,80330.0), tof(tof_),copy_of_x(18)
+tandem::tandem(const int probid, const double tof_):base(18), problem(orbit_insertion,sequence,5,0,0,0,0.98531407996358,80330.0), tof(tof_)
 {
 	if (probid < 1 || probid > 24) {
 		pagmo_throw(value_error,"probid needs to be an integer in [1,24]");
@@ -99,16 +100,18 @@ base_ptr tandem::clone() const
 /// Implementation of the objective function.
 void tandem::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
+	double DV[6];
 	if (tof!=-1) { //constrained problem
-		//Here we copy the chromosome into a new vector and we transform its time percentages into days
-		copy_of_x = x;
+		//Here we copy the chromosome into a new array and we transform its time percentages into days
+		double copy_of_x[18];
+		std::copy(x.begin(), x.end(), copy_of_x);
 		copy_of_x[4] = x[4]*365.25*tof;
 		copy_of_x[5] = x[5]*(365.25*tof-copy_of_x[4]);
 		copy_of_x[6] = x[6]*(365.25*tof-copy_of_x[4]-copy_of_x[5]);
 		copy_of_x[7] = x[7]*(365.25*tof-copy_of_x[4]-copy_of_x[5]-copy_of_x[6]);
-		MGA_DSM(copy_of_x, problem, f[0]);
+		MGA_DSM(copy_of_x, problem, f[0], DV, 0);
 	} else {	//unconstrained problem
-		MGA_DSM(x, problem, f[0]);
+		MGA_DSM(&x[0], problem, f[0], DV, 0);
 	}
 	//evaluating the mass from the dvs
 	double rE[3];
@@ -157,7 +160,7 @@ void tandem::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	double sumDVvec=0;
 
 	for(unsigned int i=1;i<=5;i++) {
-		sumDVvec=sumDVvec+problem.DV[i];
+		sumDVvec=sumDVvec+DV[i];
 	}
 	double m_final;
 	sumDVvec=sumDVvec+0.165; //losses for 3 swgbys + insertion
@@ -180,7 +183,7 @@ std::string tandem::pretty(const std::vector<double> &x) const
 	std::vector<double> printablex;
 	if (tof!=-1) { //constrained problem
 		//Here we copy the chromosome into a new vector and we transform its time percentages into days
-		copy_of_x = x;
+		std::vector<double> copy_of_x(x);
 		copy_of_x[4] = x[4]*365.25*tof;
 		copy_of_x[5] = x[5]*(365.25*tof-copy_of_x[4]);
 		copy_of_x[6] = x[6]*(365.25*tof-copy_of_x[4]-copy_of_x[5]);
@@ -258,6 +261,17 @@ std::string tandem::get_name() const
 	return "TandEM";
 }
 
+/// Thread safety of the evaluation methods.
+/**
+ * The chromosome transformation and the DV contributions are kept on the stack.
+ *
+ * \return true.
+ */
+bool tandem::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::tandem)
@@ -84,24 +84,28 @@ class __PAGMO_VISIBLE tandem: public base
 		base_ptr clone() const;
 		std::string pretty(const std::vector<double> &x) const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void set_sparsity(int &, std::vector<int> &, std::vector<int> &) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & problem;
 			ar & const_cast<double &>(tof);
-			ar & copy_of_x;
+			// Version 0 archives also stored the copy of the last decision vector: skip it.
+			if (version < 1) {
+				std::vector<double> copy_of_x;
+				ar & copy_of_x;
+			}
 		}
 		static const int Data[24][5]; // [DS] These two arrays are not serialized as they 
 		static const int sequence[5]; // are declared as static consts
 		mgadsmproblem problem;
 		const double tof;
-		mutable std::vector<double> copy_of_x;
 
 };
 
@@ -109,4 +113,7 @@ class __PAGMO_VISIBLE tandem: public base
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::tandem)
 
+// Version 1: the copy of the last decision vector is no longer archived.
+BOOST_CLASS_VERSION(pagmo::problem::tandem,1)
+
 #endif // PAGMO_PROBLEM_TANDEM_H
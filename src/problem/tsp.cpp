@@ -22,6 +22,8 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "tsp.h"
 #include "../population.h"
 
@@ -32,16 +34,17 @@ namespace pagmo { namespace problem {
      * This constructs a 3-cities symmetric problem (naive TSP) 
      * with weight matrix [[0,1,1][1,0,1][1,1,0]] and RANDOMKEYS encoding
      */
-    tsp::tsp() : base_tsp(3, 0, 0 , base_tsp::RANDOMKEYS), m_weights()
+    tsp::tsp() : base_tsp(3, 0, 0 , base_tsp::RANDOMKEYS), m_weights(), m_symmetric(true)
     {
         std::vector<double> dumb(3,0);
-        m_weights = std::vector<std::vector<double> > (3,dumb);
-        m_weights[0][1] = 1;
-        m_weights[0][2] = 1;
-        m_weights[2][1] = 1;
-        m_weights[1][0] = 1;
-        m_weights[2][0] = 1;
-        m_weights[1][2] = 1;
+        std::vector<std::vector<double> > weights(3,dumb);
+        weights[0][1] = 1;
+        weights[0][2] = 1;
+        weights[2][1] = 1;
+        weights[1][0] = 1;
+        weights[2][0] = 1;
+        weights[1][2] = 1;
+        set_weights(weights);
     }
 
     /// Constructor from weight matrix and encoding
@@ -55,9 +58,10 @@ namespace pagmo { namespace problem {
             compute_dimensions(weights.size(), encoding)[0],
             compute_dimensions(weights.size(), encoding)[1],
             encoding
-        ),  m_weights(weights)
+        ),  m_weights(), m_symmetric(false)
     {
-        check_weights(m_weights);
+        check_weights(weights);
+        set_weights(weights);
     }
 
     /// Clone method.
@@ -95,6 +99,30 @@ namespace pagmo { namespace problem {
         }
     }
 
+    /// Stores the weight matrix contiguously
+    /**
+     * Copies the matrix row by row into m_weights and records whether it is symmetric.
+     * The matrix is assumed to be square with as many rows as cities.
+     *
+     * @param[in] matrix the adjacency matrix (two dimensional std::vector)
+     */
+    void tsp::set_weights(const std::vector<std::vector<double> > &matrix)
+    {
+        const decision_vector::size_type n = get_n_cities();
+        pagmo_assert(matrix.size() == n);
+        m_weights.resize(n * n);
+        m_symmetric = true;
+        for (decision_vector::size_type i = 0; i < n; ++i) {
+            pagmo_assert(matrix[i].size() == n);
+            std::copy(matrix[i].begin(), matrix[i].end(), m_weights.begin() + i * n);
+            for (decision_vector::size_type j = 0; j < i; ++j) {
+                if (matrix[i][j] != matrix[j][i]) {
+                    m_symmetric = false;
+                }
+            }
+        }
+    }
+
     boost::array<int, 2> tsp::compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type encoding)
     {
         boost::array<int,2> retval;
@@ -117,37 +145,28 @@ namespace pagmo { namespace problem {
 
     void tsp::objfun_impl(fitness_vector &f, const decision_vector& x) const 
     {
-        f[0]=0;
-        decision_vector tour;
-        decision_vector::size_type n_cities = get_n_cities();
+        decision_vector tmp;
+        const decision_vector *tour = &x;
         switch( get_encoding() ) {
             case FULL:
-            {
-                tour = full2cities(x);
-                for (decision_vector::size_type i=0; i<n_cities-1; ++i) {
-                    f[0] += m_weights[tour[i]][tour[i+1]];
-                }
-                f[0]+= m_weights[tour[n_cities-1]][tour[0]];
+                tmp = full2cities(x);
+                tour = &tmp;
                 break;
-            }
             case RANDOMKEYS:
-            {
-                tour = randomkeys2cities(x);
-                for (decision_vector::size_type i=0; i<n_cities-1; ++i) {
-                        f[0] += m_weights[tour[i]][tour[i+1]];
-                }
-        	   f[0]+= m_weights[tour[n_cities-1]][tour[0]];
+                tmp = randomkeys2cities(x);
+                tour = &tmp;
                 break;
-	       }
             case CITIES:
-	       {
-    	        for (decision_vector::size_type i=0; i<n_cities-1; ++i) {
-                		f[0] += m_weights[x[i]][x[i+1]];
-            	}
-            	f[0]+= m_weights[x[n_cities-1]][x[0]];
                 break;
-	       }
         }
+        const decision_vector::size_type n_cities = get_n_cities();
+        const double *w = &m_weights[0];
+        const decision_vector &t = *tour;
+        f[0] = 0;
+        for (decision_vector::size_type i=0; i<n_cities-1; ++i) {
+            f[0] += w[static_cast<decision_vector::size_type>(t[i]) * n_cities + static_cast<decision_vector::size_type>(t[i+1])];
+        }
+        f[0] += w[static_cast<decision_vector::size_type>(t[n_cities-1]) * n_cities + static_cast<decision_vector::size_type>(t[0])];
         return;
     }
 
@@ -228,16 +247,52 @@ namespace pagmo { namespace problem {
     /// Definition of distance function
     double tsp::distance(decision_vector::size_type i, decision_vector::size_type j) const
     {
-        return m_weights[i][j];
+        return m_weights[i * get_n_cities() + j];
+    }
+
+    /// Change in tour length caused by an inversion
+    /**
+     * For symmetric weight matrices only the two edges at the ends of the reversed segment
+     * change, and the delta is computed in constant time. Asymmetric matrices fall back to
+     * base_tsp::inversion_delta.
+     *
+     * @see base_tsp::inversion_delta
+     */
+    double tsp::inversion_delta(const decision_vector &tour, decision_vector::size_type i, decision_vector::size_type j) const
+    {
+        if (!m_symmetric) {
+            return base_tsp::inversion_delta(tour, i, j);
+        }
+        const decision_vector::size_type n = get_n_cities();
+        pagmo_assert(tour.size() == n && i <= j && j < n && j - i + 1 < n);
+        const double *w = &m_weights[0];
+        const decision_vector::size_type prev = tour[i == 0 ? n - 1 : i - 1];
+        const decision_vector::size_type next = tour[j == n - 1 ? 0 : j + 1];
+        const decision_vector::size_type first = tour[i], last = tour[j];
+        return w[prev * n + last] + w[first * n + next] - w[prev * n + first] - w[last * n + next];
+    }
+
+    /// The objective function is the length of the closed tour
+    /**
+     * @return true
+     */
+    bool tsp::is_tour_length_objective() const
+    {
+        return true;
     }
 
-    /// Getter for m_weights
+    /// Getter for the weight matrix
     /**
-     * @return reference to m_weights
+     * @return a copy of the weight matrix as a std::vector of std::vector
      */
-    const std::vector<std::vector<double> >&  tsp::get_weights() const
+    std::vector<std::vector<double> > tsp::get_weights() const
     { 
-        return m_weights; 
+        const decision_vector::size_type n = get_n_cities();
+        std::vector<std::vector<double> > retval(n);
+        for (decision_vector::size_type i = 0; i < n; ++i) {
+            retval[i].assign(m_weights.begin() + i * n, m_weights.begin() + (i + 1) * n);
+        }
+        return retval;
     }
 
     /// Returns the problem name
@@ -269,7 +324,7 @@ namespace pagmo { namespace problem {
         oss << "\tWeight Matrix: \n";
         for (decision_vector::size_type i=0; i<get_n_cities() ; ++i)
         {
-            oss << "\t\t" << m_weights[i] << '\n';
+            oss << "\t\t" << std::vector<double>(m_weights.begin() + i * get_n_cities(), m_weights.begin() + (i + 1) * get_n_cities()) << '\n';
             if (i>5)
             {
                 oss << "\t\t..." << '\n';
@@ -39,8 +39,9 @@ namespace pagmo { namespace problem {
  * This is a class representing the classic Travelling Salesman Problem. The problem
  * is that of finding the shortest Hamiltonian path in a weighted, bidirectional graph.
  *
- * The base_tsp::distance is thus defined as the (i,j) element of a matrix represented as
- * a std::vector<std::vector<double> >
+ * The base_tsp::distance is thus defined as the (i,j) element of a matrix, stored row by row in
+ * a contiguous std::vector<double>. As the objective function is the length of the closed tour,
+ * base_tsp::inversion_delta is exact and constant time when the matrix is symmetric.
  *
  * @author Dario Izzo (dario.izzo@gmail.com)
  * @author Annalisa Riccardi
@@ -56,33 +57,50 @@ class __PAGMO_VISIBLE tsp: public base_tsp
         /// Copy constructor for polymorphic objects (deep copy)
         base_ptr clone() const;
 
-        const std::vector<std::vector<double> >& get_weights() const;
+        std::vector<std::vector<double> > get_weights() const;
 
         /** @name Implementation of virtual methods*/
         //@{
         std::string get_name() const;
         std::string human_readable_extra() const;
         double distance(decision_vector::size_type, decision_vector::size_type) const;
+        double inversion_delta(const decision_vector &, decision_vector::size_type, decision_vector::size_type) const;
+        bool is_tour_length_objective() const;
         //@}
 
     private:
         static boost::array<int, 2> compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type);
         void check_weights(const std::vector<std::vector<double> >&) const;
+        void set_weights(const std::vector<std::vector<double> >&);
         size_t compute_idx(const size_t i, const size_t j, const size_t n) const;
 
         void objfun_impl(fitness_vector&, const decision_vector&) const;
         void compute_constraints_impl(constraint_vector&, const decision_vector&) const;
 
         friend class boost::serialization::access;
+        // The archive keeps the nested matrix layout, so that the contiguous storage is an implementation detail.
         template <class Archive>
-        void serialize(Archive &ar, const unsigned int)
+        void save(Archive &ar, const unsigned int) const
         {
-            ar & boost::serialization::base_object<base_tsp>(*this);
-            ar & m_weights;
+            ar << boost::serialization::base_object<base_tsp>(*this);
+            const std::vector<std::vector<double> > weights = get_weights();
+            ar << weights;
         }
+        template <class Archive>
+        void load(Archive &ar, const unsigned int)
+        {
+            ar >> boost::serialization::base_object<base_tsp>(*this);
+            std::vector<std::vector<double> > weights;
+            ar >> weights;
+            set_weights(weights);
+        }
+        BOOST_SERIALIZATION_SPLIT_MEMBER()
 
     private:
-        std::vector<std::vector<double> > m_weights;
+        // Row-major n_cities x n_cities weight matrix.
+        std::vector<double> m_weights;
+        // Whether m_weights is symmetric, computed from the matrix and not serialized.
+        bool m_symmetric;
 };
 
 }}  //namespaces
@@ -120,6 +120,90 @@ class __PAGMO_VISIBLE rng_double: public boost::lagged_fibonacci607 {
 		BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
 
+/// Counter-based rng returning an unsigned integer in the [0,2**32-1] range.
+/**
+ * Implements the Philox4x32-10 bijection of Salmon et al.: the n-th block of four outputs is a keyed
+ * function of the counter (n, substream, stream), hence any stream can be addressed directly without
+ * generating the previous numbers and without an expensive seeding. Streams with different key, stream
+ * or substream values are statistically independent, and the construction of a generator costs as much as
+ * the initialisation of a few integers.
+ *
+ * The class models the Boost uniform random number generator concept, so it can be used with the Boost
+ * distributions (e.g. to draw the k-th noise sample of a given decision vector in a thread-safe way).
+ *
+ * @see Salmon, J. K., Moraes, M. A., Dror, R. O., & Shaw, D. E. (2011). Parallel random numbers: as easy as 1, 2, 3. SC '11.
+ */
+class __PAGMO_VISIBLE rng_counter {
+	public:
+		/// Return value of the generator.
+		typedef boost::uint32_t result_type;
+		/// Constructor from key and stream.
+		/**
+		 * @param[in] key key of the bijection (e.g. the seed of a stochastic problem).
+		 * @param[in] stream identifier of the stream (e.g. the hash of a decision vector).
+		 * @param[in] substream identifier of the substream (e.g. the index of a trial).
+		 */
+		explicit rng_counter(const boost::uint64_t &key = 0, const boost::uint64_t &stream = 0, const boost::uint32_t &substream = 0):m_block(0),m_pos(4)
+		{
+			m_key[0] = static_cast<boost::uint32_t>(key);
+			m_key[1] = static_cast<boost::uint32_t>(key >> 32);
+			m_counter[0] = 0;
+			m_counter[1] = substream;
+			m_counter[2] = static_cast<boost::uint32_t>(stream);
+			m_counter[3] = static_cast<boost::uint32_t>(stream >> 32);
+		}
+		/// Next number of the stream.
+		result_type operator()()
+		{
+			if (m_pos == 4) {
+				m_counter[0] = m_block++;
+				philox(m_counter,m_key,m_buffer);
+				m_pos = 0;
+			}
+			return m_buffer[m_pos++];
+		}
+		/// Smallest value returned.
+		static result_type min()
+		{
+			return 0;
+		}
+		/// Largest value returned.
+		static result_type max()
+		{
+			return 0xFFFFFFFFu;
+		}
+		/// Philox4x32-10 bijection.
+		/**
+		 * @param[in] counter four words of counter.
+		 * @param[in] key two words of key.
+		 * @param[out] out four words of output.
+		 */
+		static void philox(const boost::uint32_t counter[4], const boost::uint32_t key[2], boost::uint32_t out[4])
+		{
+			boost::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3], k0 = key[0], k1 = key[1];
+			for (int r = 0; r < 10; ++r) {
+				const boost::uint64_t p0 = static_cast<boost::uint64_t>(0xD2511F53u) * c0;
+				const boost::uint64_t p1 = static_cast<boost::uint64_t>(0xCD9E8D57u) * c2;
+				c0 = static_cast<boost::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+				c2 = static_cast<boost::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+				c1 = static_cast<boost::uint32_t>(p1);
+				c3 = static_cast<boost::uint32_t>(p0);
+				k0 += 0x9E3779B9u;
+				k1 += 0xBB67AE85u;
+			}
+			out[0] = c0;
+			out[1] = c1;
+			out[2] = c2;
+			out[3] = c3;
+		}
+	private:
+		boost::uint32_t	m_key[2];
+		boost::uint32_t	m_counter[4];
+		boost::uint32_t	m_buffer[4];
+		boost::uint32_t	m_block;
+		unsigned int	m_pos;
+};
+
 /// Generic thread-safe generator of pseudo-random number generators.
 /**
  * To use, call the static member get() to get a pseudo-random number generator seeded with an initial pseudo-random value.
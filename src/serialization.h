@@ -46,7 +46,10 @@
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/version.hpp>
+#include <istream>
 #include <limits>
+#include <ostream>
+#include <streambuf>
 
 // Serialization of circular buffer, unordered map.
 // TODO: serialize the functors.. allocator, Hash, Pred, etc.
@@ -110,6 +113,107 @@ void custom_vector_double_load(Archive &ar, std::vector<double> &v, const unsign
 	}
 }
 
+/// Custom save function for vector of doubles, binary archive overload.
+/**
+ * Binary archives can represent inf and NaN natively, hence the elements are written as raw memory.
+ */
+inline void custom_vector_double_save(boost::archive::binary_oarchive &ar, const std::vector<double> &v, const unsigned int)
+{
+	const std::vector<double>::size_type size = v.size();
+	ar << size;
+	if (size) {
+		ar.save_binary(&v[0],size * sizeof(double));
+	}
+}
+
+/// Custom load function for vector of doubles, binary archive overload.
+inline void custom_vector_double_load(boost::archive::binary_iarchive &ar, std::vector<double> &v, const unsigned int)
+{
+	std::vector<double>::size_type size = 0;
+	ar >> size;
+	v.resize(size);
+	if (size) {
+		ar.load_binary(&v[0],size * sizeof(double));
+	}
+}
+
+/// Stream buffer writing into a std::vector<char>.
+/**
+ * Used to serialize objects directly into a memory buffer, without going through intermediate strings.
+ */
+class vector_char_sink: public std::streambuf
+{
+	public:
+		/// Constructor from buffer.
+		/**
+		 * @param[in] buffer vector to which the output will be appended.
+		 */
+		explicit vector_char_sink(std::vector<char> &buffer):m_buffer(buffer) {}
+	protected:
+		int_type overflow(int_type c)
+		{
+			if (!traits_type::eq_int_type(c,traits_type::eof())) {
+				m_buffer.push_back(traits_type::to_char_type(c));
+			}
+			return traits_type::not_eof(c);
+		}
+		std::streamsize xsputn(const char *s, std::streamsize n)
+		{
+			m_buffer.insert(m_buffer.end(),s,s + n);
+			return n;
+		}
+	private:
+		std::vector<char> &m_buffer;
+};
+
+/// Stream buffer reading from a std::vector<char>.
+class vector_char_source: public std::streambuf
+{
+	public:
+		/// Constructor from buffer.
+		/**
+		 * @param[in] buffer vector from which the input will be read. It must outlive this.
+		 */
+		explicit vector_char_source(const std::vector<char> &buffer)
+		{
+			// NOTE: the get area is never written to.
+			char *begin = buffer.empty() ? 0 : const_cast<char *>(&buffer[0]);
+			setg(begin,begin,begin + buffer.size());
+		}
+};
+
+/// Serialize an object into a binary buffer.
+/**
+ * The content of buffer is replaced with the binary archive of obj. Binary archives are compact and store floating-point
+ * values as raw memory, but they are portable only between machines sharing the same architecture and Boost version.
+ *
+ * @param[out] buffer destination buffer.
+ * @param[in] obj object to be serialized.
+ */
+template <class T>
+inline void binary_save(std::vector<char> &buffer, const T &obj)
+{
+	buffer.clear();
+	vector_char_sink sink(buffer);
+	std::ostream os(&sink);
+	boost::archive::binary_oarchive oa(os);
+	oa << obj;
+}
+
+/// Deserialize an object from a binary buffer.
+/**
+ * @param[in] buffer buffer filled by binary_save().
+ * @param[out] obj object to be deserialized.
+ */
+template <class T>
+inline void binary_load(const std::vector<char> &buffer, T &obj)
+{
+	vector_char_source source(buffer);
+	std::istream is(&source);
+	boost::archive::binary_iarchive ia(is);
+	ia >> obj;
+}
+
 }
 
 namespace boost { namespace serialization {
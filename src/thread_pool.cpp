@@ -0,0 +1,320 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/ref.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/exceptions.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "exceptions.h"
+#include "thread_pool.h"
+
+namespace pagmo
+{
+
+// The state of the task being run by the current worker thread, used to check for interruption
+// from within the task. The pool owns the states, hence no cleanup is needed.
+boost::thread_specific_ptr<thread_pool::task_state> thread_pool::m_current(&thread_pool::no_cleanup);
+
+void thread_pool::no_cleanup(task_state *)
+{}
+
+boost::once_flag thread_pool::m_shared_flag = BOOST_ONCE_INIT;
+thread_pool *thread_pool::m_shared = 0;
+
+void thread_pool::init_shared()
+{
+	// NOTE: the pool is never destroyed, so that it can be used until the very end of the program.
+	m_shared = new thread_pool(0);
+}
+
+/// Default constructor.
+/**
+ * Construct a handle that does not refer to any task.
+ */
+thread_pool::task::task():m_state()
+{}
+
+thread_pool::task::task(const boost::shared_ptr<task_state> &state):m_state(state)
+{}
+
+/// Wait for the task to complete.
+/**
+ * Will block until the task has been executed by the pool. No-op if the handle does not refer to any task.
+ */
+void thread_pool::task::wait() const
+{
+	if (!m_state) {
+		return;
+	}
+	boost::unique_lock<boost::mutex> lock(m_state->m_mutex);
+	while (!m_state->m_done) {
+		m_state->m_cond.wait(lock);
+	}
+}
+
+/// Query the status of the task.
+/**
+ * @return true if the task has been executed or if the handle does not refer to any task, false otherwise.
+ */
+bool thread_pool::task::done() const
+{
+	if (!m_state) {
+		return true;
+	}
+	boost::lock_guard<boost::mutex> lock(m_state->m_mutex);
+	return m_state->m_done;
+}
+
+/// Request the interruption of the task.
+/**
+ * If the task has not started yet, it will be discarded. Otherwise, the task will be interrupted the first time it calls
+ * thread_pool::interruption_point(). This method does not wait for the task to terminate.
+ */
+void thread_pool::task::interrupt()
+{
+	if (!m_state) {
+		return;
+	}
+	boost::lock_guard<boost::mutex> lock(m_state->m_mutex);
+	m_state->m_interrupted = true;
+}
+
+/// Constructor from number of workers.
+/**
+ * Will start n worker threads. If n is zero, the number of worker threads will be the number of hardware threads available
+ * on the machine (or one, if such number cannot be determined).
+ *
+ * @param[in] n number of worker threads.
+ *
+ * @throws std::runtime_error if the worker threads cannot be launched.
+ */
+thread_pool::thread_pool(unsigned int n):m_workers(),m_size(n),m_queue(),m_mutex(),m_cond(),m_stop(false)
+{
+	if (!m_size) {
+		m_size = boost::thread::hardware_concurrency();
+		if (!m_size) {
+			m_size = 1;
+		}
+	}
+	try {
+		for (unsigned int i = 0; i < m_size; ++i) {
+			m_workers.create_thread(boost::bind(&thread_pool::worker,this));
+		}
+	} catch (...) {
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_cond.notify_all();
+		m_workers.join_all();
+		pagmo_throw(std::runtime_error,"failed to launch the thread pool workers");
+	}
+}
+
+/// Destructor.
+/**
+ * Will wait for all the queued tasks to be executed before joining the worker threads.
+ */
+thread_pool::~thread_pool()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cond.notify_all();
+	m_workers.join_all();
+}
+
+/// Number of worker threads.
+/**
+ * @return the number of worker threads in the pool.
+ */
+unsigned int thread_pool::get_size() const
+{
+	return m_size;
+}
+
+/// Submit a task.
+/**
+ * The callable object f will be copied into the queue and executed by the first available worker thread. Any exception
+ * thrown by f will be swallowed by the worker thread: callers interested in errors must handle them within f.
+ *
+ * @param[in] f callable object to be executed.
+ *
+ * @return handle to the submitted task.
+ */
+thread_pool::task thread_pool::submit(const boost::function<void ()> &f)
+{
+	const boost::shared_ptr<task_state> state(new task_state());
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		m_queue.push_back(item_type(f,state));
+	}
+	m_cond.notify_one();
+	return task(state);
+}
+
+/// Run a batch of tasks and wait for their completion.
+/**
+ * The first task is run in the calling thread, the others are submitted to the pool. The method returns when all the tasks
+ * have been executed. Contrary to submit(), exceptions are not swallowed: if any task throws, the exception of the first
+ * failing task (in the order of the input vector) is rethrown in the calling thread once all the tasks have completed.
+ *
+ * If called from one of the worker threads of the pool (i.e., from within a task), the tasks are run sequentially in the
+ * calling thread, as waiting for tasks queued behind the caller could otherwise deadlock the pool.
+ *
+ * @param[in] tasks callable objects to be executed.
+ */
+void thread_pool::run_all(const std::vector<boost::function<void ()> > &tasks)
+{
+	if (tasks.empty()) {
+		return;
+	}
+	if (m_workers.is_this_thread_in()) {
+		for (std::vector<boost::function<void ()> >::size_type i = 0; i < tasks.size(); ++i) {
+			tasks[i]();
+		}
+		return;
+	}
+	std::vector<boost::exception_ptr> errors(tasks.size());
+	std::vector<task> handles;
+	for (std::vector<boost::function<void ()> >::size_type i = 1; i < tasks.size(); ++i) {
+		handles.push_back(submit(boost::bind(&thread_pool::run_task,tasks[i],boost::ref(errors[i]))));
+	}
+	run_task(tasks[0],errors[0]);
+	for (std::vector<task>::size_type i = 0; i < handles.size(); ++i) {
+		handles[i].wait();
+	}
+	for (std::vector<boost::exception_ptr>::size_type i = 0; i < errors.size(); ++i) {
+		if (errors[i]) {
+			boost::rethrow_exception(errors[i]);
+		}
+	}
+}
+
+/// Pool shared by the parallel kernels of the library.
+/**
+ * The pool has as many workers as hardware threads, and it is created upon the first call. Since run_all() executes
+ * serially the batches submitted from within its own workers, nested parallel kernels (e.g., stochastic trials within a
+ * batch evaluation) do not oversubscribe the machine.
+ *
+ * @return reference to the shared pool.
+ */
+thread_pool &thread_pool::shared()
+{
+	boost::call_once(&thread_pool::init_shared,m_shared_flag);
+	return *m_shared;
+}
+
+// Run a task, storing its exception (if any) so that it can be rethrown by the caller.
+void thread_pool::run_task(const boost::function<void ()> &f, boost::exception_ptr &error)
+{
+	try {
+		f();
+	} catch (...) {
+		error = boost::current_exception();
+	}
+}
+
+/// Interruption point.
+/**
+ * If called from within a task run by a thread_pool, it will throw boost::thread_interrupted if the interruption of the task
+ * has been requested via thread_pool::task::interrupt(). Otherwise, it will behave like boost::this_thread::interruption_point().
+ *
+ * @throws boost::thread_interrupted if interruption was requested.
+ */
+void thread_pool::interruption_point()
+{
+	task_state *state = m_current.get();
+	if (state) {
+		bool interrupted;
+		{
+			boost::lock_guard<boost::mutex> lock(state->m_mutex);
+			interrupted = state->m_interrupted;
+		}
+		if (interrupted) {
+			throw boost::thread_interrupted();
+		}
+	} else {
+		boost::this_thread::interruption_point();
+	}
+}
+
+// Worker threads main loop.
+void thread_pool::worker()
+{
+	while (true) {
+		item_type item;
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while (!m_stop && m_queue.empty()) {
+				m_cond.wait(lock);
+			}
+			// Drain the queue before exiting.
+			if (m_queue.empty()) {
+				return;
+			}
+			item = m_queue.front();
+			m_queue.pop_front();
+		}
+		bool interrupted;
+		{
+			boost::lock_guard<boost::mutex> lock(item.second->m_mutex);
+			interrupted = item.second->m_interrupted;
+		}
+		if (!interrupted) {
+			m_current.reset(item.second.get());
+			try {
+				item.first();
+			} catch (...) {
+				// Tasks are supposed to handle their own errors.
+			}
+			m_current.reset();
+		}
+		mark_done(*item.second);
+	}
+}
+
+// Flag a task as completed and wake up the waiters.
+void thread_pool::mark_done(task_state &state)
+{
+	{
+		boost::lock_guard<boost::mutex> lock(state.m_mutex);
+		state.m_done = true;
+	}
+	state.m_cond.notify_all();
+}
+
+}
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_THREAD_POOL_H
+#define PAGMO_THREAD_POOL_H
+
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/once.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/utility.hpp>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+
+namespace pagmo
+{
+
+/// Fixed-size pool of worker threads.
+/**
+ * The pool starts a fixed number of worker threads upon construction, and keeps them alive until destruction. Tasks submitted
+ * via submit() are queued and executed in FIFO order by the first available worker. Each submission returns a thread_pool::task handle
+ * that can be used to wait for the completion of the task, to query its status and to request its interruption.
+ *
+ * The pool is used by pagmo::archipelago to run island evolutions without spawning a new thread per island and per evolution.
+ * The parallel kernels of the library (batch evaluations, stochastic trials, racing, hypervolumes) share instead a single
+ * pool, see shared().
+ *
+ * Upon destruction, the pool will wait for all the queued tasks to be completed.
+ */
+class __PAGMO_VISIBLE thread_pool: private boost::noncopyable
+{
+		// Shared state of a task.
+		struct task_state
+		{
+			task_state():m_done(false),m_interrupted(false) {}
+			boost::mutex			m_mutex;
+			boost::condition_variable	m_cond;
+			bool				m_done;
+			bool				m_interrupted;
+		};
+		// Queue item: callable object and its state.
+		typedef std::pair<boost::function<void ()>,boost::shared_ptr<task_state> > item_type;
+	public:
+		/// Handle to a task submitted to the pool.
+		/**
+		 * Copies of a handle refer to the same task. A default-constructed handle does not refer to any task, and it behaves
+		 * as a handle to a completed task.
+		 */
+		class __PAGMO_VISIBLE task
+		{
+				friend class thread_pool;
+			public:
+				task();
+				void wait() const;
+				bool done() const;
+				void interrupt();
+			private:
+				explicit task(const boost::shared_ptr<task_state> &);
+				boost::shared_ptr<task_state>	m_state;
+		};
+		explicit thread_pool(unsigned int = 0);
+		~thread_pool();
+		unsigned int get_size() const;
+		task submit(const boost::function<void ()> &);
+		void run_all(const std::vector<boost::function<void ()> > &);
+		static thread_pool &shared();
+		static void interruption_point();
+	private:
+		void worker();
+		static void run_task(const boost::function<void ()> &, boost::exception_ptr &);
+		static void mark_done(task_state &);
+		static void no_cleanup(task_state *);
+		static void init_shared();
+
+		boost::thread_group		m_workers;
+		unsigned int			m_size;
+		std::deque<item_type>		m_queue;
+		boost::mutex			m_mutex;
+		boost::condition_variable	m_cond;
+		bool				m_stop;
+		static boost::thread_specific_ptr<task_state>	m_current;
+		static boost::once_flag				m_shared_flag;
+		static thread_pool				*m_shared;
+};
+
+}
+
+#endif
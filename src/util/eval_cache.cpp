@@ -0,0 +1,269 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "eval_cache.h"
+
+namespace pagmo { namespace util {
+
+// Reduce a decision vector component to the value actually used for hashing and comparison.
+static inline double quantize(const double &x, const double &q)
+{
+	return (q > 0) ? std::floor(x / q + .5) : x;
+}
+
+// Bit pattern of a double.
+static inline boost::uint64_t double_bits(const double &x)
+{
+	boost::uint64_t retval;
+	std::memcpy(&retval,&x,sizeof(double));
+	return retval;
+}
+
+std::size_t eval_cache::hasher::operator()(const decision_vector *x) const
+{
+	std::size_t seed = 0;
+	for (decision_vector::size_type i = 0; i < x->size(); ++i) {
+		boost::hash_combine(seed,double_bits(quantize((*x)[i],m_quantum)));
+	}
+	return seed;
+}
+
+bool eval_cache::key_equal::operator()(const decision_vector *x1, const decision_vector *x2) const
+{
+	if (x1->size() != x2->size()) {
+		return false;
+	}
+	for (decision_vector::size_type i = 0; i < x1->size(); ++i) {
+		if (double_bits(quantize((*x1)[i],m_quantum)) != double_bits(quantize((*x2)[i],m_quantum))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Constructor from capacity and quantum.
+/**
+ * @param[in] capacity maximum number of entries stored in the cache.
+ * @param[in] quantum quantization step used when hashing and comparing decision vectors (0 for bitwise comparison).
+ *
+ * @throws value_error if quantum is negative or NaN.
+ */
+eval_cache::eval_cache(size_type capacity, const double &quantum):
+	m_list(),m_index(0,hasher(quantum),key_equal(quantum)),m_capacity(capacity),m_quantum(quantum),m_hits(0),m_misses(0)
+{
+	if (boost::math::isnan(quantum) || quantum < 0) {
+		pagmo_throw(value_error,"the cache quantum must be non-negative");
+	}
+}
+
+/// Copy constructor.
+/**
+ * The index is rebuilt so that it points to the entries of the new object.
+ *
+ * @param[in] other cache to be copied.
+ */
+eval_cache::eval_cache(const eval_cache &other):
+	m_list(other.m_list),m_index(0,hasher(other.m_quantum),key_equal(other.m_quantum)),m_capacity(other.m_capacity),
+	m_quantum(other.m_quantum),m_hits(other.m_hits),m_misses(other.m_misses)
+{
+	rebuild_index();
+}
+
+/// Assignment operator.
+/**
+ * @param[in] other cache to be assigned to this.
+ *
+ * @return reference to this.
+ */
+eval_cache &eval_cache::operator=(const eval_cache &other)
+{
+	if (this != &other) {
+		m_list = other.m_list;
+		m_capacity = other.m_capacity;
+		m_quantum = other.m_quantum;
+		m_hits = other.m_hits;
+		m_misses = other.m_misses;
+		rebuild_index();
+	}
+	return *this;
+}
+
+/// Look up a decision vector.
+/**
+ * If x is in the cache, its associated value is copied into retval, the entry becomes the most recently used one and true is returned.
+ * Otherwise retval is left untouched and false is returned. The hit/miss counters are updated accordingly.
+ *
+ * @param[out] retval vector into which the cached value will be written.
+ * @param[in] x decision vector to be looked up.
+ *
+ * @return true if x was found in the cache, false otherwise.
+ */
+bool eval_cache::get(std::vector<double> &retval, const decision_vector &x)
+{
+	const index_type::iterator it = m_index.find(&x);
+	if (it == m_index.end()) {
+		++m_misses;
+		return false;
+	}
+	++m_hits;
+	// Move the entry to the front of the list. Iterators (and hence the keys of the index) stay valid.
+	m_list.splice(m_list.begin(),m_list,it->second);
+	retval = it->second->second;
+	return true;
+}
+
+/// Insert a decision vector and its associated value.
+/**
+ * The new entry becomes the most recently used one. If x is already present its value is replaced, otherwise
+ * the least recently used entry is evicted if the cache is full.
+ *
+ * @param[in] x decision vector.
+ * @param[in] v value associated to x.
+ */
+void eval_cache::put(const decision_vector &x, const std::vector<double> &v)
+{
+	if (!m_capacity) {
+		return;
+	}
+	const index_type::iterator it = m_index.find(&x);
+	if (it != m_index.end()) {
+		it->second->second = v;
+		m_list.splice(m_list.begin(),m_list,it->second);
+		return;
+	}
+	if (m_list.size() == m_capacity) {
+		m_index.erase(&m_list.back().first);
+		m_list.pop_back();
+	}
+	m_list.push_front(entry_type(x,v));
+	m_index[&m_list.front().first] = m_list.begin();
+}
+
+/// Remove all entries.
+/**
+ * The hit/miss counters are not reset.
+ */
+void eval_cache::clear()
+{
+	m_list.clear();
+	m_index = index_type(0,hasher(m_quantum),key_equal(m_quantum));
+}
+
+/// Number of entries.
+/**
+ * @return the number of entries currently stored in the cache.
+ */
+eval_cache::size_type eval_cache::size() const
+{
+	return m_list.size();
+}
+
+/// Get capacity.
+/**
+ * @return the maximum number of entries stored in the cache.
+ */
+eval_cache::size_type eval_cache::get_capacity() const
+{
+	return m_capacity;
+}
+
+/// Set capacity.
+/**
+ * If the new capacity is smaller than the current size, the least recently used entries are evicted.
+ *
+ * @param[in] capacity new capacity.
+ */
+void eval_cache::set_capacity(size_type capacity)
+{
+	while (m_list.size() > capacity) {
+		m_index.erase(&m_list.back().first);
+		m_list.pop_back();
+	}
+	m_capacity = capacity;
+}
+
+/// Get quantum.
+/**
+ * @return the quantization step used when hashing and comparing decision vectors.
+ */
+double eval_cache::get_quantum() const
+{
+	return m_quantum;
+}
+
+/// Set quantum.
+/**
+ * Changing the quantum changes which decision vectors are considered equal, hence the cache is cleared.
+ *
+ * @param[in] quantum new quantization step (0 for bitwise comparison).
+ *
+ * @throws value_error if quantum is negative or NaN.
+ */
+void eval_cache::set_quantum(const double &quantum)
+{
+	if (boost::math::isnan(quantum) || quantum < 0) {
+		pagmo_throw(value_error,"the cache quantum must be non-negative");
+	}
+	m_quantum = quantum;
+	clear();
+}
+
+/// Number of cache hits.
+/**
+ * @return the number of successful lookups performed via get().
+ */
+unsigned int eval_cache::get_hits() const
+{
+	return m_hits;
+}
+
+/// Number of cache misses.
+/**
+ * @return the number of failed lookups performed via get().
+ */
+unsigned int eval_cache::get_misses() const
+{
+	return m_misses;
+}
+
+// Rebuild the index from the content of the list.
+void eval_cache::rebuild_index()
+{
+	m_index = index_type(m_list.size(),hasher(m_quantum),key_equal(m_quantum));
+	for (list_type::iterator it = m_list.begin(); it != m_list.end(); ++it) {
+		m_index[&it->first] = it;
+	}
+}
+
+}}
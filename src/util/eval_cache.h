@@ -0,0 +1,139 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_EVAL_CACHE_H
+#define PAGMO_UTIL_EVAL_CACHE_H
+
+#include <boost/unordered_map.hpp>
+#include <cstddef>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "../config.h"
+#include "../serialization.h"
+#include "../types.h"
+
+namespace pagmo { namespace util {
+
+/// Least-recently-used cache of evaluated decision vectors.
+/**
+ * This class associates decision vectors to the vectors (fitness or constraints) computed from them, and it is used
+ * by problem::base to avoid re-evaluating the same chromosome twice. Lookups are performed in constant time through a hash
+ * table indexing a list ordered from the most recently used entry to the least recently used one. When the cache is full,
+ * inserting a new entry evicts the least recently used one.
+ *
+ * Decision vectors are hashed and compared bitwise. Optionally a quantum q > 0 can be set: in this case two decision vectors
+ * are considered equal if all their components round to the same multiple of q.
+ *
+ * A capacity of zero disables the cache.
+ */
+class __PAGMO_VISIBLE eval_cache
+{
+		// Cache entry: decision vector and associated value.
+		typedef std::pair<decision_vector,std::vector<double> > entry_type;
+		// Entries, ordered from most to least recently used.
+		typedef std::list<entry_type> list_type;
+		// Hash functor for the index.
+		struct hasher
+		{
+			explicit hasher(const double &q = 0):m_quantum(q) {}
+			std::size_t operator()(const decision_vector *) const;
+			double m_quantum;
+		};
+		// Equality functor for the index.
+		struct key_equal
+		{
+			explicit key_equal(const double &q = 0):m_quantum(q) {}
+			bool operator()(const decision_vector *, const decision_vector *) const;
+			double m_quantum;
+		};
+		// The keys of the index point to the decision vectors stored in the list.
+		typedef boost::unordered_map<const decision_vector *,list_type::iterator,hasher,key_equal> index_type;
+	public:
+		/// Size type.
+		typedef list_type::size_type size_type;
+		explicit eval_cache(size_type = 0, const double & = 0);
+		eval_cache(const eval_cache &);
+		eval_cache &operator=(const eval_cache &);
+		bool get(std::vector<double> &, const decision_vector &);
+		void put(const decision_vector &, const std::vector<double> &);
+		void clear();
+		size_type size() const;
+		size_type get_capacity() const;
+		void set_capacity(size_type);
+		double get_quantum() const;
+		void set_quantum(const double &);
+		unsigned int get_hits() const;
+		unsigned int get_misses() const;
+	private:
+		void rebuild_index();
+		friend class boost::serialization::access;
+		template <class Archive>
+		void save(Archive &ar, const unsigned int version) const
+		{
+			ar << m_capacity;
+			ar << m_quantum;
+			ar << m_hits;
+			ar << m_misses;
+			const size_type size = m_list.size();
+			ar << size;
+			// Save from the least to the most recently used entry, so that loading via put() restores the ordering.
+			for (list_type::const_reverse_iterator it = m_list.rbegin(); it != m_list.rend(); ++it) {
+				custom_vector_double_save(ar,it->first,version);
+				custom_vector_double_save(ar,it->second,version);
+			}
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int version)
+		{
+			ar >> m_capacity;
+			ar >> m_quantum;
+			ar >> m_hits;
+			ar >> m_misses;
+			clear();
+			size_type size;
+			ar >> size;
+			decision_vector x;
+			std::vector<double> v;
+			for (size_type i = 0; i < size; ++i) {
+				custom_vector_double_load(ar,x,version);
+				custom_vector_double_load(ar,v,version);
+				put(x,v);
+			}
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+		list_type	m_list;
+		index_type	m_index;
+		size_type	m_capacity;
+		double		m_quantum;
+		unsigned int	m_hits;
+		unsigned int	m_misses;
+};
+
+}}
+
+#endif
@@ -0,0 +1,486 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include "adaptive.h"
+#include <algorithm>
+#include <boost/thread/thread_time.hpp>
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+namespace {
+
+// Rough calibration of the cost models: units of hypervolume::get_expected_operations per second
+// (measured against the exact algorithms on the test data), and coordinate comparisons per second while sampling.
+const double exact_ops_per_second = 1e7;
+const double sampling_cmps_per_second = 1e8;
+
+// Number of samples between two checks of the time limit.
+const unsigned int time_check_batch = 256;
+
+// Deadline corresponding to the time limit.
+boost::system_time get_deadline(const double max_time)
+{
+	return boost::get_system_time() + boost::posix_time::microseconds(static_cast<boost::int64_t>(max_time * 1e6));
+}
+
+// Number of the 'n_dom' points stored contiguously in 'dom' (with stride dim) dominating the point x.
+// The inner loop is branch-free, so that it can be vectorised by the compiler.
+unsigned int count_dominating(const double *dom, const unsigned int n_dom, const double *x, const unsigned int dim)
+{
+	unsigned int count = 0;
+	for (unsigned int j = 0; j < n_dom; ++j) {
+		const double *q = dom + j * dim;
+		unsigned int dominates = 1u;
+		for (unsigned int k = 0; k < dim; ++k) {
+			dominates &= static_cast<unsigned int>(q[k] <= x[k]);
+		}
+		count += dominates;
+	}
+	return count;
+}
+
+// Sample n_samples points uniformly in the box [a, b), return the number of them not dominated by any of the points in dom.
+unsigned long long sample_box(const fitness_vector &a, const fitness_vector &b, const std::vector<double> &dom, const unsigned long long n_samples,
+	rng_double &drng, fitness_vector &x)
+{
+	const unsigned int dim = a.size();
+	const unsigned int n_dom = dom.size() / dim;
+	unsigned long long n_succ = 0;
+	for (unsigned long long s = 0; s < n_samples; ++s) {
+		for (unsigned int k = 0; k < dim; ++k) {
+			x[k] = a[k] + drng() * (b[k] - a[k]);
+		}
+		n_succ += (n_dom == 0 || count_dominating(&dom[0], n_dom, &x[0], dim) == 0);
+	}
+	return n_succ;
+}
+
+}
+
+/// Constructor
+/**
+ * Constructs an instance of the algorithm
+ *
+ * @param[in] eps accuracy of the approximation
+ * @param[in] delta probability of the approximation exceeding the accuracy
+ * @param[in] max_time time limit (in seconds) for each call, 0 for the accuracy budget
+ *
+ * @throws value_error if eps or delta are not in (0, 1), or if max_time is negative
+ */
+adaptive::adaptive(const double eps, const double delta, const double max_time) : m_eps(eps), m_delta(delta), m_max_time(max_time)
+{
+	if (eps <= 0. || eps >= 1.) {
+		pagmo_throw(value_error, "Accuracy of the approximation must be in (0, 1)");
+	}
+	if (delta <= 0. || delta >= 1.) {
+		pagmo_throw(value_error, "Probability of error of the approximation must be in (0, 1)");
+	}
+	if (max_time < 0.) {
+		pagmo_throw(value_error, "Time limit cannot be negative");
+	}
+}
+
+/// Verify before compute
+/**
+ * Verifies whether given algorithm suits the requested data.
+ *
+ * @param[in] points vector of points containing the d dimensional points for which we compute the hypervolume
+ * @param[in] r_point reference point for the vector of points
+ *
+ * @throws value_error when trying to compute the hypervolume for the non-maximal reference point
+ */
+void adaptive::verify_before_compute(const std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+{
+	base::assert_minimisation(points, r_point);
+}
+
+// Choose between the exact computation and the approximation, given their predicted times.
+bool adaptive::use_exact(const double exact_time, const double approx_time) const
+{
+	if (m_max_time > 0.) {
+		return exact_time <= m_max_time;
+	}
+	return exact_time <= approx_time;
+}
+
+/// Compute method
+/**
+ * Computes the hypervolume exactly, or approximates it with the Karp-Luby estimator.
+ *
+ * @param[in] points vector of fitness_vectors for which the hypervolume is computed
+ * @param[in] r_point distinguished "reference point".
+ *
+ * @return hypervolume
+ */
+double adaptive::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+{
+	report rep;
+	return compute(points, r_point, rep);
+}
+
+/// Compute method with diagnostics
+/**
+ * As compute(std::vector<fitness_vector> &, const fitness_vector &), also reporting how the result was obtained.
+ *
+ * @param[in] points vector of fitness_vectors for which the hypervolume is computed
+ * @param[in] r_point distinguished "reference point".
+ * @param[out] rep whether the result is exact, and the half-width of its confidence interval
+ *
+ * @return hypervolume
+ */
+double adaptive::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point, report &rep) const
+{
+	const double n = points.size();
+	const double dim = r_point.size();
+	// Number of domination tests of the FPRAS (see bf_fpras::compute).
+	const double approx_tests = 12. * std::log(1. / m_delta) / std::log(2.) * n / m_eps / m_eps;
+	if (use_exact(hypervolume::get_expected_operations(points.size(), r_point.size()) / exact_ops_per_second, approx_tests * dim / sampling_cmps_per_second)) {
+		rep.exact = true;
+		rep.errors.assign(1, 0.0);
+		hypervolume hv(points, false);
+		hv.set_copy_points(false);
+		return hv.compute(r_point);
+	}
+	rep.exact = false;
+	return approx_compute(points, r_point, rep);
+}
+
+/// Exclusive method
+/**
+ * Computes the exclusive contribution exactly, or approximates it by sampling its bounding box.
+ *
+ * @param[in] p_idx index of the point
+ * @param[in] points vector of fitness_vectors for which the hypervolume is computed
+ * @param[in] r_point distinguished "reference point".
+ *
+ * @return exclusive contribution of the point
+ */
+double adaptive::exclusive(const unsigned int p_idx, std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+{
+	report rep;
+	return exclusive(p_idx, points, r_point, rep);
+}
+
+/// Exclusive method with diagnostics
+/**
+ * As exclusive(const unsigned int, std::vector<fitness_vector> &, const fitness_vector &), also reporting how the result was obtained.
+ *
+ * @param[in] p_idx index of the point
+ * @param[in] points vector of fitness_vectors for which the hypervolume is computed
+ * @param[in] r_point distinguished "reference point".
+ * @param[out] rep whether the result is exact, and the half-width of its confidence interval
+ *
+ * @return exclusive contribution of the point
+ */
+double adaptive::exclusive(const unsigned int p_idx, std::vector<fitness_vector> &points, const fitness_vector &r_point, report &rep) const
+{
+	const double n = points.size();
+	const double dim = r_point.size();
+	const double approx_samples = std::log(2. / m_delta) / (2. * m_eps * m_eps);
+	if (use_exact(2. * hypervolume::get_expected_operations(points.size(), r_point.size()) / exact_ops_per_second, approx_samples * n * dim / sampling_cmps_per_second)) {
+		rep.exact = true;
+		rep.errors.assign(1, 0.0);
+		hypervolume hv(points, false);
+		hv.set_copy_points(false);
+		return hv.exclusive(p_idx, r_point);
+	}
+	rep.exact = false;
+	return approx_contributions(points, r_point, std::vector<unsigned int>(1, p_idx), rep)[0];
+}
+
+/// Contributions method
+/**
+ * Computes the exclusive contributions exactly, or approximates them by sampling their bounding boxes.
+ *
+ * @param[in] points vector of fitness_vectors for which the contributions are computed
+ * @param[in] r_point distinguished "reference point".
+ *
+ * @return vector of exclusive contributions by every point
+ */
+std::vector<double> adaptive::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+{
+	report rep;
+	return contributions(points, r_point, rep);
+}
+
+/// Contributions method with diagnostics
+/**
+ * As contributions(std::vector<fitness_vector> &, const fitness_vector &), also reporting how the result was obtained.
+ *
+ * @param[in] points vector of fitness_vectors for which the contributions are computed
+ * @param[in] r_point distinguished "reference point".
+ * @param[out] rep whether the results are exact, and the half-widths of their confidence intervals
+ *
+ * @return vector of exclusive contributions by every point
+ */
+std::vector<double> adaptive::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point, report &rep) const
+{
+	const double n = points.size();
+	const double dim = r_point.size();
+	const double approx_samples = std::log(2. * n / m_delta) / (2. * m_eps * m_eps);
+	// The exact contributions cost about n hypervolumes of dimension d - 1.
+	const double exact_ops = (r_point.size() <= 3) ? hypervolume::get_expected_operations(points.size(), r_point.size()) :
+		n * hypervolume::get_expected_operations(points.size(), r_point.size() - 1);
+	if (use_exact(exact_ops / exact_ops_per_second, n * approx_samples * n * dim / sampling_cmps_per_second)) {
+		rep.exact = true;
+		rep.errors.assign(points.size(), 0.0);
+		hypervolume hv(points, false);
+		hv.set_copy_points(false);
+		return hv.contributions(r_point);
+	}
+	rep.exact = false;
+	std::vector<unsigned int> indices(points.size());
+	for (unsigned int i = 0; i < indices.size(); ++i) {
+		indices[i] = i;
+	}
+	return approx_contributions(points, r_point, indices, rep);
+}
+
+/// Least contributor method with diagnostics
+/**
+ * As base::least_contributor, also reporting how the result was obtained.
+ *
+ * @param[in] points vector of fitness_vectors for which the least contributor is found
+ * @param[in] r_point distinguished "reference point".
+ * @param[out] rep whether the result is exact, and the half-widths of the confidence intervals of the contributions it was chosen from, if any
+ *
+ * @return index of the least contributor
+ */
+unsigned int adaptive::least_contributor(std::vector<fitness_vector> &points, const fitness_vector &r_point, report &rep) const
+{
+	return extreme_contributor(points, r_point, base::cmp_least, rep);
+}
+
+/// Greatest contributor method with diagnostics
+/**
+ * As base::greatest_contributor, also reporting how the result was obtained.
+ *
+ * @param[in] points vector of fitness_vectors for which the greatest contributor is found
+ * @param[in] r_point distinguished "reference point".
+ * @param[out] rep whether the result is exact, and the half-widths of the confidence intervals of the contributions it was chosen from, if any
+ *
+ * @return index of the greatest contributor
+ */
+unsigned int adaptive::greatest_contributor(std::vector<fitness_vector> &points, const fitness_vector &r_point, report &rep) const
+{
+	return extreme_contributor(points, r_point, base::cmp_greatest, rep);
+}
+
+// Extreme contributor, as used by base::least_contributor and base::greatest_contributor.
+unsigned int adaptive::extreme_contributor(std::vector<fitness_vector> &points, const fitness_vector &r_point, bool (*cmp_func)(double, double)) const
+{
+	report rep;
+	return extreme_contributor(points, r_point, cmp_func, rep);
+}
+
+// Extreme contributor: exact, bf_approx under an accuracy budget, extreme of the approximated contributions under a time budget.
+unsigned int adaptive::extreme_contributor(std::vector<fitness_vector> &points, const fitness_vector &r_point, bool (*cmp_func)(double, double), report &rep) const
+{
+	if (points.size() == 1) {
+		rep.exact = true;
+		rep.errors.clear();
+		return 0;
+	}
+	if (m_max_time > 0.) {
+		// The time limit decides between the exact and the approximated contributions.
+		const std::vector<double> c = contributions(points, r_point, rep);
+		return std::min_element(c.begin(), c.end(), cmp_func) - c.begin();
+	}
+	const double n = points.size();
+	const double dim = r_point.size();
+	const double exact_ops = (r_point.size() <= 3) ? hypervolume::get_expected_operations(points.size(), r_point.size()) :
+		n * hypervolume::get_expected_operations(points.size(), r_point.size() - 1);
+	// bf_approx samples the bounding boxes only until the extreme contributor is told apart from the others,
+	// as a (pessimistic) estimate its cost is taken as that of the approximated contributions.
+	const double approx_samples = std::log(2. * n / m_delta) / (2. * m_eps * m_eps);
+	hypervolume hv(points, false);
+	hv.set_copy_points(false);
+	rep.errors.clear();
+	if (use_exact(exact_ops / exact_ops_per_second, n * approx_samples * n * dim / sampling_cmps_per_second)) {
+		rep.exact = true;
+		return (cmp_func == base::cmp_least) ? hv.least_contributor(r_point) : hv.greatest_contributor(r_point);
+	}
+	rep.exact = false;
+	const base_ptr bf(new bf_approx(true, 1, m_eps, m_delta));
+	return (cmp_func == base::cmp_least) ? hv.least_contributor(r_point, bf) : hv.greatest_contributor(r_point, bf);
+}
+
+// Karp-Luby estimator of the volume of the union of the boxes [points[i], r_point]: a box is chosen with probability proportional to its volume,
+// a point x is sampled uniformly in it, and 1 / (number of boxes containing x) is averaged. The average lies in [1 / n, 1], times the total volume
+// of the boxes it is an unbiased estimator of the hypervolume, and Hoeffding's inequality bounds its error.
+double adaptive::approx_compute(const std::vector<fitness_vector> &points, const fitness_vector &r_point, report &rep) const
+{
+	const unsigned int n = points.size();
+	const unsigned int dim = r_point.size();
+	// Per-call generator, so that concurrent calls do not share state.
+	rng_double drng(rng_generator::get<rng_double>());
+
+	// Points stored contiguously, and partial sums of the volumes of the boxes.
+	std::vector<double> flat(n * dim);
+	std::vector<double> sums(n);
+	double V = 0.0;
+	for (unsigned int i = 0; i < n; ++i) {
+		std::copy(points[i].begin(), points[i].end(), flat.begin() + i * dim);
+		V = (sums[i] = V + base::volume_between(points[i], r_point));
+	}
+
+	const boost::system_time deadline = get_deadline(m_max_time);
+	fitness_vector x(dim);
+	unsigned long long n_samples = 0;
+	unsigned long long batch = time_check_batch;
+	unsigned int n_checks = 0;
+	double sum = 0.0;
+	double h = 0.0;
+	while (true) {
+		for (unsigned long long s = 0; s < batch; ++s) {
+			const unsigned int i = std::min<unsigned int>(std::lower_bound(sums.begin(), sums.end(), drng() * V) - sums.begin(), n - 1);
+			for (unsigned int k = 0; k < dim; ++k) {
+				x[k] = points[i][k] + drng() * (r_point[k] - points[i][k]);
+			}
+			sum += 1.0 / std::max(1u, count_dominating(&flat[0], n, &x[0], dim));
+		}
+		n_samples += batch;
+		if (m_max_time > 0.) {
+			// The stopping rule does not depend on the samples, a single bound holds.
+			if (boost::get_system_time() >= deadline) {
+				h = std::sqrt(std::log(2. / m_delta) / (2. * n_samples));
+				break;
+			}
+		} else {
+			// The k-th check holds with probability 1 - delta / 2^k, so that all of them hold with probability 1 - delta.
+			++n_checks;
+			h = std::sqrt((std::log(2. / m_delta) + n_checks * std::log(2.)) / (2. * n_samples));
+			if (h <= m_eps * sum / n_samples) {
+				break;
+			}
+			batch = n_samples;
+		}
+	}
+	rep.errors.assign(1, V * h);
+	return V * sum / n_samples;
+}
+
+// Approximate the exclusive contributions of the points at the given indices. Each exclusive region lies in the box [p, b], where b[k] is the minimum
+// of r_point[k] and of the k-th coordinate of the points which are worse than p in the k-th coordinate only. The box is sampled uniformly,
+// checking the samples against the points which overlap it, and Hoeffding's inequality bounds the error of all the contributions at once.
+std::vector<double> adaptive::approx_contributions(const std::vector<fitness_vector> &points, const fitness_vector &r_point, const std::vector<unsigned int> &indices,
+	report &rep) const
+{
+	const unsigned int n = points.size();
+	const unsigned int dim = r_point.size();
+	const unsigned int n_targets = indices.size();
+	// Per-call generator, so that concurrent calls do not share state.
+	rng_double drng(rng_generator::get<rng_double>());
+
+	std::vector<fitness_vector> upper(n_targets, r_point);
+	std::vector<std::vector<double> > overlapping(n_targets);
+	std::vector<double> box_volume(n_targets, 0.0);
+	for (unsigned int t = 0; t < n_targets; ++t) {
+		const fitness_vector &p = points[indices[t]];
+		bool dominated = false;
+		for (unsigned int j = 0; j < n && !dominated; ++j) {
+			if (j == indices[t]) {
+				continue;
+			}
+			unsigned int n_worse = 0, worse_k = 0;
+			for (unsigned int k = 0; k < dim; ++k) {
+				if (points[j][k] > p[k]) {
+					++n_worse;
+					worse_k = k;
+				}
+			}
+			if (n_worse == 0) {
+				// Weakly dominated point: no exclusive contribution.
+				dominated = true;
+			} else if (n_worse == 1) {
+				upper[t][worse_k] = std::min(upper[t][worse_k], points[j][worse_k]);
+			}
+		}
+		if (dominated) {
+			continue;
+		}
+		box_volume[t] = base::volume_between(p, upper[t]);
+		for (unsigned int j = 0; j < n; ++j) {
+			if (j == indices[t]) {
+				continue;
+			}
+			unsigned int overlaps = 1u;
+			for (unsigned int k = 0; k < dim; ++k) {
+				overlaps &= static_cast<unsigned int>(points[j][k] < upper[t][k]);
+			}
+			if (overlaps) {
+				overlapping[t].insert(overlapping[t].end(), points[j].begin(), points[j].end());
+			}
+		}
+	}
+
+	const double log_term = std::log(2. * n_targets / m_delta);
+	std::vector<unsigned long long> n_succ(n_targets, 0);
+	unsigned long long n_samples = 0;
+	fitness_vector x(dim);
+	if (m_max_time > 0.) {
+		// Sample all the boxes in rounds until the time is over.
+		const boost::system_time deadline = get_deadline(m_max_time);
+		do {
+			for (unsigned int t = 0; t < n_targets; ++t) {
+				if (box_volume[t] > 0.) {
+					n_succ[t] += sample_box(points[indices[t]], upper[t], overlapping[t], time_check_batch, drng, x);
+				}
+			}
+			n_samples += time_check_batch;
+		} while (boost::get_system_time() < deadline);
+	} else {
+		n_samples = static_cast<unsigned long long>(std::ceil(log_term / (2. * m_eps * m_eps)));
+		for (unsigned int t = 0; t < n_targets; ++t) {
+			if (box_volume[t] > 0.) {
+				n_succ[t] = sample_box(points[indices[t]], upper[t], overlapping[t], n_samples, drng, x);
+			}
+		}
+	}
+
+	const double h = std::sqrt(log_term / (2. * n_samples));
+	std::vector<double> c(n_targets);
+	rep.errors.resize(n_targets);
+	for (unsigned int t = 0; t < n_targets; ++t) {
+		c[t] = box_volume[t] * n_succ[t] / n_samples;
+		rep.errors[t] = box_volume[t] * h;
+	}
+	return c;
+}
+
+/// Clone method.
+base_ptr adaptive::clone() const
+{
+	return base_ptr(new adaptive(*this));
+}
+
+/// Algorithm name
+std::string adaptive::get_name() const
+{
+	return "Adaptive exact or approximated hypervolume";
+}
+
+} } }
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hv_algorithm::adaptive)
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+#ifndef PAGMO_UTIL_HV_ALGORITHM_ADAPTIVE_H
+#define PAGMO_UTIL_HV_ALGORITHM_ADAPTIVE_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iterator>
+#include "../../rng.h"
+
+#include "base.h"
+
+#include "../hypervolume.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+/// Adaptive exact/approximated hypervolume method
+/**
+ * This algorithm chooses between the exact algorithms (picked as in pagmo::util::hypervolume) and Monte Carlo approximations,
+ * according to a budget given either as a time limit or as an accuracy (eps, delta).
+ * The cost of the exact computation is predicted with pagmo::util::hypervolume::get_expected_operations.
+ *
+ * - Time budget (max_time > 0): the exact algorithms are used when the predicted time does not exceed max_time. Otherwise the approximation
+ *   samples until max_time is over, and the bounds reported are those achieved with confidence 1 - delta.
+ * - Accuracy budget (max_time = 0): the exact algorithms are used when predicted to be cheaper than the approximation, which otherwise samples until
+ *   the requested accuracy eps is reached with confidence 1 - delta.
+ *
+ * The hypervolume is approximated with the Karp-Luby estimator of the volume of a union of boxes (the same sampling scheme as pagmo::util::hv_algorithm::bf_fpras),
+ * its eps is relative to the hypervolume. The exclusive contributions are approximated by uniform sampling in the bounding box of each exclusive
+ * region (as in pagmo::util::hv_algorithm::bf_approx), their eps is relative to the volume of the bounding box.
+ * The extreme contributors are established by pagmo::util::hv_algorithm::bf_approx under an accuracy budget, and as the extremes of the approximated
+ * contributions under a time budget.
+ *
+ * The overloads taking an adaptive::report also return how the result was obtained: whether it is exact, and the half-widths of the confidence
+ * intervals (one per value returned, zero for the exact results; for the extreme contributors, those of the contributions they were chosen from, if any).
+ * Each call uses its own random number generator, seeded from pagmo::rng_generator, so that an instance can be shared among threads.
+ *
+ * @see "Approximating the volume of unions and intersections of high-dimensional geometric objects", Karl Bringmann, Tobias Friedrich.
+ * @see "Approximating the least hypervolume contributor: NP-hard in general, but fast in practice", Karl Bringmann, Tobias Friedrich.
+ */
+class __PAGMO_VISIBLE adaptive : public base
+{
+public:
+	/// Diagnostics of a computation.
+	struct report
+	{
+		report():exact(true),errors() {}
+		/// True if the result was computed exactly, false if it was approximated.
+		bool exact;
+		/// Half-widths of the confidence intervals of the values returned (zero for the exact results).
+		std::vector<double> errors;
+	};
+
+	adaptive(const double eps = 1e-2, const double delta = 1e-2, const double max_time = 0.0);
+
+	using base::least_contributor;
+	using base::greatest_contributor;
+
+	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
+	double compute(std::vector<fitness_vector> &, const fitness_vector &, report &) const;
+	double exclusive(const unsigned int, std::vector<fitness_vector> &, const fitness_vector &) const;
+	double exclusive(const unsigned int, std::vector<fitness_vector> &, const fitness_vector &, report &) const;
+	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &) const;
+	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &, report &) const;
+	unsigned int least_contributor(std::vector<fitness_vector> &, const fitness_vector &, report &) const;
+	unsigned int greatest_contributor(std::vector<fitness_vector> &, const fitness_vector &, report &) const;
+
+	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
+	base_ptr clone() const;
+	std::string get_name() const;
+
+private:
+	bool use_exact(const double, const double) const;
+	double approx_compute(const std::vector<fitness_vector> &, const fitness_vector &, report &) const;
+	std::vector<double> approx_contributions(const std::vector<fitness_vector> &, const fitness_vector &, const std::vector<unsigned int> &, report &) const;
+	unsigned int extreme_contributor(std::vector<fitness_vector> &, const fitness_vector &, bool (*)(double, double)) const;
+	unsigned int extreme_contributor(std::vector<fitness_vector> &, const fitness_vector &, bool (*)(double, double), report &) const;
+
+	// accuracy of the approximation
+	const double m_eps;
+	// probability of error
+	const double m_delta;
+	// time limit in seconds (0 for the accuracy budget)
+	const double m_max_time;
+
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int version)
+	{
+		ar & boost::serialization::base_object<base>(*this);
+		ar & const_cast<double &>(m_eps);
+		ar & const_cast<double &>(m_delta);
+		ar & const_cast<double &>(m_max_time);
+		// Version 0 archives also stored the random number generator shared by the calls: skip it.
+		if (version < 1) {
+			rng_double drng;
+			ar & drng;
+		}
+	}
+};
+
+} } }
+
+BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::adaptive)
+
+// Version 1: each call uses its own random number generator.
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::adaptive,1)
+
+#endif
@@ -22,38 +22,122 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-
 #include "wfg.h"
 #include "base.h"
 #include <algorithm>
 #include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../../thread_pool.h"
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
-/// Comparator function for sorting
-/**
- * Comparison function for WFG. Can't be static in order to have access to member variable m_current_slice.
- */
-bool wfg::cmp_points(double* a, double* b) const
+namespace {
+
+// Comparator for the sorting of the points, from the last coordinate of the current slice backwards.
+struct slice_cmp
 {
-	for(int i = m_current_slice - 1; i >= 0 ; --i){
-		if (a[i] > b[i]) {
-			return true;
-		} else if(a[i] < b[i]) {
-			return false;
+	explicit slice_cmp(const unsigned int slice):m_slice(slice) {}
+	bool operator()(const double *a, const double *b) const
+	{
+		for(int i = m_slice - 1; i >= 0 ; --i){
+			if (a[i] > b[i]) {
+				return true;
+			} else if(a[i] < b[i]) {
+				return false;
+			}
 		}
+		return false;
 	}
-	return false;
+	const unsigned int m_slice;
+};
+
 }
 
 /// Constructor
-wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_stop_dimension(stop_dimension)
+/**
+ * @param[in] stop_dimension dimension at which the slicing stops and another algorithm takes over.
+ * @param[in] n_threads number of tasks the top level of the computation is split into: 1 (default) for the sequential algorithm,
+ * 0 for as many tasks as the hardware threads.
+ *
+ * @throws value_error if stop_dimension is smaller than 2.
+ */
+wfg::wfg(const unsigned int stop_dimension, const unsigned int n_threads) : m_stop_dimension(stop_dimension), m_n_threads(n_threads)
 {
 	if (stop_dimension < 2 ) {
 		pagmo_throw(value_error, "Stop dimension for WFG must be greater than or equal to 2");
 	}
 }
 
+/// Set up a workspace for the given points: the points are copied into the frame at index 0.
+wfg::workspace::workspace(const std::vector<fitness_vector> &points, const fitness_vector &r_point):
+	m_refpoint(r_point.begin(), r_point.end()),m_buffers(1),m_frames(1),m_frames_size(1),
+	m_current_slice(r_point.size()),m_max_points(points.size()),m_max_dim(r_point.size())
+{
+	// WFG with slicing feature will not go recursively deeper than the dimension size:
+	// reserving the levels beforehand keeps the row pointers valid while the recursion deepens.
+	m_buffers.reserve(m_max_dim + 1);
+	m_frames.reserve(m_max_dim + 1);
+	m_buffers[0].resize(m_max_points * m_max_dim);
+	m_frames[0].resize(m_max_points);
+	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
+		m_frames[0][p_idx] = &m_buffers[0][0] + p_idx * m_max_dim;
+		std::copy(points[p_idx].begin(), points[p_idx].begin() + m_max_dim, m_frames[0][p_idx]);
+	}
+	m_frames_size[0] = m_max_points;
+}
+
+/// Set up a workspace for a parallel task, starting from the first levels (up to rec_level excluded) of another workspace.
+wfg::workspace::workspace(const workspace &other, const unsigned int rec_level):
+	m_refpoint(other.m_refpoint),m_buffers(rec_level),m_frames(rec_level),m_frames_size(other.m_frames_size.begin(), other.m_frames_size.begin() + rec_level),
+	m_current_slice(other.m_current_slice),m_max_points(other.m_max_points),m_max_dim(other.m_max_dim)
+{
+	m_buffers.reserve(m_max_dim + 1);
+	m_frames.reserve(m_max_dim + 1);
+	for (unsigned int level = 0; level < rec_level; ++level) {
+		m_buffers[level].resize(m_max_points * m_max_dim);
+		m_frames[level].resize(m_max_points);
+		// Copy the points in the order of the other workspace.
+		for (unsigned int p_idx = 0; p_idx < m_frames_size[level]; ++p_idx) {
+			m_frames[level][p_idx] = &m_buffers[level][0] + p_idx * m_max_dim;
+			std::copy(other.m_frames[level][p_idx], other.m_frames[level][p_idx] + m_max_dim, m_frames[level][p_idx]);
+		}
+	}
+}
+
+/// Make sure that the frame at the given recursion level is allocated.
+void wfg::workspace::ensure_level(const unsigned int rec_level)
+{
+	while (m_frames.size() <= rec_level) {
+		m_buffers.push_back(std::vector<double>(m_max_points * m_max_dim));
+		m_frames.push_back(std::vector<double *>(m_max_points));
+		for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
+			m_frames.back()[p_idx] = &m_buffers.back()[0] + p_idx * m_max_dim;
+		}
+		m_frames_size.push_back(0);
+	}
+}
+
+/// Number of worker threads.
+/**
+ * @return the number of tasks the top level of the computation is split into (1 for the sequential algorithm, 0 for as many as the hardware threads).
+ */
+unsigned int wfg::get_threads() const
+{
+	return m_n_threads;
+}
+
+// Number of tasks to be used for n independent top level computations.
+unsigned int wfg::n_tasks(const unsigned int n) const
+{
+	unsigned int retval = m_n_threads;
+	if (!retval) {
+		retval = boost::thread::hardware_concurrency();
+	}
+	return std::max(1u, std::min(retval, n));
+}
+
 /// Compute hypervolume
 /**
  * Computes the hypervolume using the WFG algorithm.
@@ -65,10 +149,27 @@ wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_stop_dimensi
  */
 double wfg::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	allocate_wfg_members(points, r_point);
-	double hv = compute_hv(1);
-	free_wfg_members();
-	return hv;
+	workspace ws(points, r_point);
+	const unsigned int n_points = ws.m_max_points;
+	if (n_tasks(n_points) == 1 || n_points <= 2 || ws.m_current_slice == m_stop_dimension) {
+		return compute_hv(ws, 1);
+	}
+	// Parallel version of the top level of 'compute_hv': the points are sorted once, then the slices are shared among the tasks
+	// (in a round-robin fashion, as the cost of the slices decreases with the index).
+	std::sort(ws.m_frames[0].begin(), ws.m_frames[0].begin() + n_points, slice_cmp(ws.m_current_slice));
+	--ws.m_current_slice;
+	const unsigned int n = n_tasks(n_points);
+	std::vector<double> partial(n, 0.0);
+	std::vector<boost::function<void ()> > tasks;
+	for (unsigned int t = 0; t < n; ++t) {
+		tasks.push_back(boost::bind(&wfg::slice_terms, this, boost::cref(ws), t, n, boost::ref(partial[t])));
+	}
+	thread_pool::shared().run_all(tasks);
+	double H = 0.0;
+	for (unsigned int t = 0; t < n; ++t) {
+		H += partial[t];
+	}
+	return H;
 }
 
 /// Contributions method
@@ -79,6 +180,8 @@ double wfg::compute(std::vector<fitness_vector> &points, const fitness_vector &r
  * as we utilize the benefits of the 'limitset', before we begin the recursion.
  * This simplifies the sub problems for each exclusive computation right away, which makes the whole algorithm much faster, and in many cases only slower than regular WFG algorithm by a constant factor.
  *
+ * The exclusive contributions are independent, hence in the parallel mode they are shared among the tasks.
+ *
  * @see "Lyndon While and Lucas Bradstreet. Applying the WFG Algorithm To Calculate Incremental Hypervolumes. 2012 IEEE Congress on Evolutionary Computation. CEC 2012, pages 489-496. IEEE, June 2012."
  *
  * @param[in] points vector of points containing the D-dimensional points for which we compute the hypervolume
@@ -86,109 +189,78 @@ double wfg::compute(std::vector<fitness_vector> &points, const fitness_vector &r
  */
 std::vector<double> wfg::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	std::vector<double> c;
-	c.reserve(points.size());
-
-	// Allocate the same members as for 'compute' method
-	allocate_wfg_members(points, r_point);
-
-	// Prepare the memory for first front
-	double** fr = new double*[m_max_points];
-	for(unsigned int i = 0 ; i < m_max_points ; ++i) {
-		fr[i]=new double[m_current_slice];
+	std::vector<double> c(points.size(), 0.0);
+	workspace ws(points, r_point);
+	const unsigned int n = n_tasks(ws.m_max_points);
+	if (n == 1) {
+		contributions_range(ws, c, 0, 1);
+		return c;
 	}
-	m_frames[m_n_frames] = fr;
-	m_frames_size[m_n_frames] = 0;
-	++m_n_frames;
-
-	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
-		limitset(0, p_idx, 1);
-		c.push_back(exclusive_hv(p_idx, 1));
+	std::vector<boost::function<void ()> > tasks;
+	for (unsigned int t = 0; t < n; ++t) {
+		tasks.push_back(boost::bind(&wfg::contributions_range, this, boost::cref(ws), boost::ref(c), t, n));
 	}
-
-	// Free the contributions and the remaining WFG members
-	free_wfg_members();
-
+	thread_pool::shared().run_all(tasks);
 	return c;
 }
 
-/// Allocate the memory for the 'compute' method
-void wfg::allocate_wfg_members(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+// Terms of the top level sum of 'compute_hv' for the slices begin, begin + step, begin + 2 * step...
+// The points of the source workspace are expected to be already sorted, with the current slice decremented.
+void wfg::slice_terms(const workspace &src, const unsigned int begin, const unsigned int step, double &H) const
 {
-	m_max_points = points.size();
-	m_max_dim = r_point.size();
-
-	m_refpoint = new double[m_max_dim];
-	for(unsigned int d_idx = 0 ; d_idx < m_max_dim ; ++d_idx) {
-		m_refpoint[d_idx] = r_point[d_idx];
-	}
-
-	// Reserve the space beforehand for each level or recursion.
-	// WFG with slicing feature will not go recursively deeper than the dimension size.
-	m_frames = new double**[m_max_dim];
-	m_frames_size = new unsigned int[m_max_dim];
-
-	// Copy the initial set into the frame at index 0.
-	double** fr = new double*[m_max_points];
-	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
-		fr[p_idx] = new double[m_max_dim];
-		for(unsigned int d_idx = 0 ; d_idx < m_max_dim ; ++d_idx) {
-			fr[p_idx][d_idx] = points[p_idx][d_idx];
-		}
+	workspace ws(src, 1);
+	ws.ensure_level(1);
+	double **points = &ws.m_frames[0][0];
+	H = 0.0;
+	for(unsigned int p_idx = begin ; p_idx < ws.m_frames_size[0] ; p_idx += step) {
+		limitset(ws, p_idx + 1, p_idx, 1);
+		H += fabs((points[p_idx][ws.m_current_slice] - ws.m_refpoint[ws.m_current_slice]) * exclusive_hv(ws, p_idx, 1));
 	}
-	m_frames[0] = fr;
-	m_frames_size[0] = m_max_points;
-	m_n_frames = 1;
-
-	// Variable holding the current "depth" of dimension slicing. We progress by slicing dimensions from the end.
-	m_current_slice = m_max_dim;
 }
 
-/// Free the previously allocated memory
-void wfg::free_wfg_members() const
+// Exclusive contributions of the points begin, begin + step, begin + 2 * step...
+void wfg::contributions_range(const workspace &src, std::vector<double> &c, const unsigned int begin, const unsigned int step) const
 {
-	// Free the memory.
-	delete[] m_refpoint;
-
-	for(unsigned int fr_idx = 0 ; fr_idx < m_n_frames ; ++fr_idx) {
-		for(unsigned int p_idx = 0; p_idx < m_max_points ; ++p_idx) {
-			delete[] m_frames[fr_idx][p_idx];
-		}
-		delete[] m_frames[fr_idx];
+	workspace ws(src, 1);
+	ws.ensure_level(1);
+	for(unsigned int p_idx = begin ; p_idx < ws.m_max_points ; p_idx += step) {
+		limitset(ws, 0, p_idx, 1);
+		c[p_idx] = exclusive_hv(ws, p_idx, 1);
 	}
-	delete[] m_frames;
-	delete[] m_frames_size;
 }
 
 /// Limit the set of points to point at p_idx
-void wfg::limitset(const unsigned int begin_idx, const unsigned int p_idx, const unsigned int rec_level) const
+void wfg::limitset(workspace &ws, const unsigned int begin_idx, const unsigned int p_idx, const unsigned int rec_level) const
 {
-	double **points = m_frames[rec_level - 1];
-	unsigned int n_points = m_frames_size[rec_level - 1];
+	double **points = &ws.m_frames[rec_level - 1][0];
+	const unsigned int n_points = ws.m_frames_size[rec_level - 1];
+	const unsigned int slice = ws.m_current_slice;
 
 	int no_points = 0;
 
 	double* p = points[p_idx];
-	double** frame = m_frames[rec_level];
+	double** frame = &ws.m_frames[rec_level][0];
+	std::vector<int> &cmp_results = ws.m_cmp_results;
+	if (cmp_results.size() < ws.m_max_points) {
+		cmp_results.resize(ws.m_max_points);
+	}
 
 	for(unsigned int idx = begin_idx; idx < n_points; ++idx) {
 		if (idx == p_idx) {
 			continue;
 		}
 
-		for(fitness_vector::size_type f_idx = 0; f_idx < m_current_slice; ++f_idx) {
+		for(unsigned int f_idx = 0; f_idx < slice; ++f_idx) {
 			frame[no_points][f_idx] = std::max(points[idx][f_idx], p[f_idx]);
 		}
 
-		std::vector<int> cmp_results;
-		cmp_results.resize(no_points);
 		double* s = frame[no_points];
 
 		bool keep_s = true;
 
 		// Check whether any point is dominating the point 's'.
 		for(int q_idx = 0; q_idx < no_points; ++q_idx) {
-			cmp_results[q_idx] = base::dom_cmp(s, frame[q_idx], m_current_slice);
+			cmp_results[q_idx] = base::dom_cmp(s, frame[q_idx], slice);
 			if (cmp_results[q_idx] == base::DOM_CMP_B_DOMINATES_A) {
 				keep_s = false;
 				break;
@@ -201,61 +273,59 @@ void wfg::limitset(const unsigned int begin_idx, const unsigned int p_idx, const
 			while(next < no_points) {
 				if( cmp_results[next] != base::DOM_CMP_A_DOMINATES_B && cmp_results[next] != base::DOM_CMP_A_B_EQUAL) {
 					if(prev < next) {
-						for(unsigned int d_idx = 0; d_idx < m_current_slice ; ++d_idx) {
-							frame[prev][d_idx] = frame[next][d_idx];
-						}
+						// Swapping the row pointers is enough, the rows themselves stay in the buffer of the level.
+						std::swap(frame[prev], frame[next]);
 					}
 					++prev;
 				}
 				++next;
 			}
-			// Append 's' at the end, if prev==next it's not necessary as it's already there.
+			// Bring 's' right after the kept points, if prev==next it's not necessary as it's already there.
 			if(prev < next) {
-				for(unsigned int d_idx = 0; d_idx < m_current_slice ; ++d_idx) {
-					frame[prev][d_idx] = s[d_idx];
-				}
+				std::swap(frame[prev], frame[next]);
 			}
 			no_points = prev + 1;
 		}
 	}
 
-	m_frames_size[rec_level] = no_points;
+	ws.m_frames_size[rec_level] = no_points;
 }
 
 /// Compute the hypervolume recursively
-double wfg::compute_hv(const unsigned int rec_level) const
+double wfg::compute_hv(workspace &ws, const unsigned int rec_level) const
 {
-	double **points = m_frames[rec_level - 1];
-	unsigned int n_points = m_frames_size[rec_level - 1];
+	double **points = &ws.m_frames[rec_level - 1][0];
+	const unsigned int n_points = ws.m_frames_size[rec_level - 1];
+	double *refpoint = &ws.m_refpoint[0];
 
 	// Simple inclusion-exclusion for one and two points
 	if (n_points == 1) {
-		return base::volume_between(points[0], m_refpoint, m_current_slice);
+		return base::volume_between(points[0], refpoint, ws.m_current_slice);
 	}
 	else if (n_points == 2) {
-		double hv = base::volume_between(points[0], m_refpoint, m_current_slice)
-			+ base::volume_between(points[1], m_refpoint, m_current_slice);
+		double hv = base::volume_between(points[0], refpoint, ws.m_current_slice)
+			+ base::volume_between(points[1], refpoint, ws.m_current_slice);
 		double isect = 1.0;
-		for(unsigned int i=0;i<m_current_slice;++i) {
-			isect *= (m_refpoint[i] - std::max(points[0][i], points[1][i]));
+		for(unsigned int i=0;i<ws.m_current_slice;++i) {
+			isect *= (refpoint[i] - std::max(points[0][i], points[1][i]));
 		}
 		return hv - isect;
 	}
 
 	// If already sliced to dimension at which we use another algorithm.
-	if (m_current_slice == m_stop_dimension) {
+	if (ws.m_current_slice == m_stop_dimension) {
 
 		if (m_stop_dimension == 2) {
 			// Use a very efficient version of hv2d
-			return hv2d().compute(points, n_points, m_refpoint);
+			return hv2d().compute(points, n_points, &ws.m_refpoint[0]);
 		} else {
 			// Let hypervolume object pick the best method otherwise.
 			std::vector<fitness_vector> points_cpy;
 			points_cpy.reserve(n_points);
 			for(unsigned int i = 0 ; i < n_points ; ++i) {
-				points_cpy.push_back(fitness_vector(points[i], points[i] + m_current_slice));
+				points_cpy.push_back(fitness_vector(points[i], points[i] + ws.m_current_slice));
 			}
-			fitness_vector r_cpy(m_refpoint, m_refpoint + m_current_slice);
+			fitness_vector r_cpy(refpoint, refpoint + ws.m_current_slice);
 
 			hypervolume hv = hypervolume(points_cpy, false);
 			hv.set_copy_points(false);
@@ -263,43 +333,33 @@ double wfg::compute_hv(const unsigned int rec_level) const
 		}
 	} else {
 		// Otherwise, sort the points in preparation for the next recursive step
-		// Bind the object under "this" pointer to the cmp_points method so it can be used as a valid comparator function for std::sort
-		// We need that in order for the cmp_points to have acces to the m_current_slice member variable.
-		std::sort(points, points + n_points, boost::bind(&wfg::cmp_points, this, _1, _2));
+		std::sort(points, points + n_points, slice_cmp(ws.m_current_slice));
 	}
 
 	double H = 0.0;
-	--m_current_slice;
+	--ws.m_current_slice;
 
-	if(rec_level >= m_n_frames) {
-		double** fr = new double*[m_max_points];
-		for(unsigned int i = 0 ; i < m_max_points ; ++i) {
-			fr[i]=new double[m_current_slice];
-		}
-		m_frames[m_n_frames] = fr;
-		m_frames_size[m_n_frames] = 0;
-		++m_n_frames;
-	}
+	ws.ensure_level(rec_level);
 
 	for(unsigned int p_idx = 0 ; p_idx < n_points ; ++p_idx) {
-		limitset(p_idx + 1, p_idx, rec_level);
+		limitset(ws, p_idx + 1, p_idx, rec_level);
 
-		H += fabs((points[p_idx][m_current_slice] - m_refpoint[m_current_slice]) * exclusive_hv(p_idx, rec_level));
+		H += fabs((points[p_idx][ws.m_current_slice] - refpoint[ws.m_current_slice]) * exclusive_hv(ws, p_idx, rec_level));
 	}
-	++m_current_slice;
+	++ws.m_current_slice;
 	return H;
 }
 
 /// Compute the exclusive hypervolume of point at p_idx
-double wfg::exclusive_hv(const unsigned int p_idx, const unsigned int rec_level) const
+double wfg::exclusive_hv(workspace &ws, const unsigned int p_idx, const unsigned int rec_level) const
 {
-	//double H = base::volume_between(points[p_idx], m_refpoint, m_current_slice);
-	double H = base::volume_between(m_frames[rec_level - 1][p_idx], m_refpoint, m_current_slice);
+	double *refpoint = &ws.m_refpoint[0];
+	double H = base::volume_between(ws.m_frames[rec_level - 1][p_idx], refpoint, ws.m_current_slice);
 
-	if (m_frames_size[rec_level] == 1) {
-		H -= base::volume_between(m_frames[rec_level][0], m_refpoint, m_current_slice);
-	} else if (m_frames_size[rec_level] > 1) {
-		H -= compute_hv(rec_level + 1);
+	if (ws.m_frames_size[rec_level] == 1) {
+		H -= base::volume_between(ws.m_frames[rec_level][0], refpoint, ws.m_current_slice);
+	} else if (ws.m_frames_size[rec_level] > 1) {
+		H -= compute_hv(ws, rec_level + 1);
 	}
 
 	return H;
@@ -43,69 +43,80 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * @see "While, Lyndon, Lucas Bradstreet, and Luigi Barone. "A fast way of calculating exact hypervolumes." Evolutionary Computation, IEEE Transactions on 16.1 (2012): 86-95."
  * @see "Lyndon While and Lucas Bradstreet. Applying the WFG Algorithm To Calculate Incremental Hypervolumes. 2012 IEEE Congress on Evolutionary Computation. CEC 2012, pages 489-496. IEEE, June 2012."
  *
+ * The algorithm is reentrant: the working memory is allocated per call. Optionally, the top level of the computation
+ * (the slices of 'compute' and the exclusive volumes of 'contributions') can be split among the worker threads of the shared
+ * thread pool (see thread_pool::shared()).
+ *
  * @author Krzysztof Nowak (kn@kiryx.net)
  */
 class __PAGMO_VISIBLE wfg : public base
 {
 public:
-	wfg(const unsigned int stop_dimension = 2);
+	wfg(const unsigned int stop_dimension = 2, const unsigned int n_threads = 1);
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
 	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &) const;
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
 	std::string get_name() const;
+	unsigned int get_threads() const;
 
 private:
-	void limitset(const unsigned int, const unsigned int, const unsigned int) const;
-	double exclusive_hv(const unsigned int, const unsigned int) const;
-	double compute_hv(const unsigned int) const;
-
-	bool cmp_points(double* a, double* b) const;
-
-	void allocate_wfg_members(std::vector<fitness_vector> &, const fitness_vector &) const;
-	void free_wfg_members() const;
-
-	/**
-	 * 'compute' and 'extreme_contributor' method variables section.
-	 *
-	 * Variables below (especially the pointers m_frames, m_frames_size and m_refpoint) are initialized
-	 * at the beginning of the 'compute' and 'extreme_contributor' methods, and freed afterwards.
-	 * The state of the variables is irrelevant outside the scope of the these methods.
-	 */
-
-	// Current slice depth
-	mutable unsigned int m_current_slice;
-
-	// Array of point sets for each recursive level.
-	mutable double*** m_frames;
-
-	// Maintains the number of points at given recursion level.
-	mutable unsigned int* m_frames_size;
-
-	// Keeps track of currently allocated number of frames.
-	mutable unsigned int m_n_frames;
-
-	// Copy of the reference point
-	mutable double* m_refpoint;
-
-	// Size of the original front
-	mutable unsigned int m_max_points;
-
-	// Size of the dimension
-	mutable unsigned int m_max_dim;
+	/// Scratch memory of a WFG computation.
 	/**
-	 * End of 'compute' method variables section.
+	 * Every call to 'compute' and 'contributions' (and every parallel task spawned by them) works on its own workspace,
+	 * so that a single wfg object can be used concurrently by several threads.
+	 * Each recursion level owns a frame: a contiguous buffer holding the points of the level (with stride equal to the dimension),
+	 * and an array of pointers to its rows, which is what gets sorted.
 	 */
+	struct workspace
+	{
+		workspace(const std::vector<fitness_vector> &, const fitness_vector &);
+		workspace(const workspace &, const unsigned int);
+		void ensure_level(const unsigned int);
+
+		// Copy of the reference point.
+		std::vector<double> m_refpoint;
+		// Storage of the points of each recursion level.
+		std::vector<std::vector<double> > m_buffers;
+		// Pointers to the points of each recursion level.
+		std::vector<std::vector<double *> > m_frames;
+		// Number of points at each recursion level.
+		std::vector<unsigned int> m_frames_size;
+		// Domination results, reused by 'limitset'.
+		std::vector<int> m_cmp_results;
+		// Current slice depth.
+		unsigned int m_current_slice;
+		// Size of the original front.
+		unsigned int m_max_points;
+		// Size of the dimension.
+		unsigned int m_max_dim;
+	};
+
+	void limitset(workspace &, const unsigned int, const unsigned int, const unsigned int) const;
+	double exclusive_hv(workspace &, const unsigned int, const unsigned int) const;
+	double compute_hv(workspace &, const unsigned int) const;
+	void slice_terms(const workspace &, const unsigned int, const unsigned int, double &) const;
+	void contributions_range(const workspace &, std::vector<double> &, const unsigned int, const unsigned int) const;
+	unsigned int n_tasks(const unsigned int) const;
 
 	// Dimension at which WFG stops the slicing
 	const unsigned int m_stop_dimension;
 
+	// Number of tasks the top level of the computation is split into (1 for the sequential algorithm, 0 for as many as the hardware threads).
+	const unsigned int m_n_threads;
+
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<unsigned int &>(m_stop_dimension);
+		// Version 0 archives predate the parallel computation: fall back to the sequential algorithm.
+		if (version >= 1) {
+			ar & const_cast<unsigned int &>(m_n_threads);
+		} else {
+			const_cast<unsigned int &>(m_n_threads) = 1;
+		}
 	}
 };
 
@@ -113,4 +124,7 @@ private:
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::wfg)
 
+// Version 1: number of threads.
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::wfg,1)
+
 #endif
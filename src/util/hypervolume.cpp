@@ -22,6 +22,10 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <utility>
+
 #include "hypervolume.h"
 
 namespace pagmo { namespace util {
@@ -474,6 +478,299 @@ hypervolume_ptr hypervolume::clone() const
 	return hypervolume_ptr(new hypervolume(*this));
 }
 
+/// Constructor.
+/**
+ * Constructs an empty tracker.
+ *
+ * @param[in] hv_algorithm algorithm used to compute the contributions. If null (the default), the algorithm is chosen
+ * by pagmo::util::hypervolume according to the dimension.
+ */
+contribution_tracker::contribution_tracker(const hv_algorithm::base_ptr hv_algorithm):m_hv_algorithm(hv_algorithm),m_n_stale(0),m_recomputed(0) {}
+
+/// Set the point set and the reference point.
+/**
+ * After the call, the i-th point of the tracker is points[i]. The points that were already tracked keep their
+ * contributions (unless they are invalidated by the points entering or leaving the set), so that assigning
+ * a set differing by few points from the current one is cheap. If the reference point changes, or if most of the points
+ * are new, the contributions are recomputed from scratch.
+ *
+ * @param[in] points new point set.
+ * @param[in] r_point new reference point.
+ */
+void contribution_tracker::assign(const std::vector<fitness_vector> &points, const fitness_vector &r_point)
+{
+	if (r_point != m_ref_point) {
+		set_reference_point(r_point);
+	}
+	// Match the new points with the tracked ones (as multisets).
+	std::multimap<fitness_vector,unsigned int> tracked;
+	for (unsigned int i = 0; i < m_points.size(); ++i) {
+		tracked.insert(std::make_pair(m_points[i],i));
+	}
+	std::vector<int> origin(points.size(),-1);
+	for (unsigned int i = 0; i < points.size(); ++i) {
+		std::multimap<fitness_vector,unsigned int>::iterator it = tracked.find(points[i]);
+		if (it != tracked.end()) {
+			origin[i] = it->second;
+			tracked.erase(it);
+		}
+	}
+	const unsigned int n_added = std::count(origin.begin(),origin.end(),-1);
+	if (2 * (n_added + tracked.size()) > points.size()) {
+		// Most of the set changed, start over.
+		m_points = points;
+		m_contributions.assign(points.size(),0.);
+		m_stale.assign(points.size(),1);
+		m_n_stale = points.size();
+		return;
+	}
+	// Erase the points which left the set, from the back so that the indices of the others do not change.
+	std::vector<unsigned int> removed;
+	for (std::multimap<fitness_vector,unsigned int>::const_iterator it = tracked.begin(); it != tracked.end(); ++it) {
+		removed.push_back(it->second);
+	}
+	std::sort(removed.begin(),removed.end());
+	std::vector<unsigned int> position(m_points.size());
+	for (unsigned int i = 0; i < position.size(); ++i) {
+		position[i] = i;
+	}
+	for (std::vector<unsigned int>::reverse_iterator it = removed.rbegin(); it != removed.rend(); ++it) {
+		erase(*it);
+		position.erase(position.begin() + *it);
+	}
+	// position[j] is now the original index of the j-th tracked point.
+	std::vector<unsigned int> current(position.size() ? *std::max_element(position.begin(),position.end()) + 1 : 0);
+	for (unsigned int j = 0; j < position.size(); ++j) {
+		current[position[j]] = j;
+	}
+	// Insert the new points, then reorder everything as in the input set.
+	std::vector<unsigned int> order(points.size());
+	for (unsigned int i = 0; i < points.size(); ++i) {
+		if (origin[i] == -1) {
+			insert(points[i]);
+			order[i] = m_points.size() - 1;
+		} else {
+			order[i] = current[origin[i]];
+		}
+	}
+	std::vector<double> contributions(points.size());
+	std::vector<char> stale(points.size());
+	for (unsigned int i = 0; i < points.size(); ++i) {
+		contributions[i] = m_contributions[order[i]];
+		stale[i] = m_stale[order[i]];
+	}
+	m_points = points;
+	m_contributions.swap(contributions);
+	m_stale.swap(stale);
+}
+
+/// Insert a point.
+/**
+ * The point is appended to the set.
+ *
+ * @param[in] p point to be inserted.
+ *
+ * @throws value_error if the dimension of the point differs from the dimension of the reference point.
+ */
+void contribution_tracker::insert(const fitness_vector &p)
+{
+	if (p.size() != m_ref_point.size()) {
+		pagmo_throw(value_error, "Point dimension and reference point dimension must be equal.");
+	}
+	m_points.push_back(p);
+	m_contributions.push_back(0.);
+	m_stale.push_back(1);
+	++m_n_stale;
+	invalidate_neighbours(m_points.size() - 1);
+}
+
+/// Erase a point.
+/**
+ * The points following the erased one are shifted back by one position.
+ *
+ * @param[in] idx index of the point to be erased.
+ *
+ * @throws value_error if the index is out of bounds.
+ */
+void contribution_tracker::erase(const unsigned int idx)
+{
+	if (idx >= m_points.size()) {
+		pagmo_throw(value_error, "Index of the point is out of bounds.");
+	}
+	invalidate_neighbours(idx);
+	m_n_stale -= m_stale[idx];
+	m_points.erase(m_points.begin() + idx);
+	m_contributions.erase(m_contributions.begin() + idx);
+	m_stale.erase(m_stale.begin() + idx);
+}
+
+/// Remove all the points.
+void contribution_tracker::clear()
+{
+	m_points.clear();
+	m_contributions.clear();
+	m_stale.clear();
+	m_n_stale = 0;
+}
+
+/// Set the reference point.
+/**
+ * All the contributions will be recomputed.
+ *
+ * @param[in] r_point new reference point.
+ */
+void contribution_tracker::set_reference_point(const fitness_vector &r_point)
+{
+	m_ref_point = r_point;
+	m_stale.assign(m_points.size(),1);
+	m_n_stale = m_points.size();
+}
+
+/// Get the reference point.
+const fitness_vector &contribution_tracker::get_reference_point() const
+{
+	return m_ref_point;
+}
+
+/// Get the tracked points.
+const std::vector<fitness_vector> &contribution_tracker::get_points() const
+{
+	return m_points;
+}
+
+/// Number of tracked points.
+unsigned int contribution_tracker::size() const
+{
+	return m_points.size();
+}
+
+/// Exclusive contribution of a point.
+/**
+ * @param[in] idx index of the point.
+ *
+ * @return the exclusive contribution of the point.
+ *
+ * @throws value_error if the index is out of bounds.
+ */
+double contribution_tracker::contribution(const unsigned int idx) const
+{
+	if (idx >= m_points.size()) {
+		pagmo_throw(value_error, "Index of the point is out of bounds.");
+	}
+	update();
+	return m_contributions[idx];
+}
+
+/// Exclusive contributions of all the points.
+/**
+ * @return const reference to the vector of the exclusive contributions.
+ */
+const std::vector<double> &contribution_tracker::contributions() const
+{
+	update();
+	return m_contributions;
+}
+
+/// Find the least contributing point.
+/**
+ * @return index of the least contributing point.
+ *
+ * @throws value_error if the tracker is empty.
+ */
+unsigned int contribution_tracker::least_contributor() const
+{
+	if (m_points.empty()) {
+		pagmo_throw(value_error, "Point set cannot be empty.");
+	}
+	update();
+	return std::min_element(m_contributions.begin(),m_contributions.end()) - m_contributions.begin();
+}
+
+/// Number of contributions recomputed so far.
+/**
+ * Diagnostic counter: the number of exclusive contributions that had to be recomputed since the construction of the tracker.
+ *
+ * @return number of recomputed contributions.
+ */
+unsigned int contribution_tracker::get_recomputed() const
+{
+	return m_recomputed;
+}
+
+// Mark as stale the contributions that might change when the point idx enters or leaves the set.
+void contribution_tracker::invalidate_neighbours(const unsigned int idx)
+{
+	const fitness_vector &p = m_points[idx];
+	const fitness_vector::size_type f_dim = p.size();
+	fitness_vector m(f_dim);
+	for (unsigned int q = 0; q < m_points.size(); ++q) {
+		if (q == idx || m_stale[q]) {
+			continue;
+		}
+		// Region dominated by both p and q.
+		for (fitness_vector::size_type k = 0; k < f_dim; ++k) {
+			m[k] = std::max(p[k],m_points[q][k]);
+		}
+		// If a third point dominates it, the exclusive region of q does not overlap with the one of p.
+		bool covered = false;
+		for (unsigned int s = 0; s < m_points.size() && !covered; ++s) {
+			if (s == idx || s == q) {
+				continue;
+			}
+			covered = true;
+			for (fitness_vector::size_type k = 0; k < f_dim; ++k) {
+				if (m_points[s][k] > m[k]) {
+					covered = false;
+					break;
+				}
+			}
+		}
+		if (!covered) {
+			m_stale[q] = 1;
+			++m_n_stale;
+		}
+	}
+}
+
+// Recompute the stale contributions.
+void contribution_tracker::update() const
+{
+	if (!m_n_stale) {
+		return;
+	}
+	const unsigned int n = m_points.size();
+	if (n == 1) {
+		m_contributions[0] = hv_algorithm::base::volume_between(m_points[0], m_ref_point);
+	} else if (m_ref_point.size() <= 3 || 2 * m_n_stale >= n) {
+		// All at once: O(n log n) in 2 and 3 dimensions.
+		// NOTE: the temporary hypervolume objects own a copy of the points, so they can let the algorithms alter it.
+		hypervolume hv(m_points, false);
+		hv.set_copy_points(false);
+		m_contributions = m_hv_algorithm ? hv.contributions(m_ref_point, m_hv_algorithm) : hv.contributions(m_ref_point);
+	} else {
+		// One by one: contribution = total hypervolume - hypervolume without the point.
+		hypervolume all(m_points, false);
+		all.set_copy_points(false);
+		const double total = m_hv_algorithm ? all.compute(m_ref_point, m_hv_algorithm) : all.compute(m_ref_point);
+		std::vector<fitness_vector> others(m_points.begin() + 1, m_points.end());
+		for (unsigned int i = 0; i < n; ++i) {
+			if (i) {
+				// others contains all the points but the i-th one.
+				others[i - 1] = m_points[i - 1];
+			}
+			if (!m_stale[i]) {
+				continue;
+			}
+			hypervolume hv(others, false);
+			hv.set_copy_points(false);
+			m_contributions[i] = total - (m_hv_algorithm ? hv.compute(m_ref_point, m_hv_algorithm) : hv.compute(m_ref_point));
+		}
+	}
+	m_recomputed += m_n_stale;
+	m_stale.assign(n,0);
+	m_n_stale = 0;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hypervolume)
@@ -38,6 +38,7 @@
 #include "hv_algorithm/bf_fpras.h"
 #include "hv_algorithm/hoy.h"
 #include "hv_algorithm/fpl.h"
+#include "hv_algorithm/adaptive.h"
 
 namespace pagmo { namespace util {
 
@@ -110,6 +111,55 @@ private:
 	}
 };
 
+/// Incremental tracker of exclusive hypervolume contributions.
+/**
+ * Keeps a set of points together with the exclusive contribution of each of them, and updates the contributions
+ * when points are inserted or erased. This is useful when the point set changes by few points at a time,
+ * e.g., in steady-state algorithms such as SMS-EMOA, where one point enters and one point leaves the front at each step.
+ *
+ * Inserting or erasing a point p can only change the contribution of a point q if the region dominated by both p and q
+ * is not already dominated by a third point of the set, i.e., if no other point weakly dominates the component-wise maximum of p and q.
+ * The tracker applies this test (at a cost of O(n^2 * d) per update) and recomputes only the contributions of the points that fail it,
+ * lazily, when the contributions are requested. The contributions are exact for any dimension: in 2 and 3 dimensions the stale
+ * contributions are refreshed all at once via the dedicated O(n log n) algorithms, in higher dimensions each stale contribution
+ * is obtained as the difference between the total hypervolume and the hypervolume of the set without the point (unless most contributions are stale,
+ * in which case all the contributions are recomputed).
+ *
+ * Changing the reference point invalidates all the contributions.
+ */
+class __PAGMO_VISIBLE contribution_tracker
+{
+public:
+	contribution_tracker(const hv_algorithm::base_ptr = hv_algorithm::base_ptr());
+
+	void assign(const std::vector<fitness_vector> &, const fitness_vector &);
+	void insert(const fitness_vector &);
+	void erase(const unsigned int);
+	void clear();
+
+	void set_reference_point(const fitness_vector &);
+	const fitness_vector &get_reference_point() const;
+	const std::vector<fitness_vector> &get_points() const;
+	unsigned int size() const;
+
+	double contribution(const unsigned int) const;
+	const std::vector<double> &contributions() const;
+	unsigned int least_contributor() const;
+	unsigned int get_recomputed() const;
+
+private:
+	void invalidate_neighbours(const unsigned int);
+	void update() const;
+
+	hv_algorithm::base_ptr m_hv_algorithm;
+	fitness_vector m_ref_point;
+	std::vector<fitness_vector> m_points;
+	mutable std::vector<double> m_contributions;
+	mutable std::vector<char> m_stale;
+	mutable unsigned int m_n_stale;
+	mutable unsigned int m_recomputed;
+};
+
 }}
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hypervolume)
@@ -18,12 +18,60 @@ namespace pagmo{ namespace util {namespace neighbourhood {
  * @param[in]  weights the vector of real vectors
  */
 void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &retval, const std::vector<std::vector<double> > &weights) {
-	for(unsigned int i = 0; i < weights.size(); ++i) {
-		std::vector<double> distances;
-		for(unsigned int j = 0; j < weights.size(); ++j) {
-			distances.push_back(distance(weights[i],weights[j]));
+	std::vector<std::vector<pagmo::population::size_type> > nearest;
+	compute_neighbours(nearest, weights, weights.empty() ? 0 : weights.size() - 1);
+	retval.insert(retval.end(), nearest.begin(), nearest.end());
+}
+
+/**
+ * Compute the k-nearest neighbours graph. At the end of the call retval[i][0] will be i and retval[i][j], j = 1..k,
+ * will contain the j-th closest vector (according to the euclidian distance) to the i-th vector, ties being broken by index.
+ * Only the k closest vectors are selected (std::partial_sort on the squared distances, computed from a contiguous copy of the weights),
+ * so that the cost is O(N^2 (d + log k)) time and O(N k) memory instead of sorting the whole distance matrix.
+ * @param[out] retval a matrix representing the neigborhood graph (its previous content is discarded)
+ * @param[in]  weights the vector of real vectors
+ * @param[in]  k number of neighbours (clamped to weights.size() - 1)
+ */
+void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &retval, const std::vector<std::vector<double> > &weights, const pagmo::population::size_type k) {
+	const pagmo::population::size_type n = weights.size();
+	retval.assign(n, std::vector<pagmo::population::size_type>());
+	if (n == 0) {
+		return;
+	}
+	const std::vector<double>::size_type dim = weights[0].size();
+	const pagmo::population::size_type n_neigh = std::min(k, n - 1);
+
+	// Contiguous copy of the weights.
+	std::vector<double> flat(n * dim);
+	for (pagmo::population::size_type i = 0; i < n; ++i) {
+		if (weights[i].size() != dim) {
+			pagmo_throw(value_error, "All the vectors must have the same size");
+		}
+		std::copy(weights[i].begin(), weights[i].end(), flat.begin() + i * dim);
+	}
+
+	// (squared distance, index) pairs, reused across the rows.
+	std::vector<std::pair<double, pagmo::population::size_type> > candidates(n - 1);
+	for (pagmo::population::size_type i = 0; i < n; ++i) {
+		const double *a = &flat[0] + i * dim;
+		pagmo::population::size_type c = 0;
+		for (pagmo::population::size_type j = 0; j < n; ++j) {
+			if (j == i) {
+				continue;
+			}
+			const double *b = &flat[0] + j * dim;
+			double d2 = 0.0;
+			for (std::vector<double>::size_type l = 0; l < dim; ++l) {
+				d2 += (a[l] - b[l]) * (a[l] - b[l]);
+			}
+			candidates[c++] = std::make_pair(d2, j);
+		}
+		std::partial_sort(candidates.begin(), candidates.begin() + n_neigh, candidates.end());
+		retval[i].reserve(n_neigh + 1);
+		retval[i].push_back(i);
+		for (pagmo::population::size_type j = 0; j < n_neigh; ++j) {
+			retval[i].push_back(candidates[j].second);
 		}
-		retval.push_back(order(distances));
 	}
 }
 
@@ -36,7 +84,7 @@ void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::si
 double euclidian::distance(const std::vector<double> &a, const std::vector<double> &b) {
 	double rtr = 0.0;
 	for(std::vector<double>::size_type i = 0; i < a.size(); ++i) {
-		rtr += pow(a[i]-b[i], 2);
+		rtr += (a[i]-b[i]) * (a[i]-b[i]);
 	}
 	return sqrt(rtr);
 }
@@ -69,6 +69,7 @@ template<class T> std::vector<population::size_type> order(const std::vector<T>
 class __PAGMO_VISIBLE euclidian {
 public:
 	static void compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &, const std::vector<std::vector<double> > &);
+	static void compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &, const std::vector<std::vector<double> > &, const pagmo::population::size_type);
 	static double distance(const std::vector<double> &, const std::vector<double> &);
 };
 
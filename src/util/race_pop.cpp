@@ -1,12 +1,28 @@
 #include "race_pop.h"
 #include "../problem/ackley.h"
 #include "../problem/base_stochastic.h"
-
+#include "../thread_pool.h"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/function.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
 #include <map>
 #include <utility>
 
 namespace pagmo { namespace util { namespace racing {
 
+namespace {
+
+double elapsed_seconds(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1E-6;
+}
+
+}
+
 /// Constructor
 /**
  * Construct a race_pop object from an external population and a seed. The seed
@@ -15,7 +31,8 @@ namespace pagmo { namespace util { namespace racing {
  * @param[in] pop population containing the individuals to race
  * @param[in] seed seed of the race
  */
-race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed), m_pop(pop), m_pop_wilcoxon(pop), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(pop.size()), m_cache_averaged_data(pop.size())
+race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed), m_pop(pop), m_pop_wilcoxon(pop), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(pop.size()), m_cache_averaged_data(pop.size()),
+	m_n_threads(1), m_eval_problems(), m_eval_time(0), m_wall_time(0)
 {
 	register_population(pop);
 }
@@ -28,7 +45,8 @@ race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed),
  *
  * @param[in] seed seed of the race
  */
-race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(problem::ackley())), m_pop_wilcoxon(population(problem::ackley())), m_pop_registered(false), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(0), m_cache_averaged_data(0)
+race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(problem::ackley())), m_pop_wilcoxon(population(problem::ackley())), m_pop_registered(false), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(0), m_cache_averaged_data(0),
+	m_n_threads(1), m_eval_problems(), m_eval_time(0), m_wall_time(0)
 {
 }
 
@@ -41,6 +59,7 @@ race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(probl
 void race_pop::register_population(const population &pop)
 {
 	m_pop = pop;
+	m_eval_problems.clear();
 	// This is merely to set up the problem in wilcoxon pop
 	m_pop_wilcoxon = pop;
 	reset_cache();
@@ -162,8 +181,18 @@ std::vector<population::size_type> race_pop::construct_output_list(
 // @return The number of objective function calls made
 unsigned int race_pop::prepare_population_friedman(const std::vector<population::size_type>& in_race, unsigned int count_iter)
 {
-	unsigned int count_nfes = 0;
-	// Perform re-evaluation on necessary individuals under current seed
+	// Re-evaluate under current seed the racers with no previous data that
+	// can be reused
+	std::vector<population::size_type> to_evaluate;
+	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
+		if(!m_use_caching || !cache_data_exist(*it, count_iter-1)){
+			to_evaluate.push_back(*it);
+		}
+	}
+	std::vector<eval_data> evaluated;
+	evaluate(to_evaluate, evaluated);
+
+	std::vector<eval_data>::const_iterator eval_it = evaluated.begin();
 	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
 		// Case 1: Current racer has previous data that can be reused, no
 		// need to be evaluated with this seed
@@ -171,19 +200,16 @@ unsigned int race_pop::prepare_population_friedman(const std::vector<population:
 			const eval_data& cached_data = cache_get_entry(*it, count_iter-1);
 			m_pop.set_fc(*it, cached_data.f, cached_data.c);
 		}
-		// Case 2: No previous data can be reused, perform actual
-		// re-evaluation and update the cache
+		// Case 2: No previous data can be reused, use the re-evaluation
+		// and update the cache
 		else{
-			count_nfes++;
-			const population::individual_type &ind = m_pop.get_individual(*it);
-			fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-			constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
-			m_pop.set_fc(*it, f_vec, c_vec);
+			m_pop.set_fc(*it, eval_it->f, eval_it->c);
 			if(m_use_caching)
-				cache_insert_data(*it, f_vec, c_vec);
+				cache_insert_data(*it, eval_it->f, eval_it->c);
+			++eval_it;
 		}
 	}
-	return count_nfes;
+	return to_evaluate.size();
 }
 
 /// Update m_pop_wilcoxon to contain evaluation data required for Wilcoxon test
@@ -194,7 +220,6 @@ unsigned int race_pop::prepare_population_friedman(const std::vector<population:
  **/
 unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population::size_type>& in_race, unsigned int count_iter)
 {
-	unsigned int count_nfes = 0;
 	if(in_race.size() != 2){
 		pagmo_throw(value_error, "Wilcoxon rank sum test is only applicable when there are two active individuals");
 	}	
@@ -211,6 +236,21 @@ unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population:
 	else{
 		start_count_iter = count_iter;
 	}
+	// Re-evaluations are performed in one go, in the same order as they are
+	// consumed below. The cache is filled only with contiguous data, hence
+	// whether a data point exists does not change within the loop.
+	std::vector<population::size_type> to_evaluate;
+	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
+		for(unsigned int i = start_count_iter; i <= count_iter; i++){
+			if(!m_use_caching || !cache_data_exist(*it, i-1)){
+				to_evaluate.push_back(*it);
+			}
+		}
+	}
+	std::vector<eval_data> evaluated;
+	evaluate(to_evaluate, evaluated);
+
+	std::vector<eval_data>::const_iterator eval_it = evaluated.begin();
 	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
 		decision_vector dummy_x;
 		for(unsigned int i = start_count_iter; i <= count_iter; i++){
@@ -221,21 +261,91 @@ unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population:
 				const eval_data& cached_data = cache_get_entry(*it, i-1);
 				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, cached_data.f, cached_data.c);
 			}
-			// Case 2: No previous data can be reused, perform actual
-			// re-evaluation and update the cache
+			// Case 2: No previous data can be reused, use the re-evaluation
+			// and update the cache
 			else{
-				count_nfes++;
-				const population::individual_type &ind = m_pop.get_individual(*it);
-				fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-				constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
 				m_pop_wilcoxon.push_back_noeval(dummy_x);
-				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, f_vec, c_vec);
+				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, eval_it->f, eval_it->c);
 				if(m_use_caching)
-					cache_insert_data(*it, f_vec, c_vec);
+					cache_insert_data(*it, eval_it->f, eval_it->c);
+				++eval_it;
+			}
+		}
+	}
+	return to_evaluate.size();
+}
+
+/// Re-evaluates individuals under the current seed
+/**
+ * The individuals are split in contiguous blocks among at most race_pop::get_threads()
+ * tasks. The first block is evaluated in the calling thread with the problem of the
+ * registered population, the others on the shared thread pool, each with its own cached copy
+ * of the problem. Problems that are not thread-safe (see problem::base::is_thread_safe())
+ * are always evaluated in the calling thread.
+ * The time spent evaluating and the elapsed time are accumulated to measure the speedup.
+ *
+ * @param[in] ind_list indices of the individuals to evaluate (repetitions allowed)
+ * @param[out] retval fitness and constraint vectors, in the order of ind_list
+ */
+void race_pop::evaluate(const std::vector<population::size_type> &ind_list, std::vector<eval_data> &retval)
+{
+	typedef std::vector<population::size_type>::size_type size_type;
+	retval.resize(ind_list.size());
+	if(ind_list.empty()){
+		return;
+	}
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	const problem::base &prob = m_pop.problem();
+	const size_type n_tasks = prob.is_thread_safe() ? std::min<size_type>(get_threads(), ind_list.size()) : 1;
+	std::vector<double> busy(n_tasks, 0.);
+	if(n_tasks == 1){
+		evaluate_range(prob, m_pop, ind_list, retval, 0, ind_list.size(), busy[0]);
+	}
+	else{
+		// The copies are built on first use and kept until a new population is registered.
+		// They are brought to the current seed of the race before being used.
+		const unsigned int seed = dynamic_cast<const problem::base_stochastic &>(prob).get_seed();
+		while(m_eval_problems.size() < n_tasks - 1){
+			m_eval_problems.push_back(prob.clone());
+		}
+		std::vector<unsigned int> fevals(n_tasks - 1), cevals(n_tasks - 1);
+		std::vector<boost::function<void ()> > tasks;
+		for(size_type t = 0; t < n_tasks; t++){
+			if(t > 0){
+				const problem::base_stochastic &clone = dynamic_cast<const problem::base_stochastic &>(*m_eval_problems[t - 1]);
+				if(clone.get_seed() != seed){
+					clone.set_seed(seed);
+				}
+				fevals[t - 1] = clone.get_fevals();
+				cevals[t - 1] = clone.get_cevals();
 			}
+			tasks.push_back(boost::bind(&race_pop::evaluate_range, boost::cref(t == 0 ? prob : *m_eval_problems[t - 1]), boost::cref(m_pop),
+				boost::cref(ind_list), boost::ref(retval), (t * ind_list.size()) / n_tasks, ((t + 1) * ind_list.size()) / n_tasks, boost::ref(busy[t])));
 		}
+		thread_pool::shared().run_all(tasks);
+		// The evaluations done on the copies are accounted to the problem of the registered population.
+		for(size_type t = 1; t < n_tasks; t++){
+			prob.m_fevals += m_eval_problems[t - 1]->get_fevals() - fevals[t - 1];
+			prob.m_cevals += m_eval_problems[t - 1]->get_cevals() - cevals[t - 1];
+		}
+	}
+	m_wall_time += elapsed_seconds(start);
+	for(size_type t = 0; t < n_tasks; t++){
+		m_eval_time += busy[t];
 	}
-	return count_nfes;
+}
+
+// Evaluates the individuals in the positions [begin,end) of ind_list, storing the time taken in busy.
+void race_pop::evaluate_range(const problem::base &prob, const population &pop, const std::vector<population::size_type> &ind_list, std::vector<eval_data> &retval,
+	std::vector<population::size_type>::size_type begin, std::vector<population::size_type>::size_type end, double &busy)
+{
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for(std::vector<population::size_type>::size_type i = begin; i < end; i++){
+		const decision_vector &x = pop.get_individual(ind_list[i]).cur_x;
+		retval[i].f = prob.objfun(x);
+		retval[i].c = prob.compute_constraints(x);
+	}
+	busy = elapsed_seconds(start);
 }
 
 /// Computes the required number of actual fevals to complete the current iteration
@@ -700,6 +810,63 @@ void race_pop::set_seed(unsigned int seed)
 	reset_cache();
 }
 
+/// Set the number of threads used for re-evaluations.
+/**
+ * Each racing iteration re-evaluates the active individuals under the same seed. These
+ * evaluations are split among n threads, each using its own copy of the problem. As copying
+ * the problem has a cost, this pays off only for expensive objective functions. The setting
+ * is ignored for problems that are not thread-safe (see problem::base::is_thread_safe()),
+ * which are always evaluated in the calling thread.
+ *
+ * @param[in] n number of threads, 0 to use the number of hardware threads
+ */
+void race_pop::set_threads(unsigned int n)
+{
+	m_n_threads = n;
+}
+
+/// Get the number of threads used for re-evaluations.
+/**
+ * @return the number of threads, resolving 0 to the number of hardware threads
+ */
+unsigned int race_pop::get_threads() const
+{
+	if(m_n_threads == 0){
+		return std::max(1u, boost::thread::hardware_concurrency());
+	}
+	return m_n_threads;
+}
+
+/// Total time spent in objective function and constraint evaluations.
+/**
+ * @return the sum, over all the threads, of the seconds spent in re-evaluations since construction
+ */
+double race_pop::get_eval_time() const
+{
+	return m_eval_time;
+}
+
+/// Total elapsed time of the re-evaluations.
+/**
+ * @return the wall-clock seconds spent in re-evaluations since construction
+ */
+double race_pop::get_wall_time() const
+{
+	return m_wall_time;
+}
+
+/// Speedup achieved by the parallel re-evaluations.
+/**
+ * @return race_pop::get_eval_time() divided by race_pop::get_wall_time(), or 1 if nothing was evaluated yet
+ */
+double race_pop::get_speedup() const
+{
+	if(m_wall_time <= 0){
+		return 1.;
+	}
+	return m_eval_time / m_wall_time;
+}
+
 // Produce new seeds and append to the list of seeds
 void race_pop::generate_seeds(unsigned int num_seeds)
 {
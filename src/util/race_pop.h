@@ -56,6 +56,12 @@ namespace racing{
  * Currently the racing is implemented based on F-Race, which invokes Friedman
  * test iteratively during each race.
  *
+ * The re-evaluations of each racing iteration can be split among several threads
+ * (see race_pop::set_threads), each working on its own copy of the problem. As all the
+ * evaluations of an iteration share the same seed, the results are identical to the
+ * sequential ones for problems whose objective function only depends on the seed and on
+ * the decision vector (see pagmo::problem::base_stochastic).
+ *
  */
 class __PAGMO_VISIBLE race_pop
 {
@@ -88,6 +94,11 @@ public:
 	void inherit_memory(const race_pop&);
 	std::vector<fitness_vector> get_mean_fitness(const std::vector<population::size_type> &active_set = std::vector<population::size_type>()) const;
 	void set_seed(unsigned int);
+	void set_threads(unsigned int);
+	unsigned int get_threads() const;
+	double get_eval_time() const;
+	double get_wall_time() const;
+	double get_speedup() const;
 
 private:
 	// Helper methods to validate input data
@@ -109,6 +120,11 @@ private:
 		constraint_vector c;
 	};
 
+	// Re-evaluation of the individuals under the current seed
+	void evaluate(const std::vector<population::size_type> &, std::vector<eval_data> &);
+	static void evaluate_range(const problem::base &, const population &, const std::vector<population::size_type> &, std::vector<eval_data> &,
+		std::vector<population::size_type>::size_type, std::vector<population::size_type>::size_type, double &);
+
 	std::vector<population::size_type> construct_output_list(
 			const std::vector<racer_type>& racers,
 			const std::vector<population::size_type>& decided,
@@ -140,6 +156,12 @@ private:
 	std::vector<std::vector<eval_data> > m_cache_data;
 	std::vector<eval_data> m_cache_averaged_data;
 	std::vector<decision_vector> m_cache_signatures;
+
+	// Parallel re-evaluation
+	unsigned int m_n_threads;
+	std::vector<problem::base_ptr> m_eval_problems;
+	double m_eval_time;
+	double m_wall_time;
 };
 
 }}}
@@ -54,6 +54,7 @@ void racing_population::set_x_noeval(const size_type idx, const decision_vector
 	}
 	// Set decision vector.
 	m_container[idx].cur_x = x;
+	update_soa(idx);
 }
 
 /// Update directly fitness and constraint
@@ -85,6 +86,7 @@ void racing_population::set_fc(const size_type idx, const fitness_vector &f, con
 	m_container[idx].best_f = f;
 	m_container[idx].best_c = c;
 	update_dom(idx);
+	update_soa(idx);
 }
 
 
@@ -0,0 +1,237 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <vector>
+
+#include "../exceptions.h"
+#include "soa_matrix.h"
+
+namespace pagmo { namespace util {
+
+/// Constructor from number of columns.
+/**
+ * Builds an empty matrix whose rows will have the given number of columns.
+ *
+ * @param[in] cols number of columns.
+ */
+soa_matrix::soa_matrix(size_type cols):m_data(),m_rows(0),m_cols(cols),m_stride(cols + (cols & 1u)) {}
+
+/// Number of rows.
+/**
+ * @return the number of rows.
+ */
+soa_matrix::size_type soa_matrix::rows() const
+{
+	return m_rows;
+}
+
+/// Number of columns.
+/**
+ * @return the number of columns.
+ */
+soa_matrix::size_type soa_matrix::cols() const
+{
+	return m_cols;
+}
+
+/// Distance between consecutive rows.
+/**
+ * @return the number of doubles between the beginnings of two consecutive rows (the number of columns rounded up to an even number).
+ */
+soa_matrix::size_type soa_matrix::stride() const
+{
+	return m_stride;
+}
+
+/// Pointer to a row.
+/**
+ * @param[in] i row index.
+ *
+ * @return pointer to the first element of the i-th row, aligned for SIMD access.
+ */
+double *soa_matrix::row(size_type i)
+{
+	pagmo_assert(i < m_rows);
+	return data() + i * m_stride;
+}
+
+/// Constant pointer to a row.
+/**
+ * @param[in] i row index.
+ *
+ * @return constant pointer to the first element of the i-th row, aligned for SIMD access.
+ */
+const double *soa_matrix::row(size_type i) const
+{
+	pagmo_assert(i < m_rows);
+	return data() + i * m_stride;
+}
+
+/// Eigen view of a row.
+/**
+ * @param[in] i row index.
+ *
+ * @return aligned Eigen map of the i-th row.
+ */
+soa_matrix::row_view_type soa_matrix::row_view(size_type i)
+{
+	return row_view_type(row(i),static_cast<Eigen::DenseIndex>(m_cols));
+}
+
+/// Constant Eigen view of a row.
+/**
+ * @param[in] i row index.
+ *
+ * @return constant aligned Eigen map of the i-th row.
+ */
+soa_matrix::const_row_view_type soa_matrix::row_view(size_type i) const
+{
+	return const_row_view_type(row(i),static_cast<Eigen::DenseIndex>(m_cols));
+}
+
+/// Eigen view of a column.
+/**
+ * @param[in] j column index.
+ *
+ * @return strided Eigen map of the j-th column.
+ */
+soa_matrix::col_view_type soa_matrix::col_view(size_type j)
+{
+	pagmo_assert(j < m_cols);
+	return col_view_type(data() + j,static_cast<Eigen::DenseIndex>(m_rows),Eigen::InnerStride<>(static_cast<Eigen::DenseIndex>(m_stride)));
+}
+
+/// Constant Eigen view of a column.
+/**
+ * @param[in] j column index.
+ *
+ * @return constant strided Eigen map of the j-th column.
+ */
+soa_matrix::const_col_view_type soa_matrix::col_view(size_type j) const
+{
+	pagmo_assert(j < m_cols);
+	return const_col_view_type(data() + j,static_cast<Eigen::DenseIndex>(m_rows),Eigen::InnerStride<>(static_cast<Eigen::DenseIndex>(m_stride)));
+}
+
+/// Set a row.
+/**
+ * @param[in] i row index.
+ * @param[in] v vector to be copied into the i-th row.
+ */
+void soa_matrix::set_row(size_type i, const std::vector<double> &v)
+{
+	pagmo_assert(v.size() == m_cols);
+	std::copy(v.begin(),v.end(),row(i));
+}
+
+/// Copy a row over another one.
+/**
+ * @param[in] from index of the source row.
+ * @param[in] to index of the destination row.
+ */
+void soa_matrix::copy_row(size_type from, size_type to)
+{
+	if (from != to) {
+		std::copy(row(from),row(from) + m_cols,row(to));
+	}
+}
+
+/// Change the number of rows.
+/**
+ * Rows are added or removed at the end: the first rows keep their content, the new rows are filled with zeroes.
+ *
+ * @param[in] rows new number of rows.
+ */
+void soa_matrix::resize(size_type rows)
+{
+	const size_type size = rows * m_stride, capacity = static_cast<size_type>(m_data.size());
+	if (size > capacity) {
+		// The capacity grows geometrically, so that appending rows takes amortised constant time.
+		m_data.conservativeResize(static_cast<Eigen::DenseIndex>(std::max(size,2 * capacity)));
+	}
+	if (rows > m_rows) {
+		std::fill(data() + m_rows * m_stride,data() + size,0.);
+	}
+	m_rows = rows;
+}
+
+/// Remove a row.
+/**
+ * The rows after i are shifted up by one position.
+ *
+ * @param[in] i index of the row to be removed.
+ */
+void soa_matrix::erase(size_type i)
+{
+	pagmo_assert(i < m_rows);
+	std::copy(data() + (i + 1) * m_stride,data() + m_rows * m_stride,data() + i * m_stride);
+	--m_rows;
+}
+
+/// Remove all rows.
+/**
+ * The memory of the matrix is freed.
+ */
+void soa_matrix::clear()
+{
+	m_data.resize(0);
+	m_rows = 0;
+}
+
+/// Remove all rows and change the number of columns.
+/**
+ * @param[in] cols new number of columns.
+ */
+void soa_matrix::reset(size_type cols)
+{
+	clear();
+	m_cols = cols;
+	m_stride = cols + (cols & 1u);
+}
+
+/// Swap content.
+/**
+ * @param[in,out] other matrix whose content will be swapped with this.
+ */
+void soa_matrix::swap(soa_matrix &other)
+{
+	m_data.swap(other.m_data);
+	std::swap(m_rows,other.m_rows);
+	std::swap(m_cols,other.m_cols);
+	std::swap(m_stride,other.m_stride);
+}
+
+double *soa_matrix::data()
+{
+	return m_data.size() ? m_data.data() : 0;
+}
+
+const double *soa_matrix::data() const
+{
+	return m_data.size() ? m_data.data() : 0;
+}
+
+}}
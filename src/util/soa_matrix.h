@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_SOA_MATRIX_H
+#define PAGMO_UTIL_SOA_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../Eigen/Core"
+#include "../config.h"
+
+namespace pagmo { namespace util {
+
+/// Contiguous matrix of doubles with one row per individual.
+/**
+ * This class stores a set of equally sized vectors (the rows) one after the other in a single buffer aligned
+ * for SIMD access, so that the same component of all the rows is found at a fixed stride and each row starts on an aligned address
+ * (the rows are padded to an even number of doubles). It is the storage behind the structure-of-arrays view of the
+ * population (see population::soa()), which can be accessed through raw pointers or through the
+ * Eigen maps returned by row_view() and col_view().
+ *
+ * Rows are appended and removed at the end (see resize()) in amortised constant time.
+ */
+class __PAGMO_VISIBLE soa_matrix
+{
+	public:
+		/// Size type.
+		typedef std::size_t size_type;
+		/// Mutable view of a row.
+		typedef Eigen::Map<Eigen::VectorXd,Eigen::Aligned> row_view_type;
+		/// Constant view of a row.
+		typedef Eigen::Map<const Eigen::VectorXd,Eigen::Aligned> const_row_view_type;
+		/// Mutable view of a column.
+		typedef Eigen::Map<Eigen::VectorXd,Eigen::Unaligned,Eigen::InnerStride<> > col_view_type;
+		/// Constant view of a column.
+		typedef Eigen::Map<const Eigen::VectorXd,Eigen::Unaligned,Eigen::InnerStride<> > const_col_view_type;
+		explicit soa_matrix(size_type = 0);
+		size_type rows() const;
+		size_type cols() const;
+		size_type stride() const;
+		double *row(size_type);
+		const double *row(size_type) const;
+		row_view_type row_view(size_type);
+		const_row_view_type row_view(size_type) const;
+		col_view_type col_view(size_type);
+		const_col_view_type col_view(size_type) const;
+		void set_row(size_type, const std::vector<double> &);
+		void copy_row(size_type, size_type);
+		void resize(size_type);
+		void erase(size_type);
+		void clear();
+		void reset(size_type);
+		void swap(soa_matrix &);
+	private:
+		double *data();
+		const double *data() const;
+
+		// Aligned storage of the rows, whose size is the capacity of the matrix.
+		Eigen::VectorXd		m_data;
+		size_type		m_rows;
+		size_type		m_cols;
+		size_type		m_stride;
+};
+
+}}
+
+#endif
@@ -0,0 +1,187 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+// Microbenchmark of the DE strategy kernels: per-generation time of de::evolve against
+// the previous implementation (strategy dispatched per individual, all five members always drawn).
+
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// The DE main loop as it was before the strategy kernels were introduced.
+void legacy_de(population &pop, int m_gen, double m_f, double m_cr, int m_strategy, rng_uint32 &m_urng, rng_double &m_drng)
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type NP = pop.size();
+	decision_vector dummy(D), tmp(D);
+	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
+	decision_vector gbX(D),gbIter(D);
+	fitness_vector newfitness(1), gbfit(1);
+	std::vector<fitness_vector> fit(NP,gbfit);
+	std::vector<decision_vector> trial(NP,dummy);
+	std::vector<fitness_vector> trialfit(NP,gbfit);
+	for (population::size_type i = 0; i < NP; ++i) {
+		popold[i] = pop.get_individual(i).cur_x;
+		fit[i] = pop.get_individual(i).cur_f;
+	}
+	popnew = popold;
+	gbX = pop.champion().x;
+	gbfit = pop.champion().f;
+	gbIter = gbX;
+	size_t r1,r2,r3,r4,r5;
+	for (int gen = 0; gen < m_gen; ++gen) {
+		for (size_t i = 0; i < NP; ++i) {
+			do {
+				r1 = boost::uniform_int<int>(0,NP-1)(m_urng);
+			} while (r1==i);
+			do {
+				r2 = boost::uniform_int<int>(0,NP-1)(m_urng);
+			} while ((r2==i) || (r2==r1));
+			do {
+				r3 = boost::uniform_int<int>(0,NP-1)(m_urng);
+			} while ((r3==i) || (r3==r1) || (r3==r2));
+			do {
+				r4 = boost::uniform_int<int>(0,NP-1)(m_urng);
+			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
+			do {
+				r5 = boost::uniform_int<int>(0,NP-1)(m_urng);
+			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
+			tmp = popold[i];
+			if (m_strategy <= 5) {
+				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
+				do {
+					if (m_strategy == 1) {
+						tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
+					} else if (m_strategy == 2) {
+						tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
+					} else if (m_strategy == 3) {
+						tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
+					} else if (m_strategy == 4) {
+						tmp[n] = gbIter[n] + (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
+					} else {
+						tmp[n] = popold[r5][n] + (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
+					}
+					n = (n+1)%Dc;
+					++L;
+				} while ((m_drng() < m_cr) && (L < Dc));
+			} else {
+				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
+				for (size_t L = 0; L < Dc; ++L) {
+					if ((m_drng() < m_cr) || L + 1 == Dc) {
+						if (m_strategy == 6) {
+							tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
+						} else if (m_strategy == 7) {
+							tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
+						} else if (m_strategy == 8) {
+							tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
+						} else if (m_strategy == 9) {
+							tmp[n] = gbIter[n] + (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
+						} else {
+							tmp[n] = popold[r5][n] + (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
+						}
+					}
+					n = (n+1)%Dc;
+				}
+			}
+			for (size_t i2 = 0; i2 < Dc; ++i2) {
+				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
+					tmp[i2] = boost::uniform_real<double>(lb[i2],ub[i2])(m_drng);
+			}
+			trial[i] = tmp;
+		}
+		prob.batch_objfun(trialfit, trial);
+		for (size_t i = 0; i < NP; ++i) {
+			tmp = trial[i];
+			newfitness = trialfit[i];
+			if (prob.compare_fitness(newfitness,fit[i])) {
+				fit[i] = newfitness;
+				popnew[i] = tmp;
+				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+				pop.set_x(i,popnew[i]);
+				pop.set_v(i,tmp);
+				if (prob.compare_fitness(newfitness,gbfit)) {
+					gbfit = newfitness;
+					gbX = popnew[i];
+				}
+			} else {
+				popnew[i] = popold[i];
+			}
+		}
+		gbIter = gbX;
+		std::swap(popold, popnew);
+	}
+}
+
+// Time both implementations on the same problem and check that the kernels still optimise.
+int bench(const problem::base &prob, int strategy)
+{
+	const int n_gen = 200;
+	const population::size_type NP = 40;
+	rng_uint32 urng(42);
+	rng_double drng(42);
+	// xtol/ftol are disabled so that both implementations run all the generations.
+	algorithm::de algo(n_gen, 0.7, 0.9, strategy, 0, 0);
+	population pop_legacy(prob, NP, 42), pop_new(pop_legacy);
+	const double f0 = pop_new.champion().f[0];
+
+	std::clock_t start = std::clock();
+	legacy_de(pop_legacy, n_gen, 0.7, 0.9, strategy, urng, drng);
+	const double legacy_us = double(std::clock() - start) / CLOCKS_PER_SEC * 1e6 / n_gen;
+
+	start = std::clock();
+	algo.evolve(pop_new);
+	const double new_us = double(std::clock() - start) / CLOCKS_PER_SEC * 1e6 / n_gen;
+
+	std::cout << std::setw(12) << prob.get_name().substr(0,12) << " strategy " << std::setw(2) << strategy
+		<< std::fixed << std::setprecision(2)
+		<< " | legacy: " << std::setw(9) << legacy_us << " us/gen"
+		<< " | kernels: " << std::setw(9) << new_us << " us/gen"
+		<< " | speedup: " << legacy_us / new_us << std::endl;
+	std::cout.unsetf(std::ios::floatfield);
+	if (!(pop_new.champion().f[0] < f0)) {
+		std::cout << "    no improvement over the initial champion!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	problem::rosenbrock rosenbrock(30);
+	problem::rastrigin rastrigin(30);
+	int retval = 0;
+	for (int strategy = 1; strategy <= 10; ++strategy) {
+		retval += bench(rosenbrock, strategy);
+		retval += bench(rastrigin, strategy);
+	}
+	return retval;
+}
@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -56,7 +57,7 @@ class hypervolume_test
 {
 public:
 	hypervolume_test(std::istream &input, dual_stream &output, std::string test_type, std::string method_name, double eps)
-		: m_input(input), m_output(output), m_test_type(test_type), m_eps(eps) {
+		: m_input(input), m_output(output), m_test_type(test_type), m_eps(eps), m_approx(false), m_n_approx(0) {
 
 		// create correct algorithm object
 		if (method_name == "hv2d") {
@@ -67,6 +68,9 @@ public:
 			m_method = util::hv_algorithm::hv4d().clone();
 		} else if (method_name == "wfg") {
 			m_method = util::hv_algorithm::wfg().clone();
+		} else if (method_name == "wfg_parallel") {
+			// Top level of the computation split among the hardware threads
+			m_method = util::hv_algorithm::wfg(2, 0).clone();
 		} else if (method_name == "fpl") {
 			m_method = util::hv_algorithm::fpl().clone();
 		} else if (method_name == "hoy") {
@@ -75,6 +79,16 @@ public:
 			m_method = util::hv_algorithm::bf_approx().clone();
 		} else if (method_name == "bf_fpras") {
 			m_method = util::hv_algorithm::bf_fpras(0.1, 0.1).clone();
+		} else if (method_name == "adaptive") {
+			m_method = util::hv_algorithm::adaptive().clone();
+		} else if (method_name == "adaptive_time") {
+			// A time limit too short for any exact computation forces the approximation
+			m_method = util::hv_algorithm::adaptive(0.01, 1e-6, 1e-7).clone();
+			m_approx = true;
+		} else if (method_name == "adaptive_accuracy") {
+			// A loose accuracy makes the Karp-Luby approximation cheaper than the exact computation
+			m_method = util::hv_algorithm::adaptive(0.5, 0.25).clone();
+			m_approx = true;
 		} else {
 			output << "Unknown method (" << method_name << ") .. exiting\n";
 			exit(1);
@@ -92,8 +106,8 @@ public:
 			// run correct test
 			if (m_test_type == "compute") {
 				load_compute();
-				double hypvol = hv_obj.compute(m_ref_point, m_method);
-				if (fabs(hypvol-m_hv_ans) < m_eps) {
+				double hypvol = m_approx ? adaptive_method().compute(m_points_cpy, m_ref_point, m_report) : hv_obj.compute(m_ref_point, m_method);
+				if (check_value(hypvol)) {
 					++OK_counter;
 				} else {
 					m_output << "\n Error in test " << t << ". Got: " << hypvol << ", Expected: " << m_hv_ans << " (abs error: " << fabs(hypvol-m_hv_ans) << ")";
@@ -101,8 +115,8 @@ public:
 
 			} else if (m_test_type == "exclusive") {
 				load_exclusive();
-				double hypvol = hv_obj.exclusive(m_p_idx, m_ref_point, m_method);
-				if (fabs(hypvol-m_hv_ans) < m_eps) {
+				double hypvol = m_approx ? adaptive_method().exclusive(m_p_idx, m_points_cpy, m_ref_point, m_report) : hv_obj.exclusive(m_p_idx, m_ref_point, m_method);
+				if (check_value(hypvol)) {
 					++OK_counter;
 				} else {
 					m_output << "\n Error in test " << t << ". Got: " << hypvol << ", Expected: " << m_hv_ans << " (abs error: " << fabs(hypvol-m_hv_ans) << ")";
@@ -110,8 +124,8 @@ public:
 
 			} else if (m_test_type == "least_contributor") {
 				load_least_contributor();
-				unsigned int point_idx = hv_obj.least_contributor(m_ref_point, m_method);
-				if (point_idx == m_idx_ans) {
+				unsigned int point_idx = m_approx ? adaptive_method().least_contributor(m_points_cpy, m_ref_point, m_report) : hv_obj.least_contributor(m_ref_point, m_method);
+				if (check_contributor(hv_obj, point_idx, m_idx_ans)) {
 					++OK_counter;
 				} else {
 					m_output << "\n Error in test " << t << ". Got: " << point_idx << ", Expected: " << m_idx_ans ;
@@ -119,8 +133,8 @@ public:
 
 			} else if (m_test_type == "greatest_contributor") {
 				load_least_contributor(); // loads the same data as least contributor
-				unsigned int point_idx = hv_obj.greatest_contributor(m_ref_point, m_method);
-				if (point_idx == m_idx_ans) {
+				unsigned int point_idx = m_approx ? adaptive_method().greatest_contributor(m_points_cpy, m_ref_point, m_report) : hv_obj.greatest_contributor(m_ref_point, m_method);
+				if (check_contributor(hv_obj, m_idx_ans, point_idx)) {
 					++OK_counter;
 				} else {
 					m_output << "\n Error in test " << t << ". Got: " << point_idx << ", Expected: " << m_idx_ans;
@@ -132,9 +146,56 @@ public:
 			}
 		}
 		m_output << "\n" << " " << OK_counter << "/" << m_num_tests << " passed";
+		if (m_approx) {
+			m_output << ", " << m_n_approx << " approximated";
+			// The approximation must have been exercised.
+			if (!m_n_approx) {
+				return 1;
+			}
+		}
 		return (OK_counter < m_num_tests ? 1 : 0);
 	}
 private:
+	// Adaptive method forced to approximate, called directly to get the report of each result. It works on a verified copy of the points.
+	const util::hv_algorithm::adaptive &adaptive_method()
+	{
+		m_points_cpy = m_points;
+		m_method->verify_before_compute(m_points_cpy, m_ref_point);
+		return dynamic_cast<const util::hv_algorithm::adaptive &>(*m_method);
+	}
+
+	// Whether the last result of an adaptive method forced to approximate was approximated (trivial cases are still computed exactly).
+	bool last_approximated()
+	{
+		if (!m_approx || m_report.exact) {
+			return false;
+		}
+		++m_n_approx;
+		return true;
+	}
+
+	// Exact results must match the expected value within eps. Approximated results must lie within the reported error bound (plus eps).
+	bool check_value(const double value)
+	{
+		if (!last_approximated()) {
+			return fabs(value - m_hv_ans) < m_eps;
+		}
+		return fabs(value - m_hv_ans) <= m_report.errors[0] + m_eps;
+	}
+
+	// Exact results must be the expected contributor, i.e., idx_low must be idx_high. For approximated results, the exact contribution
+	// of idx_low must not exceed that of idx_high by more than the width of the confidence intervals the contributor was chosen from.
+	bool check_contributor(const util::hypervolume &hv_obj, const unsigned int idx_low, const unsigned int idx_high)
+	{
+		if (!last_approximated()) {
+			return idx_low == idx_high;
+		}
+		const std::vector<double> &errors = m_report.errors;
+		const double max_error = errors.empty() ? 0.0 : *std::max_element(errors.begin(), errors.end());
+		const std::vector<double> c = hv_obj.contributions(m_ref_point);
+		return c[idx_low] - c[idx_high] <= 2.0 * max_error + m_eps;
+	}
+
 	void load_common()
 	{
 		m_input >> m_f_dim >> m_num_points;
@@ -177,6 +238,12 @@ private:
 	dual_stream &m_output;
 	std::string m_test_type;
 	double m_eps;
+	// Whether the method is an adaptive one forced to approximate, and number of results it approximated
+	bool m_approx;
+	int m_n_approx;
+	// Points handed to the adaptive method, and its report of the last result
+	std::vector<fitness_vector> m_points_cpy;
+	util::hv_algorithm::adaptive::report m_report;
 };
 
 int main(int argc, char *argv[])
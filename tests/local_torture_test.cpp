@@ -41,5 +41,27 @@ int main()
 	}
 	a.evolve(10000);
 	a.join();
+	// Fewer worker threads than islands.
+	a.set_threads(3);
+	for (int i = 0; i < 1000; ++i) {
+		a.evolve(1);
+		a.join();
+	}
+	for (int i = 0; i < 100; ++i) {
+		a.evolve_batch(1,4);
+	}
+	// One thread per island, then a pool resized to the batch size.
+	a.set_threads(0);
+	a.evolve(1);
+	for (int i = 0; i < 100; ++i) {
+		a.evolve_batch(1,2);
+	}
+	a.evolve_t(50);
+	a.join();
+	a.evolve(1000000);
+	a.interrupt();
+	if (a.busy()) {
+		return 1;
+	}
 	return 0;
 }
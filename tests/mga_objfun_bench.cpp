@@ -0,0 +1,152 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+// Microbenchmark of the trajectory problems: heap allocations and time per objective function evaluation,
+// plus a check that threads sharing one problem instance give the same fitnesses as serial evaluations.
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Allocations are only counted while the benchmark thread is evaluating alone.
+static bool counting = false;
+static unsigned long n_allocs = 0;
+
+void *operator new(std::size_t size)
+{
+	if (counting) {
+		++n_allocs;
+	}
+	void *p = std::malloc(size ? size : 1);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void *p) throw()
+{
+	std::free(p);
+}
+
+void *operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete[](void *p) throw()
+{
+	operator delete(p);
+}
+
+// Random decision vectors within the bounds of prob.
+std::vector<decision_vector> random_points(const problem::base &prob, std::vector<decision_vector>::size_type n)
+{
+	rng_double drng(42);
+	std::vector<decision_vector> xs(n, decision_vector(prob.get_dimension()));
+	for (std::vector<decision_vector>::size_type i = 0; i < n; ++i) {
+		for (problem::base::size_type j = 0; j < prob.get_dimension(); ++j) {
+			xs[i][j] = prob.get_lb()[j] + drng() * (prob.get_ub()[j] - prob.get_lb()[j]);
+		}
+	}
+	return xs;
+}
+
+int bench(problem::base &prob)
+{
+	const std::vector<decision_vector>::size_type n_evals = 2000;
+	const std::vector<decision_vector> xs = random_points(prob, n_evals);
+	std::vector<fitness_vector> serial(n_evals, fitness_vector(prob.get_f_dimension()));
+	// Without the cache objfun() itself does not allocate, so whatever is counted comes from objfun_impl().
+	prob.set_cache_capacity(0);
+
+	n_allocs = 0;
+	counting = true;
+	const std::clock_t start = std::clock();
+	for (std::vector<decision_vector>::size_type i = 0; i < n_evals; ++i) {
+		prob.objfun(serial[i], xs[i]);
+	}
+	const double us = double(std::clock() - start) / CLOCKS_PER_SEC * 1e6 / n_evals;
+	counting = false;
+
+	std::cout << std::setw(40) << prob.get_name().substr(0,40)
+		<< std::fixed << std::setprecision(2)
+		<< " | " << std::setw(8) << us << " us/eval"
+		<< " | allocations/eval: " << double(n_allocs) / n_evals;
+	std::cout.unsetf(std::ios::floatfield);
+	if (n_allocs) {
+		std::cout << " heap allocations in the objective function!" << std::endl;
+		return 1;
+	}
+	if (!prob.is_thread_safe()) {
+		std::cout << " not thread safe!" << std::endl;
+		return 1;
+	}
+	// The batch threads share prob instead of evaluating clones.
+	std::vector<fitness_vector> threaded;
+	prob.set_batch_threads(4);
+	prob.batch_objfun(threaded, xs);
+	prob.set_batch_threads(1);
+	if (threaded != serial) {
+		std::cout << " threaded values mismatch!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int retval = 0;
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	problem::cassini_1 cassini_1;
+	problem::gtoc_1 gtoc_1;
+	problem::cassini_2 cassini_2;
+	problem::messenger messenger;
+	problem::messenger_full messenger_full;
+	problem::rosetta rosetta;
+	problem::tandem tandem(6, 10);
+	problem::mga_1dsm_tof mga_1dsm_tof;
+	problem::mga_1dsm_alpha mga_1dsm_alpha;
+	problem::mga_incipit mga_incipit;
+	problem::mga_part mga_part;
+	retval += bench(cassini_1);
+	retval += bench(gtoc_1);
+	retval += bench(cassini_2);
+	retval += bench(messenger);
+	retval += bench(messenger_full);
+	retval += bench(rosetta);
+	retval += bench(tandem);
+	retval += bench(mga_1dsm_tof);
+	retval += bench(mga_1dsm_alpha);
+	retval += bench(mga_incipit);
+	retval += bench(mga_part);
+#endif
+	return retval;
+}
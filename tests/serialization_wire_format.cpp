@@ -0,0 +1,139 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/shared_ptr.hpp>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+typedef std::pair<boost::shared_ptr<population>,algorithm::base_ptr> payload_type;
+
+// The text path formerly used by mpi_environment.
+void text_save(std::vector<char> &buffer, const payload_type &payload)
+{
+	std::stringstream ss;
+	boost::archive::text_oarchive oa(ss);
+	oa << payload;
+	const std::string buffer_str(ss.str());
+	buffer.assign(buffer_str.begin(),buffer_str.end());
+}
+
+void text_load(const std::vector<char> &buffer, payload_type &payload)
+{
+	const std::string buffer_str(buffer.begin(),buffer.end());
+	std::stringstream ss(buffer_str);
+	boost::archive::text_iarchive ia(ss);
+	ia >> payload;
+}
+
+bool same_population(const population &pop1, const population &pop2)
+{
+	if (pop1.size() != pop2.size() || pop1.champion().x != pop2.champion().x) {
+		return false;
+	}
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		const population::individual_type &i1 = pop1.get_individual(i), &i2 = pop2.get_individual(i);
+		if (i1.cur_x != i2.cur_x || i1.cur_v != i2.cur_v || i1.cur_f != i2.cur_f || i1.cur_c != i2.cur_c ||
+			i1.best_x != i2.best_x || i1.best_f != i2.best_f || i1.best_c != i2.best_c)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Round-trip an MPI-like payload through the binary wire format and compare its throughput with the text one.
+int test_wire_format(const problem::base &prob, int n_ind, int n_trips)
+{
+	std::cout << std::setw(30) << prob.get_name() << ", " << n_ind << " individuals:";
+	const payload_type payload(boost::shared_ptr<population>(new population(prob,n_ind)),algorithm::de(10).clone());
+	std::vector<char> buffer;
+	payload_type out;
+
+	std::clock_t start = std::clock();
+	for (int i = 0; i < n_trips; ++i) {
+		text_save(buffer,payload);
+		text_load(buffer,out);
+	}
+	const double text_time = double(std::clock() - start) / CLOCKS_PER_SEC;
+	const std::vector<char>::size_type text_size = buffer.size();
+
+	start = std::clock();
+	for (int i = 0; i < n_trips; ++i) {
+		binary_save(buffer,payload);
+		binary_load(buffer,out);
+	}
+	const double binary_time = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+	std::cout << " text " << text_size << " bytes, " << text_time << "s - binary " << buffer.size() << " bytes, " << binary_time << "s";
+	if (!out.first || !out.second || !same_population(*payload.first,*out.first) || out.second->get_name() != payload.second->get_name()) {
+		std::cout << " round-trip failed!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Bitwise comparison, as NaN == NaN comparisons do not survive -ffast-math.
+bool same_bits(double a, double b)
+{
+	return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Non-finite values must survive the binary round-trip.
+int test_non_finite()
+{
+	std::cout << std::setw(30) << "non-finite values:";
+	population pop(problem::ackley(5),2);
+	population::individual_type ind = pop.get_individual(0), ind_out;
+	ind.cur_f[0] = std::numeric_limits<double>::quiet_NaN();
+	ind.best_f[0] = std::numeric_limits<double>::infinity();
+	ind.cur_v[0] = -std::numeric_limits<double>::infinity();
+	std::vector<char> buffer;
+	binary_save(buffer,ind);
+	binary_load(buffer,ind_out);
+	if (!same_bits(ind_out.cur_f[0], ind.cur_f[0]) || !same_bits(ind_out.best_f[0], ind.best_f[0]) || !same_bits(ind_out.cur_v[0], ind.cur_v[0]) || ind_out.cur_x != ind.cur_x) {
+		std::cout << " failed!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_non_finite() || test_wire_format(problem::ackley(10),20,200) || test_wire_format(problem::ackley(100),1000,5) ||
+		test_wire_format(problem::zdt(1,300),500,5);
+}
@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+// Test code for the batch evaluation methods of problem::base
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+#include "../src/keplerian_toolbox/planets/planet_tle.h"
+#endif
+
+using namespace pagmo;
+
+// Check that batch evaluation, serial or threaded, gives the same results as single evaluations and fills the caches.
+int test_batch(problem::base &prob, unsigned int n_threads)
+{
+	std::cout << std::setw(40) << prob.get_name() << " threads: " << n_threads;
+	prob.set_batch_threads(n_threads);
+	prob.reset_caches();
+	std::vector<decision_vector> xs;
+	for (int i = 0; i < 23; ++i) {
+		xs.push_back(decision_vector(prob.get_dimension(), 0.01 * i));
+	}
+	prob.set_cache_capacity(xs.size());
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	const unsigned int fevals0 = prob.get_fevals(), cevals0 = prob.get_cevals();
+	// Evaluate a first point alone: the batch must take it from the cache.
+	prob.objfun(xs[0]);
+	prob.batch_objfun(f, xs);
+	prob.batch_compute_constraints(c, xs);
+	if (f.size() != xs.size() || c.size() != xs.size() || prob.get_fevals() - fevals0 != xs.size()) {
+		std::cout << " batch evaluation count failed!" << std::endl;
+		return 1;
+	}
+	if (prob.get_c_dimension() && prob.get_cevals() - cevals0 != xs.size()) {
+		std::cout << " batch constraints count failed!" << std::endl;
+		return 1;
+	}
+	// The whole batch must now be cached.
+	for (std::vector<decision_vector>::size_type i = 0; i < xs.size(); ++i) {
+		if (prob.objfun(xs[i]) != f[i] || prob.compute_constraints(xs[i]) != c[i]) {
+			std::cout << " batch values mismatch!" << std::endl;
+			return 1;
+		}
+	}
+	if (prob.get_fevals() - fevals0 != xs.size()) {
+		std::cout << " batch caching failed!" << std::endl;
+		return 1;
+	}
+	// And the values must be the same as the uncached ones.
+	prob.reset_caches();
+	for (std::vector<decision_vector>::size_type i = 0; i < xs.size(); ++i) {
+		if (prob.objfun(xs[i]) != f[i]) {
+			std::cout << " batch values mismatch!" << std::endl;
+			return 1;
+		}
+	}
+	// A batch larger than the caches must leave their capacity untouched.
+	prob.set_cache_capacity(5);
+	prob.reset_caches();
+	prob.batch_objfun(f, xs);
+	if (prob.get_cache_capacity() != 5) {
+		std::cout << " cache capacity changed!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+// Check that the leg by leg batch evaluation of mga_1dsm_tof gives exactly the same results as single evaluations.
+int test_batch_mga()
+{
+	problem::mga_1dsm_tof prob;
+	std::cout << std::setw(40) << prob.get_name() << " batched Lambert arcs";
+	rng_double drng(42);
+	std::vector<decision_vector> xs(50, decision_vector(prob.get_dimension()));
+	for (std::vector<decision_vector>::size_type i = 0; i < xs.size(); ++i) {
+		for (problem::base::size_type j = 0; j < prob.get_dimension(); ++j) {
+			xs[i][j] = prob.get_lb()[j] + drng() * (prob.get_ub()[j] - prob.get_lb()[j]);
+		}
+	}
+	std::vector<fitness_vector> f;
+	prob.batch_objfun(f, xs);
+	prob.reset_caches();
+	for (std::vector<decision_vector>::size_type i = 0; i < xs.size(); ++i) {
+		if (prob.objfun(xs[i]) != f[i]) {
+			std::cout << " batch values mismatch!" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// A planet propagated with SGP4 makes the sequence, hence the problem, not thread safe: the batches must not share it.
+int test_tle_thread_safety()
+{
+	std::vector<kep_toolbox::planet_ptr> seq;
+	seq.push_back(kep_toolbox::planet_tle().clone());
+	seq.push_back(kep_toolbox::planet_tle().clone());
+	std::vector<boost::array<double,2> > tof(1);
+	tof[0][0] = 0.1;
+	tof[0][1] = 1;
+	if (problem::mga_1dsm_tof(seq, kep_toolbox::epoch(0), kep_toolbox::epoch(1), tof).is_thread_safe()) {
+		std::cout << "mga_1dsm_tof with a TLE planet reported as thread safe!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+#endif
+
+int main()
+{
+	problem::ackley ackley(10);
+	problem::zdt zdt(1, 10);
+	problem::cec2006 cec(5);
+	int retval = test_batch(ackley, 1) || test_batch(ackley, 4) || test_batch(zdt, 3) || test_batch(cec, 1) || test_batch(cec, 0);
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	retval = retval || test_batch_mga() || test_tle_thread_safety();
+#endif
+	return retval;
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+// Test code for the interpolated ephemerides of the keplerian toolbox planets
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include "../src/pagmo.h"
+
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+#include "../src/keplerian_toolbox/planets/asteroid_gtoc7.h"
+#include "../src/keplerian_toolbox/planets/planet_ss.h"
+#include "../src/keplerian_toolbox/epoch.h"
+
+using namespace kep_toolbox;
+
+// Check that the interpolated ephemerides are within the tolerances of the computed ones across the whole window,
+// that the table is shared by the copies of the planet and that it is not used outside its window.
+int test_eph_table(const planet &body, const double &pos_tol, const double &vel_tol)
+{
+	std::cout << std::setw(40) << body.get_name() << " tolerances: " << pos_tol << ", " << vel_tol;
+	planet_ptr interpolated = body.clone();
+	const double start = 1000., end = 4650.;
+	interpolated->set_eph_table(epoch(start), epoch(end), pos_tol, vel_tol);
+	planet_ptr copy = interpolated->clone();
+	if (copy->get_eph_table() != interpolated->get_eph_table()) {
+		std::cout << " table not shared!" << std::endl;
+		return 1;
+	}
+	array3D r, v, r_ref, v_ref, d;
+	double pos_err = 0., vel_err = 0.;
+	for (int i = 0; i <= 20000; ++i) {
+		const double mjd2000 = start + (end - start) * i / 20000.;
+		copy->get_eph(epoch(mjd2000), r, v);
+		body.get_eph(epoch(mjd2000), r_ref, v_ref);
+		diff(d, r, r_ref);
+		pos_err = std::max(pos_err, norm(d));
+		diff(d, v, v_ref);
+		vel_err = std::max(vel_err, norm(d));
+	}
+	if (pos_err > pos_tol || vel_err > vel_tol) {
+		std::cout << " interpolation error too large: " << pos_err << ", " << vel_err << std::endl;
+		return 1;
+	}
+	copy->get_eph(epoch(end + 10.), r, v);
+	body.get_eph(epoch(end + 10.), r_ref, v_ref);
+	if (r != r_ref || v != v_ref) {
+		std::cout << " table used outside its window!" << std::endl;
+		return 1;
+	}
+	copy->unset_eph_table();
+	if (copy->get_eph_table() || !interpolated->get_eph_table()) {
+		std::cout << " table removal failed!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed with " << interpolated->get_eph_table()->get_size() << " nodes." << std::endl;
+	return 0;
+}
+#endif
+
+int main()
+{
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	return test_eph_table(asteroid_gtoc7(100), 1000., 1e-3) || test_eph_table(asteroid_gtoc7(100), 10., 1e-4) ||
+		test_eph_table(planet_ss("earth"), 1000., 1.);
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,143 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the fitness/constraint caches of problem::base
+
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Check that repeated evaluations are served by the cache and that LRU eviction works as expected.
+int test_lru(problem::base &prob)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	prob.set_cache_capacity(3);
+	prob.reset_caches();
+	std::vector<decision_vector> xs;
+	for (int i = 0; i < 4; ++i) {
+		xs.push_back(decision_vector(prob.get_dimension(), 0.1 * i));
+	}
+	const unsigned int fevals0 = prob.get_fevals();
+	for (int i = 0; i < 3; ++i) {
+		prob.objfun(xs[i]);
+	}
+	// All three points must now be cached.
+	for (int i = 0; i < 3; ++i) {
+		prob.objfun(xs[i]);
+	}
+	if (prob.get_fevals() - fevals0 != 3) {
+		std::cout << " cached evaluations failed!" << std::endl;
+		return 1;
+	}
+	// Inserting a fourth point evicts the least recently used, i.e., xs[0].
+	prob.objfun(xs[3]);
+	prob.objfun(xs[1]);
+	prob.objfun(xs[2]);
+	if (prob.get_fevals() - fevals0 != 4) {
+		std::cout << " LRU retention failed!" << std::endl;
+		return 1;
+	}
+	prob.objfun(xs[0]);
+	if (prob.get_fevals() - fevals0 != 5) {
+		std::cout << " LRU eviction failed!" << std::endl;
+		return 1;
+	}
+	std::cout << " LRU passed.";
+	// The cache must not change the fitness values.
+	prob.set_cache_capacity(0);
+	for (int i = 0; i < 4; ++i) {
+		const fitness_vector f_nocache = prob.objfun(xs[i]);
+		prob.set_cache_capacity(10);
+		if (prob.objfun(xs[i]) != f_nocache || prob.objfun(xs[i]) != f_nocache) {
+			std::cout << " cached fitness mismatch!" << std::endl;
+			return 1;
+		}
+		prob.set_cache_capacity(0);
+	}
+	std::cout << " values passed.";
+	// Quantization: vectors closer than the quantum hit the same entry.
+	prob.set_cache_capacity(10);
+	prob.set_cache_quantum(1e-6);
+	const unsigned int hits0 = prob.get_cache_hits();
+	decision_vector x(xs[2]);
+	prob.objfun(x);
+	x[0] += 1e-9;
+	prob.objfun(x);
+	if (prob.get_cache_hits() - hits0 != 1) {
+		std::cout << " quantization failed!" << std::endl;
+		return 1;
+	}
+	prob.set_cache_quantum(0);
+	// Negative and NaN quanta must be rejected (also under -ffast-math).
+	const double bad_quanta[] = {-1., std::numeric_limits<double>::quiet_NaN()};
+	for (int i = 0; i < 2; ++i) {
+		try {
+			prob.set_cache_quantum(bad_quanta[i]);
+			std::cout << " invalid quantum accepted!" << std::endl;
+			return 1;
+		} catch (const value_error &) {}
+	}
+	std::cout << " quantization passed." << std::endl;
+	return 0;
+}
+
+// Check that the cache content survives serialization and copy.
+int test_copy(const problem::base &prob)
+{
+	const decision_vector x(prob.get_dimension(), 0.2);
+	prob.objfun(x);
+	problem::base_ptr copy = prob.clone();
+	std::stringstream ss;
+	{
+		boost::archive::text_oarchive oa(ss);
+		oa << copy;
+	}
+	problem::base_ptr loaded;
+	{
+		boost::archive::text_iarchive ia(ss);
+		ia >> loaded;
+	}
+	const unsigned int fevals0 = loaded->get_fevals(), fevals1 = copy->get_fevals();
+	loaded->objfun(x);
+	copy->objfun(x);
+	if (loaded->get_fevals() != fevals0 || copy->get_fevals() != fevals1 || loaded->get_cache_capacity() != prob.get_cache_capacity()) {
+		std::cout << prob.get_name() << " cache copy failed!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	problem::ackley ackley(10);
+	problem::zdt zdt(1, 10);
+	problem::cec2006 cec(5);
+	return test_lru(ackley) || test_lru(zdt) || test_lru(cec) || test_copy(ackley);
+}
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+// Test code for the incremental hypervolume contribution tracker
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/util/hypervolume.h"
+
+using namespace pagmo;
+
+// Compare the tracked contributions with the ones computed from scratch.
+bool check(const util::contribution_tracker &t, const std::vector<fitness_vector> &points, const fitness_vector &r)
+{
+	util::hypervolume hv(points);
+	const std::vector<double> c = hv.contributions(r);
+	for (std::vector<double>::size_type i = 0; i < c.size(); ++i) {
+		if (std::fabs(c[i] - t.contribution(i)) > 1e-10 * std::max(1., std::fabs(c[i]))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Steady-state sequence of insertions and removals (one in, one out, as in SMS-EMOA), followed by a reordering assign().
+int test_tracker(unsigned int f_dim)
+{
+	std::cout << "Dimension " << f_dim << ":";
+	boost::mt19937 rng(f_dim);
+	boost::uniform_real<double> u(0.01,1.);
+	const fitness_vector r(f_dim,2.);
+	util::contribution_tracker t;
+	t.set_reference_point(r);
+	std::vector<fitness_vector> points;
+	for (int step = 0; step < 200; ++step) {
+		// Two points out of three lie on the unit sphere, the others are likely dominated.
+		fitness_vector p(f_dim);
+		double norm = 0;
+		for (unsigned int k = 0; k < f_dim; ++k) {
+			p[k] = u(rng);
+			norm += p[k] * p[k];
+		}
+		if (step % 3) {
+			for (unsigned int k = 0; k < f_dim; ++k) {
+				p[k] /= std::sqrt(norm);
+			}
+		}
+		t.insert(p);
+		points.push_back(p);
+		if (points.size() > 25) {
+			const unsigned int idx = (step % 2) ? t.least_contributor() : rng() % points.size();
+			t.erase(idx);
+			points.erase(points.begin() + idx);
+		}
+		if (step % 10 == 0 && !check(t, points, r)) {
+			std::cout << " contributions mismatch at step " << step << std::endl;
+			return 1;
+		}
+	}
+	std::vector<fitness_vector> shuffled(points.rbegin(),points.rend());
+	shuffled.pop_back();
+	shuffled.push_back(fitness_vector(f_dim,0.5));
+	t.assign(shuffled, r);
+	if (!check(t, shuffled, r)) {
+		std::cout << " contributions mismatch after assign()" << std::endl;
+		return 1;
+	}
+	std::cout << " passed (" << t.get_recomputed() << " contributions recomputed)." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_tracker(2) || test_tracker(3) || test_tracker(4) || test_tracker(5);
+}
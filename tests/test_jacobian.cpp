@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the finite-difference Jacobian of problem::base
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Entry (i,j) of the Jacobian of prob at x, by central differences along x_j alone.
+double plain_derivative(const problem::base &prob, const decision_vector &x, int i, int j, const double &step)
+{
+	const double h = step * std::max(1., std::fabs(x[j]));
+	decision_vector xp(x), xm(x);
+	xp[j] += h;
+	xm[j] -= h;
+	if (i < int(prob.get_f_dimension())) {
+		return (prob.objfun(xp)[i] - prob.objfun(xm)[i]) / 2 / h;
+	}
+	return (prob.compute_constraints(xp)[i - prob.get_f_dimension()] - prob.compute_constraints(xm)[i - prob.get_f_dimension()]) / 2 / h;
+}
+
+// Check that compute_jacobian() agrees with column-by-column central differences, that grouping the columns
+// costs less than 2 * max_cevals_per_column constraint evaluations per column and that the last Jacobian is cached.
+int test_jacobian(problem::base &prob, double max_cevals_per_column)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	prob.set_cache_capacity(0);
+	const double step = 1e-6;
+	population pop(prob, 1, 42);
+	const decision_vector &x = pop.get_individual(0).cur_x;
+	int lenG;
+	std::vector<int> iGfun, jGvar;
+	prob.get_jacobian_pattern(lenG, iGfun, jGvar);
+	const unsigned int fevals0 = prob.get_fevals(), cevals0 = prob.get_cevals();
+	std::vector<double> G, G2;
+	prob.compute_jacobian(G, x, step);
+	const unsigned int fevals = prob.get_fevals() - fevals0, cevals = prob.get_cevals() - cevals0;
+	if (int(G.size()) != lenG) {
+		std::cout << " wrong Jacobian size!" << std::endl;
+		return 1;
+	}
+	for (int k = 0; k < lenG; ++k) {
+		const double ref = plain_derivative(prob, x, iGfun[k], jGvar[k], step);
+		if (std::fabs(G[k] - ref) > 1e-9 * std::max(1., std::fabs(ref))) {
+			std::cout << " wrong derivative at (" << iGfun[k] << ',' << jGvar[k] << "): " << G[k] << " vs " << ref << std::endl;
+			return 1;
+		}
+	}
+	if (fevals > 2 * prob.get_dimension() || cevals > 2 * max_cevals_per_column * prob.get_dimension()) {
+		std::cout << " too many evaluations: " << fevals << ", " << cevals << std::endl;
+		return 1;
+	}
+	const unsigned int fevals1 = prob.get_fevals(), cevals1 = prob.get_cevals();
+	prob.compute_jacobian(G2, x, step);
+	if (G2 != G || prob.get_fevals() != fevals1 || prob.get_cevals() != cevals1) {
+		std::cout << " Jacobian not cached!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed (" << fevals << " fevals, " << cevals << " cevals)." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	problem::luksan_vlcek_1 luksan_vlcek_1(20);
+	problem::luksan_vlcek_2 luksan_vlcek_2(16);
+	problem::luksan_vlcek_3 luksan_vlcek_3(20);
+	problem::rosenbrock rosenbrock(10);
+	problem::cec2006 cec2006(7);
+	// The constraints of the Luksan-Vlcek problems are banded: a handful of groups cover all the columns.
+	int retval = test_jacobian(luksan_vlcek_1, 0.5);
+	retval += test_jacobian(luksan_vlcek_2, 0.5);
+	retval += test_jacobian(luksan_vlcek_3, 0.5);
+	// No set_sparsity(): dense pattern, one group per column.
+	retval += test_jacobian(rosenbrock, 1);
+	retval += test_jacobian(cec2006, 1);
+	return retval;
+}
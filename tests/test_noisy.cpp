@@ -205,15 +205,48 @@ int test_noisy_uniform(const std::vector<problem::base_ptr> & probs, double nois
 	return 0;
 }
 
+// Test that splitting the trials among several threads does not change the noisy fitness,
+// as the noise of each trial is addressed by its index.
+int test_noisy_threads(const std::vector<problem::base_ptr> & probs, unsigned int n_trials)
+{
+	std::cout << "Start testing the threaded evaluation of " << n_trials << " trials." << std::endl;
+
+	for(unsigned int i = 0; i < probs.size(); i++){
+		pagmo::problem::noisy prob_serial(*(probs[i]), n_trials, 0.0, 0.1, pagmo::problem::noisy::NORMAL, i*177 + 23, 1);
+		pagmo::problem::noisy prob_threaded(*(probs[i]), n_trials, 0.0, 0.1, pagmo::problem::noisy::NORMAL, i*177 + 23, 4);
+
+		std::cout<< std::setw(40) << prob_serial.get_name();
+
+		decision_vector x(probs[i]->get_dimension());
+		for(unsigned int xi = 0; xi < x.size(); xi++){
+			x[xi] = (probs[i]->get_lb()[xi] + probs[i]->get_ub()[xi]) / 2.0;
+		}
+		if(!is_eq(prob_serial.objfun(x), prob_threaded.objfun(x), EPS)){
+			std::cout << " threaded trials differ!" << std::endl;
+			return 1;
+		}
+		std::cout << " threaded trials passed." << std::endl;
+	}
+
+	// All good
+	return 0;
+}
+
 int main()
 {	
 	int dimension = 10;
 	std::vector<problem::base_ptr> probs;
 	probs.push_back(problem::zdt(1, dimension).clone());
 	probs.push_back(problem::ackley(dimension).clone());
+	// The trials of the problems above are run serially, as they are not thread-safe.
+	std::vector<problem::base_ptr> threaded_probs(probs);
+#ifdef PAGMO_ENABLE_KEP_TOOLBOX
+	threaded_probs.push_back(problem::cassini_1().clone());
+#endif
 
 	return test_noisy(probs, 0.0, 0.1, 5000, 0.01) ||
 		   test_noisy(probs, 3.14, 0.1, 5000, 0.01) ||
 		   test_noisy_uniform(probs, 0.0, 0.1, 5000, 0.01) ||
-		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01);
+		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01) ||
+		   test_noisy_threads(threaded_probs, 10);
 }
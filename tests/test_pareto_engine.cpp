@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Check that the lazy Pareto engine gives the same Pareto information as the incremental one.
+int compare_engines(const population &pop1, const population &pop2)
+{
+	if (pop1.size() != pop2.size() || pop1.compute_pareto_fronts() != pop2.compute_pareto_fronts()) {
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		if (pop1.get_pareto_rank(i) != pop2.get_pareto_rank(i) || pop1.get_crowding_d(i) != pop2.get_crowding_d(i) ||
+			pop1.get_domination_count(i) != pop2.get_domination_count(i) ||
+			pop1.get_domination_list(i).size() != pop2.get_domination_list(i).size())
+		{
+			return 1;
+		}
+	}
+	if (pop1.size() && (pop1.get_best_idx() != pop2.get_best_idx() || pop1.get_worst_idx() != pop2.get_worst_idx())) {
+		return 1;
+	}
+	return 0;
+}
+
+int test_engine(const problem::base &prob)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	population pop1(prob, 0, 42), pop2(prob, 0, 42);
+	pop2.set_pareto_engine(population::pareto_engine::LAZY_SORT);
+	population rnd(prob, 60, 42);
+	for (population::size_type i = 0; i < rnd.size(); ++i) {
+		pop1.push_back(rnd.get_individual(i).cur_x);
+		pop2.push_back(rnd.get_individual(i).cur_x);
+	}
+	// Duplicated individuals.
+	for (population::size_type i = 0; i < 5; ++i) {
+		pop1.push_back(rnd.get_individual(i).cur_x);
+		pop2.push_back(rnd.get_individual(i).cur_x);
+	}
+	if (compare_engines(pop1, pop2)) {
+		std::cout << " push_back failed!" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < 20; ++i) {
+		pop1.erase(i);
+		pop2.erase(i);
+		pop1.set_x(2 * i, rnd.get_individual(rnd.size() - i - 1).cur_x);
+		pop2.set_x(2 * i, rnd.get_individual(rnd.size() - i - 1).cur_x);
+	}
+	if (compare_engines(pop1, pop2)) {
+		std::cout << " erase/set_x failed!" << std::endl;
+		return 1;
+	}
+	// Switching back to the incremental engine must restore consistent domination lists.
+	pop2.set_x(0, rnd.get_individual(0).cur_x);
+	pop1.set_x(0, rnd.get_individual(0).cur_x);
+	pop2.set_pareto_engine(population::pareto_engine::INCREMENTAL);
+	pop1.erase(1);
+	pop2.erase(1);
+	if (compare_engines(pop1, pop2)) {
+		std::cout << " engine switch failed!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_engine(problem::zdt(1, 10)) || test_engine(problem::zdt(4, 10)) || test_engine(problem::dtlz(2, 5, 6)) ||
+		test_engine(problem::cec2006(5)) || test_engine(problem::ackley(10));
+}
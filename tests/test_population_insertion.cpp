@@ -0,0 +1,219 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the insertion of pre-evaluated individuals in the population
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Check that algo evaluates each offspring exactly once: with the problem cache disabled the evaluation count
+// must be within [min_fevals, max_fevals].
+int test_fevals(const algorithm::base &algo, unsigned int min_fevals, unsigned int max_fevals)
+{
+	std::cout << std::setw(40) << algo.get_name();
+	problem::ackley prob(10);
+	prob.set_cache_capacity(0);
+	population pop(prob, 20, 42), pop_check(pop);
+	pop_check.set_evaluation_check(true);
+	const unsigned int fevals0 = pop.problem().get_fevals();
+	// Clones of algo, so that both evolutions use the same random numbers.
+	algo.clone()->evolve(pop);
+	algo.clone()->evolve(pop_check);
+	const unsigned int fevals = pop.problem().get_fevals() - fevals0;
+	if (fevals < min_fevals || fevals > max_fevals) {
+		std::cout << " wrong number of evaluations: " << fevals << std::endl;
+		return 1;
+	}
+	if (pop.champion().f != pop_check.champion().f) {
+		std::cout << " champion mismatch!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Check that replace_generation() leaves the population as set_x() on every individual would,
+// and that mismatching fitnesses are detected by the evaluation check.
+int test_replace_generation(population::pareto_engine::type engine)
+{
+	std::cout << std::setw(40) << "replace_generation, engine " << engine;
+	problem::zdt prob(1, 10);
+	population pop(prob, 30, 42), pop2(prob, 30, 43);
+	pop.set_pareto_engine(engine);
+	population pop_ref(pop);
+	std::vector<decision_vector> x(pop.size());
+	std::vector<fitness_vector> f(pop.size());
+	std::vector<constraint_vector> c(pop.size());
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x[i] = pop2.get_individual(i).cur_x;
+		f[i] = pop2.get_individual(i).cur_f;
+		c[i] = pop2.get_individual(i).cur_c;
+		pop_ref.set_x(i, x[i]);
+	}
+	pop.replace_generation(x, f, c);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (pop.get_individual(i).best_f != pop_ref.get_individual(i).best_f ||
+			pop.get_domination_count(i) != pop_ref.get_domination_count(i) ||
+			pop.get_pareto_rank(i) != pop_ref.get_pareto_rank(i))
+		{
+			std::cout << " population mismatch!" << std::endl;
+			return 1;
+		}
+	}
+	pop.set_evaluation_check(true);
+	pop.replace_generation(x, f, c);
+	f[3][0] += 1;
+	try {
+		pop.replace_generation(x, f, c);
+		std::cout << " wrong fitness not detected!" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	try {
+		pop.push_back(x[3], f[3], c[3]);
+		std::cout << " wrong fitness not detected!" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	if (pop.size() != pop_ref.size()) {
+		std::cout << " population modified by a failed insertion!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Position of the worst (or best) individual by a linear scan, first one in positional order on ties.
+population::size_type scan_worst_best(const population &pop, bool worst)
+{
+	const problem::base &prob = pop.problem();
+	population::size_type retval = 0;
+	for (population::size_type i = 1; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i), &cur = pop.get_individual(retval);
+		if (worst ? prob.compare_fc(cur.cur_f, cur.cur_c, ind.cur_f, ind.cur_c) : prob.compare_fc(ind.cur_f, ind.cur_c, cur.cur_f, cur.cur_c)) {
+			retval = i;
+		}
+	}
+	return retval;
+}
+
+// Check that replace_worst() keeps the same individuals as push_back() followed by the erase() of the worst,
+// and that the tracked worst and best individuals are the ones a linear scan finds.
+int test_replace_worst(population::pareto_engine::type engine)
+{
+	std::cout << std::setw(40) << "replace_worst, engine " << engine;
+	problem::ackley prob(5);
+	population pop(prob, 20, 42), candidates(prob, 200, 43);
+	pop.set_pareto_engine(engine);
+	population pop_ref(pop);
+	for (population::size_type i = 0; i < candidates.size(); ++i) {
+		const decision_vector &x = candidates.get_individual(i).cur_x;
+		pop_ref.push_back(x);
+		const population::size_type worst_idx = pop_ref.get_worst_idx();
+		pop_ref.erase(worst_idx);
+		if (pop.replace_worst(x) != (worst_idx != pop_ref.size())) {
+			std::cout << " wrong replacement outcome!" << std::endl;
+			return 1;
+		}
+		if (i % 10 == 0) {
+			// Exercise the trees after a shift of the individuals too.
+			const decision_vector x0 = pop.get_individual(0).cur_x;
+			pop.erase(0);
+			pop.push_back(x0);
+		}
+		if (pop.get_worst_idx() != scan_worst_best(pop, true) || pop.get_best_idx() != scan_worst_best(pop, false)) {
+			std::cout << " tracked worst/best mismatch!" << std::endl;
+			return 1;
+		}
+	}
+	std::vector<double> f, f_ref;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		f.push_back(pop.get_individual(i).cur_f[0]);
+		f_ref.push_back(pop_ref.get_individual(i).cur_f[0]);
+	}
+	std::sort(f.begin(), f.end());
+	std::sort(f_ref.begin(), f_ref.end());
+	if (pop.size() != pop_ref.size() || f != f_ref || pop.champion().f != pop_ref.champion().f) {
+		std::cout << " population mismatch!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Check that after erase_unordered() (directly and via multi-objective replace_worst()) the Pareto information
+// is the same as that of a population built from scratch with the remaining individuals.
+int test_erase_unordered(population::pareto_engine::type engine)
+{
+	std::cout << std::setw(40) << "erase_unordered, engine " << engine;
+	problem::zdt prob(1, 10);
+	population pop(prob, 30, 42), candidates(prob, 30, 43);
+	pop.set_pareto_engine(engine);
+	pop.erase_unordered(5);
+	pop.erase_unordered(pop.size() - 1);
+	pop.erase_unordered(0);
+	for (population::size_type i = 0; i < candidates.size(); ++i) {
+		pop.replace_worst(candidates.get_individual(i).cur_x);
+	}
+	population pop_ref(prob, 0);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		pop_ref.push_back(pop.get_individual(i).cur_x);
+	}
+	pop.update_pareto_information();
+	pop_ref.update_pareto_information();
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		std::vector<population::size_type> dom_list(pop.get_domination_list(i)), dom_list_ref(pop_ref.get_domination_list(i));
+		std::sort(dom_list.begin(), dom_list.end());
+		std::sort(dom_list_ref.begin(), dom_list_ref.end());
+		if (pop.get_individual(i).cur_f != pop_ref.get_individual(i).cur_f || dom_list != dom_list_ref ||
+			pop.get_domination_count(i) != pop_ref.get_domination_count(i) ||
+			pop.get_pareto_rank(i) != pop_ref.get_pareto_rank(i))
+		{
+			std::cout << " population mismatch!" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	const unsigned int gen = 10, NP = 20;
+	int retval = test_fevals(algorithm::sga(gen), gen * NP, gen * NP);
+	retval += test_fevals(algorithm::cmaes(gen, -1, -1, -1, -1, 0.5, 0, 0), gen * NP, gen * NP);
+	retval += test_fevals(algorithm::firefly(gen), gen * NP * NP, gen * NP * NP);
+	// One scout bee at most per iteration.
+	retval += test_fevals(algorithm::bee_colony(gen), gen * 2 * NP, gen * (2 * NP + 1));
+	retval += test_replace_generation(population::pareto_engine::INCREMENTAL);
+	retval += test_replace_generation(population::pareto_engine::LAZY_SORT);
+	retval += test_replace_worst(population::pareto_engine::INCREMENTAL);
+	retval += test_replace_worst(population::pareto_engine::LAZY_SORT);
+	retval += test_erase_unordered(population::pareto_engine::INCREMENTAL);
+	retval += test_erase_unordered(population::pareto_engine::LAZY_SORT);
+	return retval;
+}
@@ -0,0 +1,173 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the structure-of-arrays view of the population
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Check that row i of m mirrors v (undefined vectors are skipped), and that the row and column views agree.
+bool same_row(const util::soa_matrix &m, population::size_type i, const std::vector<double> &v)
+{
+	if (reinterpret_cast<std::size_t>(m.row(i)) % 16) {
+		return false;
+	}
+	if (v.size() != m.cols()) {
+		return v.empty();
+	}
+	for (std::vector<double>::size_type j = 0; j < v.size(); ++j) {
+		if (m.row(i)[j] != v[j] || m.row_view(i)(j) != v[j] || m.col_view(j)(i) != v[j]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Check that the structure-of-arrays view mirrors the individuals.
+bool consistent(const population &pop)
+{
+	const population::soa_type &soa = pop.soa();
+	if (soa.cur_x.rows() != pop.size() || soa.best_f.rows() != pop.size()) {
+		return false;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		if (!same_row(soa.cur_x, i, ind.cur_x) || !same_row(soa.cur_v, i, ind.cur_v) || !same_row(soa.cur_c, i, ind.cur_c) ||
+			!same_row(soa.cur_f, i, ind.cur_f) || !same_row(soa.best_x, i, ind.best_x) || !same_row(soa.best_c, i, ind.best_c) ||
+			!same_row(soa.best_f, i, ind.best_f))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Check that the view is kept up to date by all the methods modifying the population.
+int test_soa(const problem::base &prob)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	population pop(prob, 20, 42), other(prob, 10, 43);
+	pop.set_soa_storage(true);
+	int n_failed = !consistent(pop);
+	pop.set_x(3, other.get_individual(0).cur_x);
+	pop.set_v(4, other.get_individual(1).cur_v);
+	n_failed += !consistent(pop);
+	pop.push_back(other.get_individual(2).cur_x);
+	pop.push_back(other.get_individual(3).cur_x, other.get_individual(3).cur_f, other.get_individual(3).cur_c);
+	n_failed += !consistent(pop);
+	pop.erase(0);
+	pop.erase_unordered(2);
+	pop.erase_unordered(pop.size() - 1);
+	n_failed += !consistent(pop);
+	for (population::size_type i = 4; i < other.size(); ++i) {
+		pop.replace_worst(other.get_individual(i).cur_x);
+	}
+	n_failed += !consistent(pop);
+	pop.reinit(5);
+	n_failed += !consistent(pop);
+	std::vector<decision_vector> x;
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	population next(prob, pop.size(), 44);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(next.get_individual(i).cur_x);
+		f.push_back(next.get_individual(i).cur_f);
+		c.push_back(next.get_individual(i).cur_c);
+	}
+	pop.replace_generation(x, f, c);
+	n_failed += !consistent(pop);
+	// Copies, swaps and archives carry the view along.
+	population copy(pop);
+	n_failed += !copy.get_soa_storage() || !consistent(copy);
+	copy = other;
+	n_failed += copy.get_soa_storage();
+	pop.swap(copy);
+	n_failed += pop.get_soa_storage() || !copy.get_soa_storage() || !consistent(copy);
+	std::vector<char> buffer;
+	binary_save(buffer, copy);
+	population loaded(prob, 0);
+	binary_load(buffer, loaded);
+	// The loaded view is rebuilt on first use, after these modifications.
+	loaded.set_x(0, x[1]);
+	loaded.erase_unordered(1);
+	n_failed += !loaded.get_soa_storage() || !consistent(loaded);
+	loaded.clear();
+	loaded.push_back(x[0]);
+	n_failed += !consistent(loaded);
+	// The view must be enabled explicitly.
+	pop.set_soa_storage(true);
+	n_failed += !consistent(pop);
+	pop.set_soa_storage(false);
+	n_failed += pop.get_soa_storage();
+	try {
+		pop.soa();
+		++n_failed;
+	} catch (const value_error &) {}
+	if (n_failed) {
+		std::cout << " view out of sync!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+// Check that the view stays in sync through the evolution of algorithms updating the population in different ways.
+int test_evolve(const algorithm::base &algo)
+{
+	std::cout << std::setw(40) << algo.get_name();
+	population pop(problem::ackley(10), 20, 42);
+	pop.set_soa_storage(true);
+	algo.evolve(pop);
+	if (!consistent(pop)) {
+		std::cout << " view out of sync!" << std::endl;
+		return 1;
+	}
+	// Algorithms must not turn the view on.
+	population plain(problem::ackley(10), 20, 42);
+	algo.evolve(plain);
+	if (plain.get_soa_storage()) {
+		std::cout << " view left on!" << std::endl;
+		return 1;
+	}
+	std::cout << " passed." << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int retval = test_soa(problem::ackley(5));
+	retval += test_soa(problem::cec2006(5));
+	retval += test_soa(problem::zdt(1, 10));
+	retval += test_evolve(algorithm::de(10));
+	retval += test_evolve(algorithm::cmaes(10));
+	retval += test_evolve(algorithm::ihs(100));
+	return retval;
+}
@@ -414,6 +414,70 @@ int test_race_pop_constructor(const problem::base_ptr& prob)
 	return 0;
 }
 
+// Noisy sphere whose noise only depends on the seed and which does not modify any state
+// when evaluated, hence declaring to be thread-safe.
+class thread_safe_noisy_sphere: public problem::base_stochastic
+{
+	public:
+		thread_safe_noisy_sphere(int dim, unsigned int seed):problem::base_stochastic(dim, seed)
+		{
+			set_bounds(-5.12, 5.12);
+		}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new thread_safe_noisy_sphere(*this));
+		}
+		bool is_thread_safe() const
+		{
+			return true;
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			rng_double drng(m_seed);
+			f[0] = 0;
+			for(unsigned int i = 0; i < x.size(); i++){
+				f[0] += x[i] * x[i] + 0.5 * drng();
+			}
+		}
+};
+
+/// Check that re-evaluations split among threads give the same race as sequential ones
+int test_racing_threads(const problem::base &prob)
+{
+	std::cout << "Testing the parallel re-evaluations of racing" << std::endl;
+
+	unsigned int seed = 123;
+	population pop(prob, 20, seed);
+
+	util::racing::race_pop race_pop_seq(pop, seed);
+	util::racing::race_pop race_pop_par(pop, seed);
+	race_pop_par.set_threads(4);
+
+	std::vector<population::size_type> active_set;
+	for(unsigned int k = 0; k < 2; k++){
+		// Race for the best first, then for the worst (ending up with a Wilcoxon test)
+		std::pair<std::vector<population::size_type>, unsigned int> res_seq = race_pop_seq.run(2, 0, 1000, 0.05, active_set, race_pop::MAX_BUDGET, k == 0, false);
+		std::pair<std::vector<population::size_type>, unsigned int> res_par = race_pop_par.run(2, 0, 1000, 0.05, active_set, race_pop::MAX_BUDGET, k == 0, false);
+		if(res_seq.first != res_par.first || res_seq.second != res_par.second){
+			std::cout << "\tFAILED Threads: Races are different!" << std::endl;
+			return 1;
+		}
+		if(race_pop_seq.get_mean_fitness() != race_pop_par.get_mean_fitness()){
+			std::cout << "\tFAILED Threads: Mean fitness vectors are different!" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "\tspeedup: " << race_pop_par.get_speedup() << std::endl;
+	if(race_pop_par.get_eval_time() < 0 || race_pop_par.get_wall_time() < 0){
+		std::cout << "\tFAILED Threads: Negative timings!" << std::endl;
+		return 1;
+	}
+
+	std::cout << "\tPASSED parallel re-evaluations." << std::endl;
+	return 0;
+}
 
 int main()
 {
@@ -454,5 +518,10 @@ int main()
 
 		   test_racing_get_mean_fitness(prob_ackley) ||
 
-		   test_race_pop_constructor(prob_ackley);
+		   test_race_pop_constructor(prob_ackley) ||
+
+		   // Problems that are not thread-safe are re-evaluated serially whatever the number of threads
+		   test_racing_threads(problem::noisy(*prob_ackley, 1, 0, 0.5, problem::noisy::NORMAL, 123)) ||
+		   test_racing_threads(problem::noisy(*prob_cec2006, 1, 0, 0.5, problem::noisy::NORMAL, 123)) ||
+		   test_racing_threads(thread_safe_noisy_sphere(dimension, 123));
 }
@@ -23,6 +23,8 @@
  *****************************************************************************/
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
 #include "boost/random.hpp"
 #include "boost/generator_iterator.hpp"
 
@@ -133,6 +135,50 @@ bool test_encoding_transformations(int repeat, boost::lagged_fibonacci607 rng)
     return false;
 }
 
+/*
+ * This test checks that base_tsp::inversion_delta matches the difference between the objective
+ * functions of the inverted and the original tours, for both symmetric and asymmetric matrices.
+ *
+ * @param[in] repeat - the number of times to repeat the test
+ */
+bool test_inversion_delta(int repeat, boost::lagged_fibonacci607 rng)
+{
+    for (int i = 0; i < repeat; ++i) {
+        boost::uniform_int<int> uniform(4,50);
+        boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_int<int> > distr(rng,uniform);
+        int n_cities = distr();
+        std::vector<std::vector<double> > weights( generate_random_matrix(n_cities,rng) );
+        if (i % 2) {
+            for (int r = 0; r < n_cities; ++r) {
+                for (int c = 0; c < r; ++c) {
+                    weights[r][c] = weights[c][r];
+                }
+            }
+        }
+
+        pagmo::problem::tsp prob(weights, pagmo::problem::tsp::CITIES);
+        pagmo::decision_vector tour = prob.randomkeys2cities(population(pagmo::problem::tsp(weights, pagmo::problem::tsp::RANDOMKEYS),1).get_individual(0).cur_x);
+        double f = prob.objfun(tour)[0];
+
+        boost::uniform_int<int> pos(0,n_cities-1);
+        boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_int<int> > rnd_pos(rng,pos);
+        for (int k = 0; k < 20; ++k) {
+            pagmo::decision_vector::size_type a = rnd_pos(), b = rnd_pos();
+            if (a > b) std::swap(a,b);
+            if (b - a + 1 == (pagmo::decision_vector::size_type)n_cities) continue;
+            double delta = prob.inversion_delta(tour, a, b);
+            std::reverse(tour.begin() + a, tour.begin() + b + 1);
+            double f_new = prob.objfun(tour)[0];
+            if (std::abs(f + delta - f_new) > 1e-10 * f_new) {
+                std::cout << "inversion delta " << delta << " does not match the objective function change " << f_new - f << "\n";
+                return true;
+            }
+            f = f_new;
+        }
+    }
+    return false;
+}
+
 int main()
 {
     boost::lagged_fibonacci607 rng;
@@ -142,6 +188,9 @@ int main()
     std::cout << "Testing Encoding Transformations: ";
     if (test_encoding_transformations(100,rng)) return 1;
     std::cout << "SUCCESS" << std::endl;
+    std::cout << "Testing Inversion Delta: ";
+    if (test_inversion_delta(100,rng)) return 1;
+    std::cout << "SUCCESS" << std::endl;
     
     // all iz well
     return 0;